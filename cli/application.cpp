@@ -5,6 +5,8 @@
 #include "./jsincludes.h"
 
 #include <syncthingconnector/syncthingconfig.h>
+#include <syncthingconnector/syncthingconfigpatch.h>
+#include <syncthingconnector/syncthingconfigtransaction.h>
 #include <syncthingconnector/utils.h>
 
 // use header-only functions waitForSignals() and signalInfo() from test utilities; disable assertions via macro
@@ -30,6 +32,7 @@
 #include <QTemporaryFile>
 #include <QTimer>
 
+#include <algorithm>
 #include <functional>
 #include <iostream>
 
@@ -88,12 +91,15 @@ Application::Application()
     m_args.pwd.setCallback(bind(&Application::checkPwdOperationPresent, this, _1));
     m_args.cat.setCallback(bind(&Application::printConfig, this, _1));
     m_args.edit.setCallback(bind(&Application::editConfig, this, _1));
+    m_args.set.setCallback(bind(&Application::changeConfig, this, _1));
     m_args.statusPwd.setCallback(bind(&Application::printPwdStatus, this, _1));
     m_args.rescanPwd.setCallback(bind(&Application::requestRescanPwd, this, _1));
     m_args.pausePwd.setCallback(bind(&Application::requestPausePwd, this, _1));
     m_args.resumePwd.setCallback(bind(&Application::requestResumePwd, this, _1));
     m_args.dir.setCallback(bind(&Application::initDirCompletion, this, ref(m_args.dir), _1));
     m_args.dev.setCallback(bind(&Application::initDevCompletion, this, ref(m_args.dev), _1));
+    m_args.shareWith.setCallback(bind(&Application::initDevCompletion, this, ref(m_args.shareWith), _1));
+    m_args.unshareWith.setCallback(bind(&Application::initDevCompletion, this, ref(m_args.unshareWith), _1));
 
     // connect signals and slots
     connect(&m_connection, &SyncthingConnection::statusChanged, this, &Application::handleStatusChanged);
@@ -327,8 +333,18 @@ void Application::handleError(
 
 void Application::requestLog(const ArgumentOccurrence &)
 {
-    connect(&m_connection, &SyncthingConnection::logAvailable, printLog);
-    m_connection.requestLog();
+    if (m_args.follow.isPresent()) {
+        // poll for new entries; only entries newer than the last one received are requested each time
+        auto *const pollTimer = new QTimer(this);
+        pollTimer->setInterval(2000);
+        connect(pollTimer, &QTimer::timeout, &m_connection, &SyncthingConnection::requestNewLogEntries);
+        connect(&m_connection, &SyncthingConnection::logEntriesAppended, this, &Application::printNewLogEntries);
+        pollTimer->start();
+        m_connection.requestNewLogEntries();
+    } else {
+        connect(&m_connection, &SyncthingConnection::logAvailable, printLog);
+        m_connection.requestLog();
+    }
     cerr << "Request log from " << m_settings.syncthingUrl.toLocal8Bit().data() << " ...";
     cerr.flush();
 }
@@ -594,7 +610,7 @@ void Application::printStatus(const ArgumentOccurrence &)
     // display stats
     if (m_args.stats.isPresent() || (!m_args.dir.isPresent() && !m_args.dev.isPresent())) {
         cout << TextAttribute::Bold << "Overall statistics\n" << TextAttribute::Reset;
-        const auto &overallStats(m_connection.computeOverallDirStatistics());
+        const auto &overallStats(m_connection.overallDirStatistics());
         const auto *statusString = "Up to Date";
         const auto *statusColor = "32";
         if (m_connection.hasOutOfSyncDirs()) {
@@ -673,18 +689,33 @@ void Application::printLog(const std::vector<SyncthingLogEntry> &logEntries)
     cerr << Phrases::Override;
 
     for (const SyncthingLogEntry &entry : logEntries) {
-        const auto when = entry.when.toUtf8();
-        try {
-            cout << DateTime::fromIsoStringLocal(when.data()).toString(DateTimeOutputFormat::DateAndTime, true);
-        } catch (const ConversionException &) {
-            cout << when.data();
-        }
-        cout << ':' << ' ' << entry.message.toLocal8Bit().data() << '\n';
+        printLogEntry(entry);
     }
     cout.flush();
     QCoreApplication::exit();
 }
 
+void Application::printLogEntry(const SyncthingLogEntry &entry)
+{
+    const auto when = entry.when.toUtf8();
+    try {
+        cout << DateTime::fromIsoStringLocal(when.data()).toString(DateTimeOutputFormat::DateAndTime, true);
+    } catch (const ConversionException &) {
+        cout << when.data();
+    }
+    cout << ':' << ' ' << entry.message.toLocal8Bit().data() << '\n';
+}
+
+void Application::printNewLogEntries(std::size_t beginIndex, std::size_t endIndex)
+{
+    cerr << Phrases::Override << flush; // erase "Request log ..." line on first invocation; no-op afterwards
+    const auto &logStore = m_connection.logStore();
+    for (auto index = std::max(beginIndex, logStore.beginIndex()), end = std::min(endIndex, logStore.endIndex()); index < end; ++index) {
+        printLogEntry(logStore.at(index));
+    }
+    cout.flush();
+}
+
 void Application::printConfig(const ArgumentOccurrence &)
 {
     // disable main event loop since this method is invoked directly as argument callback and we're doing all required async operations during the waitForConfig() call already
@@ -715,6 +746,11 @@ void Application::editConfig(const ArgumentOccurrence &)
         return;
     }
 
+    // handle "patch" case
+    if (m_args.patch.isPresent() && postConfigPatch(newConfig)) {
+        return;
+    }
+
     // handle "dry-run" case
     if (m_args.dryRun.isPresent()) {
         cout << newConfig.data();
@@ -734,6 +770,177 @@ void Application::editConfig(const ArgumentOccurrence &)
     cerr << Phrases::Override << Phrases::Info << "Configuration posted successfully" << Phrases::EndFlush;
 }
 
+/*!
+ * \brief Submits only the differences between the current and the specified \a newConfig.
+ * \returns Returns whether the new config has been handled; if not, the full config needs to be posted instead.
+ */
+bool Application::postConfigPatch(const QByteArray &newConfig)
+{
+    auto error = QJsonParseError();
+    const auto newConfigDoc = QJsonDocument::fromJson(newConfig, &error);
+    if (error.error != QJsonParseError::NoError) {
+        cerr << Phrases::Error << "Unable to parse new configuration" << Phrases::End << "reason: " << error.errorString().toLocal8Bit().data()
+             << " at character " << error.offset << endl;
+        return true;
+    }
+    const auto patch = SyncthingConfigPatch(m_connection.rawConfig(), newConfigDoc.object());
+    if (patch.isEmpty()) {
+        cerr << Phrases::Warning << "Editing aborted; config hasn't changed." << Phrases::EndFlush;
+        return true;
+    }
+
+    // handle "dry-run" case
+    if (m_args.dryRun.isPresent()) {
+        cout << QJsonDocument(patch.operations).toJson(QJsonDocument::Indented).data() << flush;
+        return true;
+    }
+
+    // fall back to posting the whole config if not all changes can be applied via per-object endpoints
+    if (patch.requiresFullConfig || m_connection.isUsingDeprecatedRoutes()) {
+        cerr << Phrases::Warning << "Not all changes can be applied via per-object endpoints; posting the whole configuration instead."
+             << Phrases::EndFlush;
+        return false;
+    }
+
+    // post changed objects
+    cerr << Phrases::Info << "Posting " << patch.requests.size() << " configuration change(s) ..." << TextAttribute::Reset << flush;
+    if (!waitForSignalsOrFail([this, &patch] { m_connection.postConfigPatch(patch); }, 0, signalInfo(&m_connection, &SyncthingConnection::error),
+            signalInfo(&m_connection, &SyncthingConnection::newConfigTriggered))) {
+        return true;
+    }
+    cerr << Phrases::Override << Phrases::Info << "Configuration changes posted successfully" << Phrases::EndFlush;
+    return true;
+}
+
+static bool assignBoolFromArg(const Argument &arg, bool &value)
+{
+    const auto *const argValue = arg.firstValue();
+    if (!argValue) {
+        return false;
+    }
+    if (!strcmp(argValue, "yes") || !strcmp(argValue, "on") || !strcmp(argValue, "true") || !strcmp(argValue, "1")) {
+        value = true;
+    } else if (!strcmp(argValue, "no") || !strcmp(argValue, "off") || !strcmp(argValue, "false") || !strcmp(argValue, "0")) {
+        value = false;
+    } else {
+        cerr << Phrases::Error << "The value \"" << argValue << "\" specified for --" << arg.name() << " is neither \"yes\" nor \"no\"."
+             << Phrases::EndFlush;
+        return false;
+    }
+    return true;
+}
+
+/*!
+ * \brief Collects the changes specified via the "set" operation for the relevant folders/devices and submits them at once.
+ */
+void Application::changeConfig(const ArgumentOccurrence &)
+{
+    // disable main event loop since this method is invoked directly as argument callback and we're doing all required async operations here
+    m_requiresMainEventLoop = false;
+
+    // wait until config is available
+    if (!waitForConfigAndStatus()) {
+        return;
+    }
+    cerr << Phrases::Override;
+
+    // determine IDs of relevant folders/devices and devices to share folders with
+    findRelevantDirsAndDevs(OperationType::ChangeConfig);
+    auto dirIds = QStringList(), devIds = QStringList();
+    dirIds.reserve(trQuandity(m_relevantDirs.size()));
+    for (const auto &dir : m_relevantDirs) {
+        dirIds << dir.dirObj->id;
+    }
+    devIds.reserve(trQuandity(m_relevantDevs.size()));
+    for (const auto *const dev : m_relevantDevs) {
+        devIds << dev->id;
+    }
+    const auto findDevIds = [this](const Argument &arg, QStringList &ids) {
+        auto dummy = int();
+        for (const auto *const devIdOrName : arg.values()) {
+            const auto devIdOrNameStr = argToQString(devIdOrName);
+            const auto *dev = m_connection.findDevInfo(devIdOrNameStr, dummy);
+            if (!dev) {
+                dev = m_connection.findDevInfoByName(devIdOrNameStr, dummy);
+            }
+            if (!dev) {
+                cerr << Phrases::Error << "Specified device \"" << devIdOrName << "\" does not exist." << Phrases::EndFlush;
+                return false;
+            }
+            ids << dev->id;
+        }
+        return true;
+    };
+    auto shareWithIds = QStringList(), unshareWithIds = QStringList();
+    if (!findDevIds(m_args.shareWith, shareWithIds) || !findDevIds(m_args.unshareWith, unshareWithIds)) {
+        return;
+    }
+    const auto dirSettingsPresent
+        = m_args.rescanInterval.isPresent() || m_args.fsWatcher.isPresent() || m_args.shareWith.isPresent() || m_args.unshareWith.isPresent();
+    if (dirIds.isEmpty() && (devIds.isEmpty() || dirSettingsPresent)) {
+        cerr << Phrases::Error << "No folders specified." << Phrases::EndFlush;
+        return;
+    }
+
+    // collect changes
+    auto transaction = SyncthingConfigTransaction(m_connection);
+    auto flag = false;
+    if (m_args.paused.isPresent()) {
+        if (!assignBoolFromArg(m_args.paused, flag)) {
+            return;
+        }
+        transaction.setDirsPaused(dirIds, flag);
+        transaction.setDevsPaused(devIds, flag);
+    }
+    if (m_args.fsWatcher.isPresent()) {
+        if (!assignBoolFromArg(m_args.fsWatcher, flag)) {
+            return;
+        }
+        transaction.setDirsWatcherEnabled(dirIds, flag);
+    }
+    if (const auto *const rescanIntervalArgValue = m_args.rescanInterval.firstValue()) {
+        try {
+            transaction.setDirsRescanInterval(dirIds, stringToNumber<int>(rescanIntervalArgValue));
+        } catch (const ConversionException &) {
+            cerr << Phrases::Error << "The specified rescan interval \"" << rescanIntervalArgValue << "\" is no integer." << Phrases::EndFlush;
+            return;
+        }
+    }
+    if (!shareWithIds.isEmpty()) {
+        transaction.shareDirs(dirIds, shareWithIds);
+    }
+    if (!unshareWithIds.isEmpty()) {
+        transaction.unshareDirs(dirIds, unshareWithIds);
+    }
+    if (!transaction.isValid()) {
+        cerr << Phrases::Error << "Unable to apply the specified changes" << Phrases::End;
+        for (const auto &error : transaction.errors()) {
+            cerr << " - " << error.toLocal8Bit().data() << '\n';
+        }
+        cerr << flush;
+        return;
+    }
+    const auto patch = transaction.patch();
+    if (patch.isEmpty()) {
+        cerr << Phrases::Warning << "No folders or devices altered." << Phrases::EndFlush;
+        return;
+    }
+
+    // handle "dry-run" case
+    if (m_args.dryRun.isPresent()) {
+        cout << QJsonDocument(patch.operations).toJson(QJsonDocument::Indented).data() << flush;
+        return;
+    }
+
+    // submit changes
+    cerr << Phrases::Info << "Posting " << patch.operations.size() << " configuration change(s) ..." << TextAttribute::Reset << flush;
+    if (!waitForSignalsOrFail([&transaction] { transaction.commit(); }, 0, signalInfo(&m_connection, &SyncthingConnection::error),
+            signalInfo(&transaction, &SyncthingConfigTransaction::committed))) {
+        return;
+    }
+    cerr << Phrases::Override << Phrases::Info << "Configuration changes posted successfully" << Phrases::EndFlush;
+}
+
 QByteArray Application::editConfigViaEditor() const
 {
     // read editor command and options
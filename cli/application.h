@@ -12,7 +12,7 @@
 
 namespace Cli {
 
-enum class OperationType { Status, PauseResume, WaitForIdle };
+enum class OperationType { Status, PauseResume, WaitForIdle, ChangeConfig };
 
 struct RelevantDir {
     explicit RelevantDir(const Data::SyncthingDir *dir = nullptr, const QString &subDir = QString());
@@ -66,10 +66,14 @@ private:
     void printDev(const Data::SyncthingDev *dev) const;
     void printStatus(const ArgumentOccurrence &);
     static void printLog(const std::vector<Data::SyncthingLogEntry> &logEntries);
+    static void printLogEntry(const Data::SyncthingLogEntry &entry);
+    void printNewLogEntries(std::size_t beginIndex, std::size_t endIndex);
     void printConfig(const ArgumentOccurrence &);
     void editConfig(const ArgumentOccurrence &);
     QByteArray editConfigViaEditor() const;
     QByteArray editConfigViaScript() const;
+    bool postConfigPatch(const QByteArray &newConfig);
+    void changeConfig(const ArgumentOccurrence &);
     void waitForIdle(const ArgumentOccurrence &);
     bool checkWhetherIdle() const;
     void checkPwdOperationPresent(const ArgumentOccurrence &occurrence);
@@ -20,24 +20,35 @@ Args::Args()
     , pwd("pwd", 'p', "operates in the current working directory")
     , cat("cat", '\0', "prints the current Syncthing configuration")
     , edit("edit", '\0', "allows editing the Syncthing configuration using an external editor")
+    , set("set", '\0', "changes settings of the specified folders and devices and submits all changes at once")
     , statusPwd("status", 's', "prints the status of the current working directory")
     , rescanPwd("rescan", 'r', "rescans the current working directory")
     , pausePwd("pause", 'p', "pauses the current working directory")
     , resumePwd("resume", '\0', "resumes the current working directory")
     , script("script", '\0', "runs the specified UTF-8 encoded ECMAScript on the configuration rather than opening an editor", { "path" })
     , jsLines("js-lines", '\0', "runs the specified ECMAScript lines on the configuration rather than opening an editor", { "line" })
-    , dryRun("dry-run", '\0', "writes the altered configuration to stdout instead of posting it to Syncthing")
+    , dryRun("dry-run", '\0',
+          "writes the altered configuration (or for \"set\" the changes as JSON patch) to stdout instead of posting it to Syncthing")
+    , patch("patch", '\0',
+          "submits only changed folders, devices and sections via Syncthing's per-object config endpoints instead of the whole configuration; "
+          "combined with --dry-run the changes are written to stdout as JSON patch")
     , stats("stats", '\0', "shows overall statistics")
     , dir("dir", 'd', "specifies a folder by ID", { "ID" })
     , dev("dev", '\0', "specifies a device by ID or name", { "ID/name" })
     , allDirs("all-dirs", '\0', "applies the operation for all folders")
     , allDevs("all-devs", '\0', "applies the operation for all devices")
+    , paused("paused", '\0', "pauses or resumes the specified folders and devices", { "yes/no" })
+    , rescanInterval("rescan-interval", '\0', "sets the interval for full rescans of the specified folders (0 disables them)", { "seconds" })
+    , fsWatcher("fs-watcher", '\0', "enables or disables watching for changes for the specified folders", { "yes/no" })
+    , shareWith("share-with", '\0', "shares the specified folders with the specified devices", { "dev ID/name" })
+    , unshareWith("unshare-with", '\0', "stops sharing the specified folders with the specified devices", { "dev ID/name" })
     , atLeast("at-least", 'a', "specifies for how many milliseconds Syncthing must idle (prevents exiting too early in case of flaky status)",
           { "number" })
     , timeout("timeout", 't', "specifies how many milliseconds to wait at most", { "number" })
     , requireDevsConnected(
           "require-devs-connected", '\0', "requires all specified devices to be connected (by default disconnected devices are considered idling)")
     , editor("editor", '\0', "specifies the editor to be opened", { "editor name", "editor option" })
+    , follow("follow", '\0', "keeps running and prints new log entries as they appear (only new entries are requested each time)")
     , configFile("config-file", 'f', "specifies the Syncthing config file to read API key and URL from, when not explicitly specified", { "path" })
     , apiKey("api-key", 'k', "specifies the API key", { "key" })
     , url("url", 'u', "specifies the Syncthing URL, default is http://localhost:8080", { "URL" })
@@ -57,12 +68,24 @@ Args::Args()
     waitForIdle.setExample(PROJECT_NAME " wait-for-idle --timeout 1800000 --at-least 5000 --all-devs --all-dirs && systemctl poweroff\n" PROJECT_NAME
                                         " wait-for-idle --dir dir1 --dir dir2 --dev dev1 --dev dev2 --at-least 5000");
     pwd.setSubArguments({ &statusPwd, &rescanPwd, &pausePwd, &resumePwd });
+    log.setSubArguments({ &follow });
+    log.setExample(PROJECT_NAME " log --follow");
 
     for (auto *arg : { &editor, &script, &jsLines }) {
         arg->setCombinable(false);
     }
     jsLines.setRequiredValueCount(Argument::varValueCount);
-    edit.setSubArguments({ &editor, &script, &jsLines, &dryRun });
+    edit.setSubArguments({ &editor, &script, &jsLines, &dryRun, &patch });
+    edit.setExample(PROJECT_NAME " edit --js-lines \"config.gui.theme = 'dark'\" --patch --dry-run");
+
+    for (auto *arg : { &shareWith, &unshareWith }) {
+        arg->setRequiredValueCount(Argument::varValueCount);
+        arg->setValueCompletionBehavior(ValueCompletionBehavior::PreDefinedValues | ValueCompletionBehavior::InvokeCallback);
+    }
+    set.setSubArguments({ &dir, &dev, &allDirs, &allDevs, &paused, &rescanInterval, &fsWatcher, &shareWith, &unshareWith, &dryRun });
+    set.setExample(PROJECT_NAME " set --all-dirs --rescan-interval 7200 --fs-watcher yes\n" PROJECT_NAME
+                                " set --dir dir1 --dir dir2 --share-with dev1 dev2 --dry-run\n" PROJECT_NAME
+                                " set --all-dirs --dev dev1 --paused no");
 
     rescan.setValueNames({ "dir ID" });
     rescan.setRequiredValueCount(Argument::varValueCount);
@@ -80,8 +103,8 @@ Args::Args()
     configFile.setExample(PROJECT_NAME " status --dir dir1 --config-file ~/.config/syncthing/config.xml");
     credentials.setExample(PROJECT_NAME " status --dir dir1 --credentials name supersecret");
 
-    parser.setMainArguments({ &status, &log, &stop, &restart, &rescan, &rescanAll, &pause, &resume, &waitForIdle, &pwd, &cat, &edit, &configFile,
-        &apiKey, &url, &credentials, &certificate, &requestTimeout, &generalTimeout, &parser.noColorArg(), &parser.helpArg() });
+    parser.setMainArguments({ &status, &log, &stop, &restart, &rescan, &rescanAll, &pause, &resume, &waitForIdle, &pwd, &cat, &edit, &set,
+        &configFile, &apiKey, &url, &credentials, &certificate, &requestTimeout, &generalTimeout, &parser.noColorArg(), &parser.helpArg() });
 
     // allow setting default values via environment
     configFile.setEnvironmentVariable("SYNCTHING_CTL_CONFIG_FILE");
@@ -10,12 +10,14 @@ using namespace CppUtilities;
 struct Args {
     Args();
     ArgumentParser parser;
-    OperationArgument status, log, stop, restart, rescan, rescanAll, pause, resume, waitForIdle, pwd, cat, edit;
+    OperationArgument status, log, stop, restart, rescan, rescanAll, pause, resume, waitForIdle, pwd, cat, edit, set;
     OperationArgument statusPwd, rescanPwd, pausePwd, resumePwd;
-    ConfigValueArgument script, jsLines, dryRun;
+    ConfigValueArgument script, jsLines, dryRun, patch;
     ConfigValueArgument stats, dir, dev, allDirs, allDevs;
+    ConfigValueArgument paused, rescanInterval, fsWatcher, shareWith, unshareWith;
     ConfigValueArgument atLeast, timeout, requireDevsConnected;
     ConfigValueArgument editor;
+    ConfigValueArgument follow;
     ConfigValueArgument configFile, apiKey, url, credentials, certificate, requestTimeout, generalTimeout;
 };
 
@@ -0,0 +1,55 @@
+#include "./selectionanalyzer.h"
+#include "./syncthingdirmembership.h"
+
+#include <algorithm>
+#include <unordered_set>
+#include <utility>
+
+using namespace Data;
+
+/*!
+ * \brief Constructs a new analyzer using the specified \a membership cache.
+ */
+SelectionAnalyzer::SelectionAnalyzer(const SyncthingDirMembership &membership)
+    : m_membership(membership)
+    , m_lastDir(nullptr)
+{
+}
+
+/*!
+ * \brief Determines the Syncthing folders the specified \a cleanPaths belong to.
+ * \remarks
+ * - The paths are supposed to be cleaned via QDir::cleanPath().
+ * - The paths are sorted once so results are deterministic and duplicates are skipped. Each path is then looked up in the
+ *   membership cache and folders are de-duplicated via hash sets. Hence the time required grows only slightly faster than
+ *   the number of paths (n log n for sorting plus n times the path depth).
+ */
+void SelectionAnalyzer::analyze(QStringList cleanPaths)
+{
+    m_selectedDirs.clear();
+    m_containingDirs.clear();
+    m_items.clear();
+    m_lastDir = nullptr;
+
+    std::sort(cleanPaths.begin(), cleanPaths.end());
+    cleanPaths.erase(std::unique(cleanPaths.begin(), cleanPaths.end()), cleanPaths.end());
+
+    auto seenSelectedDirs = std::unordered_set<const SyncthingDir *>();
+    auto seenContainingDirs = std::unordered_set<const SyncthingDir *>();
+    m_items.reserve(static_cast<std::size_t>(cleanPaths.size()));
+    for (const auto &path : std::as_const(cleanPaths)) {
+        m_membership.forEachContainingDir(path, [&](const SyncthingDir &dir, bool isRoot, const QString &relativePath) {
+            m_lastDir = &dir;
+            if (isRoot) {
+                if (seenSelectedDirs.insert(&dir).second) {
+                    m_selectedDirs.append(&dir);
+                }
+            } else {
+                m_items.emplace_back(&dir, relativePath);
+                if (seenContainingDirs.insert(&dir).second) {
+                    m_containingDirs.append(&dir);
+                }
+            }
+        });
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef SELECTIONANALYZER_H
+#define SELECTIONANALYZER_H
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <vector>
+
+namespace Data {
+struct SyncthingDir;
+}
+
+class SyncthingDirMembership;
+
+/*!
+ * \brief The SelectionItem struct refers to a selected path within a Syncthing folder.
+ */
+struct SelectionItem {
+    explicit SelectionItem(const Data::SyncthingDir *dir, const QString &path);
+    QString name() const;
+
+    const Data::SyncthingDir *dir;
+    QString path;
+};
+
+inline SelectionItem::SelectionItem(const Data::SyncthingDir *dir, const QString &path)
+    : dir(dir)
+    , path(path)
+{
+}
+
+/*!
+ * \brief Returns the file name of the item.
+ */
+inline QString SelectionItem::name() const
+{
+    const auto lastSep = path.lastIndexOf(QChar('/'));
+    return lastSep >= 0 ? path.mid(lastSep + 1) : path;
+}
+
+/*!
+ * \brief The SelectionAnalyzer class determines which Syncthing folders selected paths belong to.
+ */
+class SelectionAnalyzer {
+public:
+    explicit SelectionAnalyzer(const SyncthingDirMembership &membership);
+
+    void analyze(QStringList cleanPaths);
+    const QList<const Data::SyncthingDir *> &selectedDirs() const;
+    const QList<const Data::SyncthingDir *> &containingDirs() const;
+    const std::vector<SelectionItem> &items() const;
+    const Data::SyncthingDir *lastDir() const;
+
+private:
+    const SyncthingDirMembership &m_membership;
+    QList<const Data::SyncthingDir *> m_selectedDirs;
+    QList<const Data::SyncthingDir *> m_containingDirs;
+    std::vector<SelectionItem> m_items;
+    const Data::SyncthingDir *m_lastDir;
+};
+
+/*!
+ * \brief Returns the Syncthing folders which have been selected themselves.
+ */
+inline const QList<const Data::SyncthingDir *> &SelectionAnalyzer::selectedDirs() const
+{
+    return m_selectedDirs;
+}
+
+/*!
+ * \brief Returns the Syncthing folders containing selected items.
+ */
+inline const QList<const Data::SyncthingDir *> &SelectionAnalyzer::containingDirs() const
+{
+    return m_containingDirs;
+}
+
+/*!
+ * \brief Returns the selected items within Syncthing folders (excluding the folders themselves).
+ */
+inline const std::vector<SelectionItem> &SelectionAnalyzer::items() const
+{
+    return m_items;
+}
+
+/*!
+ * \brief Returns the Syncthing folder encountered last or nullptr if no selected path belongs to a Syncthing folder.
+ */
+inline const Data::SyncthingDir *SelectionAnalyzer::lastDir() const
+{
+    return m_lastDir;
+}
+
+#endif // SELECTIONANALYZER_H
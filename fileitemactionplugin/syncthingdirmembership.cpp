@@ -0,0 +1,128 @@
+#include "./syncthingdirmembership.h"
+
+#include <syncthingconnector/syncthingconnection.h>
+#include <syncthingconnector/utils.h>
+
+#include <QDir>
+
+using namespace Data;
+
+/// \cond
+static SyncthingDirStatusSummary summarizeStatus(const SyncthingDir &dir)
+{
+    auto summary = SyncthingDirStatusSummary();
+    summary.status = dir.status;
+    summary.completionPercentage = dir.completionPercentage;
+    summary.paused = dir.paused;
+    summary.locallyUpToDate = dir.isLocallyUpToDate();
+    summary.outOfSync = dir.isOutOfSync();
+    return summary;
+}
+/// \endcond
+
+/*!
+ * \brief Constructs a new membership cache for the folders of the specified \a connection.
+ */
+SyncthingDirMembership::SyncthingDirMembership(const SyncthingConnection &connection)
+    : SyncthingDirMembership(connection.dirInfo(), connection.tilde(), connection.pathSeparator())
+{
+}
+
+/*!
+ * \brief Constructs a new membership cache for the specified \a dirs.
+ * \remarks The cache only keeps references to the specified arguments so they must outlive the cache.
+ */
+SyncthingDirMembership::SyncthingDirMembership(const std::vector<SyncthingDir> &dirs, const QString &tilde, const QString &pathSeparator)
+    : m_dirs(dirs)
+    , m_tilde(tilde)
+    , m_pathSeparator(pathSeparator)
+    , m_dirty(true)
+{
+}
+
+/*!
+ * \brief Updates the status summary for the specified \a dir at the specified \a index.
+ * \remarks This is supposed to be connected to SyncthingConnection::dirStatusChanged().
+ */
+void SyncthingDirMembership::updateStatus(const SyncthingDir &dir, int index)
+{
+    if (m_dirty || index < 0 || static_cast<std::size_t>(index) >= m_summaries.size()) {
+        return; // summaries are re-computed anyway on the next lookup
+    }
+    m_summaries[static_cast<std::size_t>(index)] = summarizeStatus(dir);
+}
+
+/*!
+ * \brief Returns the innermost Syncthing folder containing the specified \a cleanPath or nullptr if there is none.
+ */
+const SyncthingDir *SyncthingDirMembership::innermostDir(const QString &cleanPath) const
+{
+    const SyncthingDir *innermost = nullptr;
+    forEachContainingDir(cleanPath, [&innermost](const SyncthingDir &dir, bool, const QString &) { innermost = &dir; });
+    return innermost;
+}
+
+/*!
+ * \brief Returns the status summary of the innermost Syncthing folder containing the specified \a cleanPath or nullptr if
+ *        there is none.
+ * \remarks This is cheap enough to be queried for each visible file, e.g. to determine overlay icons.
+ */
+const SyncthingDirStatusSummary *SyncthingDirMembership::statusSummary(const QString &cleanPath) const
+{
+    const auto *const dir = innermostDir(cleanPath);
+    if (!dir) {
+        return nullptr;
+    }
+    const auto index = static_cast<std::size_t>(dir - m_dirs.data());
+    return index < m_summaries.size() ? &m_summaries[index] : nullptr;
+}
+
+/// \cond
+void SyncthingDirMembership::ensureUpToDate() const
+{
+    if (m_dirty) {
+        rebuild();
+    }
+}
+
+void SyncthingDirMembership::rebuild() const
+{
+    const auto &dirs = m_dirs;
+    m_root.children.clear();
+    m_summaries.clear();
+    m_summaries.reserve(dirs.size());
+    for (auto index = std::size_t(); index != dirs.size(); ++index) {
+        const auto &dir = dirs[index];
+        m_summaries.emplace_back(summarizeStatus(dir));
+
+        // insert the folder's path segment by segment; drop the trailing slash of the root path so "/" becomes a single empty segment
+        auto path = QDir::cleanPath(substituteTilde(dir.path, m_tilde, m_pathSeparator));
+        if (path.isEmpty()) {
+            continue;
+        }
+        if (path.endsWith(QChar('/'))) {
+            path.chop(1);
+        }
+        auto *node = &m_root;
+        for (auto pos = decltype(path.size())();;) {
+            auto end = path.indexOf(QChar('/'), pos);
+            if (end < 0) {
+                end = path.size();
+            }
+            auto &child = node->children[path.mid(pos, end - pos)];
+            if (!child) {
+                child = std::make_unique<Node>();
+            }
+            node = child.get();
+            if (end == path.size()) {
+                break;
+            }
+            pos = end + 1;
+        }
+        if (node->dirIndex == noDir) {
+            node->dirIndex = index;
+        }
+    }
+    m_dirty = false;
+}
+/// \endcond
@@ -0,0 +1,110 @@
+#ifndef SYNCTHINGDIRMEMBERSHIP_H
+#define SYNCTHINGDIRMEMBERSHIP_H
+
+#include <syncthingconnector/qstringhash.h>
+#include <syncthingconnector/syncthingdir.h>
+
+#include <QString>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Data {
+class SyncthingConnection;
+}
+
+/*!
+ * \brief The SyncthingDirStatusSummary struct holds the status of a Syncthing folder relevant for the file item actions.
+ */
+struct SyncthingDirStatusSummary {
+    Data::SyncthingDirStatus status = Data::SyncthingDirStatus::Unknown;
+    int completionPercentage = 0;
+    bool paused = false;
+    bool locallyUpToDate = false;
+    bool outOfSync = false;
+};
+
+/*!
+ * \brief The SyncthingDirMembership class determines quickly which Syncthing folders a local path belongs to.
+ *
+ * The folder paths are kept in a trie of path segments so looking up a path only takes as many steps as the path has
+ * segments (instead of comparing it against the paths of all folders). Additionally, a summary of each folder's status
+ * is kept so the status of many paths can be queried without touching the SyncthingDir objects themselves.
+ *
+ * The trie is rebuilt lazily on the next lookup after the folders have been (re-)configured. Status changes are applied
+ * immediately via updateStatus().
+ */
+class SyncthingDirMembership {
+public:
+    explicit SyncthingDirMembership(const Data::SyncthingConnection &connection);
+    explicit SyncthingDirMembership(const std::vector<Data::SyncthingDir> &dirs, const QString &tilde, const QString &pathSeparator);
+
+    void invalidate();
+    void updateStatus(const Data::SyncthingDir &dir, int index);
+    template <typename Callback> void forEachContainingDir(const QString &cleanPath, Callback &&callback) const;
+    const Data::SyncthingDir *innermostDir(const QString &cleanPath) const;
+    const SyncthingDirStatusSummary *statusSummary(const QString &cleanPath) const;
+
+private:
+    struct Node {
+        std::unordered_map<QString, std::unique_ptr<Node>> children;
+        std::size_t dirIndex = noDir;
+    };
+    static constexpr auto noDir = static_cast<std::size_t>(-1);
+
+    void ensureUpToDate() const;
+    void rebuild() const;
+
+    const std::vector<Data::SyncthingDir> &m_dirs;
+    const QString &m_tilde;
+    const QString &m_pathSeparator;
+    mutable Node m_root;
+    mutable std::vector<SyncthingDirStatusSummary> m_summaries;
+    mutable bool m_dirty;
+};
+
+/*!
+ * \brief Marks the trie as outdated so it is rebuilt on the next lookup.
+ * \remarks Must be called whenever folders are added, removed or re-configured or the tilde changes.
+ */
+inline void SyncthingDirMembership::invalidate()
+{
+    m_dirty = true;
+}
+
+/*!
+ * \brief Invokes \a callback for each Syncthing folder containing the specified \a cleanPath (or being \a cleanPath itself).
+ *
+ * The callback is invoked with the folder, whether \a cleanPath is the folder's root and the path relative to the folder.
+ * Folders are reported from the outermost to the innermost one.
+ *
+ * \remarks The \a cleanPath is supposed to be cleaned via QDir::cleanPath().
+ */
+template <typename Callback> void SyncthingDirMembership::forEachContainingDir(const QString &cleanPath, Callback &&callback) const
+{
+    ensureUpToDate();
+    const auto &dirs = m_dirs;
+    const auto size = cleanPath.size();
+    const auto *node = &m_root;
+    for (auto pos = decltype(cleanPath.size())(); node && pos <= size;) {
+        auto end = cleanPath.indexOf(QChar('/'), pos);
+        if (end < 0) {
+            end = size;
+        }
+        const auto child = node->children.find(cleanPath.mid(pos, end - pos));
+        node = child != node->children.end() ? child->second.get() : nullptr;
+        if (node && node->dirIndex < dirs.size()) {
+            const auto relativePath = cleanPath.mid(std::min(end + 1, size));
+            callback(dirs[node->dirIndex], relativePath.isEmpty(), relativePath);
+        }
+        if (end == size) {
+            break;
+        }
+        pos = end + 1;
+    }
+}
+
+#endif // SYNCTHINGDIRMEMBERSHIP_H
@@ -1,4 +1,5 @@
 #include "./syncthingfileitemaction.h"
+#include "./selectionanalyzer.h"
 #include "./syncthingdiractions.h"
 #include "./syncthinginfoaction.h"
 #include "./syncthingmenuaction.h"
@@ -24,25 +25,6 @@ K_PLUGIN_CLASS_WITH_JSON(SyncthingFileItemAction, "metadata.json");
 K_PLUGIN_FACTORY(SyncthingFileItemActionFactory, registerPlugin<SyncthingFileItemAction>();)
 #endif
 
-struct SyncthingItem {
-    SyncthingItem(const Data::SyncthingDir *dir, const QString &path);
-    const Data::SyncthingDir *dir;
-    QString path;
-    QString name;
-};
-
-SyncthingItem::SyncthingItem(const Data::SyncthingDir *dir, const QString &path)
-    : dir(dir)
-    , path(path)
-{
-    const auto lastSep = path.lastIndexOf(QChar('/'));
-    if (lastSep >= 0) {
-        name = path.mid(lastSep + 1);
-    } else {
-        name = path;
-    }
-}
-
 SyncthingFileItemActionStaticData SyncthingFileItemAction::s_data;
 
 SyncthingFileItemAction::SyncthingFileItemAction(QObject *parent, const QVariantList &)
@@ -101,7 +83,6 @@ QList<QAction *> SyncthingFileItemAction::createActions(const KFileItemListPrope
     auto actions = QList<QAction *>();
     auto &data = s_data;
     auto &connection = data.connection();
-    const auto &dirs = connection.dirInfo();
 
     // get all paths
     auto paths = QStringList();
@@ -116,28 +97,12 @@ QList<QAction *> SyncthingFileItemAction::createActions(const KFileItemListPrope
     }
 
     // determine relevant Syncthing dirs
-    QList<const Data::SyncthingDir *> detectedDirs;
-    QList<const Data::SyncthingDir *> containingDirs;
-    QList<SyncthingItem> detectedItems;
-    const Data::SyncthingDir *lastDir = nullptr;
-    for (const Data::SyncthingDir &dir : dirs) {
-        auto dirPath = QDir::cleanPath(Data::substituteTilde(dir.path, connection.tilde(), connection.pathSeparator()));
-        auto dirPathWithSlash = dirPath + QChar('/');
-        for (const QString &path : std::as_const(paths)) {
-            if (path == dirPath) {
-                lastDir = &dir;
-                if (!detectedDirs.contains(lastDir)) {
-                    detectedDirs << lastDir;
-                }
-            } else if (path.startsWith(dirPathWithSlash)) {
-                detectedItems << SyncthingItem(&dir, path.mid(dirPathWithSlash.size()));
-                lastDir = &dir;
-                if (!containingDirs.contains(lastDir)) {
-                    containingDirs << lastDir;
-                }
-            }
-        }
-    }
+    auto analyzer = SelectionAnalyzer(data.membership());
+    analyzer.analyze(std::move(paths));
+    const auto &detectedDirs = analyzer.selectedDirs();
+    auto containingDirs = analyzer.containingDirs();
+    const auto &detectedItems = analyzer.items();
+    const auto *const lastDir = analyzer.lastDir();
 
     // compute dir stats
     const auto detectedDirsStats = DirStats(detectedDirs);
@@ -145,16 +110,16 @@ QList<QAction *> SyncthingFileItemAction::createActions(const KFileItemListPrope
 
     // add actions for the selected items itself
     actions.reserve(32);
-    if (!detectedItems.isEmpty()) {
+    if (!detectedItems.empty()) {
         QString rescanLabel;
         if (detectedItems.size() > 1) {
             rescanLabel = tr("Rescan selected items");
         } else {
-            rescanLabel = tr("Rescan \"%1\"").arg(detectedItems.front().name);
+            rescanLabel = tr("Rescan \"%1\"").arg(detectedItems.front().name());
         }
         actions << new QAction(QIcon::fromTheme(QStringLiteral("view-refresh")), rescanLabel, parent);
         if (connection.isConnected() && !containingDirsStats.allPaused) {
-            for (const SyncthingItem &item : std::as_const(detectedItems)) {
+            for (const SelectionItem &item : detectedItems) {
                 connect(actions.back(), &QAction::triggered, bind(&SyncthingFileItemActionStaticData::rescanDir, &data, item.dir->id, item.path));
             }
         } else {
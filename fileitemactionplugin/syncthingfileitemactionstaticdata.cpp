@@ -29,7 +29,8 @@ using namespace QtUtilities;
 using namespace Data;
 
 SyncthingFileItemActionStaticData::SyncthingFileItemActionStaticData()
-    : m_initialized(false)
+    : m_membership(m_connection)
+    , m_initialized(false)
 {
 }
 
@@ -62,6 +63,16 @@ void SyncthingFileItemActionStaticData::initialize()
     m_connection.disablePolling();
     m_connection.setPollingFlags(SyncthingConnection::PollingFlags::MainEvents);
 
+    // keep membership cache up to date
+    const auto invalidateMembership = [this] { m_membership.invalidate(); };
+    connect(&m_connection, &SyncthingConnection::newDirs, this, invalidateMembership);
+    connect(&m_connection, &SyncthingConnection::dirAdded, this, invalidateMembership);
+    connect(&m_connection, &SyncthingConnection::dirRemoved, this, invalidateMembership);
+    connect(&m_connection, &SyncthingConnection::dirConfigChanged, this, invalidateMembership);
+    connect(&m_connection, &SyncthingConnection::tildeChanged, this, invalidateMembership);
+    connect(&m_connection, &SyncthingConnection::dirStatusChanged, this,
+        [this](const SyncthingDir &dir, int index) { m_membership.updateStatus(dir, index); });
+
     // connect Signals & Slots for logging
     connect(&m_connection, &SyncthingConnection::error, this, &SyncthingFileItemActionStaticData::logConnectionError);
     if (qEnvironmentVariableIsSet("KIO_SYNCTHING_LOG_STATUS")) {
@@ -1,6 +1,8 @@
 #ifndef SYNCTHINGFILEITEMACTIONSTATICDATA_H
 #define SYNCTHINGFILEITEMACTIONSTATICDATA_H
 
+#include "./syncthingdirmembership.h"
+
 #include <syncthingconnector/syncthingconnection.h>
 
 QT_FORWARD_DECLARE_CLASS(QPalette)
@@ -22,6 +24,7 @@ public:
     explicit SyncthingFileItemActionStaticData();
     Data::SyncthingConnection &connection();
     const Data::SyncthingConnection &connection() const;
+    const SyncthingDirMembership &membership() const;
     const QString &configPath() const;
     const QString &currentError() const;
     bool hasError() const;
@@ -47,6 +50,7 @@ private:
     void appendNoteToError(QString &errorMessage, const QString &newSyncthingConfigFilePath) const;
 
     Data::SyncthingConnection m_connection;
+    SyncthingDirMembership m_membership;
     QString m_configFilePath;
     QString m_currentError;
     bool m_initialized;
@@ -62,6 +66,15 @@ inline const Data::SyncthingConnection &SyncthingFileItemActionStaticData::conne
     return m_connection;
 }
 
+/*!
+ * \brief Returns the cache to determine which Syncthing folders local paths belong to.
+ * \remarks The cache is kept up to date with the folders of connection().
+ */
+inline const SyncthingDirMembership &SyncthingFileItemActionStaticData::membership() const
+{
+    return m_membership;
+}
+
 inline const QString &SyncthingFileItemActionStaticData::configPath() const
 {
     return m_configFilePath;
@@ -0,0 +1,124 @@
+#include "../selectionanalyzer.h"
+#include "../syncthingdirmembership.h"
+
+#include <syncthingconnector/syncthingdir.h>
+
+#include <QtTest/QtTest>
+
+#include <QStringBuilder>
+
+#include <cstddef>
+#include <vector>
+
+using namespace Data;
+
+class SelectionAnalyzerTests : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void testMembership();
+    void testAnalyzing();
+    void benchmarkAnalyzing();
+
+private:
+    std::vector<SyncthingDir> m_dirs;
+    QString m_tilde;
+    QString m_pathSeparator;
+};
+
+void SelectionAnalyzerTests::initTestCase()
+{
+    m_tilde = QStringLiteral("/home/user");
+    m_pathSeparator = QStringLiteral("/");
+    m_dirs.emplace_back(QStringLiteral("docs"), QStringLiteral("Documents"), QStringLiteral("~/Documents"));
+    m_dirs.emplace_back(QStringLiteral("photos"), QStringLiteral("Photos"), QStringLiteral("/data/photos/"));
+    m_dirs.emplace_back(QStringLiteral("nested"), QStringLiteral("Nested"), QStringLiteral("/data/photos/2024"));
+    m_dirs.emplace_back(QStringLiteral("similar"), QStringLiteral("Similar prefix"), QStringLiteral("/data/photos-backup"));
+    m_dirs.back().paused = true;
+}
+
+void SelectionAnalyzerTests::testMembership()
+{
+    auto membership = SyncthingDirMembership(m_dirs, m_tilde, m_pathSeparator);
+    QCOMPARE(membership.innermostDir(QStringLiteral("/home/user/Documents/a/b.txt")), &m_dirs[0]);
+    QCOMPARE(membership.innermostDir(QStringLiteral("/home/user/Documents")), &m_dirs[0]);
+    QVERIFY(!membership.innermostDir(QStringLiteral("/home/user/Documents2")));
+    QCOMPARE(membership.innermostDir(QStringLiteral("/data/photos/2024/img.jpg")), &m_dirs[2]);
+    QCOMPARE(membership.innermostDir(QStringLiteral("/data/photos/2023/img.jpg")), &m_dirs[1]);
+    QCOMPARE(membership.innermostDir(QStringLiteral("/data/photos-backup/img.jpg")), &m_dirs[3]);
+    QVERIFY(!membership.innermostDir(QStringLiteral("/data")));
+
+    // status summary is updated in place and re-computed after invalidation
+    const auto *summary = membership.statusSummary(QStringLiteral("/data/photos-backup/img.jpg"));
+    QVERIFY(summary);
+    QVERIFY(summary->paused);
+    m_dirs[3].paused = false;
+    membership.updateStatus(m_dirs[3], 3);
+    QVERIFY(!membership.statusSummary(QStringLiteral("/data/photos-backup/img.jpg"))->paused);
+    m_dirs[3].paused = true;
+    membership.invalidate();
+    QVERIFY(membership.statusSummary(QStringLiteral("/data/photos-backup/img.jpg"))->paused);
+    QVERIFY(!membership.statusSummary(QStringLiteral("/tmp")));
+}
+
+void SelectionAnalyzerTests::testAnalyzing()
+{
+    const auto membership = SyncthingDirMembership(m_dirs, m_tilde, m_pathSeparator);
+    auto analyzer = SelectionAnalyzer(membership);
+    analyzer.analyze(QStringList({ QStringLiteral("/data/photos/2024/b.jpg"), QStringLiteral("/home/user/Documents"),
+        QStringLiteral("/data/photos/2024/a.jpg"), QStringLiteral("/tmp/foo"), QStringLiteral("/data/photos/2024/a.jpg") }));
+    QCOMPARE(analyzer.selectedDirs(), QList<const SyncthingDir *>({ &m_dirs[0] }));
+    QCOMPARE(analyzer.containingDirs(), QList<const SyncthingDir *>({ &m_dirs[1], &m_dirs[2] }));
+
+    // items are sorted and de-duplicated; items within nested folders are reported for each folder
+    const auto &items = analyzer.items();
+    QCOMPARE(items.size(), std::size_t(4));
+    QCOMPARE(items[0].dir, &m_dirs[1]);
+    QCOMPARE(items[0].path, QStringLiteral("2024/a.jpg"));
+    QCOMPARE(items[1].dir, &m_dirs[2]);
+    QCOMPARE(items[1].path, QStringLiteral("a.jpg"));
+    QCOMPARE(items[1].name(), QStringLiteral("a.jpg"));
+    QCOMPARE(items[3].path, QStringLiteral("b.jpg"));
+    QCOMPARE(analyzer.lastDir(), &m_dirs[0]);
+
+    // selecting nothing relevant yields no results
+    analyzer.analyze(QStringList({ QStringLiteral("/tmp/foo") }));
+    QVERIFY(analyzer.selectedDirs().isEmpty());
+    QVERIFY(analyzer.containingDirs().isEmpty());
+    QVERIFY(analyzer.items().empty());
+    QVERIFY(!analyzer.lastDir());
+}
+
+void SelectionAnalyzerTests::benchmarkAnalyzing()
+{
+    // select 100k files spread over all folders (in reverse order so sorting is not a no-op)
+    auto paths = QStringList();
+    paths.reserve(100000);
+    for (auto i = 99999; i >= 0; --i) {
+        switch (i % 4) {
+        case 0:
+            paths << QStringLiteral("/home/user/Documents/dir") % QString::number(i % 100) % QStringLiteral("/file") % QString::number(i);
+            break;
+        case 1:
+            paths << QStringLiteral("/data/photos/2024/img") % QString::number(i) % QStringLiteral(".jpg");
+            break;
+        case 2:
+            paths << QStringLiteral("/data/photos-backup/img") % QString::number(i) % QStringLiteral(".jpg");
+            break;
+        default:
+            paths << QStringLiteral("/tmp/unrelated/file") % QString::number(i);
+        }
+    }
+
+    const auto membership = SyncthingDirMembership(m_dirs, m_tilde, m_pathSeparator);
+    auto analyzer = SelectionAnalyzer(membership);
+    QBENCHMARK {
+        analyzer.analyze(paths);
+    }
+    QCOMPARE(analyzer.items().size(), std::size_t(100000));
+    QCOMPARE(analyzer.containingDirs().size(), static_cast<decltype(analyzer.containingDirs().size())>(4));
+}
+
+QTEST_GUILESS_MAIN(SelectionAnalyzerTests)
+#include "selectionanalyzer.moc"
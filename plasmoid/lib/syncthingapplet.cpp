@@ -548,7 +548,6 @@ void SyncthingApplet::showDirectoryErrors(const QString &dirId)
     if (!dir) {
         return;
     }
-    m_connection.requestDirPullErrors(dirId);
     auto *const dlg = new DirectoryErrorsDialog(m_connection, *dir);
     dlg->setAttribute(Qt::WA_DeleteOnClose, true);
     centerWidget(dlg);
@@ -646,7 +645,7 @@ void SyncthingApplet::handleInternalError(
 
 void SyncthingApplet::handleDirStatisticsChanged()
 {
-    m_overallStats = m_connection.computeOverallDirStatistics();
+    m_overallStats = m_connection.overallDirStatistics();
     emit statisticsChanged();
 }
 
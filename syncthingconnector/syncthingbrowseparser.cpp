@@ -0,0 +1,258 @@
+#include "./syncthingbrowseparser.h"
+#include "./syncthingconnection.h"
+#include "./utils.h"
+
+#include <c++utilities/chrono/datetime.h>
+
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+
+namespace Data {
+
+/*!
+ * \class SyncthingBrowseParser
+ * \brief The SyncthingBrowseParser class parses the response of Syncthing's "db/browse" route incrementally.
+ *
+ * The response is a JSON array of items. Instead of parsing the whole document at once, data is fed into the parser as it
+ * is received via feed(). Whenever a top-level element of the array has been received completely, it is parsed into a
+ * SyncthingItem which can be taken via takeItems(). So only the currently incomplete element is buffered and the memory
+ * usage is proportional to the number of items not taken yet rather than to the size of the whole response.
+ *
+ * \remarks The parser only scans for structural characters which are all ASCII so multi-byte UTF-8 sequences can be split
+ *          at arbitrary positions between calls to feed().
+ * \sa SyncthingConnection::browseIncrementally()
+ */
+
+/*!
+ * \brief Constructs a parser for a response that has been requested with the specified number of \a levels.
+ * \remarks The \a levels are required to set SyncthingItem::childrenPopulated correctly.
+ */
+SyncthingBrowseParser::SyncthingBrowseParser(int levels)
+    : m_totalItemCount(0)
+    , m_depth(0)
+    , m_levels(levels)
+    , m_state(State::BeforeArray)
+    , m_inString(false)
+    , m_escaped(false)
+{
+}
+
+/*!
+ * \brief Feeds the specified \a size bytes of \a data into the parser.
+ * \remarks Data fed after the end of the array has been reached or after an error occurred is ignored.
+ */
+void SyncthingBrowseParser::feed(const char *data, std::size_t size)
+{
+    const auto *const end = data + size;
+    const auto *elementStart = m_state == State::InElement ? data : nullptr;
+    for (const auto *i = data; i != end; ++i) {
+        const auto c = *i;
+        switch (m_state) {
+        case State::BeforeArray:
+            switch (c) {
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n':
+                continue;
+            case '[':
+                m_state = State::BetweenElements;
+                continue;
+            default:
+                setError(QCoreApplication::translate("Data::SyncthingBrowseParser", "response is not a JSON array"));
+                return;
+            }
+        case State::BetweenElements:
+            switch (c) {
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n':
+            case ',':
+                continue;
+            case ']':
+                m_state = State::Complete;
+                return;
+            default:
+                m_state = State::InElement;
+                m_depth = 0;
+                m_inString = m_escaped = false;
+                elementStart = i;
+                break;
+            }
+            [[fallthrough]];
+        case State::InElement:
+            if (m_inString) {
+                if (m_escaped) {
+                    m_escaped = false;
+                } else if (c == '\\') {
+                    m_escaped = true;
+                } else if (c == '"') {
+                    m_inString = false;
+                }
+                continue;
+            }
+            switch (c) {
+            case '"':
+                m_inString = true;
+                continue;
+            case '{':
+            case '[':
+                ++m_depth;
+                continue;
+            case '}':
+            case ']':
+                if (m_depth) {
+                    if (--m_depth) {
+                        continue;
+                    }
+                    m_element.append(elementStart, static_cast<int>(i + 1 - elementStart));
+                    elementStart = nullptr;
+                    completeElement();
+                    continue;
+                }
+                [[fallthrough]];
+            case ',':
+                if (!m_depth) {
+                    // end of a scalar element (which is skipped anyways)
+                    m_element.clear();
+                    elementStart = nullptr;
+                    m_state = c == ']' ? State::Complete : State::BetweenElements;
+                    if (m_state == State::Complete) {
+                        return;
+                    }
+                }
+                continue;
+            default:
+                continue;
+            }
+        case State::Complete:
+        case State::Error:
+            return;
+        }
+    }
+    if (elementStart && m_state == State::InElement) {
+        m_element.append(elementStart, static_cast<int>(end - elementStart));
+    }
+}
+
+/*!
+ * \brief Signals that no more data will be fed; sets an error if the response has been truncated.
+ */
+void SyncthingBrowseParser::finish()
+{
+    if (m_state != State::Complete && m_state != State::Error) {
+        setError(QCoreApplication::translate("Data::SyncthingBrowseParser", "response ended prematurely"));
+    }
+}
+
+/*!
+ * \brief Returns the items that have been parsed since the last call.
+ * \remarks The SyncthingItem::index of returned items is relative to the whole response so items returned by subsequent calls
+ *          can simply be appended.
+ */
+std::vector<std::unique_ptr<SyncthingItem>> SyncthingBrowseParser::takeItems()
+{
+    auto items = std::vector<std::unique_ptr<SyncthingItem>>();
+    items.swap(m_items);
+    return items;
+}
+
+/*!
+ * \brief Reads the specified JSON \a array of items returned by Syncthing's "db/browse" route into the specified vector.
+ */
+void SyncthingBrowseParser::readItems(const QJsonArray &array, std::vector<std::unique_ptr<SyncthingItem>> &into, int level, int levels)
+{
+    into.reserve(into.size() + static_cast<std::size_t>(array.size()));
+    for (const auto &jsonItem : array) {
+        if (jsonItem.isObject()) {
+            readItem(jsonItem.toObject(), into, level, levels);
+        }
+    }
+}
+
+/*!
+ * \brief Reads the specified JSON \a object describing an item returned by Syncthing's "db/browse" route into the specified vector.
+ */
+void SyncthingBrowseParser::readItem(const QJsonObject &object, std::vector<std::unique_ptr<SyncthingItem>> &into, int level, int levels)
+{
+    const auto typeValue = object.value(QLatin1String("type"));
+    const auto index = into.size();
+    const auto children = object.value(QLatin1String("children"));
+    auto &item = into.emplace_back(std::make_unique<SyncthingItem>());
+    item->name = object.value(QLatin1String("name")).toString();
+    const auto modTime = object.value(QLatin1String("modTime")).toString();
+    auto localModTime = CppUtilities::DateTime();
+    auto utcOffset = CppUtilities::TimeSpan();
+    item->modificationTime = parseIsoTimeStamp(modTime, localModTime, utcOffset) ? localModTime - utcOffset
+                                                                                : CppUtilities::DateTime::fromIsoStringGmt(modTime.toUtf8().data());
+    item->size = static_cast<std::size_t>(object
+            .value(QLatin1String("size"))
+#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
+            .toInteger()
+#else
+            .toDouble()
+#endif
+    );
+    item->index = index;
+    item->level = level;
+    switch (typeValue.toInt(-1)) {
+    case 0:
+        item->type = SyncthingItemType::File;
+        break;
+    case 1:
+        item->type = SyncthingItemType::Directory;
+        break;
+    case 2:
+    case 3:
+    case 4:
+        item->type = SyncthingItemType::Symlink;
+        break;
+    default:
+        const auto type = typeValue.toString();
+        if (type == QLatin1String("FILE_INFO_TYPE_FILE")) {
+            item->type = SyncthingItemType::File;
+        } else if (type == QLatin1String("FILE_INFO_TYPE_DIRECTORY")) {
+            item->type = SyncthingItemType::Directory;
+        } else if (type == QLatin1String("FILE_INFO_TYPE_SYMLINK")) {
+            item->type = SyncthingItemType::Symlink;
+        }
+    }
+    readItems(children.toArray(), item->children, level + 1, levels);
+    item->childrenPopulated = !levels || level < levels;
+}
+
+/// \cond
+
+void SyncthingBrowseParser::completeElement()
+{
+    m_state = State::BetweenElements;
+    if (!m_element.startsWith('{')) {
+        m_element.clear();
+        return; // skip elements which are not objects like readItems() does
+    }
+    auto jsonError = QJsonParseError();
+    const auto doc = QJsonDocument::fromJson(m_element, &jsonError);
+    m_element.clear();
+    if (jsonError.error != QJsonParseError::NoError) {
+        setError(QCoreApplication::translate("Data::SyncthingBrowseParser", "unable to parse item %1: %2")
+                     .arg(QString::number(m_totalItemCount + 1), jsonError.errorString()));
+        return;
+    }
+    readItem(doc.object(), m_items, 0, m_levels);
+    m_items.back()->index = m_totalItemCount++;
+}
+
+void SyncthingBrowseParser::setError(const QString &errorString)
+{
+    m_state = State::Error;
+    m_errorString = errorString;
+    m_element.clear();
+}
+
+/// \endcond
+
+} // namespace Data
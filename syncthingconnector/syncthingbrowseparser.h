@@ -0,0 +1,103 @@
+#ifndef DATA_SYNCTHINGBROWSEPARSER_H
+#define DATA_SYNCTHINGBROWSEPARSER_H
+
+#include "./global.h"
+
+#include <QByteArray>
+#include <QString>
+
+#include <memory>
+#include <vector>
+
+QT_FORWARD_DECLARE_CLASS(QJsonArray)
+QT_FORWARD_DECLARE_CLASS(QJsonObject)
+
+namespace Data {
+
+struct SyncthingItem;
+
+class LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingBrowseParser {
+public:
+    explicit SyncthingBrowseParser(int levels = 0);
+
+    void feed(const char *data, std::size_t size);
+    void feed(const QByteArray &data);
+    void finish();
+    std::vector<std::unique_ptr<SyncthingItem>> takeItems();
+    std::size_t pendingItemCount() const;
+    std::size_t totalItemCount() const;
+    bool isComplete() const;
+    bool hasError() const;
+    const QString &errorString() const;
+
+    static void readItems(const QJsonArray &array, std::vector<std::unique_ptr<SyncthingItem>> &into, int level, int levels);
+    static void readItem(const QJsonObject &object, std::vector<std::unique_ptr<SyncthingItem>> &into, int level, int levels);
+
+private:
+    enum class State { BeforeArray, BetweenElements, InElement, Complete, Error };
+
+    void completeElement();
+    void setError(const QString &errorString);
+
+    std::vector<std::unique_ptr<SyncthingItem>> m_items;
+    QByteArray m_element;
+    QString m_errorString;
+    std::size_t m_totalItemCount;
+    std::size_t m_depth;
+    int m_levels;
+    State m_state;
+    bool m_inString;
+    bool m_escaped;
+};
+
+/*!
+ * \brief Feeds the specified \a data into the parser.
+ */
+inline void SyncthingBrowseParser::feed(const QByteArray &data)
+{
+    feed(data.data(), static_cast<std::size_t>(data.size()));
+}
+
+/*!
+ * \brief Returns the number of items that have been parsed but not been taken via takeItems() yet.
+ */
+inline std::size_t SyncthingBrowseParser::pendingItemCount() const
+{
+    return m_items.size();
+}
+
+/*!
+ * \brief Returns the number of top-level items that have been parsed so far.
+ */
+inline std::size_t SyncthingBrowseParser::totalItemCount() const
+{
+    return m_totalItemCount;
+}
+
+/*!
+ * \brief Returns whether the end of the top-level array has been reached.
+ */
+inline bool SyncthingBrowseParser::isComplete() const
+{
+    return m_state == State::Complete;
+}
+
+/*!
+ * \brief Returns whether a parsing error occurred; see errorString() for details.
+ */
+inline bool SyncthingBrowseParser::hasError() const
+{
+    return m_state == State::Error;
+}
+
+/*!
+ * \brief Returns the error message if hasError() returns true; otherwise returns an empty string.
+ */
+inline const QString &SyncthingBrowseParser::errorString() const
+{
+    return m_errorString;
+}
+
+} // namespace Data
+
+#endif // DATA_SYNCTHINGBROWSEPARSER_H
@@ -5,8 +5,12 @@
 
 #include <qtutilities/misc/compat.h>
 
+#include <QDateTime>
 #include <QFile>
+#include <QFileInfo>
 #include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QStandardPaths>
 #include <QStringBuilder>
 #include <QXmlStreamReader>
@@ -170,50 +174,66 @@ static QJsonObject xmlToJson(QXmlStreamReader &xmlReader, bool convertDeviceId)
     return json;
 }
 
+/// \cond
+namespace {
+
 /*!
- * \brief Reads the configuration at the specified \a configFilePath.
- * \param details Whether details should be populates as well.
+ * \brief The CachedConfig struct holds a config previously read from a file along with the file's modification time and size.
  */
-bool SyncthingConfig::restore(const QString &configFilePath, bool detailed)
-{
-    auto configFile = QFile(configFilePath);
-    if (!configFile.open(QFile::ReadOnly)) {
-        return false;
-    }
+struct CachedConfig {
+    QDateTime lastModified;
+    qint64 size = -1;
+    bool detailed = false;
+    bool ok = false;
+    SyncthingConfig config;
+};
+
+struct ConfigCache {
+    QMutex mutex;
+    QHash<QString, CachedConfig> entries;
+};
+
+} // namespace
+
+Q_GLOBAL_STATIC(ConfigCache, configCache)
 
-    auto xmlReader = QXmlStreamReader(&configFile);
+/*!
+ * \brief Reads the config via \a xmlReader into \a config and the folders/devices into \a details unless nullptr.
+ * \returns Returns whether the <gui> element has been found.
+ */
+static bool readConfig(QXmlStreamReader &xmlReader, SyncthingConfig &config, SyncthingConfigDetails *details)
+{
     auto ok = false;
-    auto *const details = detailed ? &this->details.emplace() : nullptr;
 #include <qtutilities/misc/xmlparsermacros.h>
     children
     {
         // only version 16 supported, try to parse other versions anyway since the changes might not affect
         // the few parts read here
-        version = attribute("version").toString();
+        config.version = attribute("version").toString();
         children
         {
             iftag("gui")
             {
                 ok = true;
-                guiEnabled = attributeFlag("enabled");
-                guiEnforcesSecureConnection = attributeFlag("tls");
+                config.guiEnabled = attributeFlag("enabled");
+                config.guiEnforcesSecureConnection = attributeFlag("tls");
                 children
                 {
                     iftag("address")
                     {
-                        guiAddress = text;
+                        config.guiAddress = text;
                     }
                     eliftag("user")
                     {
-                        guiUser = text;
+                        config.guiUser = text;
                     }
                     eliftag("password")
                     {
-                        guiPasswordHash = text;
+                        config.guiPasswordHash = text;
                     }
                     eliftag("apikey")
                     {
-                        guiApiKey = text;
+                        config.guiApiKey = text;
                     }
                     else_skip
                 }
@@ -239,6 +259,135 @@ bool SyncthingConfig::restore(const QString &configFilePath, bool detailed)
     return ok;
 }
 
+/*!
+ * \brief Returns a minimal document only consisting of the root element and the <gui> element of the specified config \a data.
+ * \remarks
+ * - Syncthing writes the <gui> element after all <folder> and <device> elements so reading it via QXmlStreamReader would mean
+ *   tokenizing almost the whole file. Since "<" cannot occur unescaped within attribute values and text, it is possible to locate
+ *   the relevant elements by a plain search instead.
+ * - Returns an empty byte array if the elements cannot be located that way; then the whole file needs to be read.
+ */
+static QByteArray extractGuiElement(const QByteArray &data)
+{
+    const auto rootBegin = data.indexOf("<configuration");
+    const auto rootEnd = rootBegin < 0 ? rootBegin : data.indexOf('>', rootBegin);
+    if (rootEnd < 0 || data.at(rootEnd - 1) == '/') {
+        return QByteArray();
+    }
+    for (auto guiBegin = data.indexOf("<gui", rootEnd); guiBegin >= 0; guiBegin = data.indexOf("<gui", guiBegin + 4)) {
+        const auto next = guiBegin + 4 < data.size() ? data.at(guiBegin + 4) : '\0';
+        if (next != ' ' && next != '>' && next != '\t' && next != '\n' && next != '\r') {
+            continue; // some other element starting with "gui"
+        }
+        const auto guiEnd = data.indexOf("</gui>", guiBegin);
+        if (guiEnd < 0) {
+            return QByteArray();
+        }
+        auto excerpt = QByteArray();
+        excerpt.reserve(rootEnd + 1 + guiEnd + 6 - guiBegin + 16);
+        excerpt.append(data.constData(), rootEnd + 1);
+        excerpt.append(data.constData() + guiBegin, guiEnd + 6 - guiBegin);
+        excerpt.append("</configuration>");
+        return excerpt;
+    }
+    return QByteArray();
+}
+
+/*!
+ * \brief Reads the config file \a configFilePath into \a config.
+ * \remarks Reads only up to the <gui> element unless \a detailed is set.
+ */
+static bool readConfigFile(const QString &configFilePath, bool detailed, SyncthingConfig &config)
+{
+    auto configFile = QFile(configFilePath);
+    if (!configFile.open(QFile::ReadOnly)) {
+        return false;
+    }
+
+    // map the file to avoid copying its contents
+    auto data = QByteArray();
+    const auto size = configFile.size();
+    if (auto *const mapped = size > 0 ? configFile.map(0, size) : nullptr) {
+        data = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), static_cast<decltype(data.size())>(size));
+    } else {
+        data = configFile.readAll();
+    }
+
+    auto *const details = detailed ? &config.details.emplace() : nullptr;
+    if (!details) {
+        if (const auto excerpt = extractGuiElement(data); !excerpt.isEmpty()) {
+            auto xmlReader = QXmlStreamReader(excerpt);
+            if (readConfig(xmlReader, config, nullptr)) {
+                return true;
+            }
+        }
+    }
+    auto xmlReader = QXmlStreamReader(data);
+    return readConfig(xmlReader, config, details);
+}
+/// \endcond
+
+/*!
+ * \brief Reads the configuration at the specified \a configFilePath.
+ * \param details Whether details should be populates as well.
+ * \remarks
+ * - Unless \a detailed is set, the file is only read up to the <gui> element.
+ * - The result is cached per process and reused as long as the modification time and size of the file have not changed. So
+ *   it is cheap to call this function repeatedly, e.g. from setup detection, the wizard, the launcher and the CLI.
+ */
+bool SyncthingConfig::restore(const QString &configFilePath, bool detailed)
+{
+    const auto fileInfo = QFileInfo(configFilePath);
+    if (!fileInfo.isFile()) {
+        return false;
+    }
+    const auto key = fileInfo.absoluteFilePath();
+    const auto lastModified = fileInfo.lastModified();
+    const auto size = fileInfo.size();
+    auto *const cache = configCache();
+    auto entry = CachedConfig();
+    {
+        const auto locker = QMutexLocker(&cache->mutex);
+        if (const auto cached = cache->entries.constFind(key); cached != cache->entries.cend() && cached->lastModified == lastModified
+            && cached->size == size && (cached->detailed || !detailed)) {
+            entry = *cached;
+        }
+    }
+    if (entry.size < 0) {
+        entry.lastModified = lastModified;
+        entry.size = size;
+        entry.detailed = detailed;
+        entry.ok = readConfigFile(configFilePath, detailed, entry.config);
+        const auto locker = QMutexLocker(&cache->mutex);
+        cache->entries.insert(key, entry);
+    }
+
+    // take over the cached result (only populating details if requested)
+    version = entry.config.version;
+    if (entry.ok) {
+        guiEnabled = entry.config.guiEnabled;
+        guiEnforcesSecureConnection = entry.config.guiEnforcesSecureConnection;
+        guiAddress = entry.config.guiAddress;
+        guiUser = entry.config.guiUser;
+        guiPasswordHash = entry.config.guiPasswordHash;
+        guiApiKey = entry.config.guiApiKey;
+    }
+    if (detailed) {
+        details = entry.config.details;
+    }
+    return entry.ok;
+}
+
+/*!
+ * \brief Clears the per-process cache of configs read via restore().
+ */
+void SyncthingConfig::clearCache()
+{
+    auto *const cache = configCache();
+    const auto locker = QMutexLocker(&cache->mutex);
+    cache->entries.clear();
+}
+
 QString SyncthingConfig::syncthingUrl() const
 {
     return (guiEnforcesSecureConnection || !isLocal(stripPort(guiAddress)) ? QStringLiteral("https://") : QStringLiteral("http://")) + guiAddress;
@@ -29,6 +29,7 @@ struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingConfig {
     static QString locateConfigFile();
     static QString locateHttpsCertificate();
     bool restore(const QString &configFilePath, bool detailed = false);
+    static void clearCache();
     QString syncthingUrl() const;
 };
 
@@ -0,0 +1,267 @@
+#include "./syncthingconfigpatch.h"
+
+#include <QHash>
+#include <QStringList>
+#include <QStringBuilder>
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+
+namespace Data {
+
+/// \cond
+namespace {
+
+QString escapeJsonPointerToken(QString token)
+{
+    return token.replace(QChar('~'), QLatin1String("~0")).replace(QChar('/'), QLatin1String("~1"));
+}
+
+/*!
+ * \brief Returns the keys of \a first followed by the keys only present in \a second.
+ */
+QStringList keysOf(const QJsonObject &first, const QJsonObject &second)
+{
+    auto keys = first.keys();
+    for (auto i = second.begin(), end = second.end(); i != end; ++i) {
+        if (!first.contains(i.key())) {
+            keys.append(i.key());
+        }
+    }
+    return keys;
+}
+
+QJsonObject makeOperation(QLatin1String op, const QString &pointer, const QJsonValue &value = QJsonValue(QJsonValue::Undefined))
+{
+    auto operation = QJsonObject{ { QStringLiteral("op"), op }, { QStringLiteral("path"), pointer } };
+    if (!value.isUndefined()) {
+        operation.insert(QStringLiteral("value"), value);
+    }
+    return operation;
+}
+
+/*!
+ * \brief The KeyedArrayDiff struct computes the difference between arrays of objects identified by an ID (folders/devices).
+ */
+struct KeyedArrayDiff {
+    explicit KeyedArrayDiff(QLatin1String idKey, const QString &pointer, const QString &endpoint);
+    bool compute(const QJsonArray &from, const QJsonArray &to, QJsonArray &operations);
+
+    QLatin1String idKey;
+    QString pointer;
+    QString endpoint;
+    std::vector<SyncthingConfigRequest> upserts;
+    std::vector<SyncthingConfigRequest> removals;
+};
+
+KeyedArrayDiff::KeyedArrayDiff(QLatin1String idKey, const QString &pointer, const QString &endpoint)
+    : idKey(idKey)
+    , pointer(pointer)
+    , endpoint(endpoint)
+{
+}
+
+/*!
+ * \brief Computes the difference; returns false if the arrays cannot be treated as keyed arrays (missing/duplicate/unusable IDs).
+ * \remarks Changes are referring to indices within \a from so they are emitted first, followed by removals (in descending
+ *          order so the indices stay valid) and additions at the end. A different order of objects is not considered a change.
+ */
+bool KeyedArrayDiff::compute(const QJsonArray &from, const QJsonArray &to, QJsonArray &operations)
+{
+    const auto idOf = [this](const QJsonValue &value) {
+        const auto id = value.toObject().value(idKey).toString();
+        return id.contains(QChar('/')) ? QString() : id; // IDs containing slashes cannot be used within the endpoint path
+    };
+    auto fromIndexById = QHash<QString, QJsonArray::size_type>();
+    fromIndexById.reserve(from.size());
+    for (auto i = QJsonArray::size_type(); i != from.size(); ++i) {
+        const auto id = idOf(from.at(i));
+        if (id.isEmpty() || fromIndexById.contains(id)) {
+            return false;
+        }
+        fromIndexById.insert(id, i);
+    }
+    auto kept = std::vector<bool>(static_cast<std::size_t>(from.size()), false);
+    auto changes = QJsonArray(), additions = QJsonArray();
+    auto newUpserts = std::vector<SyncthingConfigRequest>(), newRemovals = std::vector<SyncthingConfigRequest>();
+    for (const auto &toValue : to) {
+        const auto id = idOf(toValue);
+        if (id.isEmpty()) {
+            return false;
+        }
+        const auto fromIndex = fromIndexById.constFind(id);
+        if (fromIndex == fromIndexById.cend()) {
+            additions.append(makeOperation(QLatin1String("add"), pointer + QStringLiteral("/-"), toValue));
+            newUpserts.emplace_back(SyncthingConfigRequest{ QByteArrayLiteral("POST"), endpoint, toValue });
+            continue;
+        }
+        if (kept[static_cast<std::size_t>(*fromIndex)]) {
+            return false; // duplicate ID
+        }
+        kept[static_cast<std::size_t>(*fromIndex)] = true;
+        const auto fromValue = from.at(*fromIndex);
+        if (fromValue != toValue) {
+            appendJsonPatch(fromValue, toValue, pointer % QChar('/') % QString::number(*fromIndex), changes);
+            newUpserts.emplace_back(
+                SyncthingConfigRequest{ QByteArrayLiteral("PATCH"), endpoint % QChar('/') % id, makeJsonMergePatch(fromValue, toValue) });
+        }
+    }
+    for (auto i = from.size(); i > 0; --i) {
+        if (!kept[static_cast<std::size_t>(i - 1)]) {
+            changes.append(makeOperation(QLatin1String("remove"), pointer % QChar('/') % QString::number(i - 1)));
+            newRemovals.emplace_back(SyncthingConfigRequest{ QByteArrayLiteral("DELETE"), endpoint % QChar('/') % idOf(from.at(i - 1)) });
+        }
+    }
+    for (const auto &operation : std::as_const(changes)) {
+        operations.append(operation);
+    }
+    for (const auto &operation : std::as_const(additions)) {
+        operations.append(operation);
+    }
+    std::move(newUpserts.begin(), newUpserts.end(), std::back_inserter(upserts));
+    std::move(newRemovals.begin(), newRemovals.end(), std::back_inserter(removals));
+    return true;
+}
+
+} // namespace
+/// \endcond
+
+/*!
+ * \struct SyncthingConfigPatch
+ * \brief The SyncthingConfigPatch struct holds the difference between two Syncthing configs.
+ *
+ * The difference is available as RFC 6902 JSON Patch (e.g. to show it to the user) and as requests for Syncthing's
+ * per-object config endpoints (`/rest/config/folders/…`, `/rest/config/devices/…`, `/rest/config/options`, …) so only
+ * changed objects need to be submitted instead of the whole config. Changed objects are submitted as RFC 7386 merge patch.
+ * Requests are ordered so added devices exist before folders referring to them and folders are removed before devices.
+ *
+ * If something changed for which there is no per-object endpoint (e.g. "version"), requiresFullConfig is set and the
+ * whole config needs to be posted instead.
+ */
+
+/*!
+ * \brief Computes the difference between \a oldConfig and \a newConfig.
+ */
+SyncthingConfigPatch::SyncthingConfigPatch(const QJsonObject &oldConfig, const QJsonObject &newConfig)
+{
+    auto devices = KeyedArrayDiff(QLatin1String("deviceID"), QStringLiteral("/devices"), QStringLiteral("config/devices"));
+    auto folders = KeyedArrayDiff(QLatin1String("id"), QStringLiteral("/folders"), QStringLiteral("config/folders"));
+    auto sections = std::vector<SyncthingConfigRequest>();
+    for (const auto &key : keysOf(oldConfig, newConfig)) {
+        const auto from = oldConfig.value(key), to = newConfig.value(key);
+        if (from == to) {
+            continue;
+        }
+        const auto pointer = QString(QChar('/') % escapeJsonPointerToken(key));
+        if (key == QLatin1String("devices") || key == QLatin1String("folders")) {
+            auto &diff = key == QLatin1String("devices") ? devices : folders;
+            if (from.isArray() && to.isArray() && diff.compute(from.toArray(), to.toArray(), operations)) {
+                continue;
+            }
+        } else if (key == QLatin1String("options") || key == QLatin1String("gui") || key == QLatin1String("ldap")) {
+            if (from.isObject() && to.isObject()) {
+                appendJsonPatch(from, to, pointer, operations);
+                sections.emplace_back(
+                    SyncthingConfigRequest{ QByteArrayLiteral("PATCH"), QStringLiteral("config/") + key, makeJsonMergePatch(from, to) });
+                continue;
+            }
+        } else if (key == QLatin1String("defaults") && from.isObject() && to.isObject()) {
+            // check whether only defaults with their own endpoint have changed
+            const auto defaultsWithEndpoint
+                = std::array<QLatin1String, 3>{ QLatin1String("folder"), QLatin1String("device"), QLatin1String("ignores") };
+            const auto fromDefaults = from.toObject(), toDefaults = to.toObject();
+            auto handled = true;
+            for (const auto &defaultsKey : keysOf(fromDefaults, toDefaults)) {
+                const auto fromDefault = fromDefaults.value(defaultsKey), toDefault = toDefaults.value(defaultsKey);
+                if (fromDefault != toDefault
+                    && (!fromDefault.isObject() || !toDefault.isObject()
+                        || std::find(defaultsWithEndpoint.begin(), defaultsWithEndpoint.end(), defaultsKey) == defaultsWithEndpoint.end())) {
+                    handled = false;
+                    break;
+                }
+            }
+            if (handled) {
+                for (const auto &defaultsKey : defaultsWithEndpoint) {
+                    const auto fromDefault = fromDefaults.value(defaultsKey), toDefault = toDefaults.value(defaultsKey);
+                    if (fromDefault == toDefault) {
+                        continue;
+                    }
+                    const auto endpoint = QString(QStringLiteral("config/defaults/") % defaultsKey);
+                    appendJsonPatch(fromDefault, toDefault, pointer % QChar('/') % defaultsKey, operations);
+                    sections.emplace_back(defaultsKey == QLatin1String("ignores")
+                            ? SyncthingConfigRequest{ QByteArrayLiteral("PUT"), endpoint, toDefault }
+                            : SyncthingConfigRequest{ QByteArrayLiteral("PATCH"), endpoint, makeJsonMergePatch(fromDefault, toDefault) });
+                }
+                continue;
+            }
+        }
+        // fall back to a plain diff which can only be applied by posting the full config
+        appendJsonPatch(from, to, pointer, operations);
+        requiresFullConfig = true;
+    }
+
+    // order requests so references stay valid: add/update devices, add/update folders, remove folders, remove devices
+    requests.reserve(devices.upserts.size() + folders.upserts.size() + folders.removals.size() + devices.removals.size() + sections.size());
+    for (auto *const batch : { &devices.upserts, &folders.upserts, &folders.removals, &devices.removals, &sections }) {
+        std::move(batch->begin(), batch->end(), std::back_inserter(requests));
+    }
+}
+
+/*!
+ * \brief Appends RFC 6902 JSON Patch operations to \a operations which turn \a from into \a to.
+ * \remarks Objects are compared recursively; arrays and other values are replaced as a whole. The specified \a pointer
+ *          is the JSON Pointer of \a from/\a to within the document.
+ */
+void appendJsonPatch(const QJsonValue &from, const QJsonValue &to, const QString &pointer, QJsonArray &operations)
+{
+    if (from == to) {
+        return;
+    }
+    if (!from.isObject() || !to.isObject()) {
+        operations.append(makeOperation(QLatin1String("replace"), pointer, to));
+        return;
+    }
+    const auto fromObject = from.toObject(), toObject = to.toObject();
+    for (auto i = fromObject.begin(), end = fromObject.end(); i != end; ++i) {
+        const auto childPointer = QString(pointer % QChar('/') % escapeJsonPointerToken(i.key()));
+        if (const auto toValue = toObject.constFind(i.key()); toValue == toObject.constEnd()) {
+            operations.append(makeOperation(QLatin1String("remove"), childPointer));
+        } else {
+            appendJsonPatch(i.value(), toValue.value(), childPointer, operations);
+        }
+    }
+    for (auto i = toObject.begin(), end = toObject.end(); i != end; ++i) {
+        if (!fromObject.contains(i.key())) {
+            operations.append(makeOperation(QLatin1String("add"), pointer % QChar('/') % escapeJsonPointerToken(i.key()), i.value()));
+        }
+    }
+}
+
+/*!
+ * \brief Returns an RFC 7386 JSON merge patch which turns \a from into \a to.
+ * \remarks Only contains the members which have changed. Removed members are set to null.
+ */
+QJsonValue makeJsonMergePatch(const QJsonValue &from, const QJsonValue &to)
+{
+    if (!from.isObject() || !to.isObject()) {
+        return to;
+    }
+    const auto fromObject = from.toObject(), toObject = to.toObject();
+    auto patch = QJsonObject();
+    for (auto i = fromObject.begin(), end = fromObject.end(); i != end; ++i) {
+        if (const auto toValue = toObject.constFind(i.key()); toValue == toObject.constEnd()) {
+            patch.insert(i.key(), QJsonValue::Null);
+        } else if (i.value() != toValue.value()) {
+            patch.insert(i.key(), makeJsonMergePatch(i.value(), toValue.value()));
+        }
+    }
+    for (auto i = toObject.begin(), end = toObject.end(); i != end; ++i) {
+        if (!fromObject.contains(i.key())) {
+            patch.insert(i.key(), i.value());
+        }
+    }
+    return patch;
+}
+
+} // namespace Data
@@ -0,0 +1,55 @@
+#ifndef DATA_SYNCTHINGCONFIGPATCH_H
+#define DATA_SYNCTHINGCONFIGPATCH_H
+
+#include "./global.h"
+
+#include <QByteArray>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+
+#include <vector>
+
+namespace Data {
+
+struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingConfigRequest {
+    /// \brief The HTTP verb, e.g. "PATCH".
+    QByteArray verb;
+    /// \brief The path relative to "/rest/", e.g. "config/folders/foo".
+    QString path;
+    /// \brief The JSON body or an undefined value if the request has no body.
+    QJsonValue body = QJsonValue(QJsonValue::Undefined);
+};
+
+struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingConfigPatch {
+    explicit SyncthingConfigPatch();
+    explicit SyncthingConfigPatch(const QJsonObject &oldConfig, const QJsonObject &newConfig);
+    bool isEmpty() const;
+
+    /// \brief The RFC 6902 JSON Patch operations to turn the old config into the new config.
+    QJsonArray operations;
+    /// \brief The requests to apply the changes via Syncthing's per-object config endpoints.
+    std::vector<SyncthingConfigRequest> requests;
+    /// \brief Whether there are changes which cannot be applied via the per-object endpoints so the full config must be posted.
+    bool requiresFullConfig = false;
+};
+
+inline SyncthingConfigPatch::SyncthingConfigPatch()
+{
+}
+
+/*!
+ * \brief Returns whether the old and new config are equal (order of folders and devices aside).
+ */
+inline bool SyncthingConfigPatch::isEmpty() const
+{
+    return operations.isEmpty();
+}
+
+LIB_SYNCTHING_CONNECTOR_EXPORT void appendJsonPatch(const QJsonValue &from, const QJsonValue &to, const QString &pointer, QJsonArray &operations);
+LIB_SYNCTHING_CONNECTOR_EXPORT QJsonValue makeJsonMergePatch(const QJsonValue &from, const QJsonValue &to);
+
+} // namespace Data
+
+#endif // DATA_SYNCTHINGCONFIGPATCH_H
@@ -0,0 +1,384 @@
+#include "./syncthingconfigtransaction.h"
+#include "./syncthingconnection.h"
+
+#include <QSet>
+#include <QStringBuilder>
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+namespace Data {
+
+/*!
+ * \class SyncthingConfigTransaction
+ * \brief The SyncthingConfigTransaction class collects many folder/device edits and submits them at once.
+ *
+ * Edits are typed (e.g. setDirsPaused(), shareDirs()) and validated against the config the transaction is based on
+ * when they are made. An edit referring to a folder/device which does not exist or using an invalid value is not
+ * applied and recorded in errors() instead; a transaction with errors cannot be committed. Edits only modify existing
+ * folder and device objects; adding or removing folders/devices is out of scope.
+ *
+ * When committing, the difference to the base config is computed via SyncthingConfigPatch. If it can be applied with at
+ * most maxObjectRequests() requests to Syncthing's per-object endpoints (e.g. when only a few folders have changed)
+ * these are used. Otherwise the full config is posted in one request. In the latter case the changed folders/devices are
+ * applied on top of the connection's current config so changes made in the meantime by someone else are preserved as
+ * far as they don't concern the same objects.
+ *
+ * The transaction may be used from QML, e.g. via App::createConfigTransaction() in the Qt Quick GUI.
+ */
+
+/*!
+ * \brief Creates a new transaction based on the current config of \a connection.
+ */
+SyncthingConfigTransaction::SyncthingConfigTransaction(SyncthingConnection &connection, QObject *parent)
+    : QObject(parent)
+    , m_connection(&connection)
+    , m_maxObjectRequests(defaultMaxObjectRequests)
+    , m_committing(false)
+{
+    reset();
+}
+
+/*!
+ * \brief Discards all edits and errors so the transaction is based on the connection's current config again.
+ */
+void SyncthingConfigTransaction::reset()
+{
+    setBaseConfig(m_connection ? m_connection->rawConfig() : QJsonObject(m_baseConfig));
+    if (!m_errors.isEmpty()) {
+        m_errors.clear();
+        emit errorsChanged(m_errors);
+    }
+}
+
+/*!
+ * \brief Returns the config with all edits so far applied.
+ */
+QJsonObject SyncthingConfigTransaction::config() const
+{
+    auto config = m_baseConfig;
+    if (config.contains(QLatin1String("folders"))) {
+        config.insert(QLatin1String("folders"), m_dirs);
+    }
+    if (config.contains(QLatin1String("devices"))) {
+        config.insert(QLatin1String("devices"), m_devs);
+    }
+    return config;
+}
+
+/*!
+ * \brief Pauses/resumes the folders with the specified \a dirIds.
+ */
+bool SyncthingConfigTransaction::setDirsPaused(const QStringList &dirIds, bool paused)
+{
+    return setDirsValue(dirIds, QStringLiteral("paused"), paused);
+}
+
+/*!
+ * \brief Pauses/resumes the devices with the specified \a devIds.
+ */
+bool SyncthingConfigTransaction::setDevsPaused(const QStringList &devIds, bool paused)
+{
+    return setDevsValue(devIds, QStringLiteral("paused"), paused);
+}
+
+/*!
+ * \brief Sets the interval for full rescans of the folders with the specified \a dirIds to \a seconds (0 disables them).
+ */
+bool SyncthingConfigTransaction::setDirsRescanInterval(const QStringList &dirIds, int seconds)
+{
+    if (seconds < 0) {
+        return addError(tr("The rescan interval must not be negative."));
+    }
+    return setDirsValue(dirIds, QStringLiteral("rescanIntervalS"), seconds);
+}
+
+/*!
+ * \brief Enables/disables watching for changes for the folders with the specified \a dirIds.
+ */
+bool SyncthingConfigTransaction::setDirsWatcherEnabled(const QStringList &dirIds, bool enabled)
+{
+    return setDirsValue(dirIds, QStringLiteral("fsWatcherEnabled"), enabled);
+}
+
+/*!
+ * \brief Sets the label of the folder with the specified \a dirId.
+ */
+bool SyncthingConfigTransaction::setDirLabel(const QString &dirId, const QString &label)
+{
+    return setDirsValue(QStringList(dirId), QStringLiteral("label"), label);
+}
+
+/*!
+ * \brief Sets the name of the device with the specified \a devId.
+ */
+bool SyncthingConfigTransaction::setDevName(const QString &devId, const QString &name)
+{
+    return setDevsValue(QStringList(devId), QStringLiteral("name"), name);
+}
+
+/*!
+ * \brief Shares the folders with the specified \a dirIds with the devices with the specified \a devIds.
+ * \remarks Folders already shared with a device are left as-is.
+ */
+bool SyncthingConfigTransaction::shareDirs(const QStringList &dirIds, const QStringList &devIds)
+{
+    auto dirIndices = std::vector<QJsonArray::size_type>(), devIndices = std::vector<QJsonArray::size_type>();
+    const auto dirsValid = resolve(dirIds, m_dirIndex, tr("There is no folder with ID %1."), dirIndices);
+    if (!resolve(devIds, m_devIndex, tr("There is no device with ID %1."), devIndices) || !dirsValid) {
+        return false;
+    }
+    for (const auto dirIndex : dirIndices) {
+        auto dir = m_dirs.at(dirIndex).toObject();
+        auto devices = dir.value(QLatin1String("devices")).toArray();
+        auto sharedWith = QSet<QString>();
+        for (const auto &device : std::as_const(devices)) {
+            sharedWith.insert(device.toObject().value(QLatin1String("deviceID")).toString());
+        }
+        const auto previousSize = devices.size();
+        for (const auto &devId : devIds) {
+            if (!sharedWith.contains(devId)) {
+                sharedWith.insert(devId);
+                devices.append(QJsonObject{
+                    { QStringLiteral("deviceID"), devId },
+                    { QStringLiteral("introducedBy"), QString() },
+                    { QStringLiteral("encryptionPassword"), QString() },
+                });
+            }
+        }
+        if (devices.size() != previousSize) {
+            dir.insert(QLatin1String("devices"), devices);
+            m_dirs.replace(dirIndex, dir);
+        }
+    }
+    return true;
+}
+
+/*!
+ * \brief Stops sharing the folders with the specified \a dirIds with the devices with the specified \a devIds.
+ * \remarks The own device cannot be removed from a folder.
+ */
+bool SyncthingConfigTransaction::unshareDirs(const QStringList &dirIds, const QStringList &devIds)
+{
+    auto dirIndices = std::vector<QJsonArray::size_type>(), devIndices = std::vector<QJsonArray::size_type>();
+    const auto dirsValid = resolve(dirIds, m_dirIndex, tr("There is no folder with ID %1."), dirIndices);
+    if (!resolve(devIds, m_devIndex, tr("There is no device with ID %1."), devIndices) || !dirsValid) {
+        return false;
+    }
+    if (m_connection && !m_connection->myId().isEmpty() && devIds.contains(m_connection->myId())) {
+        return addError(tr("Folders cannot be unshared with the own device."));
+    }
+    const auto unsharedWith = QSet<QString>(devIds.begin(), devIds.end());
+    for (const auto dirIndex : dirIndices) {
+        auto dir = m_dirs.at(dirIndex).toObject();
+        auto devices = dir.value(QLatin1String("devices")).toArray();
+        const auto previousSize = devices.size();
+        for (auto i = devices.size(); i > 0; --i) {
+            if (unsharedWith.contains(devices.at(i - 1).toObject().value(QLatin1String("deviceID")).toString())) {
+                devices.removeAt(i - 1);
+            }
+        }
+        if (devices.size() != previousSize) {
+            dir.insert(QLatin1String("devices"), devices);
+            m_dirs.replace(dirIndex, dir);
+        }
+    }
+    return true;
+}
+
+/*!
+ * \brief Sets the member \a key of the folders with the specified \a dirIds to \a value.
+ * \remarks This is meant for settings without dedicated function. Only the type of the folder ID is checked.
+ */
+bool SyncthingConfigTransaction::setDirsValue(const QStringList &dirIds, const QString &key, const QJsonValue &value)
+{
+    if (key == QLatin1String("id")) {
+        return addError(tr("The ID of a folder cannot be changed."));
+    }
+    auto indices = std::vector<QJsonArray::size_type>();
+    if (!resolve(dirIds, m_dirIndex, tr("There is no folder with ID %1."), indices)) {
+        return false;
+    }
+    setValue(m_dirs, indices, key, value);
+    return true;
+}
+
+/*!
+ * \brief Sets the member \a key of the devices with the specified \a devIds to \a value.
+ * \remarks This is meant for settings without dedicated function.
+ */
+bool SyncthingConfigTransaction::setDevsValue(const QStringList &devIds, const QString &key, const QJsonValue &value)
+{
+    if (key == QLatin1String("deviceID")) {
+        return addError(tr("The ID of a device cannot be changed."));
+    }
+    auto indices = std::vector<QJsonArray::size_type>();
+    if (!resolve(devIds, m_devIndex, tr("There is no device with ID %1."), indices)) {
+        return false;
+    }
+    setValue(m_devs, indices, key, value);
+    return true;
+}
+
+/*!
+ * \brief Returns the difference between the base config and the config with all edits applied.
+ */
+SyncthingConfigPatch SyncthingConfigTransaction::patch() const
+{
+    return SyncthingConfigPatch(m_baseConfig, config());
+}
+
+/*!
+ * \brief Returns the difference between the base config and the config with all edits applied as RFC 6902 JSON Patch.
+ * \remarks This is meant to show pending changes, e.g. in QML.
+ */
+QJsonArray SyncthingConfigTransaction::patchOperations() const
+{
+    return patch().operations;
+}
+
+/*!
+ * \brief Submits all edits to Syncthing.
+ * \returns Returns whether the edits are being submitted. The committed() signal is emitted in any case.
+ * \remarks On success, the transaction is based on the submitted config afterwards so it can be re-used for further edits. When
+ *          the full config has been posted this is the connection's config the edits have been applied to (including changes
+ *          made in the meantime by someone else).
+ */
+bool SyncthingConfigTransaction::commit()
+{
+    if (m_committing) {
+        return false;
+    }
+    if (!m_connection) {
+        emit committed(tr("The connection has been destroyed."));
+        return false;
+    }
+    if (!m_errors.isEmpty()) {
+        emit committed(tr("Unable to commit invalid changes: ") + m_errors.join(QChar(' ')));
+        return false;
+    }
+    const auto newConfig = config();
+    const auto configPatch = SyncthingConfigPatch(m_baseConfig, newConfig);
+    if (configPatch.isEmpty()) {
+        emit committed(QString());
+        return true;
+    }
+
+    m_committing = true;
+    emit committingChanged(m_committing);
+    if (!configPatch.requiresFullConfig && !m_connection->isUsingDeprecatedRoutes()
+        && configPatch.requests.size() <= static_cast<std::size_t>(std::max(m_maxObjectRequests, 0))) {
+        m_connection->postConfigPatch(configPatch, [self = QPointer<SyncthingConfigTransaction>(this), newConfig](QString &&errorMessage) {
+            if (!self) {
+                return;
+            }
+            if (errorMessage.isEmpty()) {
+                self->m_baseConfig = newConfig;
+            }
+            self->finishCommit(std::move(errorMessage));
+        });
+        return true;
+    }
+
+    // apply changed folders/devices on top of the current config (folders/devices are never added/removed so indices match)
+    auto currentConfig = m_connection->rawConfig();
+    for (const auto &[key, idKey, edited] : {
+             std::make_tuple(QLatin1String("folders"), QLatin1String("id"), &m_dirs),
+             std::make_tuple(QLatin1String("devices"), QLatin1String("deviceID"), &m_devs),
+         }) {
+        const auto base = m_baseConfig.value(key).toArray();
+        auto changed = QHash<QString, QJsonValue>();
+        for (auto i = QJsonArray::size_type(); i != base.size() && i != edited->size(); ++i) {
+            if (const auto value = edited->at(i); value != base.at(i)) {
+                changed.insert(value.toObject().value(idKey).toString(), value);
+            }
+        }
+        if (changed.isEmpty()) {
+            continue;
+        }
+        auto current = currentConfig.value(key).toArray();
+        for (auto i = QJsonArray::size_type(); i != current.size(); ++i) {
+            if (const auto value = changed.constFind(current.at(i).toObject().value(idKey).toString()); value != changed.cend()) {
+                current.replace(i, *value);
+            }
+        }
+        currentConfig.insert(key, current);
+    }
+    m_connection->postConfigFromJsonObject(currentConfig, [self = QPointer<SyncthingConfigTransaction>(this), currentConfig](QString &&errorMessage) {
+        if (!self) {
+            return;
+        }
+        if (errorMessage.isEmpty()) {
+            self->setBaseConfig(QJsonObject(currentConfig));
+        }
+        self->finishCommit(std::move(errorMessage));
+    });
+    return true;
+}
+
+/// \cond
+SyncthingConfigTransaction::Index SyncthingConfigTransaction::makeIndex(const QJsonArray &array, QLatin1String idKey)
+{
+    auto index = Index();
+    index.reserve(array.size());
+    for (auto i = QJsonArray::size_type(); i != array.size(); ++i) {
+        if (const auto id = array.at(i).toObject().value(idKey).toString(); !id.isEmpty() && !index.contains(id)) {
+            index.insert(id, i);
+        }
+    }
+    return index;
+}
+
+bool SyncthingConfigTransaction::resolve(
+    const QStringList &ids, const Index &index, const QString &errorMessage, std::vector<QJsonArray::size_type> &indices)
+{
+    auto unknownIds = QStringList();
+    indices.reserve(static_cast<std::size_t>(ids.size()));
+    for (const auto &id : ids) {
+        if (const auto i = index.constFind(id); i != index.cend()) {
+            indices.emplace_back(*i);
+        } else {
+            unknownIds.append(QString(QChar('"') % id % QChar('"')));
+        }
+    }
+    return unknownIds.isEmpty() || addError(errorMessage.arg(unknownIds.join(QStringLiteral(", "))));
+}
+
+void SyncthingConfigTransaction::setValue(
+    QJsonArray &array, const std::vector<QJsonArray::size_type> &indices, const QString &key, const QJsonValue &value)
+{
+    for (const auto i : indices) {
+        auto object = array.at(i).toObject();
+        if (const auto existing = object.constFind(key); existing == object.constEnd() || existing.value() != value) {
+            object.insert(key, value);
+            array.replace(i, object);
+        }
+    }
+}
+
+void SyncthingConfigTransaction::setBaseConfig(QJsonObject &&config)
+{
+    m_baseConfig = std::move(config);
+    m_dirs = m_baseConfig.value(QLatin1String("folders")).toArray();
+    m_devs = m_baseConfig.value(QLatin1String("devices")).toArray();
+    m_dirIndex = makeIndex(m_dirs, QLatin1String("id"));
+    m_devIndex = makeIndex(m_devs, QLatin1String("deviceID"));
+}
+
+bool SyncthingConfigTransaction::addError(const QString &error)
+{
+    m_errors.append(error);
+    emit errorsChanged(m_errors);
+    return false;
+}
+
+void SyncthingConfigTransaction::finishCommit(QString &&errorMessage)
+{
+    m_committing = false;
+    emit committingChanged(m_committing);
+    emit committed(errorMessage);
+}
+/// \endcond
+
+} // namespace Data
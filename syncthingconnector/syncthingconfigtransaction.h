@@ -0,0 +1,133 @@
+#ifndef DATA_SYNCTHINGCONFIGTRANSACTION_H
+#define DATA_SYNCTHINGCONFIGTRANSACTION_H
+
+#include "./global.h"
+#include "./syncthingconfigpatch.h"
+
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QObject>
+#include <QPointer>
+#include <QStringList>
+
+#include <vector>
+
+namespace Data {
+
+class SyncthingConnection;
+
+class LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingConfigTransaction : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(QStringList errors READ errors NOTIFY errorsChanged)
+    Q_PROPERTY(bool valid READ isValid NOTIFY errorsChanged)
+    Q_PROPERTY(bool committing READ isCommitting NOTIFY committingChanged)
+    Q_PROPERTY(int maxObjectRequests READ maxObjectRequests WRITE setMaxObjectRequests)
+
+public:
+    static constexpr int defaultMaxObjectRequests = 10;
+
+    explicit SyncthingConfigTransaction(SyncthingConnection &connection, QObject *parent = nullptr);
+
+    const QJsonObject &baseConfig() const;
+    QJsonObject config() const;
+    const QStringList &errors() const;
+    bool isValid() const;
+    bool isCommitting() const;
+    int maxObjectRequests() const;
+    void setMaxObjectRequests(int maxObjectRequests);
+
+    Q_INVOKABLE bool setDirsPaused(const QStringList &dirIds, bool paused);
+    Q_INVOKABLE bool setDevsPaused(const QStringList &devIds, bool paused);
+    Q_INVOKABLE bool setDirsRescanInterval(const QStringList &dirIds, int seconds);
+    Q_INVOKABLE bool setDirsWatcherEnabled(const QStringList &dirIds, bool enabled);
+    Q_INVOKABLE bool setDirLabel(const QString &dirId, const QString &label);
+    Q_INVOKABLE bool setDevName(const QString &devId, const QString &name);
+    Q_INVOKABLE bool shareDirs(const QStringList &dirIds, const QStringList &devIds);
+    Q_INVOKABLE bool unshareDirs(const QStringList &dirIds, const QStringList &devIds);
+    Q_INVOKABLE bool setDirsValue(const QStringList &dirIds, const QString &key, const QJsonValue &value);
+    Q_INVOKABLE bool setDevsValue(const QStringList &devIds, const QString &key, const QJsonValue &value);
+    Q_INVOKABLE void reset();
+    SyncthingConfigPatch patch() const;
+    Q_INVOKABLE QJsonArray patchOperations() const;
+    Q_INVOKABLE bool commit();
+
+Q_SIGNALS:
+    void errorsChanged(const QStringList &errors);
+    void committingChanged(bool committing);
+    void committed(const QString &errorMessage);
+
+private:
+    using Index = QHash<QString, QJsonArray::size_type>;
+    static Index makeIndex(const QJsonArray &array, QLatin1String idKey);
+    bool resolve(const QStringList &ids, const Index &index, const QString &errorMessage, std::vector<QJsonArray::size_type> &indices);
+    static void setValue(QJsonArray &array, const std::vector<QJsonArray::size_type> &indices, const QString &key, const QJsonValue &value);
+    void setBaseConfig(QJsonObject &&config);
+    bool addError(const QString &error);
+    void finishCommit(QString &&errorMessage);
+
+    QPointer<SyncthingConnection> m_connection;
+    QJsonObject m_baseConfig;
+    QJsonArray m_dirs;
+    QJsonArray m_devs;
+    Index m_dirIndex;
+    Index m_devIndex;
+    QStringList m_errors;
+    int m_maxObjectRequests;
+    bool m_committing;
+};
+
+/*!
+ * \brief Returns the config the transaction is based on (the connection's config at the time the transaction was created
+ *        or last committed).
+ */
+inline const QJsonObject &SyncthingConfigTransaction::baseConfig() const
+{
+    return m_baseConfig;
+}
+
+/*!
+ * \brief Returns the validation errors of the edits so far.
+ * \remarks Edits which could not be validated are not applied.
+ */
+inline const QStringList &SyncthingConfigTransaction::errors() const
+{
+    return m_errors;
+}
+
+/*!
+ * \brief Returns whether all edits so far could be validated so the transaction can be committed.
+ */
+inline bool SyncthingConfigTransaction::isValid() const
+{
+    return m_errors.isEmpty();
+}
+
+/*!
+ * \brief Returns whether a commit is ongoing.
+ */
+inline bool SyncthingConfigTransaction::isCommitting() const
+{
+    return m_committing;
+}
+
+/*!
+ * \brief Returns the max. number of per-object requests to use when committing before falling back to posting the full config.
+ */
+inline int SyncthingConfigTransaction::maxObjectRequests() const
+{
+    return m_maxObjectRequests;
+}
+
+/*!
+ * \brief Sets the max. number of per-object requests to use when committing before falling back to posting the full config.
+ * \remarks Set to 0 to always post the full config.
+ */
+inline void SyncthingConfigTransaction::setMaxObjectRequests(int maxObjectRequests)
+{
+    m_maxObjectRequests = maxObjectRequests;
+}
+
+} // namespace Data
+
+#endif // DATA_SYNCTHINGCONFIGTRANSACTION_H
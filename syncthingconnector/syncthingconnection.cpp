@@ -1,6 +1,9 @@
 #include "./syncthingconnection.h"
 #include "./syncthingconfig.h"
 #include "./syncthingconnectionsettings.h"
+#include "./syncthingjsondecoder.h"
+#include "./syncthingreplylog.h"
+#include "./syncthingstatesnapshot.h"
 #include "./utils.h"
 
 #if defined(LIB_SYNCTHING_CONNECTOR_CONNECTION_MOCKED) || defined(LIB_SYNCTHING_CONNECTOR_MOCKED)
@@ -31,6 +34,7 @@
 #endif
 
 #include <iostream>
+#include <tuple>
 #include <utility>
 
 using namespace std;
@@ -92,6 +96,7 @@ SyncthingConnection::SyncthingConnection(
     , m_statusRecomputationFlags(StatusRecomputation::None)
     , m_lastEventId(0)
     , m_lastDiskEventId(0)
+    , m_eventCounts{}
     , m_autoReconnectTries(0)
     , m_requestTimeout(SyncthingConnectionSettings::defaultRequestTimeout)
     , m_longPollingTimeout(SyncthingConnectionSettings::defaultLongPollingTimeout)
@@ -115,6 +120,9 @@ SyncthingConnection::SyncthingConnection(
     , m_hasEvents(false)
     , m_hasDiskEvents(false)
     , m_statsRequested(false)
+    , m_applyingConfigIncrementally(false)
+    , m_decodingNewLogEntries(false)
+    , m_snapshotApplied(false)
     , m_lastFileDeleted(false)
     , m_recordFileChanges(false)
     , m_useDeprecatedRoutes(true)
@@ -124,21 +132,10 @@ SyncthingConnection::SyncthingConnection(
 #endif
     , m_insecure(false)
 {
-    m_trafficPollTimer.setInterval(SyncthingConnectionSettings::defaultTrafficPollInterval);
-    m_trafficPollTimer.setTimerType(Qt::CoarseTimer);
-    m_trafficPollTimer.setSingleShot(true);
-    QObject::connect(&m_trafficPollTimer, &QTimer::timeout, this, &SyncthingConnection::requestConnections);
-    m_devStatsPollTimer.setInterval(SyncthingConnectionSettings::defaultDevStatusPollInterval);
-    m_devStatsPollTimer.setTimerType(Qt::CoarseTimer);
-    m_devStatsPollTimer.setSingleShot(true);
-    QObject::connect(&m_devStatsPollTimer, &QTimer::timeout, this, &SyncthingConnection::requestDeviceStatistics);
-    m_errorsPollTimer.setInterval(SyncthingConnectionSettings::defaultErrorsPollInterval);
-    m_errorsPollTimer.setTimerType(Qt::CoarseTimer);
-    m_errorsPollTimer.setSingleShot(true);
-    QObject::connect(&m_errorsPollTimer, &QTimer::timeout, this, &SyncthingConnection::requestErrors);
-    m_autoReconnectTimer.setTimerType(Qt::CoarseTimer);
-    m_autoReconnectTimer.setInterval(SyncthingConnectionSettings::defaultReconnectInterval);
-    QObject::connect(&m_autoReconnectTimer, &QTimer::timeout, this, &SyncthingConnection::autoReconnect);
+    m_pollingScheduler = new SyncthingPollingScheduler(this);
+    m_jsonDecoder = std::make_unique<SyncthingJsonDecoder>(this);
+    registerPollingTasks(SyncthingConnectionSettings::defaultTrafficPollInterval, SyncthingConnectionSettings::defaultDevStatusPollInterval,
+        SyncthingConnectionSettings::defaultErrorsPollInterval, SyncthingConnectionSettings::defaultReconnectInterval);
 
 #if defined(LIB_SYNCTHING_CONNECTOR_CONNECTION_MOCKED) || defined(LIB_SYNCTHING_CONNECTOR_MOCKED)
     setupTestData();
@@ -152,6 +149,23 @@ SyncthingConnection::SyncthingConnection(
     if (useDeprecatedRoutesIsInt) {
         m_useDeprecatedRoutes = useDeprecatedRoutesInt;
     }
+
+    // allow recording/replaying replies via environment variables
+    if (const auto recordPath = qEnvironmentVariable(PROJECT_VARNAME_UPPER "_RECORD_REPLIES"); !recordPath.isEmpty()) {
+        m_replyRecorder = new SyncthingReplyRecorder(recordPath, this);
+        if (!m_replyRecorder->isRecording()) {
+            cerr << Phrases::Error << m_replyRecorder->errorString().toStdString() << Phrases::EndFlush;
+        }
+    }
+    if (const auto replayPath = qEnvironmentVariable(PROJECT_VARNAME_UPPER "_REPLAY_REPLIES"); !replayPath.isEmpty()) {
+        m_replyReplayer = new SyncthingReplyReplayer(qEnvironmentVariableIntValue(PROJECT_VARNAME_UPPER "_REPLAY_FAST")
+                ? SyncthingReplayMode::AsFastAsPossible
+                : SyncthingReplayMode::TimeAccurate,
+            this);
+        if (!m_replyReplayer->load(replayPath)) {
+            cerr << Phrases::Error << m_replyReplayer->errorString().toStdString() << Phrases::EndFlush;
+        }
+    }
 }
 
 /*!
@@ -163,6 +177,25 @@ SyncthingConnection::~SyncthingConnection()
     disconnect();
 }
 
+/*!
+ * \brief Returns whether the SyncthingConnector instance is waiting for Syncthing to respond to a request.
+ * \remarks
+ * - Requests for (disk) events are excluded because those are long polling requests and therefore always pending.
+ *   Instead, we take only into account whether those requests have been at least concluded once (since the last
+ *   reconnect).
+ * - Only requests which contribute to the overall state and population of myId(), tilde(), dirInfo(), devInfo(),
+ *   traffic statistics, ... are considered. So requests for QR code, logs, clearing errors, rescan, ... are not
+ *   taken into account.
+ * - This function will also return true as long as the method abortAllRequests() is executed.
+ * - Responses which are still decoded in the background (see backgroundDecodingThreshold()) count as pending.
+ */
+bool SyncthingConnection::hasPendingRequests() const
+{
+    return m_abortingAllRequests || m_configReply || m_statusReply || (m_eventsReply && !m_hasEvents) || (m_diskEventsReply && !m_hasDiskEvents)
+        || m_connectionsReply || m_dirStatsReply || m_devStatsReply || m_errorsReply || m_versionReply || !m_otherReplies.isEmpty()
+        || m_jsonDecoder->pendingCount();
+}
+
 /*!
  * \brief Returns whether the currently assigned syncthingUrl() refers to the Syncthing instance on the local machine.
  */
@@ -256,18 +289,18 @@ static inline void cancelReplyWithoutAbortingConnection(QNetworkReply *&reply)
  * \brief Ensure the request with the specified \a timer, \a pendingReply and \a requestFunction is enabled or disabled depending on \a enable.
  * \remarks This function is only supposed to be called if \a enabled has actually changed.
  */
-static inline void manageTimerBasedRequest(
-    QTimer &timer, QNetworkReply *pendingReply, SyncthingConnection &connection, void (SyncthingConnection::*requestFunction)(void), bool enable)
+static inline void manageTimerBasedRequest(SyncthingPollingScheduler &scheduler, SyncthingPollingTaskId task, QNetworkReply *pendingReply,
+    SyncthingConnection &connection, void (SyncthingConnection::*requestFunction)(void), bool enable)
 {
     // stop any possibly active timer if the polling-flag has been disabled (stopping a pending request would be possible but not gain us anything)
     if (!enable) {
-        timer.stop();
+        scheduler.stop(task);
         return;
     }
 
     // make a request immediately (unless there's already a pending reply) if the polling-flag has been enabled and a non-zero polling interval is configured
-    if (timer.interval() && !pendingReply) {
-        timer.stop();
+    if (scheduler.interval(task) && !pendingReply) {
+        scheduler.stop(task);
         std::invoke(requestFunction, connection);
     }
 }
@@ -320,16 +353,16 @@ void SyncthingConnection::setPollingFlags(PollingFlags flags)
 
     // manage timers/requests for timer-based requests
     if (trafficStatsChanged) {
-        manageTimerBasedRequest(m_trafficPollTimer, m_connectionsReply, *this, &SyncthingConnection::requestConnections,
+        manageTimerBasedRequest(*m_pollingScheduler, m_trafficPollTask, m_connectionsReply, *this, &SyncthingConnection::requestConnections,
             m_keepPolling && (m_pollingFlags && PollingFlags::TrafficStatistics));
     }
     if (devStatsChanged) {
-        manageTimerBasedRequest(m_devStatsPollTimer, m_devStatsReply, *this, &SyncthingConnection::requestDeviceStatistics,
+        manageTimerBasedRequest(*m_pollingScheduler, m_devStatsPollTask, m_devStatsReply, *this, &SyncthingConnection::requestDeviceStatistics,
             m_keepPolling && (m_pollingFlags && PollingFlags::DeviceStatistics));
     }
     if (errorsChanged) {
-        manageTimerBasedRequest(
-            m_errorsPollTimer, m_errorsReply, *this, &SyncthingConnection::requestErrors, m_keepPolling && (m_pollingFlags && PollingFlags::Errors));
+        manageTimerBasedRequest(*m_pollingScheduler, m_errorsPollTask, m_errorsReply, *this, &SyncthingConnection::requestErrors,
+            m_keepPolling && (m_pollingFlags && PollingFlags::Errors));
     }
 }
 
@@ -360,6 +393,90 @@ void SyncthingConnection::disablePolling()
     setErrorsPollInterval(0);
 }
 
+/*!
+ * \brief Sets the scheduler used to run timer-based requests and auto-reconnect attempts.
+ * \remarks
+ * - Sharing one scheduler between multiple connections allows aligning their wakeups.
+ * - Configured intervals and active timers are taken over from the previously used scheduler.
+ * - Passing nullptr makes the connection use its own scheduler again.
+ * - The specified \a pollingScheduler must outlive the connection.
+ */
+void SyncthingConnection::setPollingScheduler(SyncthingPollingScheduler *pollingScheduler)
+{
+    if (pollingScheduler && pollingScheduler == m_pollingScheduler) {
+        return;
+    }
+    if (!pollingScheduler) {
+        if (m_pollingScheduler->parent() == this) {
+            return;
+        }
+        pollingScheduler = new SyncthingPollingScheduler(this);
+    }
+
+    // take over intervals and active state from the previous scheduler
+    auto *const previousScheduler = std::exchange(m_pollingScheduler, pollingScheduler);
+    const SyncthingPollingTaskId previousTasks[] = { m_trafficPollTask, m_devStatsPollTask, m_errorsPollTask, m_autoReconnectTask };
+    registerPollingTasks(previousScheduler->interval(m_trafficPollTask), previousScheduler->interval(m_devStatsPollTask),
+        previousScheduler->interval(m_errorsPollTask), previousScheduler->interval(m_autoReconnectTask));
+    const SyncthingPollingTaskId newTasks[] = { m_trafficPollTask, m_devStatsPollTask, m_errorsPollTask, m_autoReconnectTask };
+    for (auto i = std::size_t(); i != std::size(newTasks); ++i) {
+        if (previousScheduler->isActive(previousTasks[i])) {
+            m_pollingScheduler->start(newTasks[i]);
+        }
+    }
+    previousScheduler->removeTasks(this);
+    if (previousScheduler->parent() == this) {
+        previousScheduler->deleteLater();
+    }
+}
+
+/*!
+ * \brief Returns the size in bytes as of which responses are parsed and converted on a worker thread.
+ * \remarks
+ * This concerns the responses processed by readConfig(), readBrowse(), readIgnores(), readDirStatistics(), readEvents() and
+ * readLog(). Only the final move of the results into place and the emission of signals happens on the thread the connection
+ * lives in. A negative value disables this.
+ * \sa SyncthingJsonDecoder
+ */
+int SyncthingConnection::backgroundDecodingThreshold() const
+{
+    return m_jsonDecoder->threshold();
+}
+
+/*!
+ * \brief Sets the size in bytes as of which responses are parsed and converted on a worker thread.
+ * \sa backgroundDecodingThreshold()
+ */
+void SyncthingConnection::setBackgroundDecodingThreshold(int threshold)
+{
+    m_jsonDecoder->setThreshold(threshold);
+}
+
+/*!
+ * \brief Returns the decoder used to parse and convert responses on a worker thread.
+ */
+SyncthingJsonDecoder &SyncthingConnection::jsonDecoder()
+{
+    return *m_jsonDecoder;
+}
+
+/*!
+ * \brief Registers the tasks for timer-based requests and auto-reconnect attempts with m_pollingScheduler.
+ */
+void SyncthingConnection::registerPollingTasks(
+    int trafficPollInterval, int devStatsPollInterval, int errorsPollInterval, int autoReconnectInterval)
+{
+    // traffic and device statistics are only relevant when shown so these requests are adaptive
+    // note: Errors are not adaptive as new errors are only noticed via polling and are supposed to be notified about promptly.
+    m_trafficPollTask = m_pollingScheduler->addTask(
+        QStringLiteral("traffic"), this, [this] { requestConnections(); }, trafficPollInterval, SyncthingPollingTaskFlags::Adaptive);
+    m_devStatsPollTask = m_pollingScheduler->addTask(QStringLiteral("device statistics"), this, [this] { requestDeviceStatistics(); },
+        devStatsPollInterval, SyncthingPollingTaskFlags::Adaptive);
+    m_errorsPollTask = m_pollingScheduler->addTask(QStringLiteral("errors"), this, [this] { requestErrors(); }, errorsPollInterval);
+    m_autoReconnectTask = m_pollingScheduler->addTask(
+        QStringLiteral("auto-reconnect"), this, [this] { autoReconnect(); }, autoReconnectInterval, SyncthingPollingTaskFlags::Repeating);
+}
+
 /*!
  * \brief Sets whether to pause all devices on metered connections.
  */
@@ -434,7 +551,7 @@ void SyncthingConnection::handleMeteredConnection()
 void SyncthingConnection::connect()
 {
     // reset auto-reconnect
-    m_autoReconnectTimer.stop();
+    m_pollingScheduler->stop(m_autoReconnectTask);
     m_autoReconnectTries = 0;
 
     // skip if already connected (see reconnect() to force reconnecting)
@@ -450,6 +567,8 @@ void SyncthingConnection::connect()
     }
 
     // reset status
+    m_jsonDecoder->invalidate();
+    m_decodingNewLogEntries = false;
     m_connectionAborted = m_abortingToConnect = m_abortingToReconnect = m_hasConfig = m_hasStatus = m_hasEvents = m_hasDiskEvents = m_statsRequested
         = false;
 
@@ -493,7 +612,7 @@ void SyncthingConnection::connect(SyncthingConnectionSettings &connectionSetting
 void SyncthingConnection::connectLater(int milliSeconds)
 {
     // skip if connecting via auto-reconnect anyway
-    if (m_autoReconnectTimer.isActive() && milliSeconds > m_autoReconnectTimer.interval()) {
+    if (m_pollingScheduler->isActive(m_autoReconnectTask) && milliSeconds > m_pollingScheduler->interval(m_autoReconnectTask)) {
         return;
     }
     QTimer::singleShot(milliSeconds, this, static_cast<void (SyncthingConnection::*)(void)>(&SyncthingConnection::connect));
@@ -506,10 +625,10 @@ void SyncthingConnection::disconnect()
 {
     m_abortingToConnect = m_abortingToReconnect = m_keepPolling = false;
     m_statusRecomputationFlags = StatusRecomputation::None;
-    m_trafficPollTimer.stop();
-    m_devStatsPollTimer.stop();
-    m_errorsPollTimer.stop();
-    m_autoReconnectTimer.stop();
+    m_pollingScheduler->stop(m_trafficPollTask);
+    m_pollingScheduler->stop(m_devStatsPollTask);
+    m_pollingScheduler->stop(m_errorsPollTask);
+    m_pollingScheduler->stop(m_autoReconnectTask);
     m_autoReconnectTries = 0;
     abortAllRequests();
 }
@@ -532,6 +651,8 @@ static inline void abortMaybe(QNetworkReply *reply)
 void SyncthingConnection::abortAllRequests()
 {
     m_connectionAborted = m_abortingAllRequests = true;
+    m_jsonDecoder->invalidate();
+    m_decodingNewLogEntries = false;
     abortMaybe(m_configReply);
     abortMaybe(m_statusReply);
     abortMaybe(m_connectionsReply);
@@ -561,13 +682,13 @@ void SyncthingConnection::abortAllRequests()
 void SyncthingConnection::reconnect()
 {
     // reset reconnect timer
-    m_autoReconnectTimer.stop();
+    m_pollingScheduler->stop(m_autoReconnectTask);
     m_autoReconnectTries = 0;
 
     // stop other timers
-    m_trafficPollTimer.stop();
-    m_devStatsPollTimer.stop();
-    m_errorsPollTimer.stop();
+    m_pollingScheduler->stop(m_trafficPollTask);
+    m_pollingScheduler->stop(m_devStatsPollTask);
+    m_pollingScheduler->stop(m_errorsPollTask);
 
     // reset variables to track connection progress
     // note: especially resetting events is important as it influences the subsequent hasPendingRequests() call
@@ -604,16 +725,21 @@ void SyncthingConnection::reconnectLater(int milliSeconds)
 
 /*!
  * \brief Internally called to reconnect; ensures currently cached config is cleared.
+ * \remarks The state restored via applySnapshot() is kept until the config has been read unless the Syncthing URL or API
+ *          key has been changed in the meantime.
  */
 void SyncthingConnection::continueReconnecting()
 {
     // notify that we're about to invalidate the configuration if not already invalidated anyway
-    const auto isConfigInvalidated = m_rawConfig.isEmpty();
+    const auto keepSnapshot = m_snapshotApplied;
+    const auto isConfigInvalidated = m_rawConfig.isEmpty() && (keepSnapshot || (m_dirs.empty() && m_devs.empty()));
     if (!isConfigInvalidated) {
         emit newConfig(m_rawConfig = QJsonObject());
     }
 
     // cleanup information from previous connection
+    m_jsonDecoder->invalidate();
+    m_decodingNewLogEntries = false;
     m_keepPolling = true;
     m_statusRecomputationFlags = StatusRecomputation::None;
     m_connectionAborted = false;
@@ -622,9 +748,12 @@ void SyncthingConnection::continueReconnecting()
     m_lastDiskEventId = 0;
     m_lastEventIdByMask.clear();
     m_configDir.clear();
-    m_myId.clear();
-    m_tilde.clear();
-    m_pathSeparator.clear();
+    if (!keepSnapshot) {
+        m_myId.clear();
+        m_tilde.clear();
+        m_pathSeparator.clear();
+        m_syncthingVersion.clear();
+    }
     m_totalIncomingTraffic = unknownTraffic;
     m_totalOutgoingTraffic = unknownTraffic;
     m_totalIncomingRate = 0.0;
@@ -636,8 +765,11 @@ void SyncthingConnection::continueReconnecting()
     m_hasEvents = false;
     m_hasDiskEvents = false;
     m_statsRequested = false;
-    m_dirs.clear();
-    m_devs.clear();
+    if (!keepSnapshot) {
+        m_dirs.clear();
+        m_overallDirStats = SyncthingOverallDirStatistics();
+        m_devs.clear();
+    }
     m_errors.clear();
     m_devsPausedDueToMeteredConnection.clear();
     m_lastConnectionsUpdateEvent = 0;
@@ -648,7 +780,6 @@ void SyncthingConnection::continueReconnecting()
     m_startTime = DateTime();
     m_lastFileName.clear();
     m_lastFileDeleted = false;
-    m_syncthingVersion.clear();
     emit dirStatisticsChanged();
 
     // notify that the configuration has been invalidated
@@ -674,6 +805,48 @@ void SyncthingConnection::applyRawConfig()
     emit newConfigApplied();
 }
 
+/*!
+ * \brief Populates folders, devices and a few global values from the specified \a snapshot.
+ * \returns Returns whether the snapshot has been applied. It is not applied if the config or status has already been read
+ *          from Syncthing as the actual state takes precedence.
+ * \remarks
+ * - This is meant to populate the UI quickly on startup from a snapshot taken when the application was used last time (see
+ *   SyncthingStateSnapshot). Models are reset like when a new config has been read and newDevices() and newDirs() are
+ *   emitted.
+ * - The status of folders and devices is unknown until connected. Other information like statistics is preserved until
+ *   it is updated when connecting (folders/devices are matched by ID when reading the config).
+ * - The restored state is discarded on reconnect if the Syncthing URL or API key has been changed before the config has
+ *   been read as it likely belongs to a different Syncthing instance then.
+ */
+bool SyncthingConnection::applySnapshot(SyncthingStateSnapshot &&snapshot)
+{
+    if (!m_rawConfig.isEmpty() || m_hasStatus) {
+        return false;
+    }
+    emit newConfig(m_rawConfig);
+    m_snapshotApplied = true;
+    m_myId = std::move(snapshot.myId);
+    m_tilde = std::move(snapshot.tilde);
+    m_pathSeparator = std::move(snapshot.pathSeparator);
+    m_syncthingVersion = std::move(snapshot.syncthingVersion);
+    m_devs = std::move(snapshot.devs);
+    m_dirs = std::move(snapshot.dirs);
+    for (auto &dev : m_devs) {
+        dev.status = dev.id == m_myId ? SyncthingDevStatus::ThisDevice : SyncthingDevStatus::Unknown;
+    }
+    for (auto &dir : m_dirs) {
+        dir.status = SyncthingDirStatus::Unknown;
+    }
+    emit myIdChanged(m_myId);
+    emit tildeChanged(m_tilde);
+    emit newDevices(m_devs);
+    recomputeOverallDirStatistics();
+    emit newDirs(m_dirs);
+    m_hasOutOfSyncDirs.reset();
+    emit newConfigApplied();
+    return true;
+}
+
 /*!
  * \brief Reads results of requestConfig() and requestStatus().
  * \remarks Called in readConfig() or readStatus() to conclude reading parts requiring config *and* status
@@ -724,7 +897,7 @@ void SyncthingConnection::concludeConnection(StatusRecomputation flags)
 
 /*!
  * \brief Connects increasing the auto-reconnect tries.
- * \remarks Called via m_autoReconnectTimer.
+ * \remarks Called via m_pollingScheduler when m_autoReconnectTask is due.
  */
 void SyncthingConnection::autoReconnect()
 {
@@ -816,18 +989,17 @@ SyncthingDir *SyncthingConnection::findDirInfoByPath(const QString &path, QStrin
 /*!
  * \brief Appends a directory info object with the specified \a dirId to \a dirs.
  *
- * If such an object already exists, it is recycled by moving it to \a dirs.
- * Otherwise a new, empty object is created.
+ * If such an object is contained by \a previousDirs, it is recycled by moving it to \a dirs and removed from \a previousDirs
+ * so the lookup is done in constant time and each object is only recycled once. Otherwise a new, empty object is created.
  *
  * \returns Returns the directory info object or nullptr if \a dirId is invalid.
  */
-SyncthingDir *SyncthingConnection::addDirInfo(std::vector<SyncthingDir> &dirs, const QString &dirId)
+SyncthingDir *SyncthingConnection::addDirInfo(std::vector<SyncthingDir> &dirs, QHash<QString, SyncthingDir *> &previousDirs, const QString &dirId)
 {
     if (dirId.isEmpty()) {
         return nullptr;
     }
-    auto row = int();
-    if (auto *const existingDirInfo = findDirInfo(dirId, row)) {
+    if (auto *const existingDirInfo = previousDirs.take(dirId)) {
         return &dirs.emplace_back(std::move(*existingDirInfo));
     } else {
         return &dirs.emplace_back(dirId);
@@ -918,18 +1090,17 @@ std::vector<const SyncthingDev *> SyncthingConnection::connectedDevices() const
 /*!
  * \brief Appends a device info object with the specified \a devId to \a devs.
  *
- * If such an object already exists, it is recycled by moving it to \a devs.
- * Otherwise a new, empty object is created.
+ * If such an object is contained by \a previousDevs, it is recycled by moving it to \a devs and removed from \a previousDevs
+ * so the lookup is done in constant time and each object is only recycled once. Otherwise a new, empty object is created.
  *
  * \returns Returns the device info object or nullptr if \a devId is invalid.
  */
-SyncthingDev *SyncthingConnection::addDevInfo(std::vector<SyncthingDev> &devs, const QString &devId)
+SyncthingDev *SyncthingConnection::addDevInfo(std::vector<SyncthingDev> &devs, QHash<QString, SyncthingDev *> &previousDevs, const QString &devId)
 {
     if (devId.isEmpty()) {
         return nullptr;
     }
-    auto row = int();
-    if (SyncthingDev *const existingDevInfo = findDevInfo(devId, row)) {
+    if (auto *const existingDevInfo = previousDevs.take(devId)) {
         return &devs.emplace_back(std::move(*existingDevInfo));
     } else {
         return &devs.emplace_back(devId);
@@ -938,19 +1109,24 @@ SyncthingDev *SyncthingConnection::addDevInfo(std::vector<SyncthingDev> &devs, c
 
 /*!
  * \brief Internally called to parse a time stamp.
+ * \remarks Time stamps in the format Syncthing uses are parsed via parseIsoTimeStamp() which works directly on the UTF-16 data
+ *          without converting to UTF-8 first. Only other formats are passed to DateTime::fromIsoString().
  */
 DateTime SyncthingConnection::parseTimeStamp(const QJsonValue &jsonValue, const QString &context, DateTime defaultValue, bool greaterThanEpoch)
 {
     const auto utf16 = jsonValue.toString();
-    const auto utf8 = utf16.toUtf8();
-    try {
-        const auto [localTime, utcOffset] = DateTime::fromIsoString(utf8.data());
-        return !greaterThanEpoch || (localTime - utcOffset) > DateTime::unixEpochStart() ? localTime : defaultValue;
-    } catch (const ConversionException &e) {
-        emit error(tr("Unable to parse timestamp \"%1\" (%2): %3").arg(utf16, context, QString::fromUtf8(e.what())), SyncthingErrorCategory::Parsing,
-            QNetworkReply::NoError);
+    auto localTime = DateTime();
+    auto utcOffset = TimeSpan();
+    if (!parseIsoTimeStamp(utf16, localTime, utcOffset)) {
+        try {
+            std::tie(localTime, utcOffset) = DateTime::fromIsoString(utf16.toUtf8().data());
+        } catch (const ConversionException &e) {
+            emit error(tr("Unable to parse timestamp \"%1\" (%2): %3").arg(utf16, context, QString::fromUtf8(e.what())),
+                SyncthingErrorCategory::Parsing, QNetworkReply::NoError);
+            return defaultValue;
+        }
     }
-    return defaultValue;
+    return !greaterThanEpoch || (localTime - utcOffset) > DateTime::unixEpochStart() ? localTime : defaultValue;
 }
 
 /*!
@@ -1141,9 +1317,9 @@ bool SyncthingConnection::setStatus(SyncthingStatus status)
         m_connectionAborted = true;
         [[fallthrough]];
     case SyncthingStatus::Reconnecting:
-        m_devStatsPollTimer.stop();
-        m_trafficPollTimer.stop();
-        m_errorsPollTimer.stop();
+        m_pollingScheduler->stop(m_devStatsPollTask);
+        m_pollingScheduler->stop(m_trafficPollTask);
+        m_pollingScheduler->stop(m_errorsPollTask);
         break;
     default:
         // reset reconnect tries
@@ -1227,13 +1403,22 @@ bool SyncthingConnection::setStatus(SyncthingStatus status)
  * \remarks Since in this case the reply has already been read, its response must be passed as extra argument.
  */
 void SyncthingConnection::emitError(const QString &message, const QJsonParseError &jsonError, QNetworkReply *reply, const QByteArray &response)
+{
+    emitError(message, jsonError, reply->request(), response);
+}
+
+/*!
+ * \brief Internally called to emit a JSON parsing error for the specified \a request.
+ * \remarks This overload is used when the reply is not available anymore, e.g. when the response has been decoded in the background.
+ */
+void SyncthingConnection::emitError(const QString &message, const QJsonParseError &jsonError, const QNetworkRequest &request, const QByteArray &response)
 {
     if (loggingFlags() && SyncthingConnectionLoggingFlags::ApiReplies) {
         std::cerr << Phrases::Error << "JSON parsing error: " << message.toLocal8Bit().data() << jsonError.errorString().toLocal8Bit().data()
                   << " (at offset " << jsonError.offset << ')' << Phrases::End;
     }
     emit error(message % jsonError.errorString() % QChar(' ') % QChar('(') % tr("at offset %1").arg(jsonError.offset) % QChar(')'),
-        SyncthingErrorCategory::Parsing, QNetworkReply::NoError, reply->request(), response);
+        SyncthingErrorCategory::Parsing, QNetworkReply::NoError, request, response);
 }
 
 /*!
@@ -1307,8 +1492,8 @@ void SyncthingConnection::emitTildeChanged(const QString &newTilde, const QStrin
 void SyncthingConnection::handleFatalConnectionError()
 {
     // start the timer before emitting the event so its active state can be observed in event handler
-    if (m_autoReconnectTimer.interval() && !m_autoReconnectTimer.isActive()) {
-        m_autoReconnectTimer.start();
+    if (m_pollingScheduler->interval(m_autoReconnectTask) && !m_pollingScheduler->isActive(m_autoReconnectTask)) {
+        m_pollingScheduler->start(m_autoReconnectTask);
     }
     setStatus(SyncthingStatus::Disconnected);
     abortAllRequests();
@@ -1362,6 +1547,16 @@ void SyncthingConnection::invalidateHasOutOfSyncDirs()
     }
 }
 
+/*!
+ * \brief Re-computes the overall directory statistics returned by overallDirStatistics() from all directories.
+ * \remarks Only called when directories are (re-)configured; changes of the statistics of individual directories are
+ *          applied by adjusting the overall statistics by the difference.
+ */
+void SyncthingConnection::recomputeOverallDirStatistics()
+{
+    m_overallDirStats = SyncthingOverallDirStatistics(m_dirs);
+}
+
 /*!
  * \brief Returns syncthingUrl() with userName() and password().
  */
@@ -1395,18 +1590,23 @@ SyncthingCompletion SyncthingConnection::computeOverallRemoteCompletion() const
  * - Configuration is requested automatically when connecting.
  * - Previous directories (and directory info objects!) are invalidated.
  * - Previous devices (and device info objects!) are invalidated.
+ * - If isApplyingConfigIncrementally() returns true, only the changes are applied and signalled via dirAdded(), dirRemoved(),
+ *   dirMoved(), dirConfigChanged(), devAdded(), devRemoved(), devMoved() and devConfigChanged() before newConfigApplied() is
+ *   emitted.
  */
 
 /*!
  * \fn SyncthingConnection::newDirs()
  * \brief Indicates new directories are available.
- * \remarks Always emitted after newConfig() as soon as new directory info objects become available.
+ * \remarks Always emitted after newConfig() as soon as new directory info objects become available. When the config is
+ *          applied incrementally, this is only emitted if directories have been added, removed or changed.
  */
 
 /*!
  * \fn SyncthingConnection::newDevices()
  * \brief Indicates new devices are available.
- * \remarks Always emitted after newConfig() as soon as new device info objects become available.
+ * \remarks Always emitted after newConfig() as soon as new device info objects become available. When the config is
+ *          applied incrementally, this is only emitted if devices have been added, removed or changed.
  */
 
 /*!
@@ -1435,6 +1635,80 @@ SyncthingCompletion SyncthingConnection::computeOverallRemoteCompletion() const
  * \brief Indicates the status of the specified \a dev changed.
  */
 
+/*!
+ * \fn SyncthingConnection::dirAboutToBeAdded()
+ * \brief Indicates a directory is about to be inserted at the specified \a index when applying the config incrementally.
+ */
+
+/*!
+ * \fn SyncthingConnection::dirAdded()
+ * \brief Indicates the specified \a dir has been inserted at the specified \a index when applying the config incrementally.
+ */
+
+/*!
+ * \fn SyncthingConnection::dirAboutToBeRemoved()
+ * \brief Indicates the specified \a dir is about to be removed from the specified \a index when applying the config incrementally.
+ */
+
+/*!
+ * \fn SyncthingConnection::dirRemoved()
+ * \brief Indicates the directory with the specified \a dirId has been removed from the specified \a index.
+ */
+
+/*!
+ * \fn SyncthingConnection::dirAboutToBeMoved()
+ * \brief Indicates the specified \a dir is about to be moved from \a fromIndex to \a toIndex when applying the config
+ *        incrementally.
+ * \remarks This is the case when directories have been reordered. The runtime state of the directory is preserved.
+ */
+
+/*!
+ * \fn SyncthingConnection::dirMoved()
+ * \brief Indicates the specified \a dir has been moved from \a fromIndex to \a toIndex.
+ */
+
+/*!
+ * \fn SyncthingConnection::dirConfigChanged()
+ * \brief Indicates the config of the specified \a dir has been changed in place when applying the config incrementally.
+ */
+
+/*!
+ * \fn SyncthingConnection::devAboutToBeAdded()
+ * \brief Indicates a device is about to be inserted at the specified \a index when applying the config incrementally.
+ */
+
+/*!
+ * \fn SyncthingConnection::devAdded()
+ * \brief Indicates the specified \a dev has been inserted at the specified \a index when applying the config incrementally.
+ */
+
+/*!
+ * \fn SyncthingConnection::devAboutToBeRemoved()
+ * \brief Indicates the specified \a dev is about to be removed from the specified \a index when applying the config incrementally.
+ */
+
+/*!
+ * \fn SyncthingConnection::devRemoved()
+ * \brief Indicates the device with the specified \a devId has been removed from the specified \a index.
+ */
+
+/*!
+ * \fn SyncthingConnection::devAboutToBeMoved()
+ * \brief Indicates the specified \a dev is about to be moved from \a fromIndex to \a toIndex when applying the config
+ *        incrementally.
+ * \remarks This is the case when devices have been reordered. The runtime state of the device is preserved.
+ */
+
+/*!
+ * \fn SyncthingConnection::devMoved()
+ * \brief Indicates the specified \a dev has been moved from \a fromIndex to \a toIndex.
+ */
+
+/*!
+ * \fn SyncthingConnection::devConfigChanged()
+ * \brief Indicates the config of the specified \a dev has been changed in place when applying the config incrementally.
+ */
+
 /*!
  * \fn SyncthingConnection::downloadProgressChanged()
  * \brief Indicates the download progress changed.
@@ -1461,6 +1735,13 @@ SyncthingCompletion SyncthingConnection::computeOverallRemoteCompletion() const
  * \brief Indicates a request (for configuration, events, ...) failed.
  */
 
+/*!
+ * \fn SyncthingConnection::logEntriesAppended()
+ * \brief Indicates new log entries requested via requestNewLogEntries() have been appended to logStore().
+ * \remarks The new entries can be accessed via SyncthingLogStore::at() for the indices from \a beginIndex to \a endIndex
+ *          (exclusive).
+ */
+
 /*!
  * \fn SyncthingConnection::statusChanged()
  * \brief Indicates the status of the connection changed (status(), hasOutOfSyncDirs()).
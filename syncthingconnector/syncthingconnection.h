@@ -5,6 +5,9 @@
 #include "./syncthingconnectionstatus.h"
 #include "./syncthingdev.h"
 #include "./syncthingdir.h"
+#include "./syncthingeventtype.h"
+#include "./syncthinglogstore.h"
+#include "./syncthingpollingscheduler.h"
 #include "./utils.h"
 
 #include <c++utilities/misc/flagenumclass.h>
@@ -15,12 +18,14 @@
 #include <QList>
 #include <QNetworkRequest>
 #include <QObject>
+#include <QPointer>
 #include <QSslError>
 #include <QTimer>
 
 #include <cstdint>
 #include <functional>
 #include <limits>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -33,23 +38,21 @@ QT_FORWARD_DECLARE_CLASS(QJsonParseError)
 
 class ConnectionTests;
 class MiscTests;
+class ModelTests;
 
 namespace Data {
 
 struct SyncthingConnectionSettings;
+class SyncthingBrowseParser;
+class SyncthingJsonDecoder;
+struct SyncthingConfigPatch;
+struct SyncthingConfigRequest;
+class SyncthingReplyRecorder;
+class SyncthingReplyReplayer;
+struct SyncthingStateSnapshot;
 
 LIB_SYNCTHING_CONNECTOR_EXPORT QNetworkAccessManager &networkAccessManager();
 
-struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingLogEntry {
-    SyncthingLogEntry(const QString &when = QString(), const QString &message = QString())
-        : when(when)
-        , message(message)
-    {
-    }
-    QString when;
-    QString message;
-};
-
 enum class SyncthingItemType {
     Unknown, /**< the type is unknown */
     File, /**< the item is a regular file */
@@ -124,6 +127,7 @@ struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingError {
 class LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingConnection : public QObject {
     friend ConnectionTests;
     friend MiscTests;
+    friend ModelTests;
 
     Q_OBJECT
     Q_PROPERTY(QString syncthingUrl READ syncthingUrl WRITE setSyncthingUrl NOTIFY syncthingUrlChanged)
@@ -158,7 +162,7 @@ class LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingConnection : public QObject {
     Q_PROPERTY(quint64 totalOutgoingTraffic READ totalOutgoingTraffic NOTIFY trafficChanged)
     Q_PROPERTY(double totalIncomingRate READ totalIncomingRate NOTIFY trafficChanged)
     Q_PROPERTY(double totalOutgoingRate READ totalOutgoingRate NOTIFY trafficChanged)
-    Q_PROPERTY(Data::SyncthingOverallDirStatistics overallDirStatistics READ computeOverallDirStatistics NOTIFY dirStatisticsChanged)
+    Q_PROPERTY(Data::SyncthingOverallDirStatistics overallDirStatistics READ overallDirStatistics NOTIFY dirStatisticsChanged)
     Q_PROPERTY(Data::SyncthingCompletion overallRemoteCompletion READ computeOverallRemoteCompletion NOTIFY devCompletionChanged)
     Q_PROPERTY(QString lastSyncedFile READ lastSyncedFile)
     Q_PROPERTY(QString syncthingVersion READ syncthingVersion)
@@ -173,6 +177,7 @@ class LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingConnection : public QObject {
     Q_PROPERTY(bool useDeprecatedRoutes READ isUsingDeprecatedRoutes WRITE setUseDeprecatedRoutes)
     Q_PROPERTY(bool pausingOnMeteredConnection READ isPausingOnMeteredConnection WRITE setPausingOnMeteredConnection)
     Q_PROPERTY(bool insecure READ isInsecure WRITE setInsecure)
+    Q_PROPERTY(int backgroundDecodingThreshold READ backgroundDecodingThreshold WRITE setBackgroundDecodingThreshold)
 
 public:
     explicit SyncthingConnection(const QString &syncthingUrl = QStringLiteral("http://localhost:8080"), const QByteArray &apiKey = QByteArray(),
@@ -228,6 +233,10 @@ public:
     void setStatusComputionFlags(SyncthingStatusComputionFlags flags);
     SyncthingConnectionLoggingFlags loggingFlags() const;
     void setLoggingFlags(SyncthingConnectionLoggingFlags flags);
+    SyncthingReplyRecorder *replyRecorder() const;
+    void setReplyRecorder(SyncthingReplyRecorder *recorder);
+    SyncthingReplyReplayer *replyReplayer() const;
+    void setReplyReplayer(SyncthingReplyReplayer *replayer);
     bool isConnected() const;
     bool isAborted() const;
     bool isConnecting() const;
@@ -235,6 +244,7 @@ public:
     bool hasPendingRequestsIncludingEvents() const;
     bool hasErrors() const;
     bool hasOutOfSyncDirs() const;
+    bool isApplyingConfigIncrementally() const;
 
     // getter/setter to configure connection behavior
     bool isRequestingCompletionEnabled() const;
@@ -249,6 +259,11 @@ public:
     unsigned int autoReconnectTries() const;
     void setAutoReconnectInterval(int interval);
     void disablePolling();
+    SyncthingPollingScheduler *pollingScheduler() const;
+    void setPollingScheduler(SyncthingPollingScheduler *pollingScheduler);
+    int backgroundDecodingThreshold() const;
+    void setBackgroundDecodingThreshold(int threshold);
+    SyncthingJsonDecoder &jsonDecoder();
     bool recordFileChanges() const;
     void setRecordFileChanges(bool recordFileChanges);
     int requestTimeout() const;
@@ -276,6 +291,9 @@ public:
     const std::vector<SyncthingDir> &dirInfo() const;
     const std::vector<SyncthingDev> &devInfo() const;
     const std::vector<SyncthingError> &errors() const;
+    const SyncthingLogStore &logStore() const;
+    SyncthingLogStore &logStore();
+    const SyncthingOverallDirStatistics &overallDirStatistics() const;
     SyncthingOverallDirStatistics computeOverallDirStatistics() const;
     SyncthingCompletion computeOverallRemoteCompletion() const;
     const QString &lastSyncedFile() const;
@@ -283,6 +301,8 @@ public:
     CppUtilities::DateTime startTime() const;
     CppUtilities::TimeSpan uptime() const;
     const QString &syncthingVersion() const;
+    const SyncthingEventCounts &eventCounts() const;
+    void resetEventCounts();
     QStringList directoryIds() const;
     QStringList deviceIds() const;
     Q_INVOKABLE QString deviceNameOrId(const QString &deviceId) const;
@@ -296,6 +316,7 @@ public:
     SyncthingDev *findDevInfo(const QString &devId, int &row);
     const SyncthingDev *findDevInfo(const QString &devId, int &row) const;
     SyncthingDev *findDevInfoByName(const QString &devName, int &row);
+    bool applySnapshot(SyncthingStateSnapshot &&snapshot);
 
 #ifndef QT_NO_SSL
     const QList<QSslError> &expectedSslErrors() const;
@@ -351,6 +372,7 @@ public Q_SLOTS:
     void requestDiskEvents(int limit = 25);
     void requestQrCode(const QString &text);
     void requestLog();
+    void requestNewLogEntries();
     void requestOverride(const QString &dirId);
     void requestRevert(const QString &dirId);
 
@@ -361,11 +383,16 @@ public:
         bool longPolling = false);
     QueryResult browse(const QString &dirId, const QString &prefix, int level,
         std::function<void(std::vector<std::unique_ptr<SyncthingItem>> &&, QString &&)> &&callback);
+    QueryResult browseIncrementally(const QString &dirId, const QString &prefix, int levels,
+        std::function<void(std::vector<std::unique_ptr<SyncthingItem>> &&, bool, QString &&)> &&callback, std::size_t batchSize = 1000);
     QueryResult ignores(const QString &dirId, std::function<void(SyncthingIgnores &&, QString &&)> &&callback);
     QueryResult setIgnores(const QString &dirId, const SyncthingIgnores &ignores, std::function<void(QString &&)> &&callback);
+    QueryResult pullErrors(
+        const QString &dirId, int page, int perPage, std::function<void(std::vector<SyncthingItemError> &&, QString &&)> &&callback);
     QueryResult postConfigFromJsonObject(
         const QJsonObject &rawConfig, std::function<void(QString &&)> &&callback = std::function<void(QString &&)>());
     QueryResult postConfigFromByteArray(const QByteArray &rawConfig, std::function<void(QString &&)> &&callback = std::function<void(QString &&)>());
+    void postConfigPatch(const SyncthingConfigPatch &patch, std::function<void(QString &&)> &&callback = std::function<void(QString &&)>());
 
 Q_SIGNALS:
     void syncthingUrlChanged(const QString &newUrl);
@@ -380,6 +407,20 @@ Q_SIGNALS:
     void allEventsProcessed();
     void dirStatusChanged(const Data::SyncthingDir &dir, int index);
     void devStatusChanged(const Data::SyncthingDev &dev, int index);
+    void dirAboutToBeAdded(int index);
+    void dirAdded(const Data::SyncthingDir &dir, int index);
+    void dirAboutToBeRemoved(const Data::SyncthingDir &dir, int index);
+    void dirRemoved(const QString &dirId, int index);
+    void dirAboutToBeMoved(const Data::SyncthingDir &dir, int fromIndex, int toIndex);
+    void dirMoved(const Data::SyncthingDir &dir, int fromIndex, int toIndex);
+    void dirConfigChanged(const Data::SyncthingDir &dir, int index);
+    void devAboutToBeAdded(int index);
+    void devAdded(const Data::SyncthingDev &dev, int index);
+    void devAboutToBeRemoved(const Data::SyncthingDev &dev, int index);
+    void devRemoved(const QString &devId, int index);
+    void devAboutToBeMoved(const Data::SyncthingDev &dev, int fromIndex, int toIndex);
+    void devMoved(const Data::SyncthingDev &dev, int fromIndex, int toIndex);
+    void devConfigChanged(const Data::SyncthingDev &dev, int index);
     void fileChanged(const Data::SyncthingDir &dir, int index, const Data::SyncthingFileChange &fileChange);
     void downloadProgressChanged();
     void dirStatisticsChanged();
@@ -405,6 +446,7 @@ Q_SIGNALS:
     void restartTriggered();
     void shutdownTriggered();
     void logAvailable(const std::vector<Data::SyncthingLogEntry> &logEntries);
+    void logEntriesAppended(std::size_t beginIndex, std::size_t endIndex);
     void qrCodeAvailable(const QString &text, const QByteArray &qrCodeData);
     void overrideTriggered(const QString &dirId);
     void revertTriggered(const QString &dirId);
@@ -415,6 +457,9 @@ private Q_SLOTS:
     void readConfig();
     void readDirs(const QJsonArray &dirs);
     void readDevs(const QJsonArray &devs);
+    void applyRawConfigIncrementally(const QJsonObject &previousConfig);
+    bool updateDirs(const QJsonArray &previousDirs, const QJsonArray &dirs, bool devsChanged);
+    bool updateDevs(const QJsonArray &previousDevs, const QJsonArray &devs);
     void readStatus();
     void concludeReadingConfigAndStatus();
     void readConnections();
@@ -423,12 +468,18 @@ private Q_SLOTS:
     void readErrors();
     void readClearingErrors();
     void readEvents();
+    void continueReadingEvents();
+    struct EventHandling {
+        PollingFlags requiredFlag = PollingFlags::None;
+        void (*handler)(SyncthingConnection &, SyncthingEventId, CppUtilities::DateTime, SyncthingEventType, const QJsonObject &) = nullptr;
+    };
+    static constexpr std::array<EventHandling, syncthingEventTypeCount> eventHandling();
     bool readEventsFromJsonArray(const QJsonArray &events, quint64 &idVariable);
     void readStartingEvent(const QJsonObject &eventData);
     void readStatusChangedEvent(SyncthingEventId eventId, CppUtilities::DateTime eventTime, const QJsonObject &eventData);
     void readDownloadProgressEvent(const QJsonObject &eventData);
-    void readDirEvent(SyncthingEventId eventId, CppUtilities::DateTime eventTime, const QString &eventType, const QJsonObject &eventData);
-    void readDeviceEvent(SyncthingEventId eventId, CppUtilities::DateTime eventTime, const QString &eventType, const QJsonObject &eventData);
+    void readDirEvent(SyncthingEventId eventId, CppUtilities::DateTime eventTime, SyncthingEventType eventType, const QJsonObject &eventData);
+    void readDeviceEvent(SyncthingEventId eventId, CppUtilities::DateTime eventTime, SyncthingEventType eventType, const QJsonObject &eventData);
     void readItemFinished(SyncthingEventId eventId, CppUtilities::DateTime eventTime, const QJsonObject &eventData);
     void readFolderErrors(
         SyncthingEventId eventId, CppUtilities::DateTime eventTime, const QJsonObject &eventData, Data::SyncthingDir &dirInfo, int index);
@@ -457,7 +508,7 @@ private Q_SLOTS:
     void readCompletion();
     void readVersion();
     void readDiskEvents();
-    void readChangeEvent(CppUtilities::DateTime eventTime, const QString &eventType, const QJsonObject &eventData);
+    void readChangeEvent(CppUtilities::DateTime eventTime, SyncthingEventType eventType, const QJsonObject &eventData);
     void readLog();
     void readQrCode();
     void readOverride();
@@ -469,6 +520,7 @@ private Q_SLOTS:
     void autoReconnect();
     bool setStatus(Data::SyncthingStatus status);
     void emitError(const QString &message, const QJsonParseError &jsonError, QNetworkReply *reply, const QByteArray &response = QByteArray());
+    void emitError(const QString &message, const QJsonParseError &jsonError, const QNetworkRequest &request, const QByteArray &response);
     void emitError(const QString &message, Data::SyncthingErrorCategory category, QNetworkReply *reply);
     void emitError(const QString &message, QNetworkReply *reply);
     void emitMyIdChanged(const QString &newId);
@@ -482,14 +534,22 @@ private Q_SLOTS:
     void handleMeteredConnection();
     void recalculateStatus();
     void invalidateHasOutOfSyncDirs();
+    void recomputeOverallDirStatistics();
 
 private:
     // handler to evaluate results from request...() methods
     void readJsonData(std::function<void(QJsonDocument &&, QString &&)> &&callback);
     void readBrowse(const QString &dirId, int levels, std::function<void(std::vector<std::unique_ptr<SyncthingItem>> &&, QString &&)> &&callback);
+    void readBrowseChunk(QNetworkReply *reply, SyncthingBrowseParser &parser, QByteArray *rawResponse, std::size_t batchSize,
+        const std::function<void(std::vector<std::unique_ptr<SyncthingItem>> &&, bool, QString &&)> &callback);
+    void readBrowseIncrementally(const QString &dirId, SyncthingBrowseParser &parser, QByteArray *rawResponse,
+        std::function<void(std::vector<std::unique_ptr<SyncthingItem>> &&, bool, QString &&)> &&callback);
     void readIgnores(const QString &dirId, std::function<void(SyncthingIgnores &&, QString &&)> &&callback);
     void readSetIgnores(const QString &dirId, std::function<void(QString &&)> &&callback);
+    void readPullErrors(const QString &dirId, int page, std::function<void(std::vector<SyncthingItemError> &&, QString &&)> &&callback);
     void readPostConfig(std::function<void(QString &&)> &&callback);
+    void postConfigPatchRequests(
+        std::shared_ptr<const std::vector<SyncthingConfigRequest>> requests, std::size_t index, std::function<void(QString &&)> &&callback);
 
     // internal helper methods
     enum class StatusRecomputation {
@@ -512,17 +572,20 @@ private:
     Reply prepareReply(bool readData = true, bool handleAborting = true);
     Reply prepareReply(QNetworkReply *&expectedReply, bool readData = true, bool handleAborting = true);
     Reply prepareReply(QList<QNetworkReply *> &expectedReplies, bool readData = true, bool handleAborting = true);
-    Reply handleReply(QNetworkReply *reply, bool readData, bool handleAborting);
+    Reply handleReply(QNetworkReply *reply, bool readData, bool handleAborting, QByteArray &&consumedData = QByteArray());
     bool pauseResumeDevice(const QStringList &devIds, bool paused, bool dueToMetered = false);
     bool pauseResumeDirectory(const QStringList &dirIds, bool paused);
-    SyncthingDir *addDirInfo(std::vector<SyncthingDir> &dirs, const QString &dirId);
-    SyncthingDev *addDevInfo(std::vector<SyncthingDev> &devs, const QString &devId);
+    SyncthingDir *addDirInfo(std::vector<SyncthingDir> &dirs, QHash<QString, SyncthingDir *> &previousDirs, const QString &dirId);
+    SyncthingDev *addDevInfo(std::vector<SyncthingDev> &devs, QHash<QString, SyncthingDev *> &previousDevs, const QString &devId);
+    void readDirConfig(SyncthingDir &dir, const QJsonObject &dirObj, const QHash<QString, const SyncthingDev *> &devsById) const;
+    void readDevConfig(SyncthingDev &dev, const QJsonObject &devObj, bool isThisDevice) const;
     CppUtilities::DateTime parseTimeStamp(const QJsonValue &jsonValue, const QString &context,
         CppUtilities::DateTime defaultValue = CppUtilities::DateTime(), bool greaterThanEpoch = false);
     QString configPath() const;
     QByteArray changeConfigVerb() const;
     QString folderErrorsPath() const;
     bool checkConnectionConfiguration();
+    void registerPollingTasks(int trafficPollInterval, int devStatsPollInterval, int errorsPollInterval, int autoReconnectInterval);
 
     QString m_syncthingUrl;
     QByteArray m_apiKey;
@@ -545,10 +608,15 @@ private:
     SyncthingEventId m_lastEventId;
     SyncthingEventId m_lastDiskEventId;
     QHash<QString, SyncthingEventId> m_lastEventIdByMask;
-    QTimer m_trafficPollTimer;
-    QTimer m_devStatsPollTimer;
-    QTimer m_errorsPollTimer;
-    QTimer m_autoReconnectTimer;
+    SyncthingEventCounts m_eventCounts;
+    SyncthingPollingScheduler *m_pollingScheduler;
+    SyncthingPollingTaskId m_trafficPollTask;
+    SyncthingPollingTaskId m_devStatsPollTask;
+    SyncthingPollingTaskId m_errorsPollTask;
+    SyncthingPollingTaskId m_autoReconnectTask;
+    std::unique_ptr<SyncthingJsonDecoder> m_jsonDecoder;
+    QPointer<SyncthingReplyRecorder> m_replyRecorder;
+    QPointer<SyncthingReplyReplayer> m_replyReplayer;
     unsigned int m_autoReconnectTries;
     int m_requestTimeout;
     int m_longPollingTimeout;
@@ -572,13 +640,18 @@ private:
     QNetworkReply *m_diskEventsReply;
     QNetworkReply *m_logReply;
     QList<QNetworkReply *> m_otherReplies;
+    SyncthingLogStore m_logStore;
     mutable std::optional<bool> m_hasOutOfSyncDirs;
     bool m_hasConfig;
     bool m_hasStatus;
     bool m_hasEvents;
     bool m_hasDiskEvents;
     bool m_statsRequested;
+    bool m_applyingConfigIncrementally;
+    bool m_decodingNewLogEntries;
+    bool m_snapshotApplied;
     std::vector<SyncthingDir> m_dirs;
+    SyncthingOverallDirStatistics m_overallDirStats;
     std::vector<SyncthingDev> m_devs;
     std::vector<SyncthingError> m_errors;
     QStringList m_devsPausedDueToMeteredConnection;
@@ -622,6 +695,8 @@ inline const QString &SyncthingConnection::syncthingUrl() const
 inline void SyncthingConnection::setSyncthingUrl(const QString &url)
 {
     if (m_syncthingUrl != url) {
+        m_logStore.clear();
+        m_snapshotApplied = false;
         emit syncthingUrlChanged(m_syncthingUrl = url);
     }
 }
@@ -639,7 +714,10 @@ inline const QByteArray &SyncthingConnection::apiKey() const
  */
 inline void SyncthingConnection::setApiKey(const QByteArray &apiKey)
 {
-    m_apiKey = apiKey;
+    if (m_apiKey != apiKey) {
+        m_snapshotApplied = false;
+        m_apiKey = apiKey;
+    }
 }
 
 /*!
@@ -702,8 +780,8 @@ inline SyncthingConnection::PollingFlags SyncthingConnection::pollingFlags() con
 inline QString SyncthingConnection::statusText() const
 {
     auto text = m_status == SyncthingStatus::Disconnected && !isAborted() && hasPendingRequests() ? tr("connecting") : statusText(m_status);
-    if (m_autoReconnectTimer.isActive() && m_autoReconnectTimer.interval()) {
-        text += tr(", re-connect attempt every %1 ms").arg(m_autoReconnectTimer.interval());
+    if (const auto interval = m_pollingScheduler->interval(m_autoReconnectTask); interval && m_pollingScheduler->isActive(m_autoReconnectTask)) {
+        text += tr(", re-connect attempt every %1 ms").arg(interval);
     }
     return text;
 }
@@ -745,28 +823,25 @@ inline bool SyncthingConnection::isConnecting() const
 }
 
 /*!
- * \brief Returns whether the SyncthingConnector instance is waiting for Syncthing to respond to a request.
- * \remarks
- * - Requests for (disk) events are excluded because those are long polling requests and therefore always pending.
- *   Instead, we take only into account whether those requests have been at least concluded once (since the last
- *   reconnect).
- * - Only requests which contribute to the overall state and population of myId(), tilde(), dirInfo(), devInfo(),
- *   traffic statistics, ... are considered. So requests for QR code, logs, clearing errors, rescan, ... are not
- *   taken into account.
- * - This function will also return true as long as the method abortAllRequests() is executed.
+ * \brief Returns whether there are errors (notifications) available.
  */
-inline bool SyncthingConnection::hasPendingRequests() const
+inline bool SyncthingConnection::hasErrors() const
 {
-    return m_abortingAllRequests || m_configReply || m_statusReply || (m_eventsReply && !m_hasEvents) || (m_diskEventsReply && !m_hasDiskEvents)
-        || m_connectionsReply || m_dirStatsReply || m_devStatsReply || m_errorsReply || m_versionReply || !m_otherReplies.isEmpty();
+    return !m_errors.empty();
 }
 
 /*!
- * \brief Returns whether there are errors (notifications) available.
+ * \brief Returns whether a re-read config is currently being applied incrementally.
+ * \remarks
+ * - This is the case when the config has changed while being connected (e.g. due to a "ConfigSaved" event). Then only
+ *   folders/devices that have actually been added, removed, moved or changed are updated in place and dirAdded(), dirRemoved(),
+ *   dirMoved(), dirConfigChanged(), devAdded(), devRemoved(), devMoved() and devConfigChanged() are emitted accordingly.
+ * - Handlers of newConfig() and newConfigApplied() can use this to avoid invalidating everything, e.g. models can avoid
+ *   being reset so their rows and expansion state are preserved.
  */
-inline bool SyncthingConnection::hasErrors() const
+inline bool SyncthingConnection::isApplyingConfigIncrementally() const
 {
-    return !m_errors.empty();
+    return m_applyingConfigIncrementally;
 }
 
 /*!
@@ -793,7 +868,7 @@ inline void SyncthingConnection::setRequestingCompletionEnabled(bool requestingC
  */
 inline int SyncthingConnection::trafficPollInterval() const
 {
-    return m_trafficPollTimer.interval();
+    return m_pollingScheduler->interval(m_trafficPollTask);
 }
 
 /*!
@@ -802,10 +877,7 @@ inline int SyncthingConnection::trafficPollInterval() const
  */
 inline void SyncthingConnection::setTrafficPollInterval(int trafficPollInterval)
 {
-    if (!trafficPollInterval) {
-        m_trafficPollTimer.stop();
-    }
-    m_trafficPollTimer.setInterval(trafficPollInterval);
+    m_pollingScheduler->setInterval(m_trafficPollTask, trafficPollInterval);
 }
 
 /*!
@@ -814,7 +886,7 @@ inline void SyncthingConnection::setTrafficPollInterval(int trafficPollInterval)
  */
 inline int SyncthingConnection::devStatsPollInterval() const
 {
-    return m_devStatsPollTimer.interval();
+    return m_pollingScheduler->interval(m_devStatsPollTask);
 }
 
 /*!
@@ -823,10 +895,7 @@ inline int SyncthingConnection::devStatsPollInterval() const
  */
 inline void SyncthingConnection::setDevStatsPollInterval(int devStatsPollInterval)
 {
-    if (!devStatsPollInterval) {
-        m_devStatsPollTimer.stop();
-    }
-    m_devStatsPollTimer.setInterval(devStatsPollInterval);
+    m_pollingScheduler->setInterval(m_devStatsPollTask, devStatsPollInterval);
 }
 
 /*!
@@ -835,7 +904,7 @@ inline void SyncthingConnection::setDevStatsPollInterval(int devStatsPollInterva
  */
 inline int SyncthingConnection::errorsPollInterval() const
 {
-    return m_errorsPollTimer.interval();
+    return m_pollingScheduler->interval(m_errorsPollTask);
 }
 
 /*!
@@ -844,10 +913,7 @@ inline int SyncthingConnection::errorsPollInterval() const
  */
 inline void SyncthingConnection::setErrorsPollInterval(int errorPollInterval)
 {
-    if (!errorPollInterval) {
-        m_errorsPollTimer.stop();
-    }
-    m_errorsPollTimer.setInterval(errorPollInterval);
+    m_pollingScheduler->setInterval(m_errorsPollTask, errorPollInterval);
 }
 
 /*!
@@ -856,7 +922,7 @@ inline void SyncthingConnection::setErrorsPollInterval(int errorPollInterval)
  */
 inline int SyncthingConnection::autoReconnectInterval() const
 {
-    return m_autoReconnectTimer.interval();
+    return m_pollingScheduler->interval(m_autoReconnectTask);
 }
 
 /*!
@@ -873,13 +939,19 @@ inline unsigned int SyncthingConnection::autoReconnectTries() const
  */
 inline void SyncthingConnection::setAutoReconnectInterval(int interval)
 {
-    if (!interval) {
-        m_autoReconnectTimer.stop();
-    }
-    m_autoReconnectTimer.setInterval(interval);
+    m_pollingScheduler->setInterval(m_autoReconnectTask, interval);
     emit autoReconnectIntervalChanged(interval);
 }
 
+/*!
+ * \brief Returns the scheduler used to run timer-based requests (traffic, device statistics, errors) and auto-reconnect attempts.
+ * \remarks Use SyncthingPollingScheduler::setUiVisible() to inform the scheduler whether the polled information is currently shown.
+ */
+inline SyncthingPollingScheduler *SyncthingConnection::pollingScheduler() const
+{
+    return m_pollingScheduler;
+}
+
 /*!
  * \brief Returns whether file changes are recorded for each directory so SyncthingDir::recentChanges is being populated.
  * \remarks The fileChanged() signal is unaffected.
@@ -1010,6 +1082,41 @@ inline SyncthingConnectionLoggingFlags SyncthingConnection::loggingFlags() const
     return m_loggingFlags;
 }
 
+/*!
+ * \brief Returns the recorder all replies are recorded with or nullptr if replies are not recorded.
+ */
+inline SyncthingReplyRecorder *SyncthingConnection::replyRecorder() const
+{
+    return m_replyRecorder.data();
+}
+
+/*!
+ * \brief Sets the \a recorder to record all replies with; set to nullptr to stop recording.
+ * \remarks The ownership is not transferred.
+ */
+inline void SyncthingConnection::setReplyRecorder(SyncthingReplyRecorder *recorder)
+{
+    m_replyRecorder = recorder;
+}
+
+/*!
+ * \brief Returns the replayer replies are served from or nullptr if requests are sent to Syncthing.
+ */
+inline SyncthingReplyReplayer *SyncthingConnection::replyReplayer() const
+{
+    return m_replyReplayer.data();
+}
+
+/*!
+ * \brief Sets the \a replayer to serve replies from instead of sending requests to Syncthing; set to nullptr to send
+ *        requests to Syncthing again.
+ * \remarks The ownership is not transferred. Only affects requests made after calling this function.
+ */
+inline void SyncthingConnection::setReplyReplayer(SyncthingReplyReplayer *replayer)
+{
+    m_replyReplayer = replayer;
+}
+
 /*!
  * \brief Returns the Syncthing home/configuration directory.
  */
@@ -1102,8 +1209,38 @@ inline const std::vector<SyncthingError> &Data::SyncthingConnection::errors() co
     return m_errors;
 }
 
+/*!
+ * \brief Returns the log entries retrieved via requestNewLogEntries().
+ */
+inline const SyncthingLogStore &SyncthingConnection::logStore() const
+{
+    return m_logStore;
+}
+
+/*!
+ * \brief Returns the log entries retrieved via requestNewLogEntries().
+ * \remarks Use this to change the capacity of the store or to clear it.
+ */
+inline SyncthingLogStore &SyncthingConnection::logStore()
+{
+    return m_logStore;
+}
+
+/*!
+ * \brief Returns overall directory statistics based on the currently available directory information.
+ * \remarks
+ * - The statistics are kept up-to-date as the statistics of individual directories change (by adjusting them by the
+ *   difference) so this is cheap to call whenever dirStatisticsChanged() is emitted.
+ * - Only re-computed from all directories when the directories are (re-)configured.
+ */
+inline const SyncthingOverallDirStatistics &SyncthingConnection::overallDirStatistics() const
+{
+    return m_overallDirStats;
+}
+
 /*!
  * \brief Computes overall directory statistics based on the currently available directory information.
+ * \remarks Iterates over all directories; use overallDirStatistics() instead which returns the same result.
  */
 inline SyncthingOverallDirStatistics SyncthingConnection::computeOverallDirStatistics() const
 {
@@ -1150,6 +1287,24 @@ inline const QString &SyncthingConnection::syncthingVersion() const
     return m_syncthingVersion;
 }
 
+/*!
+ * \brief Returns how many events of each type have been received (indexed by SyncthingEventType).
+ * \remarks This is meant for profiling which events are causing load. Events of unhandled types are counted as
+ *          SyncthingEventType::Unknown.
+ */
+inline const SyncthingEventCounts &SyncthingConnection::eventCounts() const
+{
+    return m_eventCounts;
+}
+
+/*!
+ * \brief Resets the counters returned by eventCounts().
+ */
+inline void SyncthingConnection::resetEventCounts()
+{
+    m_eventCounts.fill(0);
+}
+
 #ifndef QT_NO_SSL
 /*!
  * \brief Returns a list of all expected certificate errors. This is meant to allow self-signed certificates.
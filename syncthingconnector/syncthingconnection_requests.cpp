@@ -1,4 +1,8 @@
+#include "./syncthingbrowseparser.h"
+#include "./syncthingconfigpatch.h"
 #include "./syncthingconnection.h"
+#include "./syncthingjsondecoder.h"
+#include "./syncthingreplylog.h"
 #include "./utils.h"
 
 #if defined(LIB_SYNCTHING_CONNECTOR_CONNECTION_MOCKED) || defined(LIB_SYNCTHING_CONNECTOR_MOCKED)
@@ -14,11 +18,14 @@
 #include <QJsonValue>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
+#include <QSet>
 #include <QStringBuilder>
 #include <QTimer>
 #include <QUrlQuery>
 
 #include <algorithm>
+#include <array>
+#include <initializer_list>
 #include <iostream>
 #include <utility>
 
@@ -28,6 +35,24 @@ using namespace CppUtilities::EscapeCodes;
 
 namespace Data {
 
+/// \cond
+/*!
+ * \brief The ParsedJson struct holds a parsed JSON document and the parsing error (if any).
+ * \remarks Used as result of decoding responses via SyncthingJsonDecoder.
+ */
+struct ParsedJson {
+    QJsonDocument doc;
+    QJsonParseError error;
+};
+
+static ParsedJson parseJson(const QByteArray &response)
+{
+    auto res = ParsedJson();
+    res.doc = QJsonDocument::fromJson(response, &res.error);
+    return res;
+}
+/// \endcond
+
 // helper to create QNetworkRequest
 
 /*!
@@ -75,7 +100,9 @@ QNetworkRequest SyncthingConnection::prepareRequest(const QString &path, const Q
 QNetworkReply *SyncthingConnection::requestData(const QString &path, const QUrlQuery &query, bool rest, bool longPolling)
 {
 #if !defined(LIB_SYNCTHING_CONNECTOR_CONNECTION_MOCKED) && !defined(LIB_SYNCTHING_CONNECTOR_MOCKED)
-    auto *const reply = networkAccessManager().get(prepareRequest(path, query, rest, longPolling));
+    auto *const reply = m_replyReplayer
+        ? m_replyReplayer->replyFor(QByteArrayLiteral("GET"), prepareRequest(path, query, rest, longPolling).url(), longPolling)
+        : networkAccessManager().get(prepareRequest(path, query, rest, longPolling));
 #ifndef QT_NO_SSL
     QObject::connect(reply, &QNetworkReply::sslErrors, this, &SyncthingConnection::handleSslErrors);
 #endif
@@ -96,7 +123,8 @@ QNetworkReply *SyncthingConnection::requestData(const QString &path, const QUrlQ
 QNetworkReply *SyncthingConnection::postData(const QString &path, const QUrlQuery &query, const QByteArray &data)
 {
 #if !defined(LIB_SYNCTHING_CONNECTOR_CONNECTION_MOCKED) && !defined(LIB_SYNCTHING_CONNECTOR_MOCKED)
-    auto *const reply = networkAccessManager().post(prepareRequest(path, query), data);
+    auto *const reply = m_replyReplayer ? m_replyReplayer->replyFor(QByteArrayLiteral("POST"), prepareRequest(path, query).url(), false)
+                                        : networkAccessManager().post(prepareRequest(path, query), data);
 #ifndef QT_NO_SSL
     QObject::connect(reply, &QNetworkReply::sslErrors, this, &SyncthingConnection::handleSslErrors);
 #endif
@@ -117,7 +145,8 @@ QNetworkReply *SyncthingConnection::postData(const QString &path, const QUrlQuer
 QNetworkReply *SyncthingConnection::sendData(const QByteArray &verb, const QString &path, const QUrlQuery &query, const QByteArray &data)
 {
 #if !defined(LIB_SYNCTHING_CONNECTOR_CONNECTION_MOCKED) && !defined(LIB_SYNCTHING_CONNECTOR_MOCKED)
-    auto *const reply = networkAccessManager().sendCustomRequest(prepareRequest(path, query), verb, data);
+    auto *const reply = m_replyReplayer ? m_replyReplayer->replyFor(verb, prepareRequest(path, query).url(), false)
+                                        : networkAccessManager().sendCustomRequest(prepareRequest(path, query), verb, data);
 #ifndef QT_NO_SSL
     QObject::connect(reply, &QNetworkReply::sslErrors, this, &SyncthingConnection::handleSslErrors);
 #endif
@@ -266,16 +295,31 @@ void SyncthingConnection::handleRedirection(const QUrl &url)
 
 /*!
  * \brief Handles the specified \a reply; invoked by the prepareReply() functions.
+ * \remarks The \a consumedData is data the caller has already read from \a reply (e.g. when parsing the response while it
+ *          is received). It is prepended to the response so it is recorded and logged as well.
  */
-SyncthingConnection::Reply SyncthingConnection::handleReply(QNetworkReply *reply, bool readData, bool handleAborting)
+SyncthingConnection::Reply SyncthingConnection::handleReply(QNetworkReply *reply, bool readData, bool handleAborting, QByteArray &&consumedData)
 {
     const auto log = m_loggingFlags && SyncthingConnectionLoggingFlags::ApiReplies;
+    auto response = std::move(consumedData);
+    if (reply->isOpen()) {
+        if (readData) {
+            response.append(reply->readAll());
+        } else if (log || m_replyRecorder) {
+            // only peek so the data is still available to the caller, e.g. for passing Syncthing's error message to emitError()
+            response.append(reply->peek(reply->bytesAvailable()));
+        }
+    }
     const auto data = Reply{
         .reply = (handleAborting && m_abortingAllRequests) ? nullptr : reply, // skip further processing if aborting to reconnect
-        .response = ((readData || log) && reply->isOpen()) ? reply->readAll() : QByteArray(),
+        .response = std::move(response),
     };
     reply->deleteLater();
 
+    if (m_replyRecorder) {
+        m_replyRecorder->record(reply, data.response);
+    }
+
     if (log) {
         const auto url = reply->url();
         const auto path = url.path().toUtf8();
@@ -674,8 +718,8 @@ void SyncthingConnection::readClearingErrors()
     switch (reply->error()) {
     case QNetworkReply::NoError:
         requestErrors();
-        if (m_errorsPollTimer.isActive()) {
-            m_errorsPollTimer.start(); // this stops and restarts the active timer to reset the remaining time
+        if (m_pollingScheduler->isActive(m_errorsPollTask)) {
+            m_pollingScheduler->start(m_errorsPollTask); // this re-schedules the active task to reset the remaining time
         }
         break;
     default:
@@ -700,6 +744,10 @@ void SyncthingConnection::requestConfig()
 
 /*!
  * \brief Reads results of requestConfig().
+ * \remarks
+ * If the config has already been applied while being connected (so it is re-read e.g. due to a "ConfigSaved" event), only the
+ * differences to the previous config are applied via applyRawConfigIncrementally(). Otherwise the config is applied as usual
+ * when the status is available as well (see concludeReadingConfigAndStatus()).
  */
 void SyncthingConnection::readConfig()
 {
@@ -709,24 +757,33 @@ void SyncthingConnection::readConfig()
     }
 
     switch (reply->error()) {
-    case QNetworkReply::NoError: {
-        auto jsonError = QJsonParseError();
-        const auto replyDoc = QJsonDocument::fromJson(response, &jsonError);
-        if (jsonError.error != QJsonParseError::NoError) {
-            emitError(tr("Unable to parse Syncthing config: "), jsonError, reply, response);
-            handleFatalConnectionError();
-            return;
-        }
+    case QNetworkReply::NoError:
+        m_jsonDecoder->decode(response, &parseJson, [this, request = reply->request(), response = response](ParsedJson &&parsed) {
+            if (parsed.error.error != QJsonParseError::NoError) {
+                emitError(tr("Unable to parse Syncthing config: "), parsed.error, request, response);
+                handleFatalConnectionError();
+                return;
+            }
 
-        m_rawConfig = replyDoc.object();
-        m_hasConfig = true;
-        emit newConfig(m_rawConfig);
+            const auto configApplied = m_hasConfig && m_hasStatus && m_keepPolling;
+            const auto previousConfig = std::exchange(m_rawConfig, parsed.doc.object());
+            m_hasConfig = true;
+            m_snapshotApplied = false;
+            if (configApplied) {
+                m_applyingConfigIncrementally = true;
+                emit newConfig(m_rawConfig);
+                applyRawConfigIncrementally(previousConfig);
+                m_applyingConfigIncrementally = false;
+                continueConnecting();
+                return;
+            }
 
-        if (m_keepPolling) {
-            concludeReadingConfigAndStatus();
-        }
+            emit newConfig(m_rawConfig);
+            if (m_keepPolling) {
+                concludeReadingConfigAndStatus();
+            }
+        });
         break;
-    }
     case QNetworkReply::OperationCanceledError:
         return;
     default:
@@ -735,6 +792,316 @@ void SyncthingConnection::readConfig()
     }
 }
 
+/// \cond
+/*!
+ * \brief The ConfigItem struct refers to a folder/device within the raw config.
+ */
+struct ConfigItem {
+    QString id;
+    QJsonObject object;
+};
+
+/*!
+ * \brief Returns the folders/devices of the specified raw config \a array skipping items with empty or duplicate IDs.
+ */
+static std::vector<ConfigItem> configItems(const QJsonArray &array, QLatin1String idKey)
+{
+    auto items = std::vector<ConfigItem>();
+    auto ids = QSet<QString>();
+    items.reserve(static_cast<std::size_t>(array.size()));
+    ids.reserve(static_cast<int>(array.size()));
+    for (const auto &value : array) {
+        auto object = value.toObject();
+        auto id = object.value(idKey).toString();
+        if (id.isEmpty() || ids.contains(id)) {
+            continue;
+        }
+        ids.insert(id);
+        items.emplace_back(ConfigItem{ std::move(id), std::move(object) });
+    }
+    return items;
+}
+
+/*!
+ * \brief Returns the folders/devices of the specified raw config \a array by ID.
+ */
+static QHash<QString, QJsonObject> configObjectsById(const QJsonArray &array, QLatin1String idKey)
+{
+    auto objects = QHash<QString, QJsonObject>();
+    objects.reserve(static_cast<int>(array.size()));
+    for (const auto &value : array) {
+        auto object = value.toObject();
+        objects.insert(object.value(idKey).toString(), object);
+    }
+    return objects;
+}
+
+/*!
+ * \brief Makes \a items correspond to \a newItems (in the same order) by removing, inserting, moving and updating items.
+ * \remarks
+ * - \a remove is supposed to remove the item at the specified index.
+ * - \a insert is supposed to insert a new item for the specified config item at the specified index.
+ * - \a move is supposed to move the item at the first specified index to the second specified index (which is always lower).
+ * - \a update is supposed to update the item at the specified index in place and return whether it has changed.
+ * - Items which have only been reordered are moved (instead of being removed and inserted again) so views can keep their
+ *   state (e.g. the expansion state) and moved items are found via their ID in constant time. Moving/inserting an item is
+ *   still linear in the number of items behind it (like inserting into a std::vector and like beginMoveRows() is).
+ * \returns Returns whether any of the \a items has been removed, inserted, moved or changed.
+ */
+template <typename Item, typename RemoveFunction, typename InsertFunction, typename MoveFunction, typename UpdateFunction>
+static bool updateConfigItems(std::vector<Item> &items, const std::vector<ConfigItem> &newItems, RemoveFunction &&remove, InsertFunction &&insert,
+    MoveFunction &&move, UpdateFunction &&update)
+{
+    // remove items that are not present anymore (starting from the back so indexes remain stable)
+    auto changed = false;
+    auto newIds = QSet<QString>();
+    newIds.reserve(static_cast<int>(newItems.size()));
+    for (const auto &newItem : newItems) {
+        newIds.insert(newItem.id);
+    }
+    for (auto index = items.size(); index-- > 0;) {
+        if (!newIds.contains(items[index].id)) {
+            remove(index);
+            changed = true;
+        }
+    }
+
+    // index the remaining items by ID to find moved items without linear search
+    auto indexes = QHash<QString, std::size_t>();
+    indexes.reserve(static_cast<int>(items.size()));
+    for (auto index = std::size_t(); index != items.size(); ++index) {
+        indexes.insert(items[index].id, index);
+    }
+
+    // insert new items, move reordered items and update existing items in place
+    // note: Items before the current index already correspond to newItems so an item found via indexes is always behind it.
+    for (auto index = std::size_t(); index != newItems.size(); ++index) {
+        const auto &newItem = newItems[index];
+        if (index < items.size() && items[index].id == newItem.id) {
+            changed = update(index, newItem) || changed;
+            continue;
+        }
+        const auto oldIndex = indexes.value(newItem.id, items.size());
+        if (oldIndex < items.size()) {
+            move(oldIndex, index);
+            for (auto shiftedIndex = index + 1; shiftedIndex <= oldIndex; ++shiftedIndex) {
+                indexes[items[shiftedIndex].id] = shiftedIndex;
+            }
+            update(index, newItem);
+        } else {
+            insert(index, newItem);
+            for (auto shiftedIndex = index + 1; shiftedIndex < items.size(); ++shiftedIndex) {
+                indexes[items[shiftedIndex].id] = shiftedIndex;
+            }
+        }
+        indexes[newItem.id] = index;
+        changed = true;
+    }
+    return changed;
+}
+/// \endcond
+
+/*!
+ * \brief Applies the differences between the current raw config and the specified \a previousConfig.
+ * \remarks
+ * - Called by readConfig() instead of applyRawConfig() when the config has been re-read while being connected.
+ * - Only folders/devices which have been added, removed or changed are updated (in place) so their runtime state (status,
+ *   statistics, completion, …) is preserved and views do not need to be reset. Besides the fine-grained signals emitted by
+ *   updateDevs() and updateDirs(), newDevices() and newDirs() are still emitted if there are any changes at all.
+ */
+void SyncthingConnection::applyRawConfigIncrementally(const QJsonObject &previousConfig)
+{
+    const auto devsChanged = updateDevs(
+        previousConfig.value(QLatin1String("devices")).toArray(), m_rawConfig.value(QLatin1String("devices")).toArray());
+    const auto dirsChanged = updateDirs(
+        previousConfig.value(QLatin1String("folders")).toArray(), m_rawConfig.value(QLatin1String("folders")).toArray(), devsChanged);
+    if (devsChanged) {
+        emit newDevices(m_devs);
+        if (m_pausingOnMeteredConnection) {
+            handleMeteredConnection();
+        }
+    }
+    if (dirsChanged) {
+        recomputeOverallDirStatistics();
+        emit newDirs(m_dirs);
+        m_hasOutOfSyncDirs.reset();
+    }
+    emit newConfigApplied();
+}
+
+/*!
+ * \brief Updates the directories according to \a dirs; called by applyRawConfigIncrementally().
+ * \remarks
+ * - Directories are only re-read if their raw config differs from \a previousDirs. If devices have changed (\a devsChanged)
+ *   the device names of other directories are updated as well.
+ * - Emits dirAboutToBeRemoved()/dirRemoved(), dirAboutToBeAdded()/dirAdded(), dirAboutToBeMoved()/dirMoved() and
+ *   dirConfigChanged() accordingly.
+ * \returns Returns whether any directory has been added, removed or changed.
+ */
+bool SyncthingConnection::updateDirs(const QJsonArray &previousDirs, const QJsonArray &dirs, bool devsChanged)
+{
+    const auto idKey = QLatin1String("id");
+    const auto previousObjects = configObjectsById(previousDirs, idKey);
+    auto devsById = QHash<QString, const SyncthingDev *>();
+    devsById.reserve(static_cast<int>(m_devs.size()));
+    for (const auto &dev : m_devs) {
+        devsById.insert(dev.id, &dev);
+    }
+
+    return updateConfigItems(
+        m_dirs, configItems(dirs, idKey),
+        [this](std::size_t index) {
+            const auto row = static_cast<int>(index);
+            emit dirAboutToBeRemoved(m_dirs[index], row);
+            const auto dirId = std::move(m_dirs[index].id);
+            m_dirs.erase(m_dirs.begin() + static_cast<std::ptrdiff_t>(index));
+            emit dirRemoved(dirId, row);
+        },
+        [this, &devsById](std::size_t index, const ConfigItem &item) {
+            const auto row = static_cast<int>(index);
+            emit dirAboutToBeAdded(row);
+            auto &dir = *m_dirs.emplace(m_dirs.begin() + static_cast<std::ptrdiff_t>(index), item.id);
+            readDirConfig(dir, item.object, devsById);
+            emit dirAdded(dir, row);
+        },
+        [this](std::size_t fromIndex, std::size_t toIndex) {
+            const auto from = static_cast<std::ptrdiff_t>(fromIndex), to = static_cast<std::ptrdiff_t>(toIndex);
+            emit dirAboutToBeMoved(m_dirs[fromIndex], static_cast<int>(from), static_cast<int>(to));
+            std::rotate(m_dirs.begin() + to, m_dirs.begin() + from, m_dirs.begin() + from + 1);
+            emit dirMoved(m_dirs[toIndex], static_cast<int>(from), static_cast<int>(to));
+        },
+        [this, &previousObjects, &devsById, devsChanged](std::size_t index, const ConfigItem &item) {
+            auto &dir = m_dirs[index];
+            if (previousObjects.value(item.id) != item.object) {
+                readDirConfig(dir, item.object, devsById);
+            } else if (devsChanged) {
+                auto deviceNames = QStringList();
+                for (const auto &devId : std::as_const(dir.deviceIds)) {
+                    if (const auto *const dev = devsById.value(devId)) {
+                        deviceNames << dev->name;
+                    }
+                }
+                if (deviceNames == dir.deviceNames) {
+                    return false;
+                }
+                dir.deviceNames.swap(deviceNames);
+            } else {
+                return false;
+            }
+            emit dirConfigChanged(dir, static_cast<int>(index));
+            return true;
+        });
+}
+
+/*!
+ * \brief Updates the devices according to \a devs; called by applyRawConfigIncrementally().
+ * \remarks
+ * - Devices are only re-read if their raw config differs from \a previousDevs. The status of existing devices is preserved.
+ * - Like readDevs(), the own device is kept as first device.
+ * - Emits devAboutToBeRemoved()/devRemoved(), devAboutToBeAdded()/devAdded(), devAboutToBeMoved()/devMoved() and
+ *   devConfigChanged() accordingly.
+ * \returns Returns whether any device has been added, removed or changed.
+ */
+bool SyncthingConnection::updateDevs(const QJsonArray &previousDevs, const QJsonArray &devs)
+{
+    const auto idKey = QLatin1String("deviceID");
+    const auto previousObjects = configObjectsById(previousDevs, idKey);
+    auto newItems = configItems(devs, idKey);
+    if (!m_myId.isEmpty()) {
+        const auto thisDevice = std::find_if(newItems.begin(), newItems.end(), [this](const ConfigItem &item) { return item.id == m_myId; });
+        if (thisDevice != newItems.end()) {
+            std::rotate(newItems.begin(), thisDevice, thisDevice + 1);
+        } else {
+            newItems.insert(newItems.begin(), ConfigItem{ m_myId, QJsonObject() });
+        }
+    }
+
+    return updateConfigItems(
+        m_devs, newItems,
+        [this](std::size_t index) {
+            const auto row = static_cast<int>(index);
+            emit devAboutToBeRemoved(m_devs[index], row);
+            const auto devId = std::move(m_devs[index].id);
+            m_devs.erase(m_devs.begin() + static_cast<std::ptrdiff_t>(index));
+            emit devRemoved(devId, row);
+        },
+        [this](std::size_t index, const ConfigItem &item) {
+            const auto row = static_cast<int>(index);
+            const auto isThisDevice = item.id == m_myId;
+            emit devAboutToBeAdded(row);
+            auto &dev = *m_devs.emplace(m_devs.begin() + static_cast<std::ptrdiff_t>(index), item.id);
+            if (isThisDevice) {
+                dev.status = SyncthingDevStatus::ThisDevice;
+                dev.paused = false;
+            }
+            readDevConfig(dev, item.object, isThisDevice);
+            emit devAdded(dev, row);
+        },
+        [this](std::size_t fromIndex, std::size_t toIndex) {
+            const auto from = static_cast<std::ptrdiff_t>(fromIndex), to = static_cast<std::ptrdiff_t>(toIndex);
+            emit devAboutToBeMoved(m_devs[fromIndex], static_cast<int>(from), static_cast<int>(to));
+            std::rotate(m_devs.begin() + to, m_devs.begin() + from, m_devs.begin() + from + 1);
+            emit devMoved(m_devs[toIndex], static_cast<int>(from), static_cast<int>(to));
+        },
+        [this, &previousObjects](std::size_t index, const ConfigItem &item) {
+            if (previousObjects.value(item.id) == item.object) {
+                return false;
+            }
+            auto &dev = m_devs[index];
+            readDevConfig(dev, item.object, item.id == m_myId);
+            emit devConfigChanged(dev, static_cast<int>(index));
+            return true;
+        });
+}
+
+/*!
+ * \brief Reads the config of a single directory from \a dirObj into \a dir.
+ * \remarks The runtime state of \a dir (status, statistics, …) is not touched.
+ */
+void SyncthingConnection::readDirConfig(SyncthingDir &dir, const QJsonObject &dirObj, const QHash<QString, const SyncthingDev *> &devsById) const
+{
+    dir.label = dirObj.value(QLatin1String("label")).toString();
+    dir.path = dirObj.value(QLatin1String("path")).toString();
+    dir.deviceIds.clear();
+    dir.deviceNames.clear();
+    const auto devices = dirObj.value(QLatin1String("devices")).toArray();
+    for (const auto devObj : devices) {
+        const auto devId = devObj.toObject().value(QLatin1String("deviceID")).toString();
+        if (devId.isEmpty() || devId == m_myId) {
+            continue;
+        }
+        dir.deviceIds << devId;
+        if (const auto *const dev = devsById.value(devId)) {
+            dir.deviceNames << dev->name;
+        }
+    }
+    dir.assignDirType(dirObj.value(QLatin1String("type")).toString());
+    dir.rescanInterval = dirObj.value(QLatin1String("rescanIntervalS")).toInt(-1);
+    dir.ignorePermissions = dirObj.value(QLatin1String("ignorePerms")).toBool(false);
+    dir.ignoreDelete = dirObj.value(QLatin1String("ignoreDelete")).toBool(false);
+    dir.autoNormalize = dirObj.value(QLatin1String("autoNormalize")).toBool(false);
+    dir.minDiskFreePercentage = dirObj.value(QLatin1String("minDiskFreePct")).toInt(-1);
+    dir.paused = dirObj.value(QLatin1String("paused")).toBool(dir.paused);
+    dir.fileSystemWatcherEnabled = dirObj.value(QLatin1String("fsWatcherEnabled")).toBool(false);
+    dir.fileSystemWatcherDelay = dirObj.value(QLatin1String("fsWatcherDelayS")).toDouble(0.0);
+}
+
+/*!
+ * \brief Reads the config of a single device from \a devObj into \a dev.
+ * \remarks The status of \a dev is not touched.
+ */
+void SyncthingConnection::readDevConfig(SyncthingDev &dev, const QJsonObject &devObj, bool isThisDevice) const
+{
+    dev.name = devObj.value(QLatin1String("name")).toString();
+    dev.addresses = things(devObj.value(QLatin1String("addresses")).toArray(), [](const QJsonValue &value) { return value.toString(); });
+    dev.compression = devObj.value(QLatin1String("compression")).toString();
+    dev.certName = devObj.value(QLatin1String("certName")).toString();
+    dev.introducer = devObj.value(QLatin1String("introducer")).toBool(false);
+    if (!isThisDevice) {
+        dev.paused = devObj.value(QLatin1String("paused")).toBool(dev.paused);
+    }
+}
+
 /*!
  * \brief Reads directory results of requestConfig(); called by readConfig().
  * \remarks
@@ -749,41 +1116,27 @@ void SyncthingConnection::readDirs(const QJsonArray &dirs)
     auto newDirs = std::vector<SyncthingDir>();
     newDirs.reserve(static_cast<std::size_t>(dirs.size()));
 
-    auto index = int();
+    // index previous dirs and devs by ID to avoid linear lookups for each dir
+    auto previousDirs = QHash<QString, SyncthingDir *>();
+    previousDirs.reserve(static_cast<int>(m_dirs.size()));
+    for (auto &dir : m_dirs) {
+        previousDirs.insert(dir.id, &dir);
+    }
+    auto devsById = QHash<QString, const SyncthingDev *>();
+    devsById.reserve(static_cast<int>(m_devs.size()));
+    for (const auto &dev : m_devs) {
+        devsById.insert(dev.id, &dev);
+    }
+
     for (const auto &dirVal : dirs) {
         const auto dirObj = dirVal.toObject();
-        auto *const dirItem = addDirInfo(newDirs, dirObj.value(QLatin1String("id")).toString());
-        if (!dirItem) {
-            continue;
-        }
-
-        dirItem->label = dirObj.value(QLatin1String("label")).toString();
-        dirItem->path = dirObj.value(QLatin1String("path")).toString();
-        dirItem->deviceIds.clear();
-        dirItem->deviceNames.clear();
-        const auto devices = dirObj.value(QLatin1String("devices")).toArray();
-        for (const auto devObj : devices) {
-            const auto devId = devObj.toObject().value(QLatin1String("deviceID")).toString();
-            if (devId.isEmpty() || devId == m_myId) {
-                continue;
-            }
-            dirItem->deviceIds << devId;
-            if (const SyncthingDev *const dev = findDevInfo(devId, index)) {
-                dirItem->deviceNames << dev->name;
-            }
+        if (auto *const dirItem = addDirInfo(newDirs, previousDirs, dirObj.value(QLatin1String("id")).toString())) {
+            readDirConfig(*dirItem, dirObj, devsById);
         }
-        dirItem->assignDirType(dirObj.value(QLatin1String("type")).toString());
-        dirItem->rescanInterval = dirObj.value(QLatin1String("rescanIntervalS")).toInt(-1);
-        dirItem->ignorePermissions = dirObj.value(QLatin1String("ignorePerms")).toBool(false);
-        dirItem->ignoreDelete = dirObj.value(QLatin1String("ignoreDelete")).toBool(false);
-        dirItem->autoNormalize = dirObj.value(QLatin1String("autoNormalize")).toBool(false);
-        dirItem->minDiskFreePercentage = dirObj.value(QLatin1String("minDiskFreePct")).toInt(-1);
-        dirItem->paused = dirObj.value(QLatin1String("paused")).toBool(dirItem->paused);
-        dirItem->fileSystemWatcherEnabled = dirObj.value(QLatin1String("fsWatcherEnabled")).toBool(false);
-        dirItem->fileSystemWatcherDelay = dirObj.value(QLatin1String("fsWatcherDelayS")).toDouble(0.0);
     }
 
     m_dirs.swap(newDirs);
+    recomputeOverallDirStatistics();
     emit this->newDirs(m_dirs);
     m_hasOutOfSyncDirs.reset();
 }
@@ -796,7 +1149,15 @@ void SyncthingConnection::readDevs(const QJsonArray &devs)
     // store the new devs in a temporary list which is assigned to m_devs later
     auto newDevs = std::vector<SyncthingDev>();
     newDevs.reserve(static_cast<std::size_t>(devs.size()));
-    auto *const thisDevice = addDevInfo(newDevs, m_myId);
+
+    // index previous devs by ID to avoid linear lookups for each dev
+    auto previousDevs = QHash<QString, SyncthingDev *>();
+    previousDevs.reserve(static_cast<int>(m_devs.size()));
+    for (auto &dev : m_devs) {
+        previousDevs.insert(dev.id, &dev);
+    }
+
+    auto *const thisDevice = addDevInfo(newDevs, previousDevs, m_myId);
     if (thisDevice) { // m_myId might be empty, then thisDevice will be nullptr
         thisDevice->id = m_myId;
         thisDevice->status = SyncthingDevStatus::ThisDevice;
@@ -807,19 +1168,13 @@ void SyncthingConnection::readDevs(const QJsonArray &devs)
         const auto devObj = devVal.toObject();
         const auto deviceId = devObj.value(QLatin1String("deviceID")).toString();
         const auto isThisDevice = deviceId == m_myId;
-        auto *const devItem = isThisDevice ? thisDevice : addDevInfo(newDevs, deviceId);
+        auto *const devItem = isThisDevice ? thisDevice : addDevInfo(newDevs, previousDevs, deviceId);
         if (!devItem) {
             continue;
         }
-
-        devItem->name = devObj.value(QLatin1String("name")).toString();
-        devItem->addresses = things(devObj.value(QLatin1String("addresses")).toArray(), [](const QJsonValue &value) { return value.toString(); });
-        devItem->compression = devObj.value(QLatin1String("compression")).toString();
-        devItem->certName = devObj.value(QLatin1String("certName")).toString();
-        devItem->introducer = devObj.value(QLatin1String("introducer")).toBool(false);
+        readDevConfig(*devItem, devObj, isThisDevice);
         if (!isThisDevice) {
             devItem->status = SyncthingDevStatus::Unknown;
-            devItem->paused = devObj.value(QLatin1String("paused")).toBool(devItem->paused);
         }
     }
 
@@ -1000,8 +1355,10 @@ void SyncthingConnection::readConnections()
         // since there seems no event for this data, keep polling
         if (m_keepPolling) {
             concludeConnection(statusRecomputationFlags);
-            if ((m_pollingFlags && PollingFlags::TrafficStatistics) && m_trafficPollTimer.interval()) {
-                m_trafficPollTimer.start();
+            if (m_pollingFlags && PollingFlags::TrafficStatistics) {
+                // poll less frequently when there is no traffic at the moment
+                m_pollingScheduler->reportActivity(m_trafficPollTask, m_totalIncomingRate > 0.0 || m_totalOutgoingRate > 0.0);
+                m_pollingScheduler->start(m_trafficPollTask);
             }
         }
 
@@ -1080,8 +1437,8 @@ void SyncthingConnection::readErrors()
         //       we can avoid a status recomputation here.
         if (m_keepPolling) {
             concludeConnection(StatusRecomputation::None);
-            if ((m_pollingFlags && PollingFlags::Errors) && m_errorsPollTimer.interval()) {
-                m_errorsPollTimer.start();
+            if (m_pollingFlags && PollingFlags::Errors) {
+                m_pollingScheduler->start(m_errorsPollTask);
             }
         }
         break;
@@ -1118,57 +1475,56 @@ void SyncthingConnection::readDirStatistics()
     }
 
     switch (reply->error()) {
-    case QNetworkReply::NoError: {
-        auto jsonError = QJsonParseError();
-        const auto replyDoc = QJsonDocument::fromJson(response, &jsonError);
-        if (jsonError.error != QJsonParseError::NoError) {
-            emitError(tr("Unable to parse folder statistics: "), jsonError, reply, response);
-            return;
-        }
+    case QNetworkReply::NoError:
+        m_jsonDecoder->decode(response, &parseJson,
+            [this, request = reply->request(), response = response, eventId = reply->property("lastEventId").toULongLong()](ParsedJson &&parsed) {
+                if (parsed.error.error != QJsonParseError::NoError) {
+                    emitError(tr("Unable to parse folder statistics: "), parsed.error, request, response);
+                    return;
+                }
 
-        const auto replyObj = replyDoc.object();
-        auto index = int();
-        for (SyncthingDir &dirInfo : m_dirs) {
-            const QJsonObject dirObj(replyObj.value(dirInfo.id).toObject());
-            if (dirObj.isEmpty()) {
-                ++index;
-                continue;
-            }
+                const auto replyObj = parsed.doc.object();
+                auto index = int();
+                for (SyncthingDir &dirInfo : m_dirs) {
+                    const QJsonObject dirObj(replyObj.value(dirInfo.id).toObject());
+                    if (dirObj.isEmpty()) {
+                        ++index;
+                        continue;
+                    }
 
-            auto dirModified = false;
-            const auto eventId = reply->property("lastEventId").toULongLong();
-            const auto lastScan = dirObj.value(QLatin1String("lastScan")).toString().toUtf8();
-            if (!lastScan.isEmpty()) {
-                dirModified = true;
-                dirInfo.lastScanTime = parseTimeStamp(dirObj.value(QLatin1String("lastScan")), QStringLiteral("last scan"));
-            }
-            const auto lastFileObj = dirObj.value(QLatin1String("lastFile")).toObject();
-            if (!lastFileObj.isEmpty()) {
-                dirInfo.lastFileEvent = eventId;
-                dirInfo.lastFileName = lastFileObj.value(QLatin1String("filename")).toString();
-                dirModified = true;
-                if (!dirInfo.lastFileName.isEmpty()) {
-                    dirInfo.lastFileDeleted = lastFileObj.value(QLatin1String("deleted")).toBool(false);
-                    dirInfo.lastFileTime = parseTimeStamp(lastFileObj.value(QLatin1String("at")), QStringLiteral("dir statistics"));
-                    if (!dirInfo.lastFileTime.isNull() && eventId >= m_lastFileEvent) {
-                        m_lastFileEvent = eventId;
-                        m_lastFileTime = dirInfo.lastFileTime;
-                        m_lastFileName = dirInfo.lastFileName;
-                        m_lastFileDeleted = dirInfo.lastFileDeleted;
+                    auto dirModified = false;
+                    const auto lastScan = dirObj.value(QLatin1String("lastScan"));
+                    if (!lastScan.toString().isEmpty()) {
+                        dirModified = true;
+                        dirInfo.lastScanTime = parseTimeStamp(lastScan, QStringLiteral("last scan"));
+                    }
+                    const auto lastFileObj = dirObj.value(QLatin1String("lastFile")).toObject();
+                    if (!lastFileObj.isEmpty()) {
+                        dirInfo.lastFileEvent = eventId;
+                        dirInfo.lastFileName = lastFileObj.value(QLatin1String("filename")).toString();
+                        dirModified = true;
+                        if (!dirInfo.lastFileName.isEmpty()) {
+                            dirInfo.lastFileDeleted = lastFileObj.value(QLatin1String("deleted")).toBool(false);
+                            dirInfo.lastFileTime = parseTimeStamp(lastFileObj.value(QLatin1String("at")), QStringLiteral("dir statistics"));
+                            if (!dirInfo.lastFileTime.isNull() && eventId >= m_lastFileEvent) {
+                                m_lastFileEvent = eventId;
+                                m_lastFileTime = dirInfo.lastFileTime;
+                                m_lastFileName = dirInfo.lastFileName;
+                                m_lastFileDeleted = dirInfo.lastFileDeleted;
+                            }
+                        }
+                    }
+                    if (dirModified) {
+                        emit dirStatusChanged(dirInfo, index);
                     }
+                    ++index;
                 }
-            }
-            if (dirModified) {
-                emit dirStatusChanged(dirInfo, index);
-            }
-            ++index;
-        }
 
-        if (m_keepPolling) {
-            concludeConnection(StatusRecomputation::Status);
-        }
+                if (m_keepPolling) {
+                    concludeConnection(StatusRecomputation::Status);
+                }
+            });
         break;
-    }
     case QNetworkReply::OperationCanceledError:
         handleAdditionalRequestCanceled();
         return;
@@ -1427,8 +1783,8 @@ void SyncthingConnection::readDeviceStatistics()
         // since there seems no event for this data, keep polling
         if (m_keepPolling) {
             concludeConnection(StatusRecomputation::None);
-            if ((m_pollingFlags && PollingFlags::DeviceStatistics) && m_devStatsPollTimer.interval()) {
-                m_devStatsPollTimer.start();
+            if (m_pollingFlags && PollingFlags::DeviceStatistics) {
+                m_pollingScheduler->start(m_devStatsPollTask);
             }
         }
         break;
@@ -1533,7 +1889,33 @@ void SyncthingConnection::requestLog()
 }
 
 /*!
- * \brief Reads log entries queried via requestLog().
+ * \brief Requests log entries which are newer than the ones already present in logStore().
+ *
+ * The new entries are appended to logStore() and logEntriesAppended() is emitted on success (unless there are no new
+ * entries); otherwise error() is emitted.
+ *
+ * \remarks
+ * - Only entries newer than SyncthingLogStore::lastTimestamp() are requested (via the "since" parameter) so in contrast
+ *   to requestLog() the whole log is only transferred and converted on the first invocation.
+ * - Does nothing if a request for the log is already pending or its response is still being decoded (as the entries
+ *   would otherwise be requested and appended twice).
+ */
+void SyncthingConnection::requestNewLogEntries()
+{
+    if (m_logReply || m_decodingNewLogEntries) {
+        return;
+    }
+    auto query = QUrlQuery();
+    if (const auto &since = m_logStore.lastTimestamp(); !since.isEmpty()) {
+        query.addQueryItem(QStringLiteral("since"), formatQueryItem(since));
+    }
+    m_logReply = requestData(QStringLiteral("system/log"), query);
+    m_logReply->setProperty("incremental", true);
+    QObject::connect(m_logReply, &QNetworkReply::finished, this, &SyncthingConnection::readLog);
+}
+
+/*!
+ * \brief Reads log entries queried via requestLog() or requestNewLogEntries().
  */
 void SyncthingConnection::readLog()
 {
@@ -1541,26 +1923,47 @@ void SyncthingConnection::readLog()
     if (!reply) {
         return;
     }
+    const auto incremental = reply->property("incremental").toBool();
 
     switch (reply->error()) {
-    case QNetworkReply::NoError: {
-        auto jsonError = QJsonParseError();
-        const auto replyDoc = QJsonDocument::fromJson(response, &jsonError);
-        if (jsonError.error != QJsonParseError::NoError) {
-            emit error(tr("Unable to parse Syncthing log: ") + jsonError.errorString(), SyncthingErrorCategory::Parsing, QNetworkReply::NoError);
-            return;
-        }
-
-        const QJsonArray log(replyDoc.object().value(QLatin1String("messages")).toArray());
-        vector<SyncthingLogEntry> logEntries;
-        logEntries.reserve(static_cast<size_t>(log.size()));
-        for (const QJsonValue &logVal : log) {
-            const QJsonObject logObj(logVal.toObject());
-            logEntries.emplace_back(logObj.value(QLatin1String("when")).toString(), logObj.value(QLatin1String("message")).toString());
-        }
-        emit logAvailable(logEntries);
+    case QNetworkReply::NoError:
+        // keep new log entries from being requested again until the entries of this response have been appended
+        if (incremental) {
+            m_decodingNewLogEntries = true;
+        }
+        m_jsonDecoder->decode(
+            response,
+            [](const QByteArray &data) {
+                auto res = std::pair<std::vector<SyncthingLogEntry>, QJsonParseError>();
+                const auto replyDoc = QJsonDocument::fromJson(data, &res.second);
+                if (res.second.error != QJsonParseError::NoError) {
+                    return res;
+                }
+                const QJsonArray log(replyDoc.object().value(QLatin1String("messages")).toArray());
+                res.first.reserve(static_cast<size_t>(log.size()));
+                for (const QJsonValue &logVal : log) {
+                    const QJsonObject logObj(logVal.toObject());
+                    res.first.emplace_back(logObj.value(QLatin1String("when")).toString(), logObj.value(QLatin1String("message")).toString());
+                }
+                return res;
+            },
+            [this, incremental](std::pair<std::vector<SyncthingLogEntry>, QJsonParseError> &&res) {
+                if (incremental) {
+                    m_decodingNewLogEntries = false;
+                }
+                if (res.second.error != QJsonParseError::NoError) {
+                    emit error(tr("Unable to parse Syncthing log: ") + res.second.errorString(), SyncthingErrorCategory::Parsing, QNetworkReply::NoError);
+                    return;
+                }
+                if (!incremental) {
+                    emit logAvailable(res.first);
+                    return;
+                }
+                if (const auto [beginIndex, endIndex] = m_logStore.append(std::move(res.first)); beginIndex != endIndex) {
+                    emit logEntriesAppended(beginIndex, endIndex);
+                }
+            });
         break;
-    }
     case QNetworkReply::OperationCanceledError:
         break;
     default:
@@ -1641,7 +2044,8 @@ SyncthingConnection::QueryResult SyncthingConnection::requestJsonData(const QByt
     const QByteArray &data, std::function<void(QJsonDocument &&, QString &&)> &&callback, bool rest, bool longPolling)
 {
 #if !defined(LIB_SYNCTHING_CONNECTOR_CONNECTION_MOCKED) && !defined(LIB_SYNCTHING_CONNECTOR_MOCKED)
-    auto *const reply = networkAccessManager().sendCustomRequest(prepareRequest(path, query, rest, longPolling), verb, data);
+    auto *const reply = m_replyReplayer ? m_replyReplayer->replyFor(verb, prepareRequest(path, query, rest, longPolling).url(), longPolling)
+                                        : networkAccessManager().sendCustomRequest(prepareRequest(path, query, rest, longPolling), verb, data);
 #ifndef QT_NO_SSL
     QObject::connect(reply, &QNetworkReply::sslErrors, this, &SyncthingConnection::handleSslErrors);
 #endif
@@ -1687,6 +2091,49 @@ SyncthingConnection::QueryResult SyncthingConnection::browse(const QString &dirI
             [this, id = dirId, l = levels, cb = std::move(callback)]() mutable { readBrowse(id, l, std::move(cb)); }, Qt::QueuedConnection) };
 }
 
+/*!
+ * \brief Lists items in the directory with the specified \a dirId like browse() but reports items incrementally.
+ * \remarks
+ * - The response is parsed while it is received (see SyncthingBrowseParser) and top-level items are passed to \a callback in
+ *   batches of up to \a batchSize items as soon as they are available. The SyncthingItem::index of the items is relative to the
+ *   whole response so batches can simply be appended.
+ * - The second parameter of \a callback is true for the last invocation which happens once the response has been received
+ *   completely. In case of an error, the last invocation has a non-empty error message as third parameter (and possibly
+ *   no items). Items passed before the error remain valid.
+ * - To cancel the request, abort or delete the returned reply. Merely disconnecting the returned connection would only
+ *   prevent the final invocation of \a callback.
+ */
+SyncthingConnection::QueryResult SyncthingConnection::browseIncrementally(const QString &dirId, const QString &prefix, int levels,
+    std::function<void(std::vector<std::unique_ptr<SyncthingItem>> &&, bool, QString &&)> &&callback, std::size_t batchSize)
+{
+    auto query = QUrlQuery();
+    query.addQueryItem(QStringLiteral("folder"), formatQueryItem(dirId));
+    if (!prefix.isEmpty()) {
+        query.addQueryItem(QStringLiteral("prefix"), formatQueryItem(prefix));
+    }
+    if (levels > 0) {
+        query.addQueryItem(QStringLiteral("levels"), QString::number(levels));
+    }
+    auto *const reply = requestData(QStringLiteral("db/browse"), query);
+    auto parser = std::make_shared<SyncthingBrowseParser>(levels);
+    auto sharedCallback = std::make_shared<std::function<void(std::vector<std::unique_ptr<SyncthingItem>> &&, bool, QString &&)>>(std::move(callback));
+    // keep the raw response only if it is needed for recording/logging as it is otherwise consumed while parsing
+    const auto keepRawResponse = m_replyRecorder || (m_loggingFlags && SyncthingConnectionLoggingFlags::ApiReplies);
+    auto rawResponse = keepRawResponse ? std::make_shared<QByteArray>() : std::shared_ptr<QByteArray>();
+    QObject::connect(reply, &QNetworkReply::readyRead, this, [this, reply, parser, rawResponse, batchSize, sharedCallback] {
+        if (reply->error() == QNetworkReply::NoError) {
+            readBrowseChunk(reply, *parser, rawResponse.get(), batchSize, *sharedCallback);
+        }
+    });
+    return { reply,
+        QObject::connect(
+            reply, &QNetworkReply::finished, this,
+            [this, id = dirId, parser = std::move(parser), rawResponse = std::move(rawResponse), cb = std::move(sharedCallback)]() mutable {
+                readBrowseIncrementally(id, *parser, rawResponse.get(), std::move(*cb));
+            },
+            Qt::QueuedConnection) };
+}
+
 /*!
  * \brief Queries the contents of ".stignore" and expansions of the directory with the specified \a dirId.
  * \sa https://docs.syncthing.net/rest/db-ignores-get.html
@@ -1734,58 +2181,29 @@ SyncthingConnection::QueryResult SyncthingConnection::setIgnores(
             Qt::QueuedConnection) };
 }
 
-/// \cond
-static void readSyncthingItems(const QJsonArray &array, std::vector<std::unique_ptr<SyncthingItem>> &into, int level, int levels)
+/*!
+ * \brief Queries the page \a page (1-based) of pull errors of the directory with the specified \a dirId.
+ * \sa https://docs.syncthing.net/rest/folder-errors-get.html
+ * \remarks
+ * - In contrast to requestDirPullErrors(), this function does not alter the SyncthingDir::itemErrors of the directory but
+ *   reports the errors of the requested page via \a callback. This allows showing huge lists of pull errors without loading
+ *   them completely (see SyncthingPullErrorModel).
+ * - Errors are still reported via the error() signal. In case of an error \a callback is invoked with a non-empty string
+ *   containing the error message.
+ */
+SyncthingConnection::QueryResult SyncthingConnection::pullErrors(
+    const QString &dirId, int page, int perPage, std::function<void(std::vector<SyncthingItemError> &&, QString &&)> &&callback)
 {
-    into.reserve(static_cast<std::size_t>(array.size()));
-    for (const auto &jsonItem : array) {
-        if (!jsonItem.isObject()) {
-            continue;
-        }
-        const auto jsonItemObj = jsonItem.toObject();
-        const auto typeValue = jsonItemObj.value(QLatin1String("type"));
-        const auto index = into.size();
-        const auto children = jsonItemObj.value(QLatin1String("children"));
-        auto &item = into.emplace_back(std::make_unique<SyncthingItem>());
-        item->name = jsonItemObj.value(QLatin1String("name")).toString();
-        item->modificationTime = CppUtilities::DateTime::fromIsoStringGmt(jsonItemObj.value(QLatin1String("modTime")).toString().toUtf8().data());
-        item->size = static_cast<std::size_t>(jsonItemObj
-                .value(QLatin1String("size"))
-#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
-                .toInteger()
-#else
-                .toDouble()
-#endif
-        );
-        item->index = index;
-        item->level = level;
-        switch (typeValue.toInt(-1)) {
-        case 0:
-            item->type = SyncthingItemType::File;
-            break;
-        case 1:
-            item->type = SyncthingItemType::Directory;
-            break;
-        case 2:
-        case 3:
-        case 4:
-            item->type = SyncthingItemType::Symlink;
-            break;
-        default:
-            const auto type = typeValue.toString();
-            if (type == QLatin1String("FILE_INFO_TYPE_FILE")) {
-                item->type = SyncthingItemType::File;
-            } else if (type == QLatin1String("FILE_INFO_TYPE_DIRECTORY")) {
-                item->type = SyncthingItemType::Directory;
-            } else if (type == QLatin1String("FILE_INFO_TYPE_SYMLINK")) {
-                item->type = SyncthingItemType::Symlink;
-            }
-        }
-        readSyncthingItems(children.toArray(), item->children, level + 1, levels);
-        item->childrenPopulated = !levels || level < levels;
-    }
+    auto query = QUrlQuery();
+    query.addQueryItem(QStringLiteral("folder"), formatQueryItem(dirId));
+    query.addQueryItem(QStringLiteral("page"), QString::number(page));
+    query.addQueryItem(QStringLiteral("perpage"), QString::number(perPage));
+    auto *const reply = requestData(folderErrorsPath(), query);
+    return { reply,
+        QObject::connect(
+            reply, &QNetworkReply::finished, this,
+            [this, id = dirId, page, cb = std::move(callback)]() mutable { readPullErrors(id, page, std::move(cb)); }, Qt::QueuedConnection) };
 }
-/// \endcond
 
 /*!
  * \brief Reads the response of requestJsonData() and reports results via the specified \a callback. Emits error() in case of an error.
@@ -1836,20 +2254,97 @@ void SyncthingConnection::readBrowse(
     }
     auto items = std::vector<std::unique_ptr<SyncthingItem>>();
     switch (reply->error()) {
+    case QNetworkReply::NoError:
+        m_jsonDecoder->decode(
+            response,
+            [levels](const QByteArray &data) {
+                auto res = std::pair<std::vector<std::unique_ptr<SyncthingItem>>, QJsonParseError>();
+                const auto replyDoc = QJsonDocument::fromJson(data, &res.second);
+                if (res.second.error == QJsonParseError::NoError) {
+                    SyncthingBrowseParser::readItems(replyDoc.array(), res.first, 0, levels);
+                }
+                return res;
+            },
+            [this, dirId, cb = std::move(callback)](std::pair<std::vector<std::unique_ptr<SyncthingItem>>, QJsonParseError> &&res) {
+                if (res.second.error != QJsonParseError::NoError) {
+                    auto errorMessage = tr("Unable to parse response for browsing \"%1\": ").arg(dirId) + res.second.errorString();
+                    emit error(errorMessage, SyncthingErrorCategory::Parsing, QNetworkReply::NoError);
+                    if (cb) {
+                        cb(std::move(res.first), std::move(errorMessage));
+                    }
+                    return;
+                }
+                if (cb) {
+                    cb(std::move(res.first), QString());
+                }
+            });
+        break;
+    default:
+        auto errorMessage = tr("Unable to browse \"%1\": ").arg(dirId) + reply->errorString();
+        emitError(errorMessage, reply);
+        if (callback) {
+            callback(std::move(items), std::move(errorMessage));
+        }
+    }
+}
+
+/*!
+ * \brief Feeds data available from the \a reply of browseIncrementally() into the \a parser and passes parsed items to \a callback.
+ * \remarks The data is also appended to \a rawResponse unless it is nullptr.
+ */
+void SyncthingConnection::readBrowseChunk(QNetworkReply *reply, SyncthingBrowseParser &parser, QByteArray *rawResponse, std::size_t batchSize,
+    const std::function<void(std::vector<std::unique_ptr<SyncthingItem>> &&, bool, QString &&)> &callback)
+{
+    // read in chunks so only up to batchSize items need to be buffered at a time
+    static constexpr auto chunkSize = qint64(64 * 1024);
+    for (auto chunk = reply->read(chunkSize); !chunk.isEmpty(); chunk = reply->read(chunkSize)) {
+        if (rawResponse) {
+            rawResponse->append(chunk);
+        }
+        parser.feed(chunk);
+        if (parser.pendingItemCount() >= batchSize && callback) {
+            callback(parser.takeItems(), false, QString());
+        }
+    }
+    if (parser.pendingItemCount() && callback) {
+        callback(parser.takeItems(), false, QString());
+    }
+}
+
+/*!
+ * \brief Reads the remaining response of browseIncrementally() and reports the last batch via the specified \a callback. Emits
+ *        error() in case of an error.
+ * \remarks The data read so far is passed to handleReply() via \a rawResponse (if not nullptr) so the whole response is
+ *          recorded and logged.
+ */
+void SyncthingConnection::readBrowseIncrementally(const QString &dirId, SyncthingBrowseParser &parser, QByteArray *rawResponse,
+    std::function<void(std::vector<std::unique_ptr<SyncthingItem>> &&, bool, QString &&)> &&callback)
+{
+    auto *const reply = static_cast<QNetworkReply *>(sender());
+    if (reply->error() == QNetworkReply::NoError && reply->isOpen()) {
+        // read remaining data before handleReply() might consume it for logging
+        const auto remainingData = reply->readAll();
+        if (rawResponse) {
+            rawResponse->append(remainingData);
+        }
+        parser.feed(remainingData);
+    }
+    if (!handleReply(reply, false, true, rawResponse ? std::move(*rawResponse) : QByteArray()).reply) {
+        return;
+    }
+    switch (reply->error()) {
     case QNetworkReply::NoError: {
-        auto jsonError = QJsonParseError();
-        const auto replyDoc = QJsonDocument::fromJson(response, &jsonError);
-        if (jsonError.error != QJsonParseError::NoError) {
-            auto errorMessage = tr("Unable to parse response for browsing \"%1\": ").arg(dirId) + jsonError.errorString();
+        parser.finish();
+        if (parser.hasError()) {
+            auto errorMessage = tr("Unable to parse response for browsing \"%1\": ").arg(dirId) + parser.errorString();
             emit error(errorMessage, SyncthingErrorCategory::Parsing, QNetworkReply::NoError);
             if (callback) {
-                callback(std::move(items), std::move(errorMessage));
+                callback(parser.takeItems(), true, std::move(errorMessage));
             }
             return;
         }
-        readSyncthingItems(replyDoc.array(), items, 0, levels);
         if (callback) {
-            callback(std::move(items), QString());
+            callback(parser.takeItems(), true, QString());
         }
         break;
     }
@@ -1857,7 +2352,7 @@ void SyncthingConnection::readBrowse(
         auto errorMessage = tr("Unable to browse \"%1\": ").arg(dirId) + reply->errorString();
         emitError(errorMessage, reply);
         if (callback) {
-            callback(std::move(items), std::move(errorMessage));
+            callback(parser.takeItems(), true, std::move(errorMessage));
         }
     }
 }
@@ -1874,38 +2369,104 @@ void SyncthingConnection::readIgnores(const QString &dirId, std::function<void(S
     }
     auto res = SyncthingIgnores();
     switch (reply->error()) {
-    case QNetworkReply::NoError: {
-        auto jsonError = QJsonParseError();
-        const auto replyDoc = QJsonDocument::fromJson(response, &jsonError);
-        if (jsonError.error != QJsonParseError::NoError) {
-            auto errorMessage = tr("Unable to query ignore patterns of \"%1\": ").arg(dirId) + jsonError.errorString();
-            emit error(errorMessage, SyncthingErrorCategory::Parsing, QNetworkReply::NoError);
-            if (callback) {
-                callback(std::move(res), std::move(errorMessage));
-            }
-            return;
-        }
-        const auto docObj = replyDoc.object();
-        const auto ignores = docObj.value(QLatin1String("ignore")).toArray();
-        const auto expanded = docObj.value(QLatin1String("expanded")).toArray();
-        res.ignore.reserve(ignores.size());
-        res.expanded.reserve(expanded.size());
-        for (const auto &ignore : ignores) {
-            res.ignore.append(ignore.toString());
-        }
-        for (const auto &expand : expanded) {
-            res.expanded.append(expand.toString());
+    case QNetworkReply::NoError:
+        m_jsonDecoder->decode(
+            response,
+            [](const QByteArray &data) {
+                auto res = std::pair<SyncthingIgnores, QJsonParseError>();
+                const auto replyDoc = QJsonDocument::fromJson(data, &res.second);
+                if (res.second.error != QJsonParseError::NoError) {
+                    return res;
+                }
+                const auto docObj = replyDoc.object();
+                const auto ignores = docObj.value(QLatin1String("ignore")).toArray();
+                const auto expanded = docObj.value(QLatin1String("expanded")).toArray();
+                res.first.ignore.reserve(ignores.size());
+                res.first.expanded.reserve(expanded.size());
+                for (const auto &ignore : ignores) {
+                    res.first.ignore.append(ignore.toString());
+                }
+                for (const auto &expand : expanded) {
+                    res.first.expanded.append(expand.toString());
+                }
+                return res;
+            },
+            [this, dirId, cb = std::move(callback)](std::pair<SyncthingIgnores, QJsonParseError> &&res) {
+                if (res.second.error != QJsonParseError::NoError) {
+                    auto errorMessage = tr("Unable to query ignore patterns of \"%1\": ").arg(dirId) + res.second.errorString();
+                    emit error(errorMessage, SyncthingErrorCategory::Parsing, QNetworkReply::NoError);
+                    if (cb) {
+                        cb(SyncthingIgnores(), std::move(errorMessage));
+                    }
+                    return;
+                }
+                if (cb) {
+                    cb(std::move(res.first), QString());
+                }
+            });
+        break;
+    default:
+        auto errorMessage = tr("Unable to query ignore patterns of \"%1\": ").arg(dirId) + reply->errorString();
+        emitError(errorMessage, reply);
+        if (callback) {
+            callback(std::move(res), std::move(errorMessage));
         }
+    }
+}
+
+/*!
+ * \brief Reads the response of pullErrors() and reports results via the specified \a callback. Emits error() in case of an error.
+ * \remarks The \a callback is also emitted in the error case (with the error message as second parameter and an empty list of items).
+ */
+void SyncthingConnection::readPullErrors(
+    const QString &dirId, int page, std::function<void(std::vector<SyncthingItemError> &&, QString &&)> &&callback)
+{
+    auto const [reply, response] = prepareReply();
+    if (!reply) {
+        return;
+    }
+    switch (reply->error()) {
+    case QNetworkReply::NoError:
+        m_jsonDecoder->decode(
+            response,
+            [](const QByteArray &data) {
+                auto res = std::pair<std::vector<SyncthingItemError>, QJsonParseError>();
+                const auto replyDoc = QJsonDocument::fromJson(data, &res.second);
+                if (res.second.error != QJsonParseError::NoError) {
+                    return res;
+                }
+                const auto errors = replyDoc.object().value(QLatin1String("errors")).toArray();
+                res.first.reserve(static_cast<std::size_t>(errors.size()));
+                for (const auto &errorVal : errors) {
+                    const auto error = errorVal.toObject();
+                    res.first.emplace_back(error.value(QLatin1String("error")).toString(), error.value(QLatin1String("path")).toString());
+                }
+                return res;
+            },
+            [this, dirId, page, cb = std::move(callback)](std::pair<std::vector<SyncthingItemError>, QJsonParseError> &&res) {
+                if (res.second.error != QJsonParseError::NoError) {
+                    auto errorMessage = tr("Unable to parse page %1 of pull errors for folder %2: ").arg(page).arg(dirId) + res.second.errorString();
+                    emit error(errorMessage, SyncthingErrorCategory::Parsing, QNetworkReply::NoError);
+                    if (cb) {
+                        cb(std::vector<SyncthingItemError>(), std::move(errorMessage));
+                    }
+                    return;
+                }
+                if (cb) {
+                    cb(std::move(res.first), QString());
+                }
+            });
+        break;
+    case QNetworkReply::OperationCanceledError:
         if (callback) {
-            callback(std::move(res), QString());
+            callback(std::vector<SyncthingItemError>(), tr("Request for pull errors has been canceled."));
         }
         break;
-    }
     default:
-        auto errorMessage = tr("Unable to query ignore patterns of \"%1\": ").arg(dirId) + reply->errorString();
+        auto errorMessage = tr("Unable to request page %1 of pull errors for folder %2: ").arg(page).arg(dirId) + reply->errorString();
         emitError(errorMessage, reply);
         if (callback) {
-            callback(std::move(res), std::move(errorMessage));
+            callback(std::vector<SyncthingItemError>(), std::move(errorMessage));
         }
     }
 }
@@ -1975,6 +2536,58 @@ SyncthingConnection::QueryResult SyncthingConnection::postConfigFromByteArray(co
             Qt::QueuedConnection) };
 }
 
+/*!
+ * \brief Applies the specified \a patch via Syncthing's per-object config endpoints.
+ * \remarks
+ * - The requests of \a patch are sent one after another. If a request fails, error() is emitted and the remaining
+ *   requests are not sent anymore. Once all requests have succeeded, newConfigTriggered() is emitted.
+ * - The \a callback is invoked in any case (with an error message in the error case).
+ * - If SyncthingConfigPatch::requiresFullConfig is set, the changes which cannot be applied via the per-object
+ *   endpoints are not submitted; use postConfigFromJsonObject() in that case.
+ * - Not supported when using deprecated routes.
+ */
+void SyncthingConnection::postConfigPatch(const SyncthingConfigPatch &patch, std::function<void(QString &&)> &&callback)
+{
+    postConfigPatchRequests(std::make_shared<const std::vector<SyncthingConfigRequest>>(patch.requests), 0, std::move(callback));
+}
+
+/*!
+ * \brief Sends the request at \a index of \a requests and continues with the next one once it has succeeded.
+ */
+void SyncthingConnection::postConfigPatchRequests(
+    std::shared_ptr<const std::vector<SyncthingConfigRequest>> requests, std::size_t index, std::function<void(QString &&)> &&callback)
+{
+    if (index >= requests->size()) {
+        emit newConfigTriggered();
+        if (callback) {
+            callback(QString());
+        }
+        return;
+    }
+    const auto &request = (*requests)[index];
+    const auto data = request.body.isObject() ? QJsonDocument(request.body.toObject()).toJson(QJsonDocument::Compact)
+        : request.body.isArray()              ? QJsonDocument(request.body.toArray()).toJson(QJsonDocument::Compact)
+                                              : QByteArray();
+    auto *const reply = sendData(request.verb, request.path, QUrlQuery(), data);
+    QObject::connect(
+        reply, &QNetworkReply::finished, this,
+        [this, requests = std::move(requests), index, cb = std::move(callback)]() mutable {
+            auto const [reply, response] = prepareReply(false, false);
+            if (reply->error() != QNetworkReply::NoError) {
+                const auto &failedRequest = (*requests)[index];
+                auto errorMessage = tr("Unable to post config change (%1 %2): ").arg(QString::fromLatin1(failedRequest.verb), failedRequest.path)
+                    + reply->errorString();
+                emitError(errorMessage, SyncthingErrorCategory::SpecificRequest, reply);
+                if (cb) {
+                    cb(std::move(errorMessage));
+                }
+                return;
+            }
+            postConfigPatchRequests(std::move(requests), index + 1, std::move(cb));
+        },
+        Qt::QueuedConnection);
+}
+
 /*!
  * \brief Reads data from postConfigFromJsonObject() and postConfigFromByteArray().
  */
@@ -2016,7 +2629,8 @@ void SyncthingConnection::readDirSummary(SyncthingEventId eventId, DateTime even
     const auto previouslyGlobal = globalStats;
     const auto previouslyNeeded = !neededStats.isNull();
 
-    // update statistics
+    // update statistics (and overall statistics by the difference)
+    m_overallDirStats.subtract(dir);
     globalStats.bytes = jsonValueToInt(summary.value(QLatin1String("globalBytes")));
     globalStats.deletes = jsonValueToInt(summary.value(QLatin1String("globalDeleted")));
     globalStats.files = jsonValueToInt(summary.value(QLatin1String("globalFiles")));
@@ -2041,6 +2655,7 @@ void SyncthingConnection::readDirSummary(SyncthingEventId eventId, DateTime even
     receiveOnlyStats.dirs = jsonValueToInt(summary.value(QLatin1String("receiveOnlyChangedDirectories")));
     receiveOnlyStats.symlinks = jsonValueToInt(summary.value(QLatin1String("receiveOnlyChangedSymlinks")));
     receiveOnlyStats.total = jsonValueToInt(summary.value(QLatin1String("receiveOnlyTotalItems")));
+    m_overallDirStats.add(dir);
     dir.pullErrorCount = jsonValueToInt(summary.value(QLatin1String("pullErrors")));
     m_statusRecomputationFlags += StatusRecomputation::DirStats;
 
@@ -2112,7 +2727,7 @@ void SyncthingConnection::readDevRejected(DateTime eventTime, const QString &dev
 /*!
  * \brief Reads "LocalChangeDetected" and "RemoveChangeDetected" events from requestEvents() and requestDiskEvents().
  */
-void SyncthingConnection::readChangeEvent(DateTime eventTime, const QString &eventType, const QJsonObject &eventData)
+void SyncthingConnection::readChangeEvent(DateTime eventTime, SyncthingEventType eventType, const QJsonObject &eventData)
 {
     // read ID via "folder" with fallback to "folderID" (which is deprecated since version v1.1.2)
     auto index = int();
@@ -2122,7 +2737,7 @@ void SyncthingConnection::readChangeEvent(DateTime eventTime, const QString &eve
     }
 
     auto change = SyncthingFileChange();
-    change.local = eventType.startsWith("Local");
+    change.local = eventType == SyncthingEventType::LocalChangeDetected;
     change.eventTime = eventTime;
     change.action = eventData.value(QLatin1String("action")).toString();
     change.type = eventData.value(QLatin1String("type")).toString();
@@ -2139,6 +2754,49 @@ void SyncthingConnection::readChangeEvent(DateTime eventTime, const QString &eve
 
 // events / long polling API
 
+/*!
+ * \brief Returns how each event type is handled (indexed by SyncthingEventType; unhandled types have no handler).
+ * \remarks
+ * - This is the single place to register event types. The event masks of requestEvents() and requestDiskEvents() as well
+ *   as the dispatching in readEventsFromJsonArray() are derived from it.
+ * - An event type is only requested if the polling flag it requires is set. Types requiring PollingFlags::DiskEvents are
+ *   requested via requestDiskEvents().
+ */
+constexpr std::array<SyncthingConnection::EventHandling, syncthingEventTypeCount> SyncthingConnection::eventHandling()
+{
+    using Handler = decltype(EventHandling::handler);
+    using T = SyncthingEventType;
+    auto handling = std::array<EventHandling, syncthingEventTypeCount>{};
+    const auto set = [&handling](std::initializer_list<T> types, PollingFlags requiredFlag, Handler handler) {
+        for (const auto type : types) {
+            handling[static_cast<std::size_t>(type)] = EventHandling{ requiredFlag, handler };
+        }
+    };
+    set({ T::Starting }, PollingFlags::None,
+        [](SyncthingConnection &c, SyncthingEventId, DateTime, T, const QJsonObject &data) { c.readStartingEvent(data); });
+    set({ T::StateChanged }, PollingFlags::None, [](SyncthingConnection &c, SyncthingEventId id, DateTime time, T, const QJsonObject &data) {
+        c.readStatusChangedEvent(id, time, data);
+    });
+    set({ T::FolderRejected, T::FolderErrors, T::FolderSummary, T::FolderCompletion, T::FolderScanProgress, T::FolderPaused, T::FolderResumed },
+        PollingFlags::None,
+        [](SyncthingConnection &c, SyncthingEventId id, DateTime time, T type, const QJsonObject &data) { c.readDirEvent(id, time, type, data); });
+    set({ T::DeviceRejected, T::DeviceConnected, T::DeviceDisconnected, T::DevicePaused, T::DeviceResumed }, PollingFlags::None,
+        [](SyncthingConnection &c, SyncthingEventId id, DateTime time, T type, const QJsonObject &data) { c.readDeviceEvent(id, time, type, data); });
+    set({ T::ConfigSaved }, PollingFlags::None,
+        [](SyncthingConnection &c, SyncthingEventId, DateTime, T, const QJsonObject &) { c.requestConfig(); });
+    set({ T::LocalIndexUpdated }, PollingFlags::None,
+        [](SyncthingConnection &c, SyncthingEventId, DateTime, T, const QJsonObject &) { c.requestDirStatistics(); });
+    set({ T::DownloadProgress }, PollingFlags::DownloadProgress,
+        [](SyncthingConnection &c, SyncthingEventId, DateTime, T, const QJsonObject &data) { c.readDownloadProgressEvent(data); });
+    set({ T::RemoteIndexUpdated }, PollingFlags::RemoteIndexUpdated,
+        [](SyncthingConnection &c, SyncthingEventId id, DateTime, T, const QJsonObject &data) { c.readRemoteIndexUpdated(id, data); });
+    set({ T::ItemFinished }, PollingFlags::ItemFinished,
+        [](SyncthingConnection &c, SyncthingEventId id, DateTime time, T, const QJsonObject &data) { c.readItemFinished(id, time, data); });
+    set({ T::LocalChangeDetected, T::RemoteChangeDetected }, PollingFlags::DiskEvents,
+        [](SyncthingConnection &c, SyncthingEventId, DateTime time, T type, const QJsonObject &data) { c.readChangeEvent(time, type, data); });
+    return handling;
+}
+
 /*!
  * \brief Requests the Syncthing events (since the last successful call) asynchronously.
  * \remarks
@@ -2152,17 +2810,17 @@ void SyncthingConnection::requestEvents()
         return;
     }
     if (m_eventMask.isEmpty()) {
-        m_eventMask = QStringLiteral("Starting,StateChanged,FolderRejected,FolderErrors,FolderSummary,FolderCompletion,"
-                                     "FolderScanProgress,FolderPaused,FolderResumed,DeviceRejected,DeviceConnected,"
-                                     "DeviceDisconnected,DevicePaused,DeviceResumed,ConfigSaved,LocalIndexUpdated");
-        if (m_pollingFlags && PollingFlags::DownloadProgress) {
-            m_eventMask += QStringLiteral(",DownloadProgress");
-        }
-        if (m_pollingFlags && PollingFlags::RemoteIndexUpdated) {
-            m_eventMask += QStringLiteral(",RemoteIndexUpdated");
-        }
-        if (m_pollingFlags && PollingFlags::ItemFinished) {
-            m_eventMask += QStringLiteral(",ItemFinished");
+        // compose mask from the event types readEventsFromJsonArray() handles (except disk events requested via requestDiskEvents())
+        static constexpr auto handling = eventHandling();
+        for (auto i = std::size_t(); i != handling.size(); ++i) {
+            const auto requiredFlag = handling[i].requiredFlag;
+            if (handling[i].handler && requiredFlag != PollingFlags::DiskEvents
+                && (requiredFlag == PollingFlags::None || (m_pollingFlags && requiredFlag))) {
+                if (!m_eventMask.isEmpty()) {
+                    m_eventMask += QChar(',');
+                }
+                m_eventMask += syncthingEventTypeLatin1Name(static_cast<SyncthingEventType>(i));
+            }
         }
 
         // reset/restore event ID as each mask creates its own stream of IDs
@@ -2203,44 +2861,44 @@ void SyncthingConnection::readEvents()
         m_statusRecomputationFlags += StatusRecomputation::OutOfSyncDirs;
     }
     switch (reply->error()) {
-    case QNetworkReply::NoError: {
-        auto jsonError = QJsonParseError();
-        const auto replyDoc = QJsonDocument::fromJson(response, &jsonError);
-        if (jsonError.error != QJsonParseError::NoError) {
-            emitError(tr("Unable to parse Syncthing events: "), jsonError, reply, response);
-            handleFatalConnectionError();
-            return;
-        }
+    case QNetworkReply::NoError:
+        m_jsonDecoder->decode(response, &parseJson, [this, request = reply->request(), response = response](ParsedJson &&parsed) {
+            if (parsed.error.error != QJsonParseError::NoError) {
+                emitError(tr("Unable to parse Syncthing events: "), parsed.error, request, response);
+                handleFatalConnectionError();
+                return;
+            }
 
-        m_hasEvents = true;
-        const auto replyArray = replyDoc.array();
-        emit newEvents(replyArray);
-        const auto res = readEventsFromJsonArray(replyArray, m_lastEventId);
-        emit allEventsProcessed();
-
-        // request further statistics only *after* receiving the first event (and not in continueConnecting())
-        // note: We avoid requesting the whole event history. So we rely on these statistics to tell the initial state. When the
-        //       state of e.g. a directory changes before we receive the first event we would miss that state change if statistics
-        //       were requested in continueConnecting().
-        if (!m_statsRequested) {
-            requestConnections();
-            requestDirStatistics();
-            requestDeviceStatistics();
-            for (const SyncthingDir &dir : m_dirs) {
-                requestDirStatus(dir.id);
+            m_hasEvents = true;
+            const auto replyArray = parsed.doc.array();
+            emit newEvents(replyArray);
+            const auto res = readEventsFromJsonArray(replyArray, m_lastEventId);
+            emit allEventsProcessed();
+
+            // request further statistics only *after* receiving the first event (and not in continueConnecting())
+            // note: We avoid requesting the whole event history. So we rely on these statistics to tell the initial state. When the
+            //       state of e.g. a directory changes before we receive the first event we would miss that state change if statistics
+            //       were requested in continueConnecting().
+            if (!m_statsRequested) {
+                requestConnections();
+                requestDirStatistics();
+                requestDeviceStatistics();
+                for (const SyncthingDir &dir : m_dirs) {
+                    requestDirStatus(dir.id);
+                }
             }
-        }
 
-        if (!res) {
-            return;
-        }
+            if (!res) {
+                return;
+            }
 
-        if (!replyArray.isEmpty() && (loggingFlags() && SyncthingConnectionLoggingFlags::Events)) {
-            const auto log = replyDoc.toJson(QJsonDocument::Indented);
-            cerr << Phrases::Info << "Received " << replyArray.size() << " Syncthing events:" << Phrases::End << log.data() << endl;
-        }
-        break;
-    }
+            if (!replyArray.isEmpty() && (loggingFlags() && SyncthingConnectionLoggingFlags::Events)) {
+                const auto log = parsed.doc.toJson(QJsonDocument::Indented);
+                cerr << Phrases::Info << "Received " << replyArray.size() << " Syncthing events:" << Phrases::End << log.data() << endl;
+            }
+            continueReadingEvents();
+        });
+        return;
     case QNetworkReply::TimeoutError:
         // no new events available, keep polling
         break;
@@ -2254,7 +2912,14 @@ void SyncthingConnection::readEvents()
         handleFatalConnectionError();
         return;
     }
+    continueReadingEvents();
+}
 
+/*!
+ * \brief Requests further events (if still polling) after events have been read via readEvents().
+ */
+void SyncthingConnection::continueReadingEvents()
+{
     if (m_keepPolling) {
         requestEvents();
         concludeConnection(StatusRecomputation::None);
@@ -2264,15 +2929,28 @@ void SyncthingConnection::readEvents()
 }
 
 /*!
- * \brief Reads results of requestEvents().
+ * \brief Reads results of requestEvents() and requestDiskEvents().
+ * \remarks The event type is looked up via syncthingEventType() and events are dispatched via a table of handlers indexed
+ *          by the type. The number of events per type is counted (see eventCounts()).
  */
 bool SyncthingConnection::readEventsFromJsonArray(const QJsonArray &events, quint64 &idVariable)
 {
+    static constexpr auto handling = eventHandling();
+    static constexpr auto handlesAllEventTypes = [] {
+        for (auto i = std::size_t(1); i != handling.size(); ++i) {
+            if (!handling[i].handler) {
+                return false;
+            }
+        }
+        return true;
+    }();
+    static_assert(handlesAllEventTypes, "every event type (except SyncthingEventType::Unknown) needs a handler in eventHandling()");
+
     const auto lastId = idVariable;
     for (const auto &eventVal : events) {
         const auto event = eventVal.toObject();
         const auto eventTime = parseTimeStamp(event.value(QLatin1String("time")), QStringLiteral("event time"));
-        const auto eventType = event.value(QLatin1String("type")).toString();
+        const auto eventType = syncthingEventType(event.value(QLatin1String("type")).toString());
         const auto eventData = event.value(QLatin1String("data")).toObject();
         const auto eventIdValue = event.value(QLatin1String("id"));
         const auto eventId = static_cast<quint64>(std::max(eventIdValue.toDouble(), 0.0));
@@ -2292,26 +2970,9 @@ bool SyncthingConnection::readEventsFromJsonArray(const QJsonArray &events, quin
                 idVariable = eventId;
             }
         }
-        if (eventType == QLatin1String("Starting")) {
-            readStartingEvent(eventData);
-        } else if (eventType == QLatin1String("StateChanged")) {
-            readStatusChangedEvent(eventId, eventTime, eventData);
-        } else if (eventType == QLatin1String("DownloadProgress")) {
-            readDownloadProgressEvent(eventData);
-        } else if (eventType.startsWith(QLatin1String("Folder"))) {
-            readDirEvent(eventId, eventTime, eventType, eventData);
-        } else if (eventType.startsWith(QLatin1String("Device"))) {
-            readDeviceEvent(eventId, eventTime, eventType, eventData);
-        } else if (eventType == QLatin1String("ConfigSaved")) {
-            requestConfig();
-        } else if (eventType.endsWith(QLatin1String("ChangeDetected"))) {
-            readChangeEvent(eventTime, eventType, eventData);
-        } else if (eventType == QLatin1String("LocalIndexUpdated")) {
-            requestDirStatistics();
-        } else if (eventType == QLatin1String("RemoteIndexUpdated")) {
-            readRemoteIndexUpdated(eventId, eventData);
-        } else if (eventType == QLatin1String("ItemFinished")) {
-            readItemFinished(eventId, eventTime, eventData);
+        ++m_eventCounts[static_cast<std::size_t>(eventType)];
+        if (const auto handler = handling[static_cast<std::size_t>(eventType)].handler) {
+            handler(*this, eventId, eventTime, eventType, eventData);
         }
     }
     return true;
@@ -2425,7 +3086,7 @@ void SyncthingConnection::readDownloadProgressEvent(const QJsonObject &eventData
 /*!
  * \brief Reads results of requestEvents().
  */
-void SyncthingConnection::readDirEvent(SyncthingEventId eventId, DateTime eventTime, const QString &eventType, const QJsonObject &eventData)
+void SyncthingConnection::readDirEvent(SyncthingEventId eventId, DateTime eventTime, SyncthingEventType eventType, const QJsonObject &eventData)
 {
     // read dir ID
     const auto dirId = [&eventData] {
@@ -2437,14 +3098,14 @@ void SyncthingConnection::readDirEvent(SyncthingEventId eventId, DateTime eventT
     }();
     if (dirId.isEmpty()) {
         // handle events which don't necessarily require a corresponding dir info
-        if (eventType == QLatin1String("FolderCompletion")) {
+        if (eventType == SyncthingEventType::FolderCompletion) {
             readFolderCompletion(eventId, eventTime, eventData, dirId, nullptr, -1);
         }
         return;
     }
 
     // handle "FolderRejected"-event which is a bit special because here the dir ID is supposed to be unknown
-    if (eventType == QLatin1String("FolderRejected")) {
+    if (eventType == SyncthingEventType::FolderRejected) {
         readDirRejected(eventTime, dirId, eventData);
         return;
     }
@@ -2459,13 +3120,17 @@ void SyncthingConnection::readDirEvent(SyncthingEventId eventId, DateTime eventT
     // distinguish specific events, keep track of status changes
     const auto previousStatus = dirInfo->status;
     const auto wasOutOfSync = dirInfo->isOutOfSync();
-    if (eventType == QLatin1String("FolderErrors")) {
+    switch (eventType) {
+    case SyncthingEventType::FolderErrors:
         readFolderErrors(eventId, eventTime, eventData, *dirInfo, index);
-    } else if (eventType == QLatin1String("FolderSummary")) {
+        break;
+    case SyncthingEventType::FolderSummary:
         readDirSummary(eventId, eventTime, eventData.value(QLatin1String("summary")).toObject(), *dirInfo, index);
-    } else if (eventType == QLatin1String("FolderCompletion")) {
+        break;
+    case SyncthingEventType::FolderCompletion:
         readFolderCompletion(eventId, eventTime, eventData, dirId, dirInfo, index);
-    } else if (eventType == QLatin1String("FolderScanProgress")) {
+        break;
+    case SyncthingEventType::FolderScanProgress: {
         const auto current = eventData.value(QLatin1String("current")).toDouble(0);
         const auto total = eventData.value(QLatin1String("total")).toDouble(0);
         const auto rate = eventData.value(QLatin1String("rate")).toDouble(0);
@@ -2475,16 +3140,21 @@ void SyncthingConnection::readDirEvent(SyncthingEventId eventId, DateTime eventT
             dirInfo->assignStatus(SyncthingDirStatus::Scanning, eventId, eventTime); // ensure state is scanning
             emit dirStatusChanged(*dirInfo, index);
         }
-    } else if (eventType == QLatin1String("FolderPaused")) {
+        break;
+    }
+    case SyncthingEventType::FolderPaused:
         if (!dirInfo->paused) {
             dirInfo->paused = true;
             emit dirStatusChanged(*dirInfo, index);
         }
-    } else if (eventType == QLatin1String("FolderResumed")) {
+        break;
+    case SyncthingEventType::FolderResumed:
         if (dirInfo->paused) {
             dirInfo->paused = false;
             emit dirStatusChanged(*dirInfo, index);
         }
+        break;
+    default:;
     }
     if (previousStatus != dirInfo->status) {
         m_statusRecomputationFlags += StatusRecomputation::Status;
@@ -2497,7 +3167,7 @@ void SyncthingConnection::readDirEvent(SyncthingEventId eventId, DateTime eventT
 /*!
  * \brief Reads results of requestEvents().
  */
-void SyncthingConnection::readDeviceEvent(SyncthingEventId eventId, DateTime eventTime, const QString &eventType, const QJsonObject &eventData)
+void SyncthingConnection::readDeviceEvent(SyncthingEventId eventId, DateTime eventTime, SyncthingEventType eventType, const QJsonObject &eventData)
 {
     // ignore device events happened before the last connections update
     if (eventId < m_lastConnectionsUpdateEvent) {
@@ -2515,7 +3185,7 @@ void SyncthingConnection::readDeviceEvent(SyncthingEventId eventId, DateTime eve
     }
 
     // handle "DeviceRejected"-event
-    if (eventType == QLatin1String("DeviceRejected")) {
+    if (eventType == SyncthingEventType::DeviceRejected) {
         readDevRejected(eventTime, devId, eventData);
         return;
     }
@@ -2531,17 +3201,22 @@ void SyncthingConnection::readDeviceEvent(SyncthingEventId eventId, DateTime eve
     auto status = devInfo->status;
     auto paused = devInfo->paused;
     auto disconnectReason = devInfo->disconnectReason;
-    if (eventType == QLatin1String("DeviceConnected")) {
+    switch (eventType) {
+    case SyncthingEventType::DeviceConnected:
         status = devInfo->computeConnectedStateAccordingToCompletion();
         disconnectReason.clear();
-    } else if (eventType == QLatin1String("DeviceDisconnected")) {
+        break;
+    case SyncthingEventType::DeviceDisconnected:
         status = SyncthingDevStatus::Disconnected;
         disconnectReason = eventData.value(QLatin1String("error")).toString();
-    } else if (eventType == QLatin1String("DevicePaused")) {
+        break;
+    case SyncthingEventType::DevicePaused:
         paused = true;
-    } else if (eventType == QLatin1String("DeviceResumed")) {
+        break;
+    case SyncthingEventType::DeviceResumed:
         paused = false;
-    } else {
+        break;
+    default:
         return;
     }
 
@@ -2684,11 +3359,13 @@ void SyncthingConnection::readLocalFolderCompletion(
     const auto previouslyUpdated = !dirInfo.lastStatisticsUpdateTime.isNull();
     const auto previouslyNeeded = !neededStats.isNull();
     const auto previouslyGlobal = globalStats;
-    // read values from event data
+    // read values from event data (and adjust overall statistics by the difference)
+    m_overallDirStats.subtract(dirInfo);
     globalStats.bytes = jsonValueToInt(eventData.value(QLatin1String("globalBytes")), static_cast<double>(globalStats.bytes));
     neededStats.bytes = jsonValueToInt(eventData.value(QLatin1String("needBytes")), static_cast<double>(neededStats.bytes));
     neededStats.deletes = jsonValueToInt(eventData.value(QLatin1String("needDeletes")), static_cast<double>(neededStats.deletes));
     neededStats.total = jsonValueToInt(eventData.value(QLatin1String("needItems")), static_cast<double>(neededStats.files));
+    m_overallDirStats.add(dirInfo);
     dirInfo.lastStatisticsUpdateEvent = eventId;
     dirInfo.lastStatisticsUpdateTime = eventTime;
     dirInfo.completionPercentage = globalStats.bytes ? static_cast<int>((globalStats.bytes - neededStats.bytes) * 100 / globalStats.bytes) : 100;
@@ -2738,16 +3415,28 @@ void SyncthingConnection::readRemoteFolderCompletion(const SyncthingCompletion &
         }
     }
     // update dev info
+    // note: The overall completion is adjusted by the difference to the previous completion of the folder so it does not need
+    //       to be recomputed from all folders. The status change is only signalled if the overall completion or the status
+    //       has actually changed as otherwise nothing visible has changed (e.g. when an unchanged completion is reported
+    //       for one of many folders shared with the device).
     if (devInfo) {
         auto &previousCompletion = devInfo->completionByDir[dirId];
-        devInfo->overallCompletion -= previousCompletion;
-        devInfo->overallCompletion += completion;
-        devInfo->overallCompletion.recomputePercentage();
+        auto &overallCompletion = devInfo->overallCompletion;
+        const auto previousOverallNeeded = overallCompletion.needed;
+        const auto previousOverallGlobalBytes = overallCompletion.globalBytes;
+        const auto previousStatus = devInfo->status;
+        const auto previouslyUpdated = !overallCompletion.lastUpdate.isNull();
+        overallCompletion -= previousCompletion;
+        overallCompletion += completion;
+        overallCompletion.recomputePercentage();
         previousCompletion = completion;
         if (devInfo->isConnected()) {
             devInfo->setConnectedStateAccordingToCompletion();
         }
-        emit devStatusChanged(*devInfo, devIndex);
+        if (!previouslyUpdated || overallCompletion.needed != previousOverallNeeded || overallCompletion.globalBytes != previousOverallGlobalBytes
+            || devInfo->status != previousStatus) {
+            emit devStatusChanged(*devInfo, devIndex);
+        }
         m_statusRecomputationFlags += StatusRecomputation::RemoteCompletion;
     }
 }
@@ -2819,7 +3508,17 @@ void SyncthingConnection::requestDiskEvents(int limit)
     }
     auto query = QUrlQuery();
     query.addQueryItem(QStringLiteral("limit"), QString::number(limit));
-    query.addQueryItem(QStringLiteral("events"), QStringLiteral("LocalChangeDetected,RemoteChangeDetected"));
+    static constexpr auto handling = eventHandling();
+    auto eventMask = QString();
+    for (auto i = std::size_t(); i != handling.size(); ++i) {
+        if (handling[i].handler && handling[i].requiredFlag == PollingFlags::DiskEvents) {
+            if (!eventMask.isEmpty()) {
+                eventMask += QChar(',');
+            }
+            eventMask += syncthingEventTypeLatin1Name(static_cast<SyncthingEventType>(i));
+        }
+    }
+    query.addQueryItem(QStringLiteral("events"), eventMask);
     if (m_lastDiskEventId && m_hasDiskEvents) {
         query.addQueryItem(QStringLiteral("since"), QString::number(m_lastDiskEventId));
     }
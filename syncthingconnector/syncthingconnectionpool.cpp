@@ -0,0 +1,258 @@
+#include "./syncthingconnectionpool.h"
+#include "./syncthingconnectionsettings.h"
+
+#include <algorithm>
+
+using namespace std;
+using namespace CppUtilities;
+
+namespace Data {
+
+/*!
+ * \class SyncthingConnectionPool
+ * \brief The SyncthingConnectionPool class runs multiple SyncthingConnection instances concurrently, e.g. to monitor many Syncthing nodes at once.
+ *
+ * All connections use the same QNetworkAccessManager (see networkAccessManager()) and share one SyncthingPollingScheduler
+ * so timer-based requests of all nodes are run within the same wakeups. The slot duration of the shared scheduler is increased
+ * to defaultSlotDuration so the number of wakeups does not grow with the number of nodes.
+ *
+ * Changes of individual connections are not forwarded immediately. Instead, affected nodes are only flagged as dirty and
+ * processed in batches every updateInterval() milliseconds. Then nodesChanged() is emitted once for the range of affected
+ * nodes and statisticsChanged() is emitted with the statistics aggregated over all nodes.
+ */
+
+/*!
+ * \brief Constructs an empty pool.
+ */
+SyncthingConnectionPool::SyncthingConnectionPool(QObject *parent)
+    : QObject(parent)
+    , m_pollingFlags(SyncthingConnection::PollingFlags::MainEvents | SyncthingConnection::PollingFlags::Errors
+          | SyncthingConnection::PollingFlags::TrafficStatistics)
+{
+    m_scheduler.setSlotDuration(defaultSlotDuration);
+    m_updateTimer.setInterval(defaultUpdateInterval);
+    m_updateTimer.setTimerType(Qt::CoarseTimer);
+    m_updateTimer.setSingleShot(true);
+    QObject::connect(&m_updateTimer, &QTimer::timeout, this, &SyncthingConnectionPool::flushChanges);
+}
+
+/*!
+ * \brief Destroys the pool and all its connections.
+ */
+SyncthingConnectionPool::~SyncthingConnectionPool()
+{
+    m_nodes.clear();
+}
+
+/*!
+ * \brief Returns the index of the specified \a connection or -1 if it is not part of the pool.
+ */
+int SyncthingConnectionPool::indexOf(const SyncthingConnection *connection) const
+{
+    const auto i = std::find_if(m_nodes.cbegin(), m_nodes.cend(), [connection](const auto &node) { return node->connection.get() == connection; });
+    return i != m_nodes.cend() ? static_cast<int>(i - m_nodes.cbegin()) : -1;
+}
+
+/*!
+ * \brief Sets the polling flags applied to all connections of the pool.
+ * \remarks Defaults to main events, errors and traffic statistics which is sufficient for populating an overview.
+ */
+void SyncthingConnectionPool::setPollingFlags(SyncthingConnection::PollingFlags pollingFlags)
+{
+    m_pollingFlags = pollingFlags;
+    for (auto &node : m_nodes) {
+        node->connection->setPollingFlags(pollingFlags);
+    }
+}
+
+/*!
+ * \brief Adds a new connection configured via the specified \a settings to the pool and returns its index.
+ * \remarks The connection is established immediately if SyncthingConnectionSettings::autoConnect is enabled.
+ */
+int SyncthingConnectionPool::addConnection(SyncthingConnectionSettings &settings)
+{
+    const auto index = connectionCount();
+    emit connectionAboutToBeAdded(index);
+
+    auto &node = *m_nodes.emplace_back(std::make_unique<SyncthingConnectionPoolNode>());
+    node.label = settings.label.isEmpty() ? settings.syncthingUrl : settings.label;
+    node.connection = std::make_unique<SyncthingConnection>();
+    auto *const connection = node.connection.get();
+    connection->setPollingScheduler(&m_scheduler);
+    connection->setPollingFlags(m_pollingFlags);
+    connection->applySettings(settings);
+
+    // flag the node as dirty on relevant changes; the actual update happens in flushChanges()
+    auto *const nodePtr = &node;
+    const auto markNodeDirty = [this, nodePtr] { markDirty(*nodePtr); };
+    QObject::connect(connection, &SyncthingConnection::statusChanged, this, markNodeDirty);
+    QObject::connect(connection, &SyncthingConnection::trafficChanged, this, markNodeDirty);
+    QObject::connect(connection, &SyncthingConnection::dirStatisticsChanged, this, markNodeDirty);
+    QObject::connect(connection, &SyncthingConnection::devCompletionChanged, this, markNodeDirty);
+    QObject::connect(connection, &SyncthingConnection::hasOutOfSyncDirsChanged, this, markNodeDirty);
+    QObject::connect(connection, &SyncthingConnection::newConfigApplied, this, markNodeDirty);
+
+    emit connectionAdded(index);
+    emit connectionCountChanged(connectionCount());
+    markDirty(node);
+    if (settings.autoConnect) {
+        connection->reconnect();
+    }
+    return index;
+}
+
+/*!
+ * \brief Removes the connection at the specified \a index from the pool.
+ */
+void SyncthingConnectionPool::removeConnection(int index)
+{
+    if (!node(index)) {
+        return;
+    }
+    emit connectionAboutToBeRemoved(index);
+    m_nodes.erase(m_nodes.begin() + index);
+    emit connectionRemoved(index);
+    emit connectionCountChanged(connectionCount());
+    recomputeStatistics();
+}
+
+/*!
+ * \brief Replaces all connections with new ones configured via the specified \a settings.
+ */
+void SyncthingConnectionPool::setConnections(std::vector<SyncthingConnectionSettings> &settings)
+{
+    clear();
+    m_nodes.reserve(settings.size());
+    for (auto &connectionSettings : settings) {
+        addConnection(connectionSettings);
+    }
+}
+
+/*!
+ * \brief Removes all connections from the pool.
+ */
+void SyncthingConnectionPool::clear()
+{
+    for (auto index = connectionCount() - 1; index >= 0; --index) {
+        removeConnection(index);
+    }
+}
+
+/*!
+ * \brief Connects all connections of the pool.
+ */
+void SyncthingConnectionPool::connectAll()
+{
+    for (auto &node : m_nodes) {
+        node->connection->connect();
+    }
+}
+
+/*!
+ * \brief Disconnects all connections of the pool.
+ */
+void SyncthingConnectionPool::disconnectAll()
+{
+    for (auto &node : m_nodes) {
+        node->connection->disconnect();
+    }
+}
+
+/*!
+ * \brief Reconnects all connections of the pool.
+ */
+void SyncthingConnectionPool::reconnectAll()
+{
+    for (auto &node : m_nodes) {
+        node->connection->reconnect();
+    }
+}
+
+/*!
+ * \brief Updates all dirty nodes, emits nodesChanged() for the affected range and re-computes the aggregated statistics.
+ */
+void SyncthingConnectionPool::flushChanges()
+{
+    auto first = -1, last = -1, index = 0;
+    for (auto &node : m_nodes) {
+        if (node->dirty) {
+            updateNode(*node);
+            if (first < 0) {
+                first = index;
+            }
+            last = index;
+        }
+        ++index;
+    }
+    if (first >= 0) {
+        emit nodesChanged(first, last);
+    }
+    recomputeStatistics();
+}
+
+/// \cond
+
+void SyncthingConnectionPool::markDirty(SyncthingConnectionPoolNode &node)
+{
+    node.dirty = true;
+    if (!m_updateTimer.isActive()) {
+        m_updateTimer.start();
+    }
+}
+
+void SyncthingConnectionPool::updateNode(SyncthingConnectionPoolNode &node)
+{
+    const auto &connection = *node.connection;
+    node.dirStatistics = connection.overallDirStatistics();
+    node.remoteCompletion = connection.computeOverallRemoteCompletion();
+    node.localCompletion = node.dirStatistics.global.bytes
+        ? static_cast<double>(node.dirStatistics.global.bytes - std::min(node.dirStatistics.needed.bytes, node.dirStatistics.global.bytes)) * 100.0
+            / static_cast<double>(node.dirStatistics.global.bytes)
+        : 100.0;
+    node.dirty = false;
+}
+
+void SyncthingConnectionPool::recomputeStatistics()
+{
+    auto statistics = SyncthingConnectionPoolStatistics();
+    auto remoteGlobalBytes = quint64(), remoteNeededBytes = quint64();
+    statistics.nodeCount = connectionCount();
+    for (const auto &node : m_nodes) {
+        const auto &connection = *node->connection;
+        if (!connection.isConnected()) {
+            continue;
+        }
+        ++statistics.connectedNodes;
+        if (connection.status() == SyncthingStatus::Synchronizing) {
+            ++statistics.synchronizingNodes;
+        }
+        if (connection.hasOutOfSyncDirs()) {
+            ++statistics.outOfSyncNodes;
+        }
+        statistics.global += node->dirStatistics.global;
+        statistics.needed += node->dirStatistics.needed;
+        remoteGlobalBytes += node->remoteCompletion.globalBytes;
+        remoteNeededBytes += node->remoteCompletion.needed.bytes;
+        if (connection.totalIncomingTraffic() != SyncthingConnection::unknownTraffic) {
+            statistics.totalIncomingTraffic += connection.totalIncomingTraffic();
+        }
+        if (connection.totalOutgoingTraffic() != SyncthingConnection::unknownTraffic) {
+            statistics.totalOutgoingTraffic += connection.totalOutgoingTraffic();
+        }
+        statistics.totalIncomingRate += connection.totalIncomingRate();
+        statistics.totalOutgoingRate += connection.totalOutgoingRate();
+    }
+    statistics.localCompletion = statistics.global.bytes
+        ? static_cast<double>(statistics.global.bytes - std::min(statistics.needed.bytes, statistics.global.bytes)) * 100.0
+            / static_cast<double>(statistics.global.bytes)
+        : 100.0;
+    statistics.remoteCompletion = remoteGlobalBytes
+        ? static_cast<double>(remoteGlobalBytes - std::min(remoteNeededBytes, remoteGlobalBytes)) * 100.0 / static_cast<double>(remoteGlobalBytes)
+        : 100.0;
+    m_statistics = statistics;
+    emit statisticsChanged(m_statistics);
+}
+
+/// \endcond
+
+} // namespace Data
@@ -0,0 +1,196 @@
+#ifndef DATA_SYNCTHINGCONNECTIONPOOL_H
+#define DATA_SYNCTHINGCONNECTIONPOOL_H
+
+#include "./syncthingconnection.h"
+#include "./syncthingpollingscheduler.h"
+
+#include <QObject>
+#include <QTimer>
+
+#include <memory>
+#include <vector>
+
+namespace Data {
+
+struct SyncthingConnectionSettings;
+
+/*!
+ * \brief The SyncthingConnectionPoolNode struct holds a connection of a SyncthingConnectionPool and its cached statistics.
+ */
+struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingConnectionPoolNode {
+    QString label;
+    std::unique_ptr<SyncthingConnection> connection;
+    SyncthingOverallDirStatistics dirStatistics;
+    SyncthingCompletion remoteCompletion;
+    double localCompletion = 0.0;
+    bool dirty = false;
+};
+
+/*!
+ * \brief The SyncthingConnectionPoolStatistics struct holds statistics aggregated over all connections of a SyncthingConnectionPool.
+ */
+struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingConnectionPoolStatistics {
+    Q_GADGET
+    Q_PROPERTY(int nodeCount MEMBER nodeCount)
+    Q_PROPERTY(int connectedNodes MEMBER connectedNodes)
+    Q_PROPERTY(int synchronizingNodes MEMBER synchronizingNodes)
+    Q_PROPERTY(int outOfSyncNodes MEMBER outOfSyncNodes)
+    Q_PROPERTY(double localCompletion MEMBER localCompletion)
+    Q_PROPERTY(double remoteCompletion MEMBER remoteCompletion)
+    Q_PROPERTY(double totalIncomingRate MEMBER totalIncomingRate)
+    Q_PROPERTY(double totalOutgoingRate MEMBER totalOutgoingRate)
+
+public:
+    int nodeCount = 0;
+    int connectedNodes = 0;
+    int synchronizingNodes = 0;
+    int outOfSyncNodes = 0;
+    SyncthingStatistics global;
+    SyncthingStatistics needed;
+    double localCompletion = 0.0;
+    double remoteCompletion = 0.0;
+    quint64 totalIncomingTraffic = 0;
+    quint64 totalOutgoingTraffic = 0;
+    double totalIncomingRate = 0.0;
+    double totalOutgoingRate = 0.0;
+};
+
+class LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingConnectionPool : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(int connectionCount READ connectionCount NOTIFY connectionCountChanged)
+    Q_PROPERTY(Data::SyncthingConnectionPoolStatistics statistics READ statistics NOTIFY statisticsChanged)
+    Q_PROPERTY(int updateInterval READ updateInterval WRITE setUpdateInterval)
+
+public:
+    explicit SyncthingConnectionPool(QObject *parent = nullptr);
+    ~SyncthingConnectionPool() override;
+
+    static constexpr int defaultSlotDuration = 2000;
+    static constexpr int defaultUpdateInterval = 500;
+
+    int connectionCount() const;
+    SyncthingConnection *connection(int index) const;
+    const SyncthingConnectionPoolNode *node(int index) const;
+    int indexOf(const SyncthingConnection *connection) const;
+    SyncthingPollingScheduler &pollingScheduler();
+    SyncthingConnection::PollingFlags pollingFlags() const;
+    void setPollingFlags(SyncthingConnection::PollingFlags pollingFlags);
+    int updateInterval() const;
+    void setUpdateInterval(int updateInterval);
+    const SyncthingConnectionPoolStatistics &statistics() const;
+
+    int addConnection(SyncthingConnectionSettings &settings);
+    void removeConnection(int index);
+    void setConnections(std::vector<SyncthingConnectionSettings> &settings);
+    void clear();
+
+public Q_SLOTS:
+    void connectAll();
+    void disconnectAll();
+    void reconnectAll();
+    void setUiVisible(bool uiVisible);
+
+Q_SIGNALS:
+    void connectionAboutToBeAdded(int index);
+    void connectionAdded(int index);
+    void connectionAboutToBeRemoved(int index);
+    void connectionRemoved(int index);
+    void connectionCountChanged(int connectionCount);
+    void nodesChanged(int firstIndex, int lastIndex);
+    void statisticsChanged(const Data::SyncthingConnectionPoolStatistics &statistics);
+
+private Q_SLOTS:
+    void flushChanges();
+
+private:
+    void markDirty(SyncthingConnectionPoolNode &node);
+    void updateNode(SyncthingConnectionPoolNode &node);
+    void recomputeStatistics();
+
+    // note: The scheduler must be declared before the nodes so it outlives the connections using it.
+    SyncthingPollingScheduler m_scheduler;
+    std::vector<std::unique_ptr<SyncthingConnectionPoolNode>> m_nodes;
+    SyncthingConnectionPoolStatistics m_statistics;
+    SyncthingConnection::PollingFlags m_pollingFlags;
+    QTimer m_updateTimer;
+};
+
+/*!
+ * \brief Returns the number of connections in the pool.
+ */
+inline int SyncthingConnectionPool::connectionCount() const
+{
+    return static_cast<int>(m_nodes.size());
+}
+
+/*!
+ * \brief Returns the connection at the specified \a index or nullptr if \a index is out of range.
+ */
+inline SyncthingConnection *SyncthingConnectionPool::connection(int index) const
+{
+    const auto *const n = node(index);
+    return n ? n->connection.get() : nullptr;
+}
+
+/*!
+ * \brief Returns the node at the specified \a index or nullptr if \a index is out of range.
+ */
+inline const SyncthingConnectionPoolNode *SyncthingConnectionPool::node(int index) const
+{
+    return index >= 0 && static_cast<std::size_t>(index) < m_nodes.size() ? m_nodes[static_cast<std::size_t>(index)].get() : nullptr;
+}
+
+/*!
+ * \brief Returns the scheduler shared by all connections of the pool.
+ */
+inline SyncthingPollingScheduler &SyncthingConnectionPool::pollingScheduler()
+{
+    return m_scheduler;
+}
+
+/*!
+ * \brief Returns the polling flags applied to all connections of the pool.
+ */
+inline SyncthingConnection::PollingFlags SyncthingConnectionPool::pollingFlags() const
+{
+    return m_pollingFlags;
+}
+
+/*!
+ * \brief Returns the interval in milliseconds changes of individual connections are batched for.
+ */
+inline int SyncthingConnectionPool::updateInterval() const
+{
+    return m_updateTimer.interval();
+}
+
+/*!
+ * \brief Sets the interval in milliseconds changes of individual connections are batched for.
+ */
+inline void SyncthingConnectionPool::setUpdateInterval(int updateInterval)
+{
+    m_updateTimer.setInterval(updateInterval);
+}
+
+/*!
+ * \brief Returns the statistics aggregated over all connections.
+ * \remarks Updated in batches; see statisticsChanged().
+ */
+inline const SyncthingConnectionPoolStatistics &SyncthingConnectionPool::statistics() const
+{
+    return m_statistics;
+}
+
+/*!
+ * \brief Informs the shared scheduler whether the UI showing the connections is visible.
+ */
+inline void SyncthingConnectionPool::setUiVisible(bool uiVisible)
+{
+    m_scheduler.setUiVisible(uiVisible);
+}
+
+} // namespace Data
+
+Q_DECLARE_METATYPE(Data::SyncthingConnectionPoolStatistics)
+
+#endif // DATA_SYNCTHINGCONNECTIONPOOL_H
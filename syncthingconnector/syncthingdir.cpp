@@ -280,6 +280,17 @@ SyncthingStatistics &SyncthingStatistics::operator+=(const SyncthingStatistics &
     return *this;
 }
 
+SyncthingStatistics &SyncthingStatistics::operator-=(const SyncthingStatistics &other)
+{
+    bytes -= other.bytes;
+    deletes -= other.deletes;
+    dirs -= other.dirs;
+    files -= other.files;
+    symlinks -= other.symlinks;
+    total -= other.total;
+    return *this;
+}
+
 QString Data::SyncthingStatistics::bytesAsString() const
 {
     return QString::fromStdString(CppUtilities::dataSizeToString(bytes));
@@ -291,9 +302,7 @@ QString Data::SyncthingStatistics::bytesAsString() const
 SyncthingOverallDirStatistics::SyncthingOverallDirStatistics(const std::vector<SyncthingDir> &directories)
 {
     for (const auto &dir : directories) {
-        local += dir.localStats;
-        global += dir.globalStats;
-        needed += dir.neededStats;
+        add(dir);
     }
 }
 
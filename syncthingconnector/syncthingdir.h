@@ -110,6 +110,7 @@ public:
     constexpr bool operator==(const SyncthingStatistics &other) const;
     constexpr bool operator!=(const SyncthingStatistics &other) const;
     SyncthingStatistics &operator+=(const SyncthingStatistics &other);
+    SyncthingStatistics &operator-=(const SyncthingStatistics &other);
     QString bytesAsString() const;
 };
 
@@ -247,6 +248,10 @@ public:
     SyncthingStatistics needed;
 
     bool isNull() const;
+    void add(const SyncthingDir &dir);
+    void subtract(const SyncthingDir &dir);
+    bool operator==(const SyncthingOverallDirStatistics &other) const;
+    bool operator!=(const SyncthingOverallDirStatistics &other) const;
 };
 
 inline SyncthingOverallDirStatistics::SyncthingOverallDirStatistics()
@@ -258,6 +263,36 @@ inline bool SyncthingOverallDirStatistics::isNull() const
     return local.isNull() && global.isNull();
 }
 
+/*!
+ * \brief Adds the statistics of the specified \a dir.
+ */
+inline void SyncthingOverallDirStatistics::add(const SyncthingDir &dir)
+{
+    local += dir.localStats;
+    global += dir.globalStats;
+    needed += dir.neededStats;
+}
+
+/*!
+ * \brief Subtracts the statistics of the specified \a dir which must have been added before.
+ */
+inline void SyncthingOverallDirStatistics::subtract(const SyncthingDir &dir)
+{
+    local -= dir.localStats;
+    global -= dir.globalStats;
+    needed -= dir.neededStats;
+}
+
+inline bool SyncthingOverallDirStatistics::operator==(const SyncthingOverallDirStatistics &other) const
+{
+    return local == other.local && global == other.global && needed == other.needed;
+}
+
+inline bool SyncthingOverallDirStatistics::operator!=(const SyncthingOverallDirStatistics &other) const
+{
+    return !(*this == other);
+}
+
 } // namespace Data
 
 Q_DECLARE_METATYPE(Data::SyncthingItemError)
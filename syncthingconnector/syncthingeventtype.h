@@ -0,0 +1,192 @@
+#ifndef DATA_SYNCTHINGEVENTTYPE_H
+#define DATA_SYNCTHINGEVENTTYPE_H
+
+#include <QLatin1String>
+#include <QStringView>
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace Data {
+
+/*!
+ * \brief The SyncthingEventType enum specifies the types of Syncthing events SyncthingConnection handles.
+ * \remarks The names of the types are returned by syncthingEventTypeName() and looked up via syncthingEventType().
+ */
+enum class SyncthingEventType : std::uint8_t {
+    Unknown, /**< an event type SyncthingConnection does not handle */
+    Starting,
+    StateChanged,
+    FolderRejected,
+    FolderErrors,
+    FolderSummary,
+    FolderCompletion,
+    FolderScanProgress,
+    FolderPaused,
+    FolderResumed,
+    DeviceRejected,
+    DeviceConnected,
+    DeviceDisconnected,
+    DevicePaused,
+    DeviceResumed,
+    ConfigSaved,
+    LocalIndexUpdated,
+    DownloadProgress,
+    RemoteIndexUpdated,
+    ItemFinished,
+    LocalChangeDetected,
+    RemoteChangeDetected,
+};
+
+/*!
+ * \brief The number of values of SyncthingEventType (including SyncthingEventType::Unknown).
+ */
+constexpr std::size_t syncthingEventTypeCount = static_cast<std::size_t>(SyncthingEventType::RemoteChangeDetected) + 1;
+
+/*!
+ * \brief The number of events handled by SyncthingConnection per SyncthingEventType.
+ */
+using SyncthingEventCounts = std::array<std::uint64_t, syncthingEventTypeCount>;
+
+/// \cond
+namespace SyncthingEventTypeDetails {
+
+constexpr auto names = std::array<std::string_view, syncthingEventTypeCount>{
+    std::string_view(),
+    "Starting",
+    "StateChanged",
+    "FolderRejected",
+    "FolderErrors",
+    "FolderSummary",
+    "FolderCompletion",
+    "FolderScanProgress",
+    "FolderPaused",
+    "FolderResumed",
+    "DeviceRejected",
+    "DeviceConnected",
+    "DeviceDisconnected",
+    "DevicePaused",
+    "DeviceResumed",
+    "ConfigSaved",
+    "LocalIndexUpdated",
+    "DownloadProgress",
+    "RemoteIndexUpdated",
+    "ItemFinished",
+    "LocalChangeDetected",
+    "RemoteChangeDetected",
+};
+constexpr auto tableBits = 6;
+constexpr auto tableSize = std::size_t(1) << tableBits;
+
+constexpr char16_t codeUnit(char c)
+{
+    return static_cast<unsigned char>(c);
+}
+
+constexpr char16_t codeUnit(QChar c)
+{
+    return c.unicode();
+}
+
+/*!
+ * \brief Returns the FNV-1a hash of \a name using \a seed as offset basis.
+ */
+template <typename String> constexpr std::uint32_t hash(std::uint32_t seed, String name)
+{
+    auto h = seed ^ static_cast<std::uint32_t>(name.size());
+    for (const auto c : name) {
+        h = (h ^ codeUnit(c)) * 16777619u;
+    }
+    return h;
+}
+
+template <typename String> constexpr std::size_t slot(std::uint32_t seed, String name)
+{
+    return hash(seed, name) >> (32 - tableBits);
+}
+
+constexpr bool isPerfect(std::uint32_t seed)
+{
+    auto used = std::array<bool, tableSize>{};
+    for (auto i = std::size_t(1); i != names.size(); ++i) {
+        auto &isUsed = used[slot(seed, names[i])];
+        if (isUsed) {
+            return false;
+        }
+        isUsed = true;
+    }
+    return true;
+}
+
+/*!
+ * \brief Returns the first seed starting from the usual FNV-1a offset basis which maps all names to distinct slots.
+ */
+constexpr std::uint32_t findSeed()
+{
+    auto seed = std::uint32_t(2166136261u);
+    while (!isPerfect(seed)) {
+        ++seed;
+    }
+    return seed;
+}
+
+constexpr auto seed = findSeed();
+
+constexpr std::array<SyncthingEventType, tableSize> makeTable()
+{
+    auto table = std::array<SyncthingEventType, tableSize>{};
+    for (auto i = std::size_t(1); i != names.size(); ++i) {
+        table[slot(seed, names[i])] = static_cast<SyncthingEventType>(i);
+    }
+    return table;
+}
+
+constexpr auto table = makeTable();
+
+} // namespace SyncthingEventTypeDetails
+/// \endcond
+
+/*!
+ * \brief Returns the name Syncthing uses for the specified event \a type or an empty string for SyncthingEventType::Unknown.
+ */
+constexpr std::string_view syncthingEventTypeName(SyncthingEventType type)
+{
+    const auto index = static_cast<std::size_t>(type);
+    return index < syncthingEventTypeCount ? SyncthingEventTypeDetails::names[index] : std::string_view();
+}
+
+/*!
+ * \brief Returns the name Syncthing uses for the specified event \a type as QLatin1String, e.g. for composing event masks.
+ */
+inline QLatin1String syncthingEventTypeLatin1Name(SyncthingEventType type)
+{
+    const auto name = syncthingEventTypeName(type);
+    return QLatin1String(name.data(), static_cast<int>(name.size()));
+}
+
+/*!
+ * \brief Returns the event type for the specified \a name or SyncthingEventType::Unknown if \a name is not known.
+ * \remarks
+ * The names are mapped via a perfect hash table which is computed at compile-time so only a single string comparison is
+ * required to look up a name (instead of comparing against all names one after another).
+ */
+inline SyncthingEventType syncthingEventType(QStringView name)
+{
+    using namespace SyncthingEventTypeDetails;
+    const auto type = table[slot(seed, name)];
+    const auto expectedName = syncthingEventTypeName(type);
+    if (static_cast<std::size_t>(name.size()) != expectedName.size()) {
+        return SyncthingEventType::Unknown;
+    }
+    for (auto i = std::size_t(); i != expectedName.size(); ++i) {
+        if (name[static_cast<qsizetype>(i)].unicode() != codeUnit(expectedName[i])) {
+            return SyncthingEventType::Unknown;
+        }
+    }
+    return type;
+}
+
+} // namespace Data
+
+#endif // DATA_SYNCTHINGEVENTTYPE_H
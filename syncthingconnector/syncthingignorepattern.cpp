@@ -480,6 +480,96 @@ match:
     return false;
 }
 
+/*!
+ * \brief Returns whether the glob only matches from the root of the Syncthing folder (because it starts with a path separator).
+ */
+bool SyncthingIgnorePattern::matchesFromRoot(QChar pathSeparator) const
+{
+    return !glob.isEmpty() && (glob.front() == pathSeparator || glob.front() == QChar('/'));
+}
+
+/*!
+ * \brief Returns the literal part at the beginning of the glob, excluding a leading path separator.
+ * \remarks
+ * - Every path matched by the pattern contains the returned prefix: at its beginning if matchesFromRoot() returns true
+ *   and otherwise at the beginning of one of its path elements. See mightMatch() for making use of that.
+ * - Occurrences of "/" are replaced by \a pathSeparator so the prefix can be compared against paths directly.
+ */
+QString SyncthingIgnorePattern::literalPrefix(QChar pathSeparator) const
+{
+    auto prefix = QString();
+    if (comment || glob.isEmpty()) {
+        return prefix;
+    }
+    for (auto i = glob.begin() + (matchesFromRoot(pathSeparator) ? 1 : 0), end = glob.end(); i != end; ++i) {
+        switch (i->unicode()) {
+        case '*':
+        case '?':
+        case '[':
+        case '{':
+            return prefix;
+        case '\\':
+            if (pathSeparator != QChar('\\')) {
+                return prefix; // stop at escaped characters to keep it simple
+            }
+            prefix += pathSeparator;
+            break;
+        case '/':
+            prefix += pathSeparator;
+            break;
+        default:
+            prefix += *i;
+        }
+    }
+    return prefix;
+}
+
+/*!
+ * \brief Returns whether the pattern might match \a path considering only the specified \a literalPrefix.
+ * \remarks
+ * - The \a literalPrefix is supposed to be obtained via literalPrefix() (and cached by the caller when checking many paths).
+ * - Returns false only if matches() would return false as well. So matches() must still be called if true is returned.
+ */
+bool SyncthingIgnorePattern::mightMatch(const QString &literalPrefix, const QString &path, QChar pathSeparator) const
+{
+    if (comment || glob.isEmpty()) {
+        return false;
+    }
+    if (literalPrefix.isEmpty()) {
+        return true;
+    }
+
+    // compare like matches() does, so treat "/" within the path as path separator as well
+    static constexpr auto genericPathSeparator = '/';
+    const auto isPathSeparator = [pathSeparator](QChar c) { return c == pathSeparator || c == QChar(genericPathSeparator); };
+    const auto startsWithPrefix = [&, this](QString::size_type offset) {
+        if (path.size() - offset < literalPrefix.size()) {
+            return false;
+        }
+        for (auto i = QString::size_type(), size = literalPrefix.size(); i != size; ++i) {
+            const auto expectedChar = literalPrefix[i], presentChar = path[offset + i];
+            if (expectedChar == pathSeparator ? !isPathSeparator(presentChar)
+                                              : (caseInsensitive ? presentChar.toCaseFolded() != expectedChar.toCaseFolded()
+                                                                 : presentChar != expectedChar)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    if (startsWithPrefix(0)) {
+        return true;
+    }
+    if (matchesFromRoot(pathSeparator)) {
+        return false;
+    }
+    for (auto i = QString::size_type(), size = path.size(); i != size; ++i) {
+        if (isPathSeparator(path[i]) && startsWithPrefix(i + 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 /*!
  * \brief Makes an ignore pattern for \a path with the specified settings.
  */
@@ -21,6 +21,9 @@ struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingIgnorePattern {
     SyncthingIgnorePattern(SyncthingIgnorePattern &&);
     ~SyncthingIgnorePattern();
     bool matches(const QString &path, QChar pathSeparator = QChar('/')) const;
+    bool matchesFromRoot(QChar pathSeparator = QChar('/')) const;
+    QString literalPrefix(QChar pathSeparator = QChar('/')) const;
+    bool mightMatch(const QString &literalPrefix, const QString &path, QChar pathSeparator = QChar('/')) const;
     static QString forPath(const QString &path, bool ignore = true, bool caseInsensitive = false, bool allowRemovalOnParentDirRemoval = false);
 
     /// \brief The full ignore pattern as passed to the c'tor (unless modified).
@@ -0,0 +1,67 @@
+#include "./syncthingjsondecoder.h"
+
+#include <QMetaObject>
+#include <QMutexLocker>
+
+namespace Data {
+
+/*!
+ * \class SyncthingJsonDecoder
+ * \brief The SyncthingJsonDecoder class decodes large responses on a worker thread.
+ *
+ * Parsing a big response via QJsonDocument::fromJson() and converting it into e.g. SyncthingItem instances can take a
+ * noticeable amount of time. This class allows to do that on a worker thread so only moving the results into place and
+ * emitting signals happens within the thread of the context object (usually the GUI thread). See decode() for details.
+ *
+ * There is only one worker thread and small responses are queued behind responses which are still pending. So results are
+ * applied in the order the responses have been passed to decode().
+ */
+
+/*!
+ * \brief Constructs a new decoder applying results within the thread of the specified \a context object.
+ * \remarks The \a context object must outlive the decoder.
+ */
+SyncthingJsonDecoder::SyncthingJsonDecoder(QObject *context)
+    : m_state(std::make_shared<State>())
+    , m_threshold(defaultThreshold)
+{
+    m_state->context = context;
+    m_pool.setMaxThreadCount(1);
+    m_pool.setExpiryTimeout(5000);
+}
+
+/*!
+ * \brief Destroys the decoder discarding all pending results.
+ * \remarks Waits for the response that is currently decoded (if any) but not for further queued responses.
+ */
+SyncthingJsonDecoder::~SyncthingJsonDecoder()
+{
+    {
+        const auto locker = QMutexLocker(&m_state->mutex);
+        m_state->context = nullptr;
+    }
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+/*!
+ * \brief Waits until all responses have been decoded.
+ * \remarks Results are still only applied once the event loop of the context object's thread is processed.
+ */
+void SyncthingJsonDecoder::waitForDone()
+{
+    m_pool.waitForDone();
+}
+
+/*!
+ * \brief Invokes the specified \a function within the thread of the context object unless the decoder has been destroyed.
+ */
+void SyncthingJsonDecoder::post(const std::shared_ptr<State> &state, std::function<void()> &&function)
+{
+    const auto locker = QMutexLocker(&state->mutex);
+    if (state->context) {
+        QMetaObject::invokeMethod(state->context, std::move(function), Qt::QueuedConnection);
+    }
+}
+
+} // namespace Data
@@ -0,0 +1,121 @@
+#ifndef DATA_SYNCTHINGJSONDECODER_H
+#define DATA_SYNCTHINGJSONDECODER_H
+
+#include "./global.h"
+
+#include <QByteArray>
+#include <QMutex>
+#include <QObject>
+#include <QThreadPool>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace Data {
+
+class LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingJsonDecoder {
+public:
+    explicit SyncthingJsonDecoder(QObject *context);
+    ~SyncthingJsonDecoder();
+
+    static constexpr int defaultThreshold = 256 * 1024;
+
+    int threshold() const;
+    void setThreshold(int threshold);
+    std::size_t pendingCount() const;
+    void invalidate();
+    void waitForDone();
+    template <typename DecodeFunction, typename ApplyFunction>
+    void decode(const QByteArray &data, DecodeFunction &&decodeFunction, ApplyFunction &&applyFunction);
+
+private:
+    struct State {
+        QMutex mutex;
+        QObject *context = nullptr;
+        std::uint64_t generation = 0;
+        std::size_t pending = 0;
+    };
+    static void post(const std::shared_ptr<State> &state, std::function<void()> &&function);
+
+    std::shared_ptr<State> m_state;
+    QThreadPool m_pool;
+    int m_threshold;
+};
+
+/*!
+ * \brief Returns the size in bytes as of which responses are decoded in the background.
+ * \remarks Smaller responses are decoded synchronously because handing them over to the worker thread would not pay off
+ *          (unless other responses are still pending, see decode()). A negative value disables decoding in the background
+ *          completely.
+ */
+inline int SyncthingJsonDecoder::threshold() const
+{
+    return m_threshold;
+}
+
+/*!
+ * \brief Sets the size in bytes as of which responses are decoded in the background.
+ * \sa threshold()
+ */
+inline void SyncthingJsonDecoder::setThreshold(int threshold)
+{
+    m_threshold = threshold;
+}
+
+/*!
+ * \brief Returns the number of responses which are currently decoded in the background.
+ */
+inline std::size_t SyncthingJsonDecoder::pendingCount() const
+{
+    return m_state->pending;
+}
+
+/*!
+ * \brief Discards results of all responses which are currently decoded in the background.
+ * \remarks This is supposed to be called when the results are not relevant anymore, e.g. when the connection is aborted.
+ */
+inline void SyncthingJsonDecoder::invalidate()
+{
+    ++m_state->generation;
+    m_state->pending = 0;
+}
+
+/*!
+ * \brief Decodes the specified \a data via \a decodeFunction and passes the result to \a applyFunction.
+ * \remarks
+ * - If the size of \a data exceeds threshold(), \a decodeFunction is invoked on the worker thread and \a applyFunction is
+ *   invoked later within the thread of the context object. Otherwise both functions are invoked immediately unless other
+ *   responses are still pending; then \a data is queued behind those as well.
+ * - \a decodeFunction must therefore not access any state that is not thread-safe (like the members of SyncthingConnection)
+ *   and is supposed to do all the expensive work (parsing and converting into ready-to-use structures) so \a applyFunction
+ *   only needs to move the result into place and emit signals.
+ * - Results are applied in the order the data has been passed, regardless of their size.
+ */
+template <typename DecodeFunction, typename ApplyFunction>
+void SyncthingJsonDecoder::decode(const QByteArray &data, DecodeFunction &&decodeFunction, ApplyFunction &&applyFunction)
+{
+    using Result = std::decay_t<std::invoke_result_t<DecodeFunction, const QByteArray &>>;
+    if ((m_threshold < 0 || data.size() < m_threshold) && !m_state->pending) {
+        applyFunction(decodeFunction(data));
+        return;
+    }
+    ++m_state->pending;
+    auto apply = std::make_shared<std::decay_t<ApplyFunction>>(std::forward<ApplyFunction>(applyFunction));
+    m_pool.start([state = m_state, generation = m_state->generation, data, decode = std::forward<DecodeFunction>(decodeFunction), apply]() {
+        auto result = std::make_shared<Result>(decode(data));
+        post(state, [state, generation, result = std::move(result), apply = std::move(apply)] {
+            if (state->generation != generation) {
+                return; // the result has been invalidated in the meantime
+            }
+            --state->pending;
+            (*apply)(std::move(*result));
+        });
+    });
+}
+
+} // namespace Data
+
+#endif // DATA_SYNCTHINGJSONDECODER_H
@@ -0,0 +1,83 @@
+#include "./syncthinglogstore.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace Data {
+
+/*!
+ * \struct SyncthingLogEntry
+ * \brief The SyncthingLogEntry struct holds a single entry of the Syncthing log.
+ */
+
+/*!
+ * \class SyncthingLogStore
+ * \brief The SyncthingLogStore class keeps the most recent entries of the Syncthing log in memory.
+ *
+ * The store is filled by SyncthingConnection::requestNewLogEntries() which only requests entries newer than lastTimestamp().
+ * Entries are addressed by absolute indices which are never reused. Hence viewers can keep track of the entries they have
+ * already shown and only handle the range passed via SyncthingConnection::logEntriesAppended(). Once the capacity is exceeded
+ * the oldest entries are dropped.
+ */
+
+/*!
+ * \brief Constructs a new store retaining at most \a capacity entries.
+ */
+SyncthingLogStore::SyncthingLogStore(std::size_t capacity)
+    : m_beginIndex(0)
+    , m_capacity(capacity)
+{
+}
+
+/*!
+ * \brief Sets the max. number of entries the store retains dropping the oldest entries if the store currently retains more.
+ */
+void SyncthingLogStore::setCapacity(std::size_t capacity)
+{
+    m_capacity = capacity;
+    dropExcessEntries();
+}
+
+/*!
+ * \brief Appends the specified \a entries.
+ * \returns Returns the range of indices of the appended entries that are retained (might be less than the number of
+ *          \a entries if it exceeds the capacity).
+ */
+std::pair<std::size_t, std::size_t> SyncthingLogStore::append(std::vector<SyncthingLogEntry> &&entries)
+{
+    if (entries.empty()) {
+        return std::make_pair(endIndex(), endIndex());
+    }
+    const auto appendedBegin = endIndex();
+    m_lastTimestamp = entries.back().when;
+    m_entries.insert(m_entries.end(), std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
+    dropExcessEntries();
+    return std::make_pair(std::max(appendedBegin, m_beginIndex), endIndex());
+}
+
+/*!
+ * \brief Drops all entries.
+ * \remarks
+ * - Indices of subsequently appended entries continue where they left off.
+ * - The last timestamp is reset as well so all entries are requested again next time.
+ */
+void SyncthingLogStore::clear()
+{
+    m_beginIndex += m_entries.size();
+    m_entries.clear();
+    m_lastTimestamp.clear();
+}
+
+/// \cond
+void SyncthingLogStore::dropExcessEntries()
+{
+    if (m_entries.size() <= m_capacity) {
+        return;
+    }
+    const auto excess = m_entries.size() - m_capacity;
+    m_entries.erase(m_entries.begin(), m_entries.begin() + static_cast<std::ptrdiff_t>(excess));
+    m_beginIndex += excess;
+}
+/// \endcond
+
+} // namespace Data
@@ -0,0 +1,121 @@
+#ifndef DATA_SYNCTHINGLOGSTORE_H
+#define DATA_SYNCTHINGLOGSTORE_H
+
+#include "./global.h"
+
+#include <QString>
+
+#include <cstddef>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace Data {
+
+struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingLogEntry {
+    SyncthingLogEntry(const QString &when = QString(), const QString &message = QString())
+        : when(when)
+        , message(message)
+    {
+    }
+    QString when;
+    QString message;
+};
+
+class LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingLogStore {
+public:
+    static constexpr std::size_t defaultCapacity = 10000;
+
+    explicit SyncthingLogStore(std::size_t capacity = defaultCapacity);
+
+    std::size_t capacity() const;
+    void setCapacity(std::size_t capacity);
+    std::size_t size() const;
+    bool isEmpty() const;
+    std::size_t beginIndex() const;
+    std::size_t endIndex() const;
+    bool contains(std::size_t index) const;
+    const SyncthingLogEntry &at(std::size_t index) const;
+    const QString &lastTimestamp() const;
+    std::pair<std::size_t, std::size_t> append(std::vector<SyncthingLogEntry> &&entries);
+    void clear();
+
+private:
+    void dropExcessEntries();
+
+    std::deque<SyncthingLogEntry> m_entries;
+    std::size_t m_beginIndex;
+    std::size_t m_capacity;
+    QString m_lastTimestamp;
+};
+
+/*!
+ * \brief Returns the max. number of entries the store retains.
+ */
+inline std::size_t SyncthingLogStore::capacity() const
+{
+    return m_capacity;
+}
+
+/*!
+ * \brief Returns the number of entries the store currently retains.
+ */
+inline std::size_t SyncthingLogStore::size() const
+{
+    return m_entries.size();
+}
+
+/*!
+ * \brief Returns whether the store currently retains no entries.
+ */
+inline bool SyncthingLogStore::isEmpty() const
+{
+    return m_entries.empty();
+}
+
+/*!
+ * \brief Returns the index of the oldest entry the store retains.
+ * \remarks Indices are absolute, so an index keeps referring to the same entry when older entries are dropped.
+ */
+inline std::size_t SyncthingLogStore::beginIndex() const
+{
+    return m_beginIndex;
+}
+
+/*!
+ * \brief Returns the index the next appended entry will get.
+ */
+inline std::size_t SyncthingLogStore::endIndex() const
+{
+    return m_beginIndex + m_entries.size();
+}
+
+/*!
+ * \brief Returns whether the entry with the specified \a index is still retained.
+ */
+inline bool SyncthingLogStore::contains(std::size_t index) const
+{
+    return index >= beginIndex() && index < endIndex();
+}
+
+/*!
+ * \brief Returns the entry with the specified \a index.
+ * \remarks The entry must be retained; see contains().
+ */
+inline const SyncthingLogEntry &SyncthingLogStore::at(std::size_t index) const
+{
+    return m_entries[index - m_beginIndex];
+}
+
+/*!
+ * \brief Returns the timestamp of the last entry which has been appended.
+ * \remarks This is retained when entries are dropped due to the capacity so only newer entries are requested.
+ */
+inline const QString &SyncthingLogStore::lastTimestamp() const
+{
+    return m_lastTimestamp;
+}
+
+} // namespace Data
+
+#endif // DATA_SYNCTHINGLOGSTORE_H
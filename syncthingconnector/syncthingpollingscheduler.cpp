@@ -0,0 +1,421 @@
+#include "./syncthingpollingscheduler.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+using namespace CppUtilities;
+
+namespace Data {
+
+/*!
+ * \class SyncthingPollingScheduler
+ * \brief The SyncthingPollingScheduler class runs periodic requests like polling traffic statistics within shared wakeups.
+ *
+ * Instead of having one QTimer per periodic request which all fire independently, tasks are registered via addTask()
+ * and started/stopped similar to a QTimer. The scheduler only uses one timer and rounds the due time of each task up to
+ * the next multiple of slotDuration(). That way tasks becoming due at roughly the same time are run within the same
+ * wakeup which avoids waking up the process unnecessarily often. This is especially useful when multiple connections
+ * share the same scheduler.
+ *
+ * The interval of tasks flagged as SyncthingPollingTaskFlags::Adaptive is stretched by backgroundFactor() when the UI
+ * is hidden (see setUiVisible()) and doubled (up to maxIdleLevel() times) each time reportActivity() reports that a
+ * run did not yield any activity.
+ *
+ * The current schedule can be inspected via schedule(), e.g. for debugging and testing. The scheduleChanged() signal is
+ * emitted whenever it changes.
+ */
+
+/*!
+ * \brief Constructs a new scheduler without any tasks.
+ */
+SyncthingPollingScheduler::SyncthingPollingScheduler(QObject *parent)
+    : QObject(parent)
+    , m_nextId(0)
+    , m_wakeupCount(0)
+    , m_slotDuration(defaultSlotDuration)
+    , m_backgroundFactor(defaultBackgroundFactor)
+    , m_maxIdleLevel(defaultMaxIdleLevel)
+    , m_uiVisible(true)
+    , m_runningDueTasks(false)
+{
+    m_clock.start();
+    m_timer.setTimerType(Qt::CoarseTimer);
+    m_timer.setSingleShot(true);
+    QObject::connect(&m_timer, &QTimer::timeout, this, &SyncthingPollingScheduler::runDueTasks);
+}
+
+/*!
+ * \brief Destroys the scheduler. Pending tasks are not run anymore.
+ */
+SyncthingPollingScheduler::~SyncthingPollingScheduler()
+{
+}
+
+/*!
+ * \brief Registers a new task which will invoke the specified \a callback once the specified \a interval has elapsed.
+ * \remarks
+ * - The task is initially inactive; use start() to schedule it.
+ * - The task is removed automatically when \a receiver is destroyed. It can also be removed explicitly via removeTask().
+ * - The \a name is only used to make schedule() more readable.
+ */
+SyncthingPollingTaskId SyncthingPollingScheduler::addTask(
+    const QString &name, QObject *receiver, std::function<void()> &&callback, int interval, SyncthingPollingTaskFlags flags)
+{
+    if (receiver && std::none_of(m_tasks.cbegin(), m_tasks.cend(), [receiver](const auto &task) { return task.second.receiver == receiver; })) {
+        QObject::connect(receiver, &QObject::destroyed, this, [this](QObject *destroyedReceiver) { removeTasks(destroyedReceiver); });
+    }
+    const auto id = ++m_nextId;
+    auto &task = m_tasks[id];
+    task.name = name;
+    task.receiver = receiver;
+    task.callback = std::move(callback);
+    task.interval = interval;
+    task.flags = flags;
+    emit scheduleChanged();
+    return id;
+}
+
+/*!
+ * \brief Removes the task with the specified \a id.
+ */
+void SyncthingPollingScheduler::removeTask(SyncthingPollingTaskId id)
+{
+    if (m_tasks.erase(id)) {
+        updateTimer();
+    }
+}
+
+/*!
+ * \brief Removes all tasks registered for the specified \a receiver.
+ */
+void SyncthingPollingScheduler::removeTasks(const QObject *receiver)
+{
+    auto removed = false;
+    for (auto i = m_tasks.begin(); i != m_tasks.end();) {
+        if (i->second.receiver == receiver) {
+            i = m_tasks.erase(i);
+            removed = true;
+        } else {
+            ++i;
+        }
+    }
+    if (removed) {
+        updateTimer();
+    }
+}
+
+/*!
+ * \brief Returns the configured interval of the task with the specified \a id in milliseconds.
+ * \remarks Zero means the task is disabled.
+ */
+int SyncthingPollingScheduler::interval(SyncthingPollingTaskId id) const
+{
+    const auto *const task = findTask(id);
+    return task ? task->interval : 0;
+}
+
+/*!
+ * \brief Sets the interval of the task with the specified \a id in milliseconds.
+ * \remarks
+ * - An active task is re-scheduled relative to the time it has been started (like QTimer::setInterval() restarts the timer).
+ * - An interval of zero disables the task so it is stopped as well.
+ */
+void SyncthingPollingScheduler::setInterval(SyncthingPollingTaskId id, int interval)
+{
+    auto *const task = findTask(id);
+    if (!task || task->interval == interval) {
+        return;
+    }
+    task->interval = interval;
+    if (!interval) {
+        task->active = false;
+    } else if (task->active) {
+        task->dueTime = alignToSlot(task->startTime + effectiveInterval(*task));
+    }
+    updateTimer();
+}
+
+/*!
+ * \brief Returns the interval of the task with the specified \a id taking visibility and activity into account.
+ */
+int SyncthingPollingScheduler::effectiveInterval(SyncthingPollingTaskId id) const
+{
+    const auto *const task = findTask(id);
+    return task ? effectiveInterval(*task) : 0;
+}
+
+/*!
+ * \brief Returns whether the task with the specified \a id is currently scheduled.
+ */
+bool SyncthingPollingScheduler::isActive(SyncthingPollingTaskId id) const
+{
+    const auto *const task = findTask(id);
+    return task && task->active;
+}
+
+/*!
+ * \brief Returns the time in milliseconds until the task with the specified \a id is run or -1 if it is not active.
+ */
+std::int64_t SyncthingPollingScheduler::remainingTime(SyncthingPollingTaskId id) const
+{
+    const auto *const task = findTask(id);
+    return task && task->active ? std::max<std::int64_t>(task->dueTime - now(), 0) : -1;
+}
+
+/*!
+ * \brief Schedules the task with the specified \a id; re-schedules it if it is already active.
+ * \remarks Does nothing if the interval of the task is zero.
+ */
+void SyncthingPollingScheduler::start(SyncthingPollingTaskId id)
+{
+    auto *const task = findTask(id);
+    if (!task || !task->interval) {
+        return;
+    }
+    scheduleTask(*task);
+    updateTimer();
+}
+
+/*!
+ * \brief Unschedules the task with the specified \a id.
+ */
+void SyncthingPollingScheduler::stop(SyncthingPollingTaskId id)
+{
+    auto *const task = findTask(id);
+    if (!task || !task->active) {
+        return;
+    }
+    task->active = false;
+    updateTimer();
+}
+
+/*!
+ * \brief Reports whether the last run of the task with the specified \a id yielded any activity.
+ * \remarks
+ * - Only relevant for tasks flagged as SyncthingPollingTaskFlags::Adaptive.
+ * - The interval of the task is doubled for each consecutive run without activity (up to maxIdleLevel() times) and
+ *   reset as soon as there is activity again. This takes effect when the task is scheduled the next time.
+ */
+void SyncthingPollingScheduler::reportActivity(SyncthingPollingTaskId id, bool hadActivity)
+{
+    auto *const task = findTask(id);
+    if (!task) {
+        return;
+    }
+    if (hadActivity) {
+        task->idleLevel = 0;
+    } else if (task->idleLevel < m_maxIdleLevel) {
+        ++task->idleLevel;
+    }
+}
+
+/*!
+ * \brief Sets the duration of a wakeup slot in milliseconds.
+ * \remarks Only affects tasks scheduled after the change. Values below 1 disable the alignment.
+ */
+void SyncthingPollingScheduler::setSlotDuration(int slotDuration)
+{
+    m_slotDuration = slotDuration;
+}
+
+/*!
+ * \brief Sets whether the UI showing the polled information is currently visible.
+ * \remarks Active adaptive tasks are re-scheduled immediately so tasks run sooner when the UI becomes visible.
+ */
+void SyncthingPollingScheduler::setUiVisible(bool uiVisible)
+{
+    if (m_uiVisible == uiVisible) {
+        return;
+    }
+    m_uiVisible = uiVisible;
+    rescheduleActiveTasks();
+    emit uiVisibleChanged(uiVisible);
+}
+
+/*!
+ * \brief Sets the factor the interval of adaptive tasks is multiplied with while the UI is hidden.
+ */
+void SyncthingPollingScheduler::setBackgroundFactor(unsigned int backgroundFactor)
+{
+    if (m_backgroundFactor == backgroundFactor) {
+        return;
+    }
+    m_backgroundFactor = std::max(backgroundFactor, 1u);
+    if (!m_uiVisible) {
+        rescheduleActiveTasks();
+    }
+}
+
+/*!
+ * \brief Sets how often the interval of adaptive tasks may be doubled due to inactivity.
+ */
+void SyncthingPollingScheduler::setMaxIdleLevel(unsigned int maxIdleLevel)
+{
+    m_maxIdleLevel = std::min(maxIdleLevel, 16u);
+    for (auto &[id, task] : m_tasks) {
+        task.idleLevel = std::min(task.idleLevel, m_maxIdleLevel);
+    }
+}
+
+/*!
+ * \brief Sets the function returning the current time in milliseconds; an empty function restores the default clock.
+ * \remarks
+ * - This is meant for testing. The function must be monotonic and it should be set before any task is started.
+ * - The internal timer still waits for the difference between the next due time and now() to elapse in real time. So when
+ *   using a custom clock one usually invokes runDueTasks() manually after advancing the clock.
+ */
+void SyncthingPollingScheduler::setClock(Clock &&clock)
+{
+    m_customClock = std::move(clock);
+    updateTimer();
+}
+
+/*!
+ * \brief Returns the time (according to now()) when the scheduler wakes up the next time or -1 if no task is active.
+ */
+std::int64_t SyncthingPollingScheduler::nextWakeup() const
+{
+    auto next = std::numeric_limits<std::int64_t>::max();
+    for (const auto &[id, task] : m_tasks) {
+        if (task.active) {
+            next = std::min(next, task.dueTime);
+        }
+    }
+    return next != std::numeric_limits<std::int64_t>::max() ? next : -1;
+}
+
+/*!
+ * \brief Returns all registered tasks ordered by their due time; inactive tasks come last.
+ */
+std::vector<SyncthingPollingScheduleEntry> SyncthingPollingScheduler::schedule() const
+{
+    auto entries = std::vector<SyncthingPollingScheduleEntry>();
+    entries.reserve(m_tasks.size());
+    for (const auto &[id, task] : m_tasks) {
+        auto &entry = entries.emplace_back();
+        entry.id = id;
+        entry.name = task.name;
+        entry.receiver = task.receiver;
+        entry.interval = task.interval;
+        entry.effectiveInterval = effectiveInterval(task);
+        entry.dueTime = task.dueTime;
+        entry.idleLevel = task.idleLevel;
+        entry.flags = task.flags;
+        entry.active = task.active;
+    }
+    std::stable_sort(entries.begin(), entries.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.active != rhs.active ? lhs.active : (lhs.active && lhs.dueTime < rhs.dueTime);
+    });
+    return entries;
+}
+
+/*!
+ * \brief Returns the specified \a time rounded up to the next multiple of slotDuration().
+ */
+std::int64_t SyncthingPollingScheduler::alignToSlot(std::int64_t time) const
+{
+    if (m_slotDuration <= 1) {
+        return time;
+    }
+    const auto remainder = time % m_slotDuration;
+    return remainder ? time - remainder + m_slotDuration : time;
+}
+
+/*!
+ * \brief Runs all tasks which are due within the current wakeup slot.
+ * \remarks Called when the internal timer fires. Tasks not flagged as SyncthingPollingTaskFlags::Repeating are unscheduled
+ *          before being run so they can re-schedule themselves via start() from within the callback.
+ */
+void SyncthingPollingScheduler::runDueTasks()
+{
+    ++m_wakeupCount;
+
+    // consider everything due within the first half of the current slot as the coarse timer might fire slightly early
+    const auto deadline = now() + std::max(m_slotDuration / 2, 1);
+    auto dueTasks = std::vector<SyncthingPollingTaskId>();
+    for (auto &[id, task] : m_tasks) {
+        if (!task.active || task.dueTime > deadline) {
+            continue;
+        }
+        if (task.flags && SyncthingPollingTaskFlags::Repeating) {
+            scheduleTask(task);
+        } else {
+            task.active = false;
+        }
+        dueTasks.emplace_back(id);
+    }
+
+    // run due tasks; avoid updating the timer for each start()/stop() invoked from callbacks
+    m_runningDueTasks = true;
+    for (const auto id : dueTasks) {
+        // copy the callback as the task might be removed from within the callback
+        if (const auto *const task = findTask(id)) {
+            const auto callback = task->callback;
+            callback();
+        }
+    }
+    m_runningDueTasks = false;
+    updateTimer();
+}
+
+/// \cond
+
+SyncthingPollingScheduler::Task *SyncthingPollingScheduler::findTask(SyncthingPollingTaskId id)
+{
+    const auto i = m_tasks.find(id);
+    return i != m_tasks.end() ? &i->second : nullptr;
+}
+
+const SyncthingPollingScheduler::Task *SyncthingPollingScheduler::findTask(SyncthingPollingTaskId id) const
+{
+    const auto i = m_tasks.find(id);
+    return i != m_tasks.end() ? &i->second : nullptr;
+}
+
+int SyncthingPollingScheduler::effectiveInterval(const Task &task) const
+{
+    auto interval = static_cast<std::int64_t>(task.interval);
+    if (task.flags && SyncthingPollingTaskFlags::Adaptive) {
+        if (!m_uiVisible) {
+            interval *= m_backgroundFactor;
+        }
+        interval <<= task.idleLevel;
+    }
+    return static_cast<int>(std::min<std::int64_t>(interval, std::numeric_limits<int>::max()));
+}
+
+void SyncthingPollingScheduler::scheduleTask(Task &task)
+{
+    task.active = true;
+    task.startTime = now();
+    task.dueTime = alignToSlot(task.startTime + effectiveInterval(task));
+}
+
+void SyncthingPollingScheduler::rescheduleActiveTasks()
+{
+    for (auto &[id, task] : m_tasks) {
+        if (task.active && (task.flags && SyncthingPollingTaskFlags::Adaptive)) {
+            task.dueTime = alignToSlot(task.startTime + effectiveInterval(task));
+        }
+    }
+    updateTimer();
+}
+
+void SyncthingPollingScheduler::updateTimer()
+{
+    if (m_runningDueTasks) {
+        return;
+    }
+    if (const auto next = nextWakeup(); next < 0) {
+        m_timer.stop();
+    } else if (const auto timeout = static_cast<int>(std::clamp<std::int64_t>(next - now(), 0, std::numeric_limits<int>::max()));
+               !m_timer.isActive() || m_timer.remainingTime() != timeout) {
+        m_timer.start(timeout);
+    }
+    emit scheduleChanged();
+}
+
+/// \endcond
+
+} // namespace Data
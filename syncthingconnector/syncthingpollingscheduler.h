@@ -0,0 +1,207 @@
+#ifndef DATA_SYNCTHINGPOLLINGSCHEDULER_H
+#define DATA_SYNCTHINGPOLLINGSCHEDULER_H
+
+#include "./global.h"
+
+#include <c++utilities/misc/flagenumclass.h>
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace Data {
+
+/*!
+ * \brief The SyncthingPollingTaskFlags enum specifies how a task registered via SyncthingPollingScheduler::addTask() is scheduled.
+ */
+enum class SyncthingPollingTaskFlags : std::uint8_t {
+    None = 0x0, /**< the task is run once after its interval has elapsed (like a single-shot QTimer) */
+    Repeating = 0x1, /**< the task is re-scheduled automatically after it has been run (like a repeating QTimer) */
+    Adaptive = 0x2, /**< the interval is stretched when the UI is hidden and when reportActivity() signals inactivity */
+};
+
+using SyncthingPollingTaskId = std::size_t;
+
+/*!
+ * \brief The SyncthingPollingScheduleEntry struct describes a task registered with a SyncthingPollingScheduler.
+ * \sa SyncthingPollingScheduler::schedule()
+ */
+struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingPollingScheduleEntry {
+    SyncthingPollingTaskId id = 0;
+    QString name;
+    const QObject *receiver = nullptr;
+    int interval = 0;
+    int effectiveInterval = 0;
+    std::int64_t dueTime = 0;
+    unsigned int idleLevel = 0;
+    SyncthingPollingTaskFlags flags = SyncthingPollingTaskFlags::None;
+    bool active = false;
+};
+
+class LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingPollingScheduler : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(int slotDuration READ slotDuration WRITE setSlotDuration)
+    Q_PROPERTY(bool uiVisible READ isUiVisible WRITE setUiVisible NOTIFY uiVisibleChanged)
+    Q_PROPERTY(unsigned int backgroundFactor READ backgroundFactor WRITE setBackgroundFactor)
+    Q_PROPERTY(unsigned int maxIdleLevel READ maxIdleLevel WRITE setMaxIdleLevel)
+    Q_PROPERTY(quint64 wakeupCount READ wakeupCount)
+
+public:
+    using Clock = std::function<std::int64_t()>;
+
+    explicit SyncthingPollingScheduler(QObject *parent = nullptr);
+    ~SyncthingPollingScheduler() override;
+
+    static constexpr int defaultSlotDuration = 1000;
+    static constexpr unsigned int defaultBackgroundFactor = 4;
+    static constexpr unsigned int defaultMaxIdleLevel = 2;
+
+    SyncthingPollingTaskId addTask(const QString &name, QObject *receiver, std::function<void()> &&callback, int interval,
+        SyncthingPollingTaskFlags flags = SyncthingPollingTaskFlags::None);
+    void removeTask(SyncthingPollingTaskId id);
+    void removeTasks(const QObject *receiver);
+    bool hasTask(SyncthingPollingTaskId id) const;
+    std::size_t taskCount() const;
+
+    int interval(SyncthingPollingTaskId id) const;
+    void setInterval(SyncthingPollingTaskId id, int interval);
+    int effectiveInterval(SyncthingPollingTaskId id) const;
+    bool isActive(SyncthingPollingTaskId id) const;
+    std::int64_t remainingTime(SyncthingPollingTaskId id) const;
+    void start(SyncthingPollingTaskId id);
+    void stop(SyncthingPollingTaskId id);
+    void reportActivity(SyncthingPollingTaskId id, bool hadActivity);
+
+    int slotDuration() const;
+    void setSlotDuration(int slotDuration);
+    bool isUiVisible() const;
+    unsigned int backgroundFactor() const;
+    void setBackgroundFactor(unsigned int backgroundFactor);
+    unsigned int maxIdleLevel() const;
+    void setMaxIdleLevel(unsigned int maxIdleLevel);
+    std::uint64_t wakeupCount() const;
+    void setClock(Clock &&clock);
+    std::int64_t now() const;
+    std::int64_t nextWakeup() const;
+    std::vector<SyncthingPollingScheduleEntry> schedule() const;
+    std::int64_t alignToSlot(std::int64_t time) const;
+
+public Q_SLOTS:
+    void setUiVisible(bool uiVisible);
+    void runDueTasks();
+
+Q_SIGNALS:
+    void uiVisibleChanged(bool uiVisible);
+    void scheduleChanged();
+
+private:
+    struct Task {
+        QString name;
+        QObject *receiver = nullptr;
+        std::function<void()> callback;
+        int interval = 0;
+        std::int64_t startTime = 0;
+        std::int64_t dueTime = 0;
+        unsigned int idleLevel = 0;
+        SyncthingPollingTaskFlags flags = SyncthingPollingTaskFlags::None;
+        bool active = false;
+    };
+
+    Task *findTask(SyncthingPollingTaskId id);
+    const Task *findTask(SyncthingPollingTaskId id) const;
+    int effectiveInterval(const Task &task) const;
+    void scheduleTask(Task &task);
+    void rescheduleActiveTasks();
+    void updateTimer();
+
+    std::map<SyncthingPollingTaskId, Task> m_tasks;
+    QElapsedTimer m_clock;
+    Clock m_customClock;
+    QTimer m_timer;
+    SyncthingPollingTaskId m_nextId;
+    std::uint64_t m_wakeupCount;
+    int m_slotDuration;
+    unsigned int m_backgroundFactor;
+    unsigned int m_maxIdleLevel;
+    bool m_uiVisible;
+    bool m_runningDueTasks;
+};
+
+/*!
+ * \brief Returns the duration of a wakeup slot in milliseconds.
+ * \remarks Due times of all tasks are rounded up to a multiple of the slot duration so tasks becoming due at roughly
+ *          the same time are run within the same wakeup.
+ */
+inline int SyncthingPollingScheduler::slotDuration() const
+{
+    return m_slotDuration;
+}
+
+/*!
+ * \brief Returns whether the UI showing the polled information is currently visible.
+ */
+inline bool SyncthingPollingScheduler::isUiVisible() const
+{
+    return m_uiVisible;
+}
+
+/*!
+ * \brief Returns the factor the interval of adaptive tasks is multiplied with while the UI is hidden.
+ */
+inline unsigned int SyncthingPollingScheduler::backgroundFactor() const
+{
+    return m_backgroundFactor;
+}
+
+/*!
+ * \brief Returns how often the interval of adaptive tasks may be doubled due to inactivity.
+ */
+inline unsigned int SyncthingPollingScheduler::maxIdleLevel() const
+{
+    return m_maxIdleLevel;
+}
+
+/*!
+ * \brief Returns how often the scheduler has woken up to run due tasks so far.
+ */
+inline std::uint64_t SyncthingPollingScheduler::wakeupCount() const
+{
+    return m_wakeupCount;
+}
+
+/*!
+ * \brief Returns the current time of the scheduler's monotonic clock in milliseconds.
+ * \sa setClock()
+ */
+inline std::int64_t SyncthingPollingScheduler::now() const
+{
+    return m_customClock ? m_customClock() : m_clock.elapsed();
+}
+
+/*!
+ * \brief Returns the number of registered tasks.
+ */
+inline std::size_t SyncthingPollingScheduler::taskCount() const
+{
+    return m_tasks.size();
+}
+
+/*!
+ * \brief Returns whether a task with the specified \a id is registered.
+ */
+inline bool SyncthingPollingScheduler::hasTask(SyncthingPollingTaskId id) const
+{
+    return findTask(id) != nullptr;
+}
+
+} // namespace Data
+
+CPP_UTILITIES_MARK_FLAG_ENUM_CLASS(Data, Data::SyncthingPollingTaskFlags)
+
+#endif // DATA_SYNCTHINGPOLLINGSCHEDULER_H
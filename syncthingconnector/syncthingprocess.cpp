@@ -13,6 +13,8 @@
 //#define LIB_SYNCTHING_CONNECTOR_ENFORCE_STOP_VIA_API
 
 #ifdef LIB_SYNCTHING_CONNECTOR_BOOST_PROCESS
+#include "./syncthingprocessbuffer.h"
+
 #include <c++utilities/io/ansiescapecodes.h>
 
 #include <boost/version.hpp>
@@ -53,7 +55,6 @@
 #include <condition_variable>
 #include <csignal>
 #include <iostream>
-#include <limits>
 #include <mutex>
 #include <system_error>
 #include <thread>
@@ -85,9 +86,6 @@ namespace Data {
 /// \brief Holds data related to the process execution via Boost.Process.
 /// \remarks A new one is created for each process to be started.
 struct SyncthingProcessInternalData : std::enable_shared_from_this<SyncthingProcessInternalData> {
-    static constexpr std::size_t bufferCapacity = 0x1000;
-    static_assert(SyncthingProcessInternalData::bufferCapacity <= std::numeric_limits<qint64>::max());
-
     explicit SyncthingProcessInternalData(boost::asio::io_context &ioc);
     struct Lock {
         explicit Lock(const std::weak_ptr<SyncthingProcessInternalData> &weak);
@@ -104,9 +102,11 @@ struct SyncthingProcessInternalData : std::enable_shared_from_this<SyncthingProc
     boost::process::async_pipe pipe;
     std::mutex readMutex;
     std::condition_variable readCondVar;
-    char buffer[bufferCapacity];
-    std::atomic_size_t bytesBuffered = 0;
-    std::size_t bytesRead = 0;
+    std::atomic_size_t readWaiters = 0;
+    SyncthingProcessBuffer buffer;
+    std::atomic_bool readingSuspended = false;
+    std::atomic_bool outputNotificationPending = false;
+    std::atomic_bool outputComplete = false;
     QProcess::ProcessState state = QProcess::NotRunning;
 };
 
@@ -670,24 +670,34 @@ void SyncthingProcess::kill()
 
 /*!
  * \brief Reads data from the pipe into the internal buffer.
+ * \remarks
+ * - Data is read directly into the SyncthingProcessBuffer which the consumer can read from concurrently. So the next read
+ *   operation is started immediately without waiting until the consumer has read the data.
+ * - Reading is suspended once the buffer exceeds its high-water mark and resumed by readData() once the consumer has caught up.
+ * - readyRead() is not emitted for each read operation. Instead, handleOutputAvailable() is queued if it is not already
+ *   pending so output that arrives in quick succession leads to only one notification.
  */
 void SyncthingProcess::bufferOutput()
 {
 #ifdef LIB_SYNCTHING_CONNECTOR_BOOST_PROCESS
-    m_process->pipe.async_read_some(boost::asio::buffer(m_process->buffer, m_process->bufferCapacity),
+    if (!m_process) {
+        return;
+    }
+    const auto [space, spaceSize] = m_process->buffer.prepareWrite();
+    m_process->pipe.async_read_some(boost::asio::buffer(space, spaceSize),
         [this, maybeProcess = m_process->weak_from_this()](const boost::system::error_code &ec, auto bytesRead) {
             const auto lock = SyncthingProcessInternalData::Lock(maybeProcess);
             if (!lock) {
                 return;
             }
-            m_process->bytesBuffered = bytesRead;
+            m_process->buffer.commitWrite(bytesRead);
             if (ec == boost::asio::error::eof
 #ifdef PLATFORM_WINDOWS // looks like we're getting broken pipe (and not just eof) under Windows when stopping the process
                 || ec == boost::asio::error::broken_pipe
 #endif
             ) {
                 m_process->pipe.async_close();
-                setOpenMode(QIODevice::NotOpen);
+                m_process->outputComplete = true;
             } else if (ec) {
                 const auto msg = ec.message();
                 std::cerr << EscapeCodes::Phrases::Error << "Unable to read output of process " << m_process->child.native_handle() << ": " << msg
@@ -695,14 +705,54 @@ void SyncthingProcess::bufferOutput()
                 QMetaObject::invokeMethod(this, "handleError", Qt::QueuedConnection, Q_ARG(int, QProcess::ReadError),
                     Q_ARG(QString, QString::fromStdString(msg)), Q_ARG(bool, true));
             }
-            if (!ec || bytesRead) {
-                emit readyRead();
+
+            // notify the consumer about new data (and the end of the output)
+            if ((bytesRead || m_process->outputComplete) && !m_process->outputNotificationPending.exchange(true)) {
+                QMetaObject::invokeMethod(this, "handleOutputAvailable", Qt::QueuedConnection);
+            }
+            if (m_process->readWaiters) {
+                // acquire the mutex briefly so the notification cannot get lost while waitForReadyRead() checks for output
+                m_process->readMutex.lock();
+                m_process->readMutex.unlock();
                 m_process->readCondVar.notify_all();
             }
+            if (ec) {
+                return;
+            }
+
+            // continue reading unless the consumer is too far behind
+            // note: The flag is set before checking the buffer again so either this handler or readData() resumes reading.
+            if (m_process->buffer.isAboveHighWaterMark()) {
+                m_process->readingSuspended = true;
+                if (!m_process->buffer.isBelowLowWaterMark() || !m_process->readingSuspended.exchange(false)) {
+                    return;
+                }
+            }
+            bufferOutput();
         });
 #endif
 }
 
+/*!
+ * \brief Emits readyRead() if there is buffered output and closes the device once all output has been read.
+ * \remarks Queued by bufferOutput() when new data has been buffered.
+ */
+void SyncthingProcess::handleOutputAvailable()
+{
+#ifdef LIB_SYNCTHING_CONNECTOR_BOOST_PROCESS
+    if (!m_process) {
+        return;
+    }
+    m_process->outputNotificationPending = false;
+    if (!m_process->buffer.isEmpty()) {
+        emit readyRead();
+    }
+    if (m_process && m_process->outputComplete && m_process->buffer.isEmpty() && isOpen()) {
+        setOpenMode(QIODevice::NotOpen);
+    }
+#endif
+}
+
 /*!
  * \brief Terminates all processes in the group forcefully and waits until they're gone.
  */
@@ -732,7 +782,7 @@ void SyncthingProcess::handleLeftoverProcesses()
 qint64 SyncthingProcess::bytesAvailable() const
 {
 #ifdef LIB_SYNCTHING_CONNECTOR_BOOST_PROCESS
-    return (m_process ? static_cast<qint64>(m_process->bytesBuffered) : 0) + QIODevice::bytesAvailable();
+    return (m_process ? static_cast<qint64>(m_process->buffer.size()) : 0) + QIODevice::bytesAvailable();
 #else
     return 0;
 #endif
@@ -801,18 +851,21 @@ bool SyncthingProcess::waitForReadyRead(int msecs)
     if (!m_process) {
         return false;
     }
-    if (m_process->bytesBuffered) {
+    if (!m_process->buffer.isEmpty()) {
         return true;
     }
     QEventLoop().processEvents(
         QEventLoop::ExcludeUserInputEvents | QEventLoop::ExcludeSocketNotifiers); // ensure a possibly pending bufferOutput() invocation is processed
     auto lock = std::unique_lock<std::mutex>(m_process->readMutex);
+    const auto hasOutput = [process = m_process.get()] { return !process->buffer.isEmpty() || process->outputComplete; };
+    ++m_process->readWaiters;
     if (msecs < 0) {
-        m_process->readCondVar.wait(lock);
+        m_process->readCondVar.wait(lock, hasOutput);
     } else {
-        m_process->readCondVar.wait_for(lock, std::chrono::milliseconds(msecs));
+        m_process->readCondVar.wait_for(lock, std::chrono::milliseconds(msecs), hasOutput);
     }
-    return m_process->bytesBuffered;
+    --m_process->readWaiters;
+    return !m_process->buffer.isEmpty();
 #else
     Q_UNUSED(msecs)
     return false;
@@ -864,22 +917,19 @@ qint64 SyncthingProcess::readData(char *data, qint64 maxSize)
     if (maxSize < 1) {
         return 0;
     }
-    if (!m_process->bytesBuffered) {
-        return 0; // do *not* invoke bufferOutput() here; an async read operation is already pending
-    }
+    const auto bytesRead = m_process->buffer.read(data, static_cast<std::size_t>(maxSize));
 
-    const auto bytesAvailable = m_process->bytesBuffered - m_process->bytesRead;
-    if (bytesAvailable > static_cast<std::size_t>(maxSize)) {
-        std::memcpy(data, m_process->buffer + m_process->bytesRead, static_cast<std::size_t>(maxSize));
-        m_process->bytesRead += static_cast<std::size_t>(maxSize);
-        return maxSize;
-    } else {
-        std::memcpy(data, m_process->buffer + m_process->bytesRead, bytesAvailable);
-        m_process->bytesBuffered = 0;
-        m_process->bytesRead = 0;
+    // resume reading from the pipe if it has been suspended due to backpressure
+    // note: Do *not* invoke bufferOutput() otherwise; an async read operation is already pending.
+    if (m_process->readingSuspended && m_process->buffer.isBelowLowWaterMark() && m_process->readingSuspended.exchange(false)) {
         QMetaObject::invokeMethod(this, "bufferOutput", Qt::QueuedConnection);
-        return static_cast<qint64>(bytesAvailable);
     }
+
+    // close the device after all output has been read
+    if (m_process->outputComplete && m_process->buffer.isEmpty() && !m_process->outputNotificationPending.exchange(true)) {
+        QMetaObject::invokeMethod(this, "handleOutputAvailable", Qt::QueuedConnection);
+    }
+    return static_cast<qint64>(bytesRead);
 #else
     Q_UNUSED(data)
     Q_UNUSED(maxSize)
@@ -118,6 +118,7 @@ private Q_SLOTS:
 #ifdef LIB_SYNCTHING_CONNECTOR_PROCESS_IO_DEV_BASED
     void handleError(int error, const QString &errorMessage, bool closed);
     void bufferOutput();
+    void handleOutputAvailable();
     void handleLeftoverProcesses();
 #endif
 
@@ -0,0 +1,160 @@
+#include "./syncthingprocessbuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Data {
+
+/*!
+ * \class SyncthingProcessBuffer
+ * \brief The SyncthingProcessBuffer class is a growable single-producer/single-consumer byte queue for the output of SyncthingProcess.
+ *
+ * The producer (the thread reading from the process' pipe) and the consumer (the thread of the SyncthingProcess object) can
+ * access the buffer concurrently without locking. The data is stored in a chain of fixed-size blocks. The producer only ever
+ * writes into the last block and appends a new block once it is full. The consumer only ever reads from the first block and
+ * drops it once it has been read completely and the producer has moved on. One drained block is kept as spare so a steady
+ * flow of data does not lead to allocating a new block all the time.
+ *
+ * The producer can write directly into the buffer via prepareWrite() and commitWrite() so data can be read from the pipe
+ * without copying it. Since the buffer can grow without limit, the producer is supposed to stop reading from the pipe once
+ * isAboveHighWaterMark() returns true and the consumer is supposed to resume the producer once isBelowLowWaterMark() returns
+ * true. That way a slow consumer leads to backpressure on the process' pipe instead of unbounded memory usage.
+ *
+ * \remarks
+ * - Only one thread may act as producer and only one thread may act as consumer at a time.
+ * - The member functions are documented with the side they may be called from.
+ */
+
+/// \cond
+SyncthingProcessBuffer::Block::Block(std::size_t capacity)
+    : data(std::make_unique<char[]>(capacity))
+    , capacity(capacity)
+    , written(0)
+    , next(nullptr)
+    , read(0)
+{
+}
+/// \endcond
+
+/*!
+ * \brief Constructs a new buffer allocating blocks of the specified \a blockSize.
+ */
+SyncthingProcessBuffer::SyncthingProcessBuffer(std::size_t blockSize, std::size_t highWaterMark)
+    : m_spare(nullptr)
+    , m_size(0)
+    , m_blockSize(std::max<std::size_t>(blockSize, 1))
+    , m_highWaterMark(highWaterMark)
+{
+    m_head = m_tail = new Block(m_blockSize);
+}
+
+/*!
+ * \brief Destroys the buffer.
+ * \remarks Neither the producer nor the consumer must access the buffer anymore at this point.
+ */
+SyncthingProcessBuffer::~SyncthingProcessBuffer()
+{
+    for (auto *block = m_head; block;) {
+        delete std::exchange(block, block->next.load());
+    }
+    delete m_spare.load();
+}
+
+/*!
+ * \brief Returns a pointer to contiguous free space and its size; to be called from the producer side.
+ * \remarks
+ * - The returned space is never empty. The buffer grows as needed to achieve that.
+ * - Call commitWrite() after writing to the returned space to make the data visible to the consumer.
+ */
+std::pair<char *, std::size_t> SyncthingProcessBuffer::prepareWrite()
+{
+    auto written = m_tail->written.load(std::memory_order_relaxed);
+    if (written == m_tail->capacity) {
+        auto *block = m_spare.exchange(nullptr, std::memory_order_acquire);
+        if (block) {
+            block->written.store(0, std::memory_order_relaxed);
+            block->next.store(nullptr, std::memory_order_relaxed);
+            block->read = 0;
+        } else {
+            block = new Block(m_blockSize);
+        }
+        m_tail->next.store(block, std::memory_order_release);
+        m_tail = block;
+        written = 0;
+    }
+    return std::make_pair(m_tail->data.get() + written, m_tail->capacity - written);
+}
+
+/*!
+ * \brief Makes the specified number of bytes written to the space returned by prepareWrite() visible to the consumer; to
+ *        be called from the producer side.
+ * \returns Returns whether the buffer has been empty before so the consumer might need to be notified.
+ */
+bool SyncthingProcessBuffer::commitWrite(std::size_t size)
+{
+    if (!size) {
+        return false;
+    }
+    // increase the size before publishing the data so the consumer cannot decrease the size below zero
+    const auto wasEmpty = m_size.fetch_add(size) == 0;
+    m_tail->written.store(m_tail->written.load(std::memory_order_relaxed) + size, std::memory_order_release);
+    return wasEmpty;
+}
+
+/*!
+ * \brief Copies the specified \a data into the buffer; to be called from the producer side.
+ * \returns Returns the number of bytes written which is always \a size.
+ */
+std::size_t SyncthingProcessBuffer::write(const char *data, std::size_t size)
+{
+    for (auto remaining = size; remaining;) {
+        const auto [space, spaceSize] = prepareWrite();
+        const auto bytesToWrite = std::min(remaining, spaceSize);
+        std::memcpy(space, data, bytesToWrite);
+        commitWrite(bytesToWrite);
+        data += bytesToWrite;
+        remaining -= bytesToWrite;
+    }
+    return size;
+}
+
+/*!
+ * \brief Reads up to \a maxSize bytes into \a data; to be called from the consumer side.
+ * \returns Returns the number of bytes read.
+ */
+std::size_t SyncthingProcessBuffer::read(char *data, std::size_t maxSize)
+{
+    auto bytesRead = std::size_t();
+    while (bytesRead < maxSize) {
+        const auto written = m_head->written.load(std::memory_order_acquire);
+        if (m_head->read == written) {
+            // proceed with next block if the producer has moved on; otherwise there is nothing more to read
+            if (written != m_head->capacity) {
+                break;
+            }
+            auto *const next = m_head->next.load(std::memory_order_acquire);
+            if (!next) {
+                break;
+            }
+            recycle(std::exchange(m_head, next));
+            continue;
+        }
+        const auto bytesToRead = std::min(written - m_head->read, maxSize - bytesRead);
+        std::memcpy(data + bytesRead, m_head->data.get() + m_head->read, bytesToRead);
+        m_head->read += bytesToRead;
+        bytesRead += bytesToRead;
+    }
+    if (bytesRead) {
+        m_size.fetch_sub(bytesRead);
+    }
+    return bytesRead;
+}
+
+/// \cond
+void SyncthingProcessBuffer::recycle(Block *block)
+{
+    delete m_spare.exchange(block, std::memory_order_acq_rel);
+}
+/// \endcond
+
+} // namespace Data
@@ -0,0 +1,119 @@
+#ifndef DATA_SYNCTHINGPROCESSBUFFER_H
+#define DATA_SYNCTHINGPROCESSBUFFER_H
+
+#include "./global.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace Data {
+
+class LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingProcessBuffer {
+public:
+    static constexpr std::size_t defaultBlockSize = 64 * 1024;
+    static constexpr std::size_t defaultHighWaterMark = 16 * 1024 * 1024;
+
+    explicit SyncthingProcessBuffer(std::size_t blockSize = defaultBlockSize, std::size_t highWaterMark = defaultHighWaterMark);
+    SyncthingProcessBuffer(const SyncthingProcessBuffer &) = delete;
+    SyncthingProcessBuffer &operator=(const SyncthingProcessBuffer &) = delete;
+    ~SyncthingProcessBuffer();
+
+    // producer side
+    std::pair<char *, std::size_t> prepareWrite();
+    bool commitWrite(std::size_t size);
+    std::size_t write(const char *data, std::size_t size);
+
+    // consumer side
+    std::size_t read(char *data, std::size_t maxSize);
+
+    // state accessible from both sides
+    std::size_t size() const;
+    bool isEmpty() const;
+    std::size_t blockSize() const;
+    std::size_t highWaterMark() const;
+    std::size_t lowWaterMark() const;
+    bool isAboveHighWaterMark() const;
+    bool isBelowLowWaterMark() const;
+
+private:
+    struct Block {
+        explicit Block(std::size_t capacity);
+        std::unique_ptr<char[]> data;
+        std::size_t capacity;
+        std::atomic_size_t written;
+        std::atomic<Block *> next;
+        std::size_t read;
+    };
+
+    void recycle(Block *block);
+
+    Block *m_head;
+    Block *m_tail;
+    std::atomic<Block *> m_spare;
+    std::atomic_size_t m_size;
+    std::size_t m_blockSize;
+    std::size_t m_highWaterMark;
+};
+
+/*!
+ * \brief Returns the number of bytes which have been committed by the producer but not read by the consumer yet.
+ */
+inline std::size_t SyncthingProcessBuffer::size() const
+{
+    return m_size.load();
+}
+
+/*!
+ * \brief Returns whether there are no bytes to read.
+ */
+inline bool SyncthingProcessBuffer::isEmpty() const
+{
+    return !size();
+}
+
+/*!
+ * \brief Returns the size of the blocks the buffer allocates when it needs to grow.
+ */
+inline std::size_t SyncthingProcessBuffer::blockSize() const
+{
+    return m_blockSize;
+}
+
+/*!
+ * \brief Returns the number of buffered bytes as of which the producer is supposed to stop writing.
+ * \remarks The buffer itself does not enforce this limit; it is up to the producer to check isAboveHighWaterMark().
+ */
+inline std::size_t SyncthingProcessBuffer::highWaterMark() const
+{
+    return m_highWaterMark;
+}
+
+/*!
+ * \brief Returns the number of buffered bytes below which a producer that has been stopped is supposed to continue.
+ */
+inline std::size_t SyncthingProcessBuffer::lowWaterMark() const
+{
+    return m_highWaterMark / 2;
+}
+
+/*!
+ * \brief Returns whether the high-water mark has been reached.
+ */
+inline bool SyncthingProcessBuffer::isAboveHighWaterMark() const
+{
+    return size() >= m_highWaterMark;
+}
+
+/*!
+ * \brief Returns whether the buffered bytes fell below the low-water mark.
+ */
+inline bool SyncthingProcessBuffer::isBelowLowWaterMark() const
+{
+    return size() < lowWaterMark();
+}
+
+} // namespace Data
+
+#endif // DATA_SYNCTHINGPROCESSBUFFER_H
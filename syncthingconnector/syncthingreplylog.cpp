@@ -0,0 +1,370 @@
+#include "./syncthingreplylog.h"
+
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QStringBuilder>
+#include <QTimer>
+#include <QUrl>
+#include <QUrlQuery>
+
+#include <algorithm>
+#include <optional>
+
+namespace Data {
+
+/*!
+ * \struct SyncthingRecordedReply
+ * \brief The SyncthingRecordedReply struct holds a raw reply of the Syncthing API recorded via SyncthingReplyRecorder.
+ */
+
+/*!
+ * \class SyncthingReplyRecorder
+ * \brief The SyncthingReplyRecorder class writes raw replies of the Syncthing API with timestamps to a compact log.
+ *
+ * The log can be loaded via SyncthingReplyReplayer to drive a SyncthingConnection without a running Syncthing instance,
+ * e.g. to reproduce performance problems or to benchmark the processing of events deterministically. To record replies
+ * of a connection, assign the recorder via SyncthingConnection::setReplyRecorder() or set the environment variable
+ * `LIB_SYNCTHING_CONNECTOR_RECORD_REPLIES` to the path of the log file.
+ *
+ * The log starts with magic and version followed by one QDataStream-serialized record per reply. The response data is
+ * compressed via qCompress(). Records are written immediately so the log is usable even if the application is not
+ * terminated gracefully.
+ */
+
+/*!
+ * \brief Constructs a recorder writing to the specified \a device which must already be open for writing.
+ */
+SyncthingReplyRecorder::SyncthingReplyRecorder(QIODevice *device, QObject *parent)
+    : QObject(parent)
+    , m_device(device)
+    , m_recordCount(0)
+{
+    start();
+}
+
+/*!
+ * \brief Constructs a recorder writing to the file at the specified \a path (which is truncated).
+ */
+SyncthingReplyRecorder::SyncthingReplyRecorder(const QString &path, QObject *parent)
+    : QObject(parent)
+    , m_file(path)
+    , m_device(&m_file)
+    , m_recordCount(0)
+{
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        m_errorString = tr("Unable to open \"%1\" for recording replies: %2").arg(path, m_file.errorString());
+        m_device = nullptr;
+        return;
+    }
+    start();
+}
+
+/*!
+ * \brief Returns whether replies can be recorded; if not, errorString() returns the reason.
+ */
+bool SyncthingReplyRecorder::isRecording() const
+{
+    return m_device && m_stream.status() == QDataStream::Ok;
+}
+
+/*!
+ * \brief Records the specified \a reply.
+ * \remarks The offset of \a reply is set to the time elapsed since the recorder has been constructed.
+ */
+void SyncthingReplyRecorder::record(const SyncthingRecordedReply &reply)
+{
+    if (!isRecording()) {
+        return;
+    }
+    m_stream << static_cast<qint64>(m_timer.elapsed()) << reply.verb << reply.path << reply.query << static_cast<qint32>(reply.httpStatus)
+             << static_cast<qint32>(reply.error) << qCompress(reply.response);
+    if (m_stream.status() != QDataStream::Ok) {
+        m_errorString = tr("Unable to write recorded reply: %1").arg(m_device->errorString());
+        return;
+    }
+    ++m_recordCount;
+}
+
+/*!
+ * \brief Records the specified \a reply which has finished with the specified \a response.
+ * \remarks Replies which have been aborted are not recorded as they do not contain any information from Syncthing.
+ */
+void SyncthingReplyRecorder::record(QNetworkReply *reply, const QByteArray &response)
+{
+    if (reply->error() == QNetworkReply::OperationCanceledError) {
+        return;
+    }
+    auto verb = QByteArray();
+    switch (reply->operation()) {
+    case QNetworkAccessManager::GetOperation:
+        verb = QByteArrayLiteral("GET");
+        break;
+    case QNetworkAccessManager::PostOperation:
+        verb = QByteArrayLiteral("POST");
+        break;
+    case QNetworkAccessManager::PutOperation:
+        verb = QByteArrayLiteral("PUT");
+        break;
+    case QNetworkAccessManager::DeleteOperation:
+        verb = QByteArrayLiteral("DELETE");
+        break;
+    default:
+        verb = reply->request().attribute(QNetworkRequest::CustomVerbAttribute).toByteArray();
+    }
+    const auto url = reply->request().url();
+    auto recordedReply = SyncthingRecordedReply();
+    recordedReply.verb = std::move(verb);
+    recordedReply.path = url.path();
+    recordedReply.query = url.query(QUrl::FullyEncoded);
+    recordedReply.httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    recordedReply.error = static_cast<int>(reply->error());
+    recordedReply.response = response;
+    record(recordedReply);
+}
+
+/// \cond
+void SyncthingReplyRecorder::start()
+{
+    m_stream.setDevice(m_device);
+    m_stream.setVersion(QDataStream::Qt_5_15);
+    m_stream << magic << version;
+    m_timer.start();
+}
+
+/*!
+ * \brief The ReplayedReply class serves a recorded reply.
+ * \remarks Unlike MockedReply this is available in normal builds.
+ */
+class ReplayedReply final : public QNetworkReply {
+public:
+    explicit ReplayedReply(const QByteArray &verb, const QUrl &url, QObject *parent = nullptr);
+
+    void abort() override;
+    qint64 bytesAvailable() const override;
+    bool isSequential() const override;
+    qint64 size() const override;
+    void finish(const SyncthingRecordedReply *record);
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) override;
+
+private:
+    QByteArray m_data;
+    qint64 m_pos;
+};
+
+ReplayedReply::ReplayedReply(const QByteArray &verb, const QUrl &url, QObject *parent)
+    : QNetworkReply(parent)
+    , m_pos(0)
+{
+    auto request = QNetworkRequest(url);
+    request.setAttribute(QNetworkRequest::CustomVerbAttribute, verb);
+    setRequest(request);
+    setUrl(url);
+    setOperation(QNetworkAccessManager::CustomOperation);
+    setOpenMode(QIODevice::ReadOnly);
+}
+
+void ReplayedReply::abort()
+{
+    if (isFinished()) {
+        return;
+    }
+    setError(QNetworkReply::OperationCanceledError, QStringLiteral("Operation canceled"));
+    setFinished(true);
+    emit finished();
+}
+
+qint64 ReplayedReply::bytesAvailable() const
+{
+    return m_data.size() - m_pos + QNetworkReply::bytesAvailable();
+}
+
+bool ReplayedReply::isSequential() const
+{
+    return true;
+}
+
+qint64 ReplayedReply::size() const
+{
+    return m_data.size();
+}
+
+void ReplayedReply::finish(const SyncthingRecordedReply *record)
+{
+    if (isFinished()) {
+        return;
+    }
+    if (!record) {
+        setError(QNetworkReply::ContentNotFoundError, QStringLiteral("No recorded reply available for request: ") + url().toString());
+        setAttribute(QNetworkRequest::HttpStatusCodeAttribute, 404);
+    } else {
+        m_data = record->response;
+        setAttribute(QNetworkRequest::HttpStatusCodeAttribute, record->httpStatus);
+        if (record->error != QNetworkReply::NoError) {
+            setError(static_cast<QNetworkReply::NetworkError>(record->error), QStringLiteral("Recorded error"));
+        }
+    }
+    if (!m_data.isEmpty()) {
+        emit readyRead();
+    }
+    setFinished(true);
+    emit finished();
+}
+
+qint64 ReplayedReply::readData(char *data, qint64 maxlen)
+{
+    const auto bytesToRead = std::min<qint64>(m_data.size() - m_pos, maxlen);
+    if (bytesToRead <= 0) {
+        return m_pos < m_data.size() ? 0 : -1;
+    }
+    std::copy(m_data.constData() + m_pos, m_data.constData() + m_pos + bytesToRead, data);
+    m_pos += bytesToRead;
+    return bytesToRead;
+}
+/// \endcond
+
+/*!
+ * \class SyncthingReplyReplayer
+ * \brief The SyncthingReplyReplayer class serves replies recorded via SyncthingReplyRecorder.
+ *
+ * Assign the replayer via SyncthingConnection::setReplyReplayer() (or set the environment variable
+ * `LIB_SYNCTHING_CONNECTOR_REPLAY_REPLIES` to the path of the log file) to let the connection use recorded replies instead of
+ * sending requests to Syncthing. Requests are matched to recorded replies by verb, path and query. Query parameters
+ * which depend on previous replies (`since` and `timeout`) are ignored. Replies recorded for the same request are served
+ * in the recorded order. When all replies for a request have been served, the last one is served again. Long-polling
+ * requests (events) never finish in that case, just like when Syncthing has no new events.
+ *
+ * In SyncthingReplayMode::TimeAccurate mode, replies finish at the same time relative to the first request as they were
+ * recorded. In SyncthingReplayMode::AsFastAsPossible mode, replies finish immediately (asynchronously) which is useful
+ * for benchmarking. The exhausted() signal is emitted when all recorded replies have been served.
+ */
+
+/*!
+ * \brief Constructs a replayer using the specified \a mode; call load() to load recorded replies.
+ */
+SyncthingReplyReplayer::SyncthingReplyReplayer(SyncthingReplayMode mode, QObject *parent)
+    : QObject(parent)
+    , m_mode(mode)
+    , m_replayedCount(0)
+{
+}
+
+/*!
+ * \brief Loads the replies recorded in the specified \a device which must already be open for reading.
+ * \returns Returns whether the replies could be loaded; if not, errorString() returns the reason.
+ */
+bool SyncthingReplyReplayer::load(QIODevice *device)
+{
+    m_records.clear();
+    m_queues.clear();
+    m_errorString.clear();
+
+    auto stream = QDataStream(device);
+    stream.setVersion(QDataStream::Qt_5_15);
+    auto magic = quint32();
+    auto version = quint16();
+    stream >> magic >> version;
+    if (stream.status() != QDataStream::Ok || magic != SyncthingReplyRecorder::magic) {
+        m_errorString = tr("The recorded replies are not in the expected format.");
+        return false;
+    }
+    if (version != SyncthingReplyRecorder::version) {
+        m_errorString = tr("The recorded replies are in an unsupported version (%1).").arg(version);
+        return false;
+    }
+    while (!stream.atEnd()) {
+        auto record = SyncthingRecordedReply();
+        auto httpStatus = qint32(), error = qint32();
+        auto compressedResponse = QByteArray();
+        stream >> record.offset >> record.verb >> record.path >> record.query >> httpStatus >> error >> compressedResponse;
+        if (stream.status() != QDataStream::Ok) {
+            // tolerate a truncated last record (e.g. if the recording application has crashed)
+            break;
+        }
+        record.httpStatus = httpStatus;
+        record.error = error;
+        record.response = qUncompress(compressedResponse);
+        m_queues[keyFor(record.verb, record.path, record.query)].indices.emplace_back(m_records.size());
+        m_records.emplace_back(std::move(record));
+    }
+    restart();
+    return true;
+}
+
+/*!
+ * \brief Loads the replies recorded in the file at the specified \a path.
+ */
+bool SyncthingReplyReplayer::load(const QString &path)
+{
+    auto file = QFile(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        m_errorString = tr("Unable to open \"%1\" for replaying replies: %2").arg(path, file.errorString());
+        return false;
+    }
+    return load(&file);
+}
+
+/*!
+ * \brief Starts serving replies from the beginning again.
+ * \remarks The time is measured from the next request on.
+ */
+void SyncthingReplyReplayer::restart()
+{
+    for (auto &[key, queue] : m_queues) {
+        queue.next = 0;
+    }
+    m_replayedCount = 0;
+    m_timer.invalidate();
+}
+
+/*!
+ * \brief Returns a reply for the specified request.
+ * \remarks The reply finishes asynchronously. It fails with QNetworkReply::ContentNotFoundError if no reply has been
+ *          recorded for the request.
+ */
+QNetworkReply *SyncthingReplyReplayer::replyFor(const QByteArray &verb, const QUrl &url, bool longPolling)
+{
+    if (!m_timer.isValid()) {
+        m_timer.start();
+    }
+
+    auto *const reply = new ReplayedReply(verb, url);
+    const auto queue = m_queues.find(keyFor(verb, url.path(), url.query(QUrl::FullyEncoded)));
+    const SyncthingRecordedReply *record = nullptr;
+    auto delay = qint64();
+    if (queue != m_queues.end() && !queue->second.indices.empty()) {
+        auto &[indices, next] = queue->second;
+        if (next < indices.size()) {
+            record = &m_records[indices[next++]];
+            if (m_mode == SyncthingReplayMode::TimeAccurate) {
+                delay = std::max<qint64>(0, record->offset - m_timer.elapsed());
+            }
+            if (++m_replayedCount == m_records.size()) {
+                QTimer::singleShot(static_cast<int>(delay), this, &SyncthingReplyReplayer::exhausted);
+            }
+        } else if (longPolling) {
+            return reply; // keep long-polling requests pending until they are aborted
+        } else {
+            record = &m_records[indices.back()];
+        }
+    }
+    // capture a copy of the record (cheap as the data is implicitly shared) as load() might be called or the replayer might be
+    // destroyed before the reply finishes
+    QTimer::singleShot(static_cast<int>(delay), reply,
+        [reply, record = record ? std::make_optional(*record) : std::nullopt] { reply->finish(record ? &*record : nullptr); });
+    return reply;
+}
+
+/*!
+ * \brief Returns the key used to match requests with recorded replies.
+ */
+QString SyncthingReplyReplayer::keyFor(const QByteArray &verb, const QString &path, const QString &query)
+{
+    auto urlQuery = QUrlQuery(query);
+    urlQuery.removeAllQueryItems(QStringLiteral("since"));
+    urlQuery.removeAllQueryItems(QStringLiteral("timeout"));
+    return QString::fromLatin1(verb) % QChar(' ') % path % QChar('?') % urlQuery.query(QUrl::FullyEncoded);
+}
+
+} // namespace Data
@@ -0,0 +1,144 @@
+#ifndef DATA_SYNCTHINGREPLYLOG_H
+#define DATA_SYNCTHINGREPLYLOG_H
+
+#include "./global.h"
+#include "./qstringhash.h"
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QObject>
+#include <QString>
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+QT_FORWARD_DECLARE_CLASS(QIODevice)
+QT_FORWARD_DECLARE_CLASS(QNetworkReply)
+QT_FORWARD_DECLARE_CLASS(QUrl)
+
+namespace Data {
+
+struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingRecordedReply {
+    qint64 offset = 0; ///< milliseconds since the recording has been started
+    QByteArray verb;
+    QString path;
+    QString query;
+    int httpStatus = 0;
+    int error = 0; ///< the QNetworkReply::NetworkError
+    QByteArray response;
+};
+
+class LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingReplyRecorder : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr quint32 magic = 0x5354524C; // "STRL"
+    static constexpr quint16 version = 1;
+
+    explicit SyncthingReplyRecorder(QIODevice *device, QObject *parent = nullptr);
+    explicit SyncthingReplyRecorder(const QString &path, QObject *parent = nullptr);
+
+    bool isRecording() const;
+    const QString &errorString() const;
+    std::size_t recordCount() const;
+    void record(const SyncthingRecordedReply &reply);
+    void record(QNetworkReply *reply, const QByteArray &response);
+
+private:
+    void start();
+
+    QFile m_file;
+    QIODevice *m_device;
+    QDataStream m_stream;
+    QElapsedTimer m_timer;
+    QString m_errorString;
+    std::size_t m_recordCount;
+};
+
+inline const QString &SyncthingReplyRecorder::errorString() const
+{
+    return m_errorString;
+}
+
+inline std::size_t SyncthingReplyRecorder::recordCount() const
+{
+    return m_recordCount;
+}
+
+enum class SyncthingReplayMode {
+    TimeAccurate, /**< replies are delayed so they finish at the same time (relative to the start) as they were recorded */
+    AsFastAsPossible, /**< replies finish as soon as possible */
+};
+
+class LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingReplyReplayer : public QObject {
+    Q_OBJECT
+
+public:
+    explicit SyncthingReplyReplayer(SyncthingReplayMode mode = SyncthingReplayMode::TimeAccurate, QObject *parent = nullptr);
+
+    bool load(QIODevice *device);
+    bool load(const QString &path);
+    const QString &errorString() const;
+    SyncthingReplayMode mode() const;
+    void setMode(SyncthingReplayMode mode);
+    const std::vector<SyncthingRecordedReply> &records() const;
+    std::size_t replayedCount() const;
+    bool isExhausted() const;
+    void restart();
+    QNetworkReply *replyFor(const QByteArray &verb, const QUrl &url, bool longPolling);
+
+    static QString keyFor(const QByteArray &verb, const QString &path, const QString &query);
+
+Q_SIGNALS:
+    void exhausted();
+
+private:
+    struct Queue {
+        std::vector<std::size_t> indices;
+        std::size_t next = 0;
+    };
+
+    std::vector<SyncthingRecordedReply> m_records;
+    std::unordered_map<QString, Queue> m_queues;
+    QElapsedTimer m_timer;
+    QString m_errorString;
+    SyncthingReplayMode m_mode;
+    std::size_t m_replayedCount;
+};
+
+inline const QString &SyncthingReplyReplayer::errorString() const
+{
+    return m_errorString;
+}
+
+inline SyncthingReplayMode SyncthingReplyReplayer::mode() const
+{
+    return m_mode;
+}
+
+inline void SyncthingReplyReplayer::setMode(SyncthingReplayMode mode)
+{
+    m_mode = mode;
+}
+
+inline const std::vector<SyncthingRecordedReply> &SyncthingReplyReplayer::records() const
+{
+    return m_records;
+}
+
+inline std::size_t SyncthingReplyReplayer::replayedCount() const
+{
+    return m_replayedCount;
+}
+
+inline bool SyncthingReplyReplayer::isExhausted() const
+{
+    return m_replayedCount >= m_records.size();
+}
+
+} // namespace Data
+
+#endif // DATA_SYNCTHINGREPLYLOG_H
@@ -0,0 +1,520 @@
+#include "./syncthingstatesnapshot.h"
+#include "./syncthingconnection.h"
+
+#include <QDataStream>
+
+#include <algorithm>
+#include <unordered_map>
+
+using namespace CppUtilities;
+
+namespace Data {
+
+/*!
+ * \struct SyncthingStateSnapshot
+ * \brief The SyncthingStateSnapshot struct holds the state of a SyncthingConnection (folders, devices and a few global
+ *        values) and allows storing it in a compact binary format.
+ *
+ * This is meant for caching the state on disk to populate the UI quickly on startup, for test fixtures and for tools like
+ * the CLI which would otherwise need to re-request and re-parse all the JSON returned by Syncthing.
+ *
+ * The format is based on QDataStream and looks like this:
+ * - a header consisting of magic and version
+ * - a string table: the number of strings, the UTF-8 size of each string and the UTF-8 data of all strings as one block
+ * - the actual data which refers to strings only by their index within the string table
+ *
+ * Storing each string only once makes the format compact as IDs of folders and devices occur many times (e.g. in the
+ * device lists of folders and the completion of each folder/device). When deserializing, each string is only decoded once
+ * and all references to it share the same (implicitly shared) QString. The string data is stored as one contiguous block
+ * so it can be used without further copying.
+ *
+ * Transient information like the download progress is not stored. Deserialization fails if the magic or version does not
+ * match or the data is truncated or otherwise invalid.
+ */
+
+/// \cond
+namespace {
+
+enum class DirFlags : quint8 {
+    IgnorePermissions = 1 << 0,
+    IgnoreDelete = 1 << 1,
+    IgnorePatterns = 1 << 2,
+    AutoNormalize = 1 << 3,
+    LastFileDeleted = 1 << 4,
+    FileSystemWatcherEnabled = 1 << 5,
+    Paused = 1 << 6,
+};
+
+enum class DevFlags : quint8 {
+    Introducer = 1 << 0,
+    Paused = 1 << 1,
+    ConnectionLocal = 1 << 2,
+};
+
+template <typename Flag> constexpr quint8 flagIf(bool condition, Flag flag)
+{
+    return condition ? static_cast<quint8>(flag) : quint8();
+}
+
+template <typename Flag> constexpr bool hasFlag(quint8 flags, Flag flag)
+{
+    return flags & static_cast<quint8>(flag);
+}
+
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter();
+    QByteArray finish();
+    void write(const SyncthingStateSnapshot &snapshot);
+
+private:
+    void write(const QString &string);
+    void write(const QStringList &strings);
+    void write(DateTime dateTime);
+    void write(const SyncthingStatistics &stats);
+    void write(const SyncthingCompletion &completion);
+    void write(const std::unordered_map<QString, SyncthingCompletion> &completionByItem);
+    void write(const SyncthingDir &dir);
+    void write(const SyncthingDev &dev);
+
+    std::unordered_map<QString, quint32> m_stringIndices;
+    std::vector<const QString *> m_strings;
+    QByteArray m_bodyData;
+    QDataStream m_body;
+};
+
+class SnapshotReader {
+public:
+    explicit SnapshotReader(const QByteArray &data);
+    bool read(SyncthingStateSnapshot &snapshot);
+
+private:
+    bool readStringTable();
+    quint32 readCount();
+    template <typename Enum> Enum readEnum(Enum maxValue);
+    QString readString();
+    QStringList readStringList();
+    DateTime readDateTime();
+    SyncthingStatistics readStatistics();
+    SyncthingCompletion readCompletion();
+    std::unordered_map<QString, SyncthingCompletion> readCompletionMap();
+    void read(SyncthingDir &dir);
+    void read(SyncthingDev &dev);
+    bool isOk() const;
+
+    QDataStream m_stream;
+    std::vector<QString> m_strings;
+    bool m_ok;
+};
+
+SnapshotWriter::SnapshotWriter()
+    : m_body(&m_bodyData, QIODevice::WriteOnly)
+{
+    m_body.setVersion(QDataStream::Qt_5_15);
+}
+
+QByteArray SnapshotWriter::finish()
+{
+    auto utf8Strings = std::vector<QByteArray>();
+    auto utf8Size = qsizetype();
+    utf8Strings.reserve(m_strings.size());
+    for (const auto *const string : m_strings) {
+        utf8Size += utf8Strings.emplace_back(string->toUtf8()).size();
+    }
+
+    auto data = QByteArray();
+    data.reserve(static_cast<qsizetype>(12 + 4 * m_strings.size()) + utf8Size + m_bodyData.size());
+    auto stream = QDataStream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_15);
+    stream << SyncthingStateSnapshot::magic << SyncthingStateSnapshot::version << static_cast<quint32>(m_strings.size());
+    for (const auto &utf8String : utf8Strings) {
+        stream << static_cast<quint32>(utf8String.size());
+    }
+    for (const auto &utf8String : utf8Strings) {
+        stream.writeRawData(utf8String.data(), static_cast<int>(utf8String.size()));
+    }
+    stream.writeRawData(m_bodyData.data(), static_cast<int>(m_bodyData.size()));
+    return data;
+}
+
+void SnapshotWriter::write(const SyncthingStateSnapshot &snapshot)
+{
+    write(snapshot.myId);
+    write(snapshot.tilde);
+    write(snapshot.pathSeparator);
+    write(snapshot.syncthingVersion);
+    m_body << static_cast<quint32>(snapshot.dirs.size());
+    for (const auto &dir : snapshot.dirs) {
+        write(dir);
+    }
+    m_body << static_cast<quint32>(snapshot.devs.size());
+    for (const auto &dev : snapshot.devs) {
+        write(dev);
+    }
+}
+
+void SnapshotWriter::write(const QString &string)
+{
+    const auto [i, inserted] = m_stringIndices.emplace(string, static_cast<quint32>(m_strings.size()));
+    if (inserted) {
+        m_strings.emplace_back(&i->first);
+    }
+    m_body << i->second;
+}
+
+void SnapshotWriter::write(const QStringList &strings)
+{
+    m_body << static_cast<quint32>(strings.size());
+    for (const auto &string : strings) {
+        write(string);
+    }
+}
+
+void SnapshotWriter::write(DateTime dateTime)
+{
+    m_body << static_cast<quint64>(dateTime.totalTicks());
+}
+
+void SnapshotWriter::write(const SyncthingStatistics &stats)
+{
+    m_body << stats.bytes << stats.deletes << stats.dirs << stats.files << stats.symlinks << stats.total;
+}
+
+void SnapshotWriter::write(const SyncthingCompletion &completion)
+{
+    write(completion.lastUpdate);
+    m_body << completion.percentage << completion.globalBytes << completion.needed.bytes << completion.needed.items << completion.needed.deletes;
+}
+
+void SnapshotWriter::write(const std::unordered_map<QString, SyncthingCompletion> &completionByItem)
+{
+    m_body << static_cast<quint32>(completionByItem.size());
+    for (const auto &[id, completion] : completionByItem) {
+        write(id);
+        write(completion);
+    }
+}
+
+void SnapshotWriter::write(const SyncthingDir &dir)
+{
+    write(dir.id);
+    write(dir.label);
+    write(dir.path);
+    write(dir.deviceIds);
+    write(dir.deviceNames);
+    m_body << static_cast<quint8>(dir.dirType) << static_cast<qint32>(dir.rescanInterval) << static_cast<qint32>(dir.minDiskFreePercentage)
+           << static_cast<quint8>(dir.status) << dir.lastStatusUpdateEvent;
+    write(dir.lastStatusUpdateTime);
+    m_body << dir.lastSyncStartedEvent;
+    write(dir.lastSyncStartedTime);
+    m_body << static_cast<qint32>(dir.completionPercentage) << static_cast<qint32>(dir.scanningPercentage) << dir.scanningRate
+           << dir.fileSystemWatcherDelay;
+    write(dir.completionByDevice);
+    write(dir.globalError);
+    m_body << dir.pullErrorCount << static_cast<quint32>(dir.itemErrors.size());
+    for (const auto &itemError : dir.itemErrors) {
+        write(itemError.message);
+        write(itemError.path);
+    }
+    m_body << static_cast<quint32>(dir.recentChanges.size());
+    for (const auto &change : dir.recentChanges) {
+        write(change.action);
+        write(change.type);
+        write(change.modifiedBy);
+        write(change.path);
+        write(change.eventTime);
+        m_body << change.local;
+    }
+    write(dir.globalStats);
+    write(dir.localStats);
+    write(dir.neededStats);
+    write(dir.receiveOnlyStats);
+    m_body << dir.lastStatisticsUpdateEvent;
+    write(dir.lastStatisticsUpdateTime);
+    write(dir.lastScanTime);
+    m_body << dir.lastFileEvent;
+    write(dir.lastFileTime);
+    write(dir.lastFileName);
+    write(dir.rawStatus);
+    m_body << static_cast<quint8>(flagIf(dir.ignorePermissions, DirFlags::IgnorePermissions) | flagIf(dir.ignoreDelete, DirFlags::IgnoreDelete)
+        | flagIf(dir.ignorePatterns, DirFlags::IgnorePatterns) | flagIf(dir.autoNormalize, DirFlags::AutoNormalize)
+        | flagIf(dir.lastFileDeleted, DirFlags::LastFileDeleted) | flagIf(dir.fileSystemWatcherEnabled, DirFlags::FileSystemWatcherEnabled)
+        | flagIf(dir.paused, DirFlags::Paused));
+}
+
+void SnapshotWriter::write(const SyncthingDev &dev)
+{
+    write(dev.id);
+    write(dev.name);
+    write(dev.addresses);
+    write(dev.compression);
+    write(dev.certName);
+    m_body << static_cast<quint8>(dev.status) << static_cast<quint64>(dev.totalIncomingTraffic) << static_cast<quint64>(dev.totalOutgoingTraffic);
+    write(dev.connectionAddress);
+    write(dev.connectionType);
+    write(dev.clientVersion);
+    write(dev.disconnectReason);
+    write(dev.lastSeen);
+    write(dev.completionByDir);
+    write(dev.overallCompletion);
+    m_body << static_cast<quint8>(flagIf(dev.introducer, DevFlags::Introducer) | flagIf(dev.paused, DevFlags::Paused)
+        | flagIf(dev.connectionLocal, DevFlags::ConnectionLocal));
+}
+
+SnapshotReader::SnapshotReader(const QByteArray &data)
+    : m_stream(data)
+    , m_ok(true)
+{
+    m_stream.setVersion(QDataStream::Qt_5_15);
+}
+
+bool SnapshotReader::read(SyncthingStateSnapshot &snapshot)
+{
+    auto magic = quint32();
+    auto version = quint16();
+    m_stream >> magic >> version;
+    if (!isOk() || magic != SyncthingStateSnapshot::magic || version != SyncthingStateSnapshot::version || !readStringTable()) {
+        return false;
+    }
+    snapshot.myId = readString();
+    snapshot.tilde = readString();
+    snapshot.pathSeparator = readString();
+    snapshot.syncthingVersion = readString();
+    snapshot.dirs.clear();
+    snapshot.dirs.resize(readCount());
+    for (auto &dir : snapshot.dirs) {
+        read(dir);
+    }
+    snapshot.devs.clear();
+    snapshot.devs.resize(readCount());
+    for (auto &dev : snapshot.devs) {
+        read(dev);
+    }
+    return isOk();
+}
+
+bool SnapshotReader::readStringTable()
+{
+    const auto count = readCount();
+    auto sizes = std::vector<quint32>(count);
+    auto totalSize = quint64();
+    for (auto &size : sizes) {
+        m_stream >> size;
+        totalSize += size;
+    }
+    if (!isOk() || totalSize > static_cast<quint64>(m_stream.device()->bytesAvailable())) {
+        return m_ok = false;
+    }
+    // read the UTF-8 data of all strings at once and decode each string only once
+    const auto utf8 = m_stream.device()->read(static_cast<qint64>(totalSize));
+    const auto *data = utf8.data();
+    m_strings.reserve(count);
+    for (const auto size : sizes) {
+        m_strings.emplace_back(QString::fromUtf8(data, static_cast<int>(size)));
+        data += size;
+    }
+    return true;
+}
+
+quint32 SnapshotReader::readCount()
+{
+    auto count = quint32();
+    m_stream >> count;
+    // each element takes at least one byte so the count cannot exceed the remaining bytes unless the data is invalid
+    if (!isOk() || count > m_stream.device()->bytesAvailable()) {
+        m_ok = false;
+        return 0;
+    }
+    return count;
+}
+
+template <typename Enum> Enum SnapshotReader::readEnum(Enum maxValue)
+{
+    auto value = quint8();
+    m_stream >> value;
+    return value <= static_cast<quint8>(maxValue) ? static_cast<Enum>(value) : Enum();
+}
+
+QString SnapshotReader::readString()
+{
+    auto index = quint32();
+    m_stream >> index;
+    if (index >= m_strings.size()) {
+        m_ok = false;
+        return QString();
+    }
+    return m_strings[index];
+}
+
+QStringList SnapshotReader::readStringList()
+{
+    auto strings = QStringList();
+    const auto count = readCount();
+    strings.reserve(static_cast<QStringList::size_type>(count));
+    for (auto i = quint32(); i != count && m_ok; ++i) {
+        strings << readString();
+    }
+    return strings;
+}
+
+DateTime SnapshotReader::readDateTime()
+{
+    auto ticks = quint64();
+    m_stream >> ticks;
+    return DateTime(ticks);
+}
+
+SyncthingStatistics SnapshotReader::readStatistics()
+{
+    auto stats = SyncthingStatistics();
+    m_stream >> stats.bytes >> stats.deletes >> stats.dirs >> stats.files >> stats.symlinks >> stats.total;
+    return stats;
+}
+
+SyncthingCompletion SnapshotReader::readCompletion()
+{
+    auto completion = SyncthingCompletion();
+    completion.lastUpdate = readDateTime();
+    m_stream >> completion.percentage >> completion.globalBytes >> completion.needed.bytes >> completion.needed.items >> completion.needed.deletes;
+    return completion;
+}
+
+std::unordered_map<QString, SyncthingCompletion> SnapshotReader::readCompletionMap()
+{
+    auto completionByItem = std::unordered_map<QString, SyncthingCompletion>();
+    const auto count = readCount();
+    completionByItem.reserve(count);
+    for (auto i = quint32(); i != count && m_ok; ++i) {
+        auto id = readString();
+        completionByItem.emplace(std::move(id), readCompletion());
+    }
+    return completionByItem;
+}
+
+void SnapshotReader::read(SyncthingDir &dir)
+{
+    auto rescanInterval = qint32(), minDiskFreePercentage = qint32(), completionPercentage = qint32(), scanningPercentage = qint32();
+    dir.id = readString();
+    dir.label = readString();
+    dir.path = readString();
+    dir.deviceIds = readStringList();
+    dir.deviceNames = readStringList();
+    dir.dirType = readEnum(SyncthingDirType::ReceiveEncrypted);
+    m_stream >> rescanInterval >> minDiskFreePercentage;
+    dir.rescanInterval = rescanInterval;
+    dir.minDiskFreePercentage = minDiskFreePercentage;
+    dir.status = readEnum(SyncthingDirStatus::OutOfSync);
+    m_stream >> dir.lastStatusUpdateEvent;
+    dir.lastStatusUpdateTime = readDateTime();
+    m_stream >> dir.lastSyncStartedEvent;
+    dir.lastSyncStartedTime = readDateTime();
+    m_stream >> completionPercentage >> scanningPercentage >> dir.scanningRate >> dir.fileSystemWatcherDelay;
+    dir.completionPercentage = completionPercentage;
+    dir.scanningPercentage = scanningPercentage;
+    dir.completionByDevice = readCompletionMap();
+    dir.globalError = readString();
+    m_stream >> dir.pullErrorCount;
+    dir.itemErrors.resize(readCount());
+    for (auto &itemError : dir.itemErrors) {
+        itemError.message = readString();
+        itemError.path = readString();
+    }
+    dir.recentChanges.resize(readCount());
+    for (auto &change : dir.recentChanges) {
+        change.action = readString();
+        change.type = readString();
+        change.modifiedBy = readString();
+        change.path = readString();
+        change.eventTime = readDateTime();
+        m_stream >> change.local;
+    }
+    dir.globalStats = readStatistics();
+    dir.localStats = readStatistics();
+    dir.neededStats = readStatistics();
+    dir.receiveOnlyStats = readStatistics();
+    m_stream >> dir.lastStatisticsUpdateEvent;
+    dir.lastStatisticsUpdateTime = readDateTime();
+    dir.lastScanTime = readDateTime();
+    m_stream >> dir.lastFileEvent;
+    dir.lastFileTime = readDateTime();
+    dir.lastFileName = readString();
+    dir.rawStatus = readString();
+    auto flags = quint8();
+    m_stream >> flags;
+    dir.ignorePermissions = hasFlag(flags, DirFlags::IgnorePermissions);
+    dir.ignoreDelete = hasFlag(flags, DirFlags::IgnoreDelete);
+    dir.ignorePatterns = hasFlag(flags, DirFlags::IgnorePatterns);
+    dir.autoNormalize = hasFlag(flags, DirFlags::AutoNormalize);
+    dir.lastFileDeleted = hasFlag(flags, DirFlags::LastFileDeleted);
+    dir.fileSystemWatcherEnabled = hasFlag(flags, DirFlags::FileSystemWatcherEnabled);
+    dir.paused = hasFlag(flags, DirFlags::Paused);
+}
+
+void SnapshotReader::read(SyncthingDev &dev)
+{
+    auto totalIncomingTraffic = quint64(), totalOutgoingTraffic = quint64();
+    dev.id = readString();
+    dev.name = readString();
+    dev.addresses = readStringList();
+    dev.compression = readString();
+    dev.certName = readString();
+    dev.status = readEnum(SyncthingDevStatus::Rejected);
+    m_stream >> totalIncomingTraffic >> totalOutgoingTraffic;
+    dev.totalIncomingTraffic = totalIncomingTraffic;
+    dev.totalOutgoingTraffic = totalOutgoingTraffic;
+    dev.connectionAddress = readString();
+    dev.connectionType = readString();
+    dev.clientVersion = readString();
+    dev.disconnectReason = readString();
+    dev.lastSeen = readDateTime();
+    dev.completionByDir = readCompletionMap();
+    dev.overallCompletion = readCompletion();
+    auto flags = quint8();
+    m_stream >> flags;
+    dev.introducer = hasFlag(flags, DevFlags::Introducer);
+    dev.paused = hasFlag(flags, DevFlags::Paused);
+    dev.connectionLocal = hasFlag(flags, DevFlags::ConnectionLocal);
+}
+
+bool SnapshotReader::isOk() const
+{
+    return m_ok && m_stream.status() == QDataStream::Ok;
+}
+
+} // namespace
+/// \endcond
+
+/*!
+ * \brief Takes a snapshot of the current state of the specified \a connection.
+ */
+SyncthingStateSnapshot::SyncthingStateSnapshot(const SyncthingConnection &connection)
+    : myId(connection.myId())
+    , tilde(connection.tilde())
+    , pathSeparator(connection.pathSeparator())
+    , syncthingVersion(connection.syncthingVersion())
+    , dirs(connection.dirInfo())
+    , devs(connection.devInfo())
+{
+}
+
+/*!
+ * \brief Returns the snapshot in the binary format described in the class documentation.
+ */
+QByteArray SyncthingStateSnapshot::serialize() const
+{
+    auto writer = SnapshotWriter();
+    writer.write(*this);
+    return writer.finish();
+}
+
+/*!
+ * \brief Replaces the contents of the snapshot with the snapshot serialized in \a data.
+ * \returns Returns whether \a data could be deserialized. If not, the snapshot is left in an unspecified (but valid) state.
+ */
+bool SyncthingStateSnapshot::deserialize(const QByteArray &data)
+{
+    auto reader = SnapshotReader(data);
+    return reader.read(*this);
+}
+
+} // namespace Data
@@ -0,0 +1,40 @@
+#ifndef DATA_SYNCTHINGSTATESNAPSHOT_H
+#define DATA_SYNCTHINGSTATESNAPSHOT_H
+
+#include "./syncthingdev.h"
+#include "./syncthingdir.h"
+
+#include <QByteArray>
+#include <QString>
+
+#include <vector>
+
+namespace Data {
+
+class SyncthingConnection;
+
+struct LIB_SYNCTHING_CONNECTOR_EXPORT SyncthingStateSnapshot {
+    static constexpr quint32 magic = 0x53545353; // "STSS"
+    static constexpr quint16 version = 1;
+
+    explicit SyncthingStateSnapshot();
+    explicit SyncthingStateSnapshot(const SyncthingConnection &connection);
+
+    QByteArray serialize() const;
+    bool deserialize(const QByteArray &data);
+
+    QString myId;
+    QString tilde;
+    QString pathSeparator;
+    QString syncthingVersion;
+    std::vector<SyncthingDir> dirs;
+    std::vector<SyncthingDev> devs;
+};
+
+inline SyncthingStateSnapshot::SyncthingStateSnapshot()
+{
+}
+
+} // namespace Data
+
+#endif // DATA_SYNCTHINGSTATESNAPSHOT_H
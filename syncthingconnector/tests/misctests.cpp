@@ -1,8 +1,18 @@
+#include "../syncthingbrowseparser.h"
 #include "../syncthingconfig.h"
+#include "../syncthingconfigpatch.h"
+#include "../syncthingconfigtransaction.h"
 #include "../syncthingconnection.h"
+#include "../syncthingconnectionpool.h"
 #include "../syncthingconnectionsettings.h"
+#include "../syncthingjsondecoder.h"
+#include "../syncthinglogstore.h"
+#include "../syncthingpollingscheduler.h"
 #include "../syncthingprocess.h"
+#include "../syncthingprocessbuffer.h"
+#include "../syncthingreplylog.h"
 #include "../syncthingservice.h"
+#include "../syncthingstatesnapshot.h"
 #include "../utils.h"
 
 #include <c++utilities/chrono/datetime.h>
@@ -14,10 +24,29 @@
 
 #include <cppunit/TestFixture.h>
 
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QEventLoop>
 #include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QNetworkReply>
+#include <QThread>
+#include <QTimer>
 #include <QUrl>
+#include <QUrlQuery>
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string_view>
+#include <thread>
+#include <utility>
 
 using namespace std;
 using namespace Data;
@@ -35,11 +64,33 @@ class MiscTests : public TestFixture {
     CPPUNIT_TEST(testParsingConfigWithDetails);
     CPPUNIT_TEST(testSplittingArguments);
     CPPUNIT_TEST(testUtils);
+    CPPUNIT_TEST(testParsingTimeStamps);
+    CPPUNIT_TEST(testEventTypes);
 #ifdef LIB_SYNCTHING_CONNECTOR_SUPPORT_SYSTEMD
     CPPUNIT_TEST(testService);
 #endif
     CPPUNIT_TEST(testConnectionSettingsAndLoadingSelfSignedCert);
     CPPUNIT_TEST(testSyncthingDir);
+    CPPUNIT_TEST(testPollingScheduler);
+    CPPUNIT_TEST(testConnectionPool);
+    CPPUNIT_TEST(testBrowseParser);
+    CPPUNIT_TEST(testJsonDecoder);
+    CPPUNIT_TEST(testProcessBuffer);
+    CPPUNIT_TEST(testLogStore);
+    CPPUNIT_TEST(testRequestingNewLogEntries);
+    CPPUNIT_TEST(testOverallDirStatistics);
+    CPPUNIT_TEST(testApplyingConfigIncrementally);
+    CPPUNIT_TEST(testStateSnapshot);
+    CPPUNIT_TEST(testReplyLog);
+    CPPUNIT_TEST(testRecordingErrorReplies);
+    CPPUNIT_TEST(testRecordingIncrementalBrowsing);
+    CPPUNIT_TEST(testReplayingEvents);
+    CPPUNIT_TEST(testConfigPatch);
+    CPPUNIT_TEST(testConfigTransaction);
+    CPPUNIT_TEST(testCommittingConfigTransaction);
+#if defined(LIB_SYNCTHING_CONNECTOR_BOOST_PROCESS) && defined(PLATFORM_UNIX)
+    CPPUNIT_TEST(testProcessOutput);
+#endif
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -49,6 +100,8 @@ public:
     void testParsingConfigWithDetails();
     void testSplittingArguments();
     void testUtils();
+    void testParsingTimeStamps();
+    void testEventTypes();
 #ifdef LIB_SYNCTHING_CONNECTOR_SUPPORT_SYSTEMD
     void testService();
 #endif
@@ -56,6 +109,26 @@ public:
     void testConnectionSettingsAndLoadingSelfSignedCert();
 #endif
     void testSyncthingDir();
+    void testPollingScheduler();
+    void testConnectionPool();
+    void testBrowseParser();
+    void testJsonDecoder();
+    void testProcessBuffer();
+    void testLogStore();
+    void testRequestingNewLogEntries();
+    void testOverallDirStatistics();
+    void testApplyingConfigIncrementally();
+    void testStateSnapshot();
+    void testReplyLog();
+    void testRecordingErrorReplies();
+    void testRecordingIncrementalBrowsing();
+    void testReplayingEvents();
+    void testConfigPatch();
+    void testConfigTransaction();
+    void testCommittingConfigTransaction();
+#if defined(LIB_SYNCTHING_CONNECTOR_BOOST_PROCESS) && defined(PLATFORM_UNIX)
+    void testProcessOutput();
+#endif
 
     void setUp() override;
     void tearDown() override;
@@ -101,6 +174,30 @@ void MiscTests::testParsingConfig()
     CPPUNIT_ASSERT_EQUAL_MESSAGE("url", QStringLiteral("http://127.0.0.1:4001"), config.syncthingUrl());
     config.guiEnforcesSecureConnection = true;
     CPPUNIT_ASSERT_EQUAL_MESSAGE("url", QStringLiteral("https://127.0.0.1:4001"), config.syncthingUrl());
+
+    // reading only up to the <gui> element yields the same as reading the whole file
+    auto detailedConfig = SyncthingConfig();
+    CPPUNIT_ASSERT(detailedConfig.restore(QString::fromLocal8Bit(testFilePath("testconfig/config.xml").data()), true));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("version", detailedConfig.version, config.version);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("address (detailed)", detailedConfig.guiAddress, config.guiAddress);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("API key (detailed)", detailedConfig.guiApiKey, config.guiApiKey);
+
+    // cached results are invalidated when the file changes
+    const auto workingCopy = QString::fromLocal8Bit(workingCopyPath("testconfig/config.xml").data());
+    CPPUNIT_ASSERT(config.restore(workingCopy));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("address (working copy)", QStringLiteral("127.0.0.1:4001"), config.guiAddress);
+    auto workingCopyFile = QFile(workingCopy);
+    CPPUNIT_ASSERT(workingCopyFile.open(QFile::ReadOnly));
+    auto contents = workingCopyFile.readAll();
+    workingCopyFile.close();
+    contents.replace("<address>127.0.0.1:4001</address>", "<address>127.0.0.1:40001</address>");
+    CPPUNIT_ASSERT(workingCopyFile.open(QFile::WriteOnly | QFile::Truncate));
+    CPPUNIT_ASSERT_EQUAL(static_cast<qint64>(contents.size()), workingCopyFile.write(contents));
+    workingCopyFile.close();
+    CPPUNIT_ASSERT(config.restore(workingCopy));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("address (modified)", QStringLiteral("127.0.0.1:40001"), config.guiAddress);
+    SyncthingConfig::clearCache();
+
     const QString configFile(SyncthingConfig::locateConfigFile());
     CPPUNIT_ASSERT(configFile.isEmpty() || QFile::exists(configFile));
     const QString httpsCert(SyncthingConfig::locateHttpsCertificate());
@@ -216,6 +313,83 @@ void MiscTests::testUtils()
     CPPUNIT_ASSERT_EQUAL(QStringLiteral("/home/foo"), substituteTilde(QStringLiteral("~"), QStringLiteral("/home/foo"), QStringLiteral("\\")));
 }
 
+/*!
+ * \brief Tests parseIsoTimeStamp() against DateTime::fromIsoString() and compares their performance.
+ */
+void MiscTests::testParsingTimeStamps()
+{
+    auto localTime = DateTime();
+    auto utcOffset = TimeSpan();
+    for (const auto *const timeStamp : { "2024-02-29T23:59:59Z", "2024-05-01T12:34:56.1234567+02:00", "1970-01-01T00:00:00.5-05:30",
+             "2016-12-31T00:00:00.12Z", "2023-11-08T17:21:54.8913968+01:00" }) {
+        CPPUNIT_ASSERT_MESSAGE(timeStamp, parseIsoTimeStamp(QString::fromLatin1(timeStamp), localTime, utcOffset));
+        const auto expected = DateTime::fromIsoString(timeStamp);
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(timeStamp, expected.first.toString(), localTime.toString());
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(timeStamp, expected.second.totalTicks(), utcOffset.totalTicks());
+    }
+    CPPUNIT_ASSERT(parseIsoTimeStamp(QStringLiteral("2024-05-01T12:34:56.123456789+02:00"), localTime, utcOffset));
+    CPPUNIT_ASSERT_EQUAL((DateTime::fromDateAndTime(2024, 5, 1, 12, 34, 56) + TimeSpan(1234567)).totalTicks(), localTime.totalTicks());
+    CPPUNIT_ASSERT_EQUAL(TimeSpan::fromHours(2.0).totalTicks(), utcOffset.totalTicks());
+    for (const auto *const timeStamp : { "", "2024-05-01", "2023-02-29T00:00:00Z", "2024-13-01T00:00:00Z", "2024-05-01T24:00:00Z",
+             "2024-05-01T12:34:56", "2024-05-01T12:34:56.Z", "2024-05-01T12:34:56+0200", "2024-05-01T12:34:56Z ", "2024-05-0aT12:34:56Z" }) {
+        CPPUNIT_ASSERT_MESSAGE(timeStamp, !parseIsoTimeStamp(QString::fromLatin1(timeStamp), localTime, utcOffset));
+    }
+
+    // compare against converting to UTF-8 and using DateTime::fromIsoString() as done before for every time stamp
+    constexpr auto iterations = 100000;
+    const auto timeStamp = QStringLiteral("2023-11-08T17:21:54.8913968+01:00");
+    auto checksum = std::uint64_t();
+    const auto fromIsoStringStart = std::chrono::steady_clock::now();
+    for (auto i = 0; i != iterations; ++i) {
+        checksum += DateTime::fromIsoString(timeStamp.toUtf8().data()).first.totalTicks();
+    }
+    const auto fromIsoStringDuration = std::chrono::steady_clock::now() - fromIsoStringStart;
+    const auto parseIsoTimeStampStart = std::chrono::steady_clock::now();
+    for (auto i = 0; i != iterations; ++i) {
+        parseIsoTimeStamp(timeStamp, localTime, utcOffset);
+        checksum -= localTime.totalTicks();
+    }
+    const auto parseIsoTimeStampDuration = std::chrono::steady_clock::now() - parseIsoTimeStampStart;
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(), checksum);
+    std::cout << "\n - parsing " << iterations << " time stamps via UTF-8 conversion and DateTime::fromIsoString(): "
+              << std::chrono::duration_cast<std::chrono::microseconds>(fromIsoStringDuration).count() << " µs"
+              << "\n - parsing " << iterations << " time stamps via parseIsoTimeStamp(): "
+              << std::chrono::duration_cast<std::chrono::microseconds>(parseIsoTimeStampDuration).count() << " µs\n";
+}
+
+/*!
+ * \brief Tests looking up event types via syncthingEventType() and counting events.
+ */
+void MiscTests::testEventTypes()
+{
+    for (auto i = std::size_t(1); i != syncthingEventTypeCount; ++i) {
+        const auto type = static_cast<SyncthingEventType>(i);
+        const auto name = syncthingEventTypeLatin1Name(type);
+        CPPUNIT_ASSERT_MESSAGE(std::string(syncthingEventTypeName(type)), syncthingEventType(QString(name)) == type);
+    }
+    for (const auto *const name : { "", "Folder", "FolderWatchStateChanged", "Startinh", "starting", "DeviceDiscovered" }) {
+        CPPUNIT_ASSERT_MESSAGE(name, syncthingEventType(QString::fromLatin1(name)) == SyncthingEventType::Unknown);
+    }
+
+    auto connection = SyncthingConnection();
+    const auto events = QJsonDocument::fromJson(R"([
+        {"id": 1, "type": "LocalChangeDetected", "data": {"folder": "unknown"}},
+        {"id": 2, "type": "FolderPaused", "data": {"id": "unknown"}},
+        {"id": 3, "type": "FolderPaused", "data": {"id": "unknown"}},
+        {"id": 4, "type": "DeviceDiscovered", "data": {}}
+    ])").array();
+    auto lastEventId = quint64();
+    CPPUNIT_ASSERT(connection.readEventsFromJsonArray(events, lastEventId));
+    CPPUNIT_ASSERT_EQUAL(quint64(4), lastEventId);
+    const auto &counts = connection.eventCounts();
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(1), counts[static_cast<std::size_t>(SyncthingEventType::LocalChangeDetected)]);
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(2), counts[static_cast<std::size_t>(SyncthingEventType::FolderPaused)]);
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(1), counts[static_cast<std::size_t>(SyncthingEventType::Unknown)]);
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(0), counts[static_cast<std::size_t>(SyncthingEventType::Starting)]);
+    connection.resetEventCounts();
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(0), connection.eventCounts()[static_cast<std::size_t>(SyncthingEventType::FolderPaused)]);
+}
+
 #ifdef LIB_SYNCTHING_CONNECTOR_SUPPORT_SYSTEMD
 /*!
  * \brief Tests SyncthingService class, but only error cases with a non-existent service so far.
@@ -342,3 +516,1380 @@ void MiscTests::testSyncthingDir()
     CPPUNIT_ASSERT_MESSAGE("same status again not considered an update",
         !dir.assignStatus(QStringLiteral("idle"), updateEvent += 1, updateTime += TimeSpan::fromMinutes(1.5)));
 }
+
+void MiscTests::testPollingScheduler()
+{
+    auto scheduler = SyncthingPollingScheduler();
+    scheduler.setSlotDuration(100);
+    CPPUNIT_ASSERT_EQUAL(std::int64_t(0), scheduler.alignToSlot(0));
+    CPPUNIT_ASSERT_EQUAL(std::int64_t(100), scheduler.alignToSlot(1));
+    CPPUNIT_ASSERT_EQUAL(std::int64_t(200), scheduler.alignToSlot(200));
+
+    // register tasks
+    auto runs = std::vector<QString>();
+    auto receiver = QObject();
+    const auto traffic = scheduler.addTask(
+        QStringLiteral("traffic"), &receiver, [&runs] { runs.emplace_back(QStringLiteral("traffic")); }, 150, SyncthingPollingTaskFlags::Adaptive);
+    const auto errors = scheduler.addTask(QStringLiteral("errors"), &receiver, [&runs] { runs.emplace_back(QStringLiteral("errors")); }, 180);
+    const auto reconnect = scheduler.addTask(QStringLiteral("reconnect"), &receiver, [&runs] { runs.emplace_back(QStringLiteral("reconnect")); },
+        0, SyncthingPollingTaskFlags::Repeating);
+    CPPUNIT_ASSERT_EQUAL(3_st, scheduler.taskCount());
+    CPPUNIT_ASSERT_MESSAGE("tasks initially inactive", !scheduler.isActive(traffic) && !scheduler.isActive(errors));
+    CPPUNIT_ASSERT_EQUAL(std::int64_t(-1), scheduler.nextWakeup());
+    scheduler.start(reconnect);
+    CPPUNIT_ASSERT_MESSAGE("task with zero interval not started", !scheduler.isActive(reconnect));
+
+    // adapt intervals to visibility and activity
+    scheduler.setUiVisible(false);
+    CPPUNIT_ASSERT_EQUAL(150 * static_cast<int>(scheduler.backgroundFactor()), scheduler.effectiveInterval(traffic));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("non-adaptive task not stretched", 180, scheduler.effectiveInterval(errors));
+    scheduler.setUiVisible(true);
+    scheduler.reportActivity(traffic, false);
+    CPPUNIT_ASSERT_EQUAL(300, scheduler.effectiveInterval(traffic));
+    for (auto i = 0; i != 10; ++i) {
+        scheduler.reportActivity(traffic, false);
+    }
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("back-off limited", 150 << scheduler.maxIdleLevel(), scheduler.effectiveInterval(traffic));
+    scheduler.reportActivity(traffic, true);
+    CPPUNIT_ASSERT_EQUAL(150, scheduler.effectiveInterval(traffic));
+
+    // use a fake clock so the test does not depend on timing
+    auto time = std::int64_t(1234);
+    scheduler.setClock([&time] { return time; });
+    CPPUNIT_ASSERT_EQUAL(std::int64_t(1234), scheduler.now());
+    auto scheduleChanges = 0;
+    QObject::connect(&scheduler, &SyncthingPollingScheduler::scheduleChanged, [&scheduleChanges] { ++scheduleChanges; });
+
+    // start tasks which are supposed to end up in the same slot
+    scheduler.setSlotDuration(1000);
+    scheduler.start(traffic);
+    scheduler.start(errors);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("starting tasks changes schedule", 2, scheduleChanges);
+    const auto schedule = scheduler.schedule();
+    CPPUNIT_ASSERT_EQUAL(3_st, schedule.size());
+    CPPUNIT_ASSERT_MESSAGE("active tasks first", schedule[0].active && schedule[1].active && !schedule[2].active);
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("reconnect"), schedule[2].name);
+    for (const auto &entry : schedule) {
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("due time aligned to slot", std::int64_t(0), entry.dueTime % scheduler.slotDuration());
+    }
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("tasks share slot", schedule[0].dueTime, schedule[1].dueTime);
+    CPPUNIT_ASSERT_EQUAL(std::int64_t(2000), scheduler.nextWakeup());
+    CPPUNIT_ASSERT_EQUAL(std::int64_t(766), scheduler.remainingTime(traffic));
+
+    // tasks are not run before they are due
+    time = 1400;
+    scheduler.runDueTasks();
+    CPPUNIT_ASSERT(runs.empty());
+    CPPUNIT_ASSERT(scheduler.isActive(traffic) && scheduler.isActive(errors));
+
+    // run tasks
+    time = 2000;
+    scheduler.runDueTasks();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("both tasks run within one wakeup", 2_st, runs.size());
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(2), scheduler.wakeupCount());
+    CPPUNIT_ASSERT_MESSAGE("single-shot tasks inactive after run", !scheduler.isActive(traffic) && !scheduler.isActive(errors));
+    CPPUNIT_ASSERT_EQUAL(std::int64_t(-1), scheduler.nextWakeup());
+
+    // stopping and changing the interval changes the schedule as well
+    scheduler.start(errors);
+    scheduleChanges = 0;
+    scheduler.stop(errors);
+    CPPUNIT_ASSERT_EQUAL(1, scheduleChanges);
+    scheduler.setInterval(errors, 500);
+    CPPUNIT_ASSERT_EQUAL(2, scheduleChanges);
+    CPPUNIT_ASSERT_EQUAL(500, scheduler.interval(errors));
+
+    // repeating tasks stay active and are re-scheduled relative to the time they have been run
+    scheduler.setSlotDuration(100);
+    scheduler.setInterval(reconnect, 50);
+    scheduler.start(reconnect);
+    CPPUNIT_ASSERT_EQUAL(std::int64_t(2100), scheduler.nextWakeup());
+    time = 2100;
+    scheduler.runDueTasks();
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("reconnect"), runs.back());
+    CPPUNIT_ASSERT(scheduler.isActive(reconnect));
+    CPPUNIT_ASSERT_EQUAL(std::int64_t(2200), scheduler.nextWakeup());
+    scheduleChanges = 0;
+    scheduler.setInterval(reconnect, 0);
+    CPPUNIT_ASSERT_MESSAGE("setting interval to zero stops task", !scheduler.isActive(reconnect));
+    CPPUNIT_ASSERT_EQUAL(1, scheduleChanges);
+
+    // tasks are removed together with their receiver
+    scheduler.removeTask(errors);
+    CPPUNIT_ASSERT(!scheduler.hasTask(errors));
+    scheduler.removeTasks(&receiver);
+    CPPUNIT_ASSERT_EQUAL(0_st, scheduler.taskCount());
+}
+
+void MiscTests::testConnectionPool()
+{
+    auto pool = SyncthingConnectionPool();
+    auto settings = std::vector<SyncthingConnectionSettings>(100);
+    auto index = 0;
+    for (auto &connectionSettings : settings) {
+        connectionSettings.label = QStringLiteral("node %1").arg(++index);
+        connectionSettings.syncthingUrl = QStringLiteral("http://127.0.0.1:%1").arg(8000 + index);
+    }
+    pool.setConnections(settings);
+    CPPUNIT_ASSERT_EQUAL(100, pool.connectionCount());
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("node 1"), pool.node(0)->label);
+    CPPUNIT_ASSERT_EQUAL(1, pool.indexOf(pool.connection(1)));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("all connections share one scheduler", &pool.pollingScheduler(), pool.connection(99)->pollingScheduler());
+    CPPUNIT_ASSERT_EQUAL(400_st, pool.pollingScheduler().taskCount());
+
+    // start all tasks with the same interval at once as happens when all nodes are connected at the same time; wakeups must not
+    // grow with the number of nodes
+    auto &scheduler = pool.pollingScheduler();
+    for (const auto &entry : scheduler.schedule()) {
+        scheduler.setInterval(entry.id, 5000);
+        scheduler.start(entry.id);
+    }
+    auto distinctDueTimes = std::vector<std::int64_t>();
+    for (const auto &entry : scheduler.schedule()) {
+        CPPUNIT_ASSERT(entry.active);
+        if (std::find(distinctDueTimes.begin(), distinctDueTimes.end(), entry.dueTime) == distinctDueTimes.end()) {
+            distinctDueTimes.emplace_back(entry.dueTime);
+        }
+    }
+    CPPUNIT_ASSERT_MESSAGE("tasks of all nodes due within at most two slots", distinctDueTimes.size() <= 2);
+
+    // removing connections removes their tasks
+    pool.removeConnection(0);
+    CPPUNIT_ASSERT_EQUAL(99, pool.connectionCount());
+    CPPUNIT_ASSERT_EQUAL(396_st, scheduler.taskCount());
+    CPPUNIT_ASSERT_EQUAL(99, pool.statistics().nodeCount);
+    CPPUNIT_ASSERT_EQUAL(0, pool.statistics().connectedNodes);
+    pool.clear();
+    CPPUNIT_ASSERT_EQUAL(0_st, scheduler.taskCount());
+}
+
+void MiscTests::testBrowseParser()
+{
+    auto file = QFile(QString::fromLocal8Bit(testFilePath("mocks/browse.json").data()));
+    CPPUNIT_ASSERT(file.open(QFile::ReadOnly));
+    const auto response = file.readAll();
+    auto expectedItems = std::vector<std::unique_ptr<SyncthingItem>>();
+    SyncthingBrowseParser::readItems(QJsonDocument::fromJson(response).array(), expectedItems, 0, 0);
+    CPPUNIT_ASSERT(!expectedItems.empty());
+
+    // feed the response in chunks of different sizes (including single bytes) and compare with parsing the whole document
+    for (const auto chunkSize : { 1, 7, 64, static_cast<int>(response.size()) }) {
+        auto parser = SyncthingBrowseParser();
+        auto items = std::vector<std::unique_ptr<SyncthingItem>>();
+        for (auto offset = 0; offset < response.size(); offset += chunkSize) {
+            parser.feed(response.mid(offset, chunkSize));
+            for (auto &item : parser.takeItems()) {
+                items.emplace_back(std::move(item));
+            }
+        }
+        parser.finish();
+        CPPUNIT_ASSERT_MESSAGE(parser.errorString().toStdString(), !parser.hasError());
+        CPPUNIT_ASSERT(parser.isComplete());
+        CPPUNIT_ASSERT_EQUAL(expectedItems.size(), items.size());
+        CPPUNIT_ASSERT_EQUAL(expectedItems.size(), parser.totalItemCount());
+        for (auto i = std::size_t(); i != items.size(); ++i) {
+            CPPUNIT_ASSERT_EQUAL(expectedItems[i]->name, items[i]->name);
+            CPPUNIT_ASSERT_EQUAL(i, items[i]->index);
+            CPPUNIT_ASSERT_EQUAL(expectedItems[i]->size, items[i]->size);
+            CPPUNIT_ASSERT_EQUAL(expectedItems[i]->children.size(), items[i]->children.size());
+            CPPUNIT_ASSERT(expectedItems[i]->type == items[i]->type);
+            CPPUNIT_ASSERT(expectedItems[i]->modificationTime == items[i]->modificationTime);
+        }
+    }
+
+    // scalar elements are skipped, strings containing structural characters are handled and truncation is detected
+    auto parser = SyncthingBrowseParser(1);
+    parser.feed(QByteArrayLiteral(R"([1, "]", {"name": "a]\"}", "type": 1}, {"name": "b", "children": [{"name": "c"}]}, {"name": )"));
+    auto items = parser.takeItems();
+    CPPUNIT_ASSERT_EQUAL(2_st, items.size());
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("a]\"}"), items[0]->name);
+    CPPUNIT_ASSERT(items[0]->type == SyncthingItemType::Directory);
+    CPPUNIT_ASSERT_EQUAL(1_st, items[1]->index);
+    CPPUNIT_ASSERT_EQUAL(1_st, items[1]->children.size());
+    CPPUNIT_ASSERT(!parser.isComplete());
+    parser.finish();
+    CPPUNIT_ASSERT(parser.hasError());
+
+    // non-array responses are rejected
+    auto errorParser = SyncthingBrowseParser();
+    errorParser.feed(QByteArrayLiteral(R"({"error": "no such folder"})"));
+    CPPUNIT_ASSERT(errorParser.hasError());
+}
+
+void MiscTests::testJsonDecoder()
+{
+    auto context = QObject();
+    auto decoder = SyncthingJsonDecoder(&context);
+    auto results = std::vector<int>();
+    const auto decode = [](const QByteArray &data) { return QJsonDocument::fromJson(data).array().size(); };
+    const auto apply = [&results](auto size) { results.emplace_back(static_cast<int>(size)); };
+
+    // small responses are decoded immediately
+    decoder.decode(QByteArrayLiteral("[1]"), decode, apply);
+    CPPUNIT_ASSERT_EQUAL(1_st, results.size());
+    CPPUNIT_ASSERT_EQUAL(1, results.back());
+    CPPUNIT_ASSERT_EQUAL(0_st, decoder.pendingCount());
+
+    // responses exceeding the threshold are decoded in the background and applied in order via the event loop
+    decoder.setThreshold(0);
+    decoder.decode(QByteArrayLiteral("[1, 2]"), decode, apply);
+    decoder.decode(QByteArrayLiteral("[1, 2, 3]"), decode, apply);
+    CPPUNIT_ASSERT_EQUAL(2_st, decoder.pendingCount());
+    decoder.waitForDone();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("results not applied before the event loop is processed", 1_st, results.size());
+    QCoreApplication::processEvents();
+    CPPUNIT_ASSERT_EQUAL(3_st, results.size());
+    CPPUNIT_ASSERT_EQUAL(2, results[1]);
+    CPPUNIT_ASSERT_EQUAL(3, results[2]);
+    CPPUNIT_ASSERT_EQUAL(0_st, decoder.pendingCount());
+
+    // small responses do not overtake large responses which are still pending
+    decoder.setThreshold(8);
+    decoder.decode(QByteArrayLiteral("[1, 2, 3, 4]"), decode, apply);
+    decoder.decode(QByteArrayLiteral("[1]"), decode, apply);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("small response queued behind large one", 3_st, results.size());
+    CPPUNIT_ASSERT_EQUAL(2_st, decoder.pendingCount());
+    decoder.waitForDone();
+    QCoreApplication::processEvents();
+    CPPUNIT_ASSERT_EQUAL(5_st, results.size());
+    CPPUNIT_ASSERT_EQUAL(4, results[3]);
+    CPPUNIT_ASSERT_EQUAL(1, results[4]);
+    CPPUNIT_ASSERT_EQUAL(0_st, decoder.pendingCount());
+    decoder.decode(QByteArrayLiteral("[1, 2]"), decode, apply);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("small response decoded immediately again", 6_st, results.size());
+
+    // invalidated results are discarded
+    decoder.setThreshold(0);
+    decoder.decode(QByteArrayLiteral("[1, 2, 3, 4]"), decode, apply);
+    decoder.invalidate();
+    decoder.waitForDone();
+    QCoreApplication::processEvents();
+    CPPUNIT_ASSERT_EQUAL(6_st, results.size());
+    CPPUNIT_ASSERT_EQUAL(0_st, decoder.pendingCount());
+}
+
+void MiscTests::testProcessBuffer()
+{
+    // writing directly into the buffer makes data visible only after committing it
+    auto buffer = SyncthingProcessBuffer(16, 64);
+    auto [space, spaceSize] = buffer.prepareWrite();
+    CPPUNIT_ASSERT_EQUAL(16_st, spaceSize);
+    std::memcpy(space, "foo", 3);
+    CPPUNIT_ASSERT(buffer.isEmpty());
+    CPPUNIT_ASSERT_MESSAGE("consumer needs to be notified", buffer.commitWrite(3));
+    CPPUNIT_ASSERT_EQUAL(3_st, buffer.size());
+
+    // the buffer grows beyond the block size
+    CPPUNIT_ASSERT_EQUAL(40_st, buffer.write("0123456789012345678901234567890123456789", 40));
+    CPPUNIT_ASSERT_EQUAL(43_st, buffer.size());
+    CPPUNIT_ASSERT(!buffer.isAboveHighWaterMark());
+    buffer.write("012345678901234567890", 21);
+    CPPUNIT_ASSERT(buffer.isAboveHighWaterMark());
+    char data[128];
+    CPPUNIT_ASSERT_EQUAL(5_st, buffer.read(data, 5));
+    CPPUNIT_ASSERT_EQUAL(std::string_view("foo01"), std::string_view(data, 5));
+    CPPUNIT_ASSERT_EQUAL(59_st, buffer.read(data, sizeof(data)));
+    CPPUNIT_ASSERT_EQUAL(std::string_view("23456789012345678901234567890123456789012345678901234567890"), std::string_view(data, 59));
+    CPPUNIT_ASSERT(buffer.isEmpty());
+    CPPUNIT_ASSERT(buffer.isBelowLowWaterMark());
+    CPPUNIT_ASSERT_EQUAL(0_st, buffer.read(data, sizeof(data)));
+
+    // pump data through the buffer from another thread obeying the high-water mark
+    constexpr auto totalSize = std::size_t(64 * 1024 * 1024);
+    auto concurrentBuffer = SyncthingProcessBuffer(4096, 256 * 1024);
+    auto producer = std::thread([&concurrentBuffer] {
+        for (auto written = std::size_t(); written < totalSize;) {
+            if (concurrentBuffer.isAboveHighWaterMark()) {
+                std::this_thread::yield();
+                continue;
+            }
+            auto [chunk, chunkSize] = concurrentBuffer.prepareWrite();
+            chunkSize = std::min(chunkSize, totalSize - written);
+            for (auto i = std::size_t(); i != chunkSize; ++i) {
+                chunk[i] = static_cast<char>((written + i) % 251);
+            }
+            concurrentBuffer.commitWrite(chunkSize);
+            written += chunkSize;
+        }
+    });
+    auto bytesRead = std::size_t(), mismatches = std::size_t(), maxSize = std::size_t();
+    while (bytesRead < totalSize) {
+        maxSize = std::max(maxSize, concurrentBuffer.size());
+        const auto chunkSize = concurrentBuffer.read(data, sizeof(data));
+        for (auto i = std::size_t(); i != chunkSize; ++i) {
+            mismatches += data[i] != static_cast<char>((bytesRead + i) % 251);
+        }
+        bytesRead += chunkSize;
+    }
+    producer.join();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("data read in the order it has been written", 0_st, mismatches);
+    CPPUNIT_ASSERT_EQUAL(totalSize, bytesRead);
+    CPPUNIT_ASSERT_MESSAGE("buffer does not grow much beyond high-water mark", maxSize <= 256 * 1024 + 4096);
+    CPPUNIT_ASSERT(concurrentBuffer.isEmpty());
+}
+
+#if defined(LIB_SYNCTHING_CONNECTOR_BOOST_PROCESS) && defined(PLATFORM_UNIX)
+/*!
+ * \brief Pumps a lot of output through a child process while the consumer is occasionally slow.
+ */
+void MiscTests::testProcessOutput()
+{
+    constexpr auto pattern = std::string_view("0123456789abcdef\n");
+    constexpr auto totalSize = std::size_t(256 * 1024 * 1024);
+    auto process = SyncthingProcess();
+    auto loop = QEventLoop();
+    auto timeout = QTimer();
+    auto data = std::vector<char>(256 * 1024);
+    auto bytesRead = std::size_t(), mismatches = std::size_t(), notifications = std::size_t();
+    auto maxBuffered = qint64();
+    timeout.setSingleShot(true);
+    timeout.setInterval(120000);
+    QObject::connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+    QObject::connect(&process, &SyncthingProcess::readyRead, &loop, [&] {
+        // simulate a slow consumer from time to time so the producer runs into the high-water mark
+        if (++notifications % 16 == 1) {
+            QThread::msleep(20);
+        }
+        maxBuffered = std::max(maxBuffered, process.bytesAvailable());
+        for (auto chunkSize = qint64(); (chunkSize = process.read(data.data(), static_cast<qint64>(data.size()))) > 0;) {
+            for (auto i = std::size_t(); i != static_cast<std::size_t>(chunkSize); ++i) {
+                mismatches += data[i] != pattern[(bytesRead + i) % pattern.size()];
+            }
+            bytesRead += static_cast<std::size_t>(chunkSize);
+        }
+        if (bytesRead >= totalSize) {
+            loop.quit();
+        }
+    });
+
+    process.start(QStringLiteral("sh"),
+        QStringList{ QStringLiteral("-c"), QStringLiteral("yes 0123456789abcdef | head -c %1").arg(static_cast<qulonglong>(totalSize)) });
+    timeout.start();
+    loop.exec();
+    CPPUNIT_ASSERT_MESSAGE("all output read before timeout", timeout.isActive());
+    CPPUNIT_ASSERT_EQUAL(totalSize, bytesRead);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("output read in order", 0_st, mismatches);
+    CPPUNIT_ASSERT_MESSAGE("buffered output bounded by high-water mark",
+        maxBuffered <= static_cast<qint64>(SyncthingProcessBuffer::defaultHighWaterMark + SyncthingProcessBuffer::defaultBlockSize));
+    CPPUNIT_ASSERT(process.waitForFinished(10000));
+}
+#endif
+
+void MiscTests::testLogStore()
+{
+    auto store = SyncthingLogStore(3);
+    CPPUNIT_ASSERT(store.isEmpty());
+    CPPUNIT_ASSERT(store.lastTimestamp().isEmpty());
+    CPPUNIT_ASSERT_MESSAGE("appending nothing yields empty range", store.append({}) == std::make_pair(0_st, 0_st));
+
+    // entries are appended with increasing indices
+    auto range = store.append(
+        { SyncthingLogEntry(QStringLiteral("t1"), QStringLiteral("m1")), SyncthingLogEntry(QStringLiteral("t2"), QStringLiteral("m2")) });
+    CPPUNIT_ASSERT_EQUAL(0_st, range.first);
+    CPPUNIT_ASSERT_EQUAL(2_st, range.second);
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("t2"), store.lastTimestamp());
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("m1"), store.at(0).message);
+
+    // oldest entries are dropped when exceeding the capacity but indices keep referring to the same entries
+    range = store.append(
+        { SyncthingLogEntry(QStringLiteral("t3"), QStringLiteral("m3")), SyncthingLogEntry(QStringLiteral("t4"), QStringLiteral("m4")) });
+    CPPUNIT_ASSERT_EQUAL(2_st, range.first);
+    CPPUNIT_ASSERT_EQUAL(4_st, range.second);
+    CPPUNIT_ASSERT_EQUAL(3_st, store.size());
+    CPPUNIT_ASSERT_EQUAL(1_st, store.beginIndex());
+    CPPUNIT_ASSERT(!store.contains(0));
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("m2"), store.at(1).message);
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("m4"), store.at(3).message);
+
+    // the returned range only covers retained entries
+    range = store.append({ SyncthingLogEntry(QStringLiteral("t5")), SyncthingLogEntry(QStringLiteral("t6")), SyncthingLogEntry(QStringLiteral("t7")),
+        SyncthingLogEntry(QStringLiteral("t8")) });
+    CPPUNIT_ASSERT_EQUAL(5_st, range.first);
+    CPPUNIT_ASSERT_EQUAL(8_st, range.second);
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("t6"), store.at(5).when);
+
+    // clearing keeps indices monotonic but resets the timestamp
+    store.clear();
+    CPPUNIT_ASSERT(store.isEmpty());
+    CPPUNIT_ASSERT_EQUAL(8_st, store.beginIndex());
+    CPPUNIT_ASSERT(store.lastTimestamp().isEmpty());
+}
+
+/*!
+ * \brief Tests fetching the log incrementally via SyncthingConnection::requestNewLogEntries() using recorded replies.
+ */
+void MiscTests::testRequestingNewLogEntries()
+{
+    // record replies like Syncthing would return them initially and when passing "since"
+    auto buffer = QBuffer();
+    CPPUNIT_ASSERT(buffer.open(QIODevice::WriteOnly));
+    auto recorder = SyncthingReplyRecorder(&buffer);
+    auto recordedReply = SyncthingRecordedReply();
+    recordedReply.verb = QByteArrayLiteral("GET");
+    recordedReply.path = QStringLiteral("/rest/system/log");
+    recordedReply.httpStatus = 200;
+    recordedReply.response = QByteArrayLiteral(R"({"messages": [
+        {"when": "2024-05-01T12:34:55.000000001+02:00", "message": "first"},
+        {"when": "2024-05-01T12:34:56.123456789+02:00", "message": "second"}
+    ]})");
+    recorder.record(recordedReply);
+    recordedReply.response = QByteArrayLiteral(R"({"messages": [{"when": "2024-05-01T12:35:00.5+02:00", "message": "third"}]})");
+    recorder.record(recordedReply);
+    recordedReply.response = QByteArrayLiteral(R"({"messages": [{"when": "2024-05-01T12:35:01+02:00", "message": "fourth"}]})");
+    recorder.record(recordedReply);
+    buffer.close();
+    auto replayer = SyncthingReplyReplayer(SyncthingReplayMode::AsFastAsPossible);
+    CPPUNIT_ASSERT(buffer.open(QIODevice::ReadOnly));
+    CPPUNIT_ASSERT(replayer.load(&buffer));
+
+    auto connection = SyncthingConnection(QStringLiteral("http://127.0.0.1:8384"), QByteArray());
+    connection.setReplyReplayer(&replayer);
+    const auto requestNewLogEntries = [&connection] {
+        connection.requestNewLogEntries();
+        CPPUNIT_ASSERT(connection.m_logReply);
+        return connection.m_logReply->url();
+    };
+
+    // initially the whole log is requested
+    auto url = QUrl();
+    CPPUNIT_ASSERT(waitForSignals([&] { url = requestNewLogEntries(); }, 1000,
+        signalInfo(&connection, &SyncthingConnection::logEntriesAppended)));
+    CPPUNIT_ASSERT(!QUrlQuery(url).hasQueryItem(QStringLiteral("since")));
+    CPPUNIT_ASSERT_EQUAL(2_st, connection.logStore().size());
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("2024-05-01T12:34:56.123456789+02:00"), connection.logStore().lastTimestamp());
+
+    // the timestamp of the last entry is passed as "since" with the plus sign of the UTC offset being percent-encoded
+    CPPUNIT_ASSERT(waitForSignals([&] { url = requestNewLogEntries(); }, 1000,
+        signalInfo(&connection, &SyncthingConnection::logEntriesAppended)));
+    const auto encodedQuery = url.query(QUrl::FullyEncoded);
+    CPPUNIT_ASSERT_MESSAGE(encodedQuery.toStdString(), encodedQuery.contains(QLatin1String("%2B02")));
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("2024-05-01T12:34:56.123456789+02:00"),
+        QUrlQuery(url).queryItemValue(QStringLiteral("since"), QUrl::FullyDecoded));
+
+    // only the new entry has been appended
+    CPPUNIT_ASSERT_EQUAL(3_st, connection.logStore().size());
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("third"), connection.logStore().at(2).message);
+
+    // no further request is made while the response is still decoded in the background as the entries would be appended twice
+    // note: The replayer would serve the last reply again when requesting it another time.
+    connection.setBackgroundDecodingThreshold(0);
+    requestNewLogEntries();
+    CPPUNIT_ASSERT(waitForSignals(noop, 1000, signalInfo(connection.m_logReply, &QNetworkReply::finished)));
+    CPPUNIT_ASSERT(!connection.m_logReply);
+    CPPUNIT_ASSERT(connection.m_decodingNewLogEntries);
+    connection.requestNewLogEntries();
+    CPPUNIT_ASSERT(!connection.m_logReply);
+    CPPUNIT_ASSERT(waitForSignals(noop, 1000, signalInfo(&connection, &SyncthingConnection::logEntriesAppended)));
+    CPPUNIT_ASSERT(!connection.m_decodingNewLogEntries);
+    CPPUNIT_ASSERT_EQUAL(4_st, connection.logStore().size());
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("fourth"), connection.logStore().at(3).message);
+    CPPUNIT_ASSERT(replayer.isExhausted());
+}
+
+void MiscTests::testOverallDirStatistics()
+{
+    SyncthingConnection connection;
+    auto makeDirs = [](int count) {
+        auto dirs = QJsonArray();
+        for (auto i = 0; i != count; ++i) {
+            dirs.append(QJsonObject({ { QStringLiteral("id"), QStringLiteral("dir-%1").arg(i) } }));
+        }
+        return dirs;
+    };
+    connection.readDirs(makeDirs(8));
+    CPPUNIT_ASSERT_EQUAL(8_st, connection.dirInfo().size());
+    CPPUNIT_ASSERT(connection.overallDirStatistics().isNull());
+
+    // apply random summaries, completion events and config changes; the running totals must always equal a full re-computation
+    auto rng = std::mt19937(42);
+    auto randomValue = [&rng] { return static_cast<double>(std::uniform_int_distribution<int>(0, 100000)(rng)); };
+    auto eventId = SyncthingEventId();
+    for (auto i = 0; i != 2000; ++i) {
+        const auto dirCount = static_cast<int>(connection.dirInfo().size());
+        const auto index = std::uniform_int_distribution<int>(0, dirCount - 1)(rng);
+        auto &dir = connection.m_dirs[static_cast<std::size_t>(index)];
+        switch (std::uniform_int_distribution<int>(0, 9)(rng)) {
+        case 0:
+            connection.readDirs(makeDirs(std::uniform_int_distribution<int>(1, 12)(rng)));
+            break;
+        case 1:
+        case 2:
+        case 3:
+            connection.readLocalFolderCompletion(++eventId, DateTime::now(),
+                QJsonObject({ { QStringLiteral("globalBytes"), randomValue() }, { QStringLiteral("needBytes"), randomValue() },
+                    { QStringLiteral("needDeletes"), randomValue() }, { QStringLiteral("needItems"), randomValue() } }),
+                dir, index);
+            break;
+        default:
+            auto summary = QJsonObject({ { QStringLiteral("stateChanged"), QStringLiteral("2024-03-06T21:52:35.060931713+01:00") } });
+            for (const auto *const key : { "globalBytes", "globalDeleted", "globalFiles", "globalDirectories", "globalSymlinks", "globalTotalItems",
+                     "localBytes", "localDeleted", "localFiles", "localDirectories", "localSymlinks", "localTotalItems", "needBytes", "needDeletes",
+                     "needFiles", "needDirectories", "needSymlinks", "needTotalItems" }) {
+                summary.insert(QLatin1String(key), randomValue());
+            }
+            connection.readDirSummary(++eventId, DateTime::now(), summary, dir, index);
+        }
+        CPPUNIT_ASSERT_MESSAGE("running totals equal full re-computation", connection.overallDirStatistics() == connection.computeOverallDirStatistics());
+    }
+    CPPUNIT_ASSERT(!connection.overallDirStatistics().isNull());
+
+    // statistics are reset when the directories are cleared
+    connection.readDirs(QJsonArray());
+    CPPUNIT_ASSERT(connection.overallDirStatistics().isNull());
+}
+
+void MiscTests::testApplyingConfigIncrementally()
+{
+    // populate a connection from the mocked config
+    auto file = QFile(QString::fromLocal8Bit(testFilePath("mocks/config.json").data()));
+    CPPUNIT_ASSERT(file.open(QFile::ReadOnly));
+    auto config = QJsonDocument::fromJson(file.readAll()).object();
+    const auto myId = QStringLiteral("P56IOI7-MZJNU2Y-IQGDREY-DM2MGTI-MGL3BXN-PQ6W5BM-TBBZ4TJ-XZWICQ2");
+    const auto otherId = QStringLiteral("53STGR7-YBM6FCX-PAZ2RHM-YPY6OEJ-WYHVZO7-PCKQRCK-PZLTP7T");
+    const auto newDevId = QStringLiteral("6EIS2PN-J2IHWGS-AXS3YUL-HC5FT3K-77ZXTLL-AKQLJSC-ZOXRMU3-URERYQ6");
+    SyncthingConnection connection;
+    connection.m_myId = myId;
+    connection.m_rawConfig = config;
+    connection.applyRawConfig();
+    CPPUNIT_ASSERT_EQUAL(3_st, connection.m_dirs.size());
+    CPPUNIT_ASSERT_EQUAL(2_st, connection.m_devs.size());
+
+    // count the fine-grained signals
+    auto dirsAdded = 0, dirsRemoved = 0, dirsMoved = 0, dirsChanged = 0, devsAdded = 0, devsRemoved = 0, devsMoved = 0, devsChanged = 0;
+    QObject::connect(&connection, &SyncthingConnection::dirAdded, [&dirsAdded] { ++dirsAdded; });
+    QObject::connect(&connection, &SyncthingConnection::dirRemoved, [&dirsRemoved] { ++dirsRemoved; });
+    QObject::connect(&connection, &SyncthingConnection::dirMoved, [&dirsMoved] { ++dirsMoved; });
+    QObject::connect(&connection, &SyncthingConnection::dirConfigChanged, [&dirsChanged] { ++dirsChanged; });
+    QObject::connect(&connection, &SyncthingConnection::devAdded, [&devsAdded] { ++devsAdded; });
+    QObject::connect(&connection, &SyncthingConnection::devRemoved, [&devsRemoved] { ++devsRemoved; });
+    QObject::connect(&connection, &SyncthingConnection::devMoved, [&devsMoved] { ++devsMoved; });
+    QObject::connect(&connection, &SyncthingConnection::devConfigChanged, [&devsChanged] { ++devsChanged; });
+
+    // applies the config incrementally and compares the result with applying the config from scratch
+    const auto apply = [&] {
+        dirsAdded = dirsRemoved = dirsMoved = dirsChanged = devsAdded = devsRemoved = devsMoved = devsChanged = 0;
+        connection.applyRawConfigIncrementally(std::exchange(connection.m_rawConfig, config));
+        SyncthingConnection reference;
+        reference.m_myId = myId;
+        reference.m_rawConfig = config;
+        reference.applyRawConfig();
+        CPPUNIT_ASSERT_EQUAL(reference.m_devs.size(), connection.m_devs.size());
+        for (auto i = std::size_t(); i != reference.m_devs.size(); ++i) {
+            const auto &expected = reference.m_devs[i], &actual = connection.m_devs[i];
+            CPPUNIT_ASSERT_EQUAL(expected.id, actual.id);
+            CPPUNIT_ASSERT_EQUAL(expected.name, actual.name);
+            CPPUNIT_ASSERT_EQUAL(expected.addresses, actual.addresses);
+            CPPUNIT_ASSERT_EQUAL(expected.paused, actual.paused);
+            CPPUNIT_ASSERT_EQUAL(expected.status == SyncthingDevStatus::ThisDevice, actual.status == SyncthingDevStatus::ThisDevice);
+        }
+        CPPUNIT_ASSERT_EQUAL(reference.m_dirs.size(), connection.m_dirs.size());
+        for (auto i = std::size_t(); i != reference.m_dirs.size(); ++i) {
+            const auto &expected = reference.m_dirs[i], &actual = connection.m_dirs[i];
+            CPPUNIT_ASSERT_EQUAL(expected.id, actual.id);
+            CPPUNIT_ASSERT_EQUAL(expected.label, actual.label);
+            CPPUNIT_ASSERT_EQUAL(expected.path, actual.path);
+            CPPUNIT_ASSERT_EQUAL(expected.deviceIds, actual.deviceIds);
+            CPPUNIT_ASSERT_EQUAL(expected.deviceNames, actual.deviceNames);
+            CPPUNIT_ASSERT_EQUAL(expected.dirTypeString(), actual.dirTypeString());
+            CPPUNIT_ASSERT_EQUAL(expected.rescanInterval, actual.rescanInterval);
+            CPPUNIT_ASSERT_EQUAL(expected.paused, actual.paused);
+        }
+    };
+    const auto modifyArray = [&config](const char *key, const std::function<void(QJsonArray &)> &modify) {
+        auto array = config.value(QLatin1String(key)).toArray();
+        modify(array);
+        config.insert(QString::fromLatin1(key), array);
+    };
+    const auto findDir = [&connection](const QString &id) {
+        return std::find_if(connection.m_dirs.begin(), connection.m_dirs.end(), [&id](const SyncthingDir &dir) { return dir.id == id; });
+    };
+
+    // add a folder
+    modifyArray("folders", [&otherId](QJsonArray &folders) {
+        folders.append(QJsonObject({ { QStringLiteral("id"), QStringLiteral("new-folder") }, { QStringLiteral("label"), QStringLiteral("New") },
+            { QStringLiteral("path"), QStringLiteral("/new") },
+            { QStringLiteral("devices"), QJsonArray({ QJsonObject({ { QStringLiteral("deviceID"), otherId } }) }) } }));
+    });
+    apply();
+    CPPUNIT_ASSERT_EQUAL(1, dirsAdded);
+    CPPUNIT_ASSERT_EQUAL(0, dirsRemoved + dirsMoved + dirsChanged + devsAdded + devsRemoved + devsMoved + devsChanged);
+
+    // change a folder
+    modifyArray("folders", [](QJsonArray &folders) {
+        auto folder = folders.at(1).toObject();
+        folder.insert(QStringLiteral("label"), QStringLiteral("Changed"));
+        folder.insert(QStringLiteral("rescanIntervalS"), 42);
+        folders.replace(1, folder);
+    });
+    apply();
+    CPPUNIT_ASSERT_EQUAL(1, dirsChanged);
+    CPPUNIT_ASSERT_EQUAL(0, dirsAdded + dirsRemoved + dirsMoved);
+
+    // reorder folders; the runtime state of moved folders is preserved
+    findDir(QStringLiteral("forever-alone"))->globalStats.bytes = 1234;
+    modifyArray("folders", [](QJsonArray &folders) {
+        auto reversed = QJsonArray();
+        for (const auto &folder : std::as_const(folders)) {
+            reversed.prepend(folder);
+        }
+        folders = reversed;
+    });
+    apply();
+    CPPUNIT_ASSERT_EQUAL(3, dirsMoved);
+    CPPUNIT_ASSERT_EQUAL(0, dirsAdded + dirsRemoved + dirsChanged);
+    CPPUNIT_ASSERT_EQUAL(quint64(1234), findDir(QStringLiteral("forever-alone"))->globalStats.bytes);
+
+    // remove a folder
+    modifyArray("folders", [](QJsonArray &folders) { folders.removeAt(2); });
+    apply();
+    CPPUNIT_ASSERT_EQUAL(1, dirsRemoved);
+    CPPUNIT_ASSERT_EQUAL(0, dirsAdded + dirsMoved + dirsChanged);
+
+    // add a device
+    modifyArray("devices", [&newDevId](QJsonArray &devices) {
+        devices.append(QJsonObject({ { QStringLiteral("deviceID"), newDevId }, { QStringLiteral("name"), QStringLiteral("New device") } }));
+    });
+    apply();
+    CPPUNIT_ASSERT_EQUAL(1, devsAdded);
+    CPPUNIT_ASSERT_EQUAL(0, devsRemoved + devsMoved + devsChanged + dirsAdded + dirsRemoved + dirsMoved + dirsChanged);
+
+    // change a device; the device names of folders shared with it are updated as well
+    modifyArray("devices", [&otherId](QJsonArray &devices) {
+        for (auto i = 0; i != devices.size(); ++i) {
+            auto device = devices.at(i).toObject();
+            if (device.value(QLatin1String("deviceID")).toString() == otherId) {
+                device.insert(QStringLiteral("name"), QStringLiteral("Renamed instance"));
+                devices.replace(i, device);
+            }
+        }
+    });
+    apply();
+    CPPUNIT_ASSERT_EQUAL(1, devsChanged);
+    CPPUNIT_ASSERT_EQUAL(2, dirsChanged);
+    CPPUNIT_ASSERT_EQUAL(0, devsAdded + devsRemoved + devsMoved + dirsAdded + dirsRemoved + dirsMoved);
+
+    // reorder devices; the own device is kept as first device
+    connection.m_devs.back().totalIncomingTraffic = 5678;
+    modifyArray("devices", [](QJsonArray &devices) {
+        auto reversed = QJsonArray();
+        for (const auto &device : std::as_const(devices)) {
+            reversed.prepend(device);
+        }
+        devices = reversed;
+    });
+    apply();
+    CPPUNIT_ASSERT_EQUAL(1, devsMoved);
+    CPPUNIT_ASSERT_EQUAL(0, devsAdded + devsRemoved + devsChanged + dirsChanged);
+    CPPUNIT_ASSERT_EQUAL(myId, connection.m_devs.front().id);
+    CPPUNIT_ASSERT_EQUAL(newDevId, connection.m_devs[1].id);
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::uint64_t>(5678), connection.m_devs[1].totalIncomingTraffic);
+
+    // remove a device; folders shared with it keep its ID but lose its name
+    modifyArray("devices", [&otherId](QJsonArray &devices) {
+        for (auto i = 0; i != devices.size(); ++i) {
+            if (devices.at(i).toObject().value(QLatin1String("deviceID")).toString() == otherId) {
+                devices.removeAt(i);
+                break;
+            }
+        }
+    });
+    apply();
+    CPPUNIT_ASSERT_EQUAL(1, devsRemoved);
+    CPPUNIT_ASSERT_EQUAL(2, dirsChanged);
+    CPPUNIT_ASSERT_EQUAL(0, devsAdded + devsMoved + devsChanged + dirsAdded + dirsRemoved + dirsMoved);
+}
+
+void MiscTests::testStateSnapshot()
+{
+    // populate a connection from the mocked config and add some runtime state
+    auto file = QFile(QString::fromLocal8Bit(testFilePath("mocks/config.json").data()));
+    CPPUNIT_ASSERT(file.open(QFile::ReadOnly));
+    const auto config = QJsonDocument::fromJson(file.readAll()).object();
+    SyncthingConnection connection;
+    connection.m_myId = QStringLiteral("P56IOI7-MZJNU2Y-IQGDREY-DM2MGTI-MGL3BXN-PQ6W5BM-TBBZ4TJ-XZWICQ2");
+    connection.readDevs(config.value(QLatin1String("devices")).toArray());
+    connection.readDirs(config.value(QLatin1String("folders")).toArray());
+    CPPUNIT_ASSERT(!connection.m_dirs.empty());
+    CPPUNIT_ASSERT(!connection.m_devs.empty());
+    auto &dir = connection.m_dirs.front();
+    dir.status = SyncthingDirStatus::Synchronizing;
+    dir.globalStats.bytes = 1234567;
+    dir.neededStats.files = 42;
+    dir.lastScanTime = DateTime::fromDateAndTime(2024, 3, 6, 21, 52, 35);
+    dir.itemErrors.emplace_back(QStringLiteral("permission denied"), QStringLiteral("foo/bar"));
+    dir.recentChanges.emplace_back(SyncthingFileChange{ QStringLiteral("modified"), QStringLiteral("file"), connection.m_myId,
+        QStringLiteral("foo/baz"), DateTime::fromDate(2024, 3, 7), true });
+    dir.completionByDevice[connection.m_myId].needed.items = 7;
+    dir.paused = true;
+    auto &dev = connection.m_devs.back();
+    dev.status = SyncthingDevStatus::Synchronizing;
+    dev.totalIncomingTraffic = 987654321;
+    dev.completionByDir[dir.id].globalBytes = 5000;
+    dev.overallCompletion.percentage = 12.5;
+    dev.connectionLocal = true;
+
+    // serialize and deserialize
+    const auto snapshot = SyncthingStateSnapshot(connection);
+    const auto data = snapshot.serialize();
+    auto restored = SyncthingStateSnapshot();
+    CPPUNIT_ASSERT(restored.deserialize(data));
+    CPPUNIT_ASSERT_EQUAL(connection.m_myId, restored.myId);
+    CPPUNIT_ASSERT_EQUAL(connection.m_dirs.size(), restored.dirs.size());
+    CPPUNIT_ASSERT_EQUAL(connection.m_devs.size(), restored.devs.size());
+    for (auto i = std::size_t(); i != restored.dirs.size(); ++i) {
+        const auto &expected = connection.m_dirs[i], &actual = restored.dirs[i];
+        CPPUNIT_ASSERT_EQUAL(expected.id, actual.id);
+        CPPUNIT_ASSERT_EQUAL(expected.label, actual.label);
+        CPPUNIT_ASSERT_EQUAL(expected.path, actual.path);
+        CPPUNIT_ASSERT_EQUAL(expected.deviceIds, actual.deviceIds);
+        CPPUNIT_ASSERT_EQUAL(expected.rescanInterval, actual.rescanInterval);
+        CPPUNIT_ASSERT(expected.dirType == actual.dirType);
+        CPPUNIT_ASSERT(expected.status == actual.status);
+        CPPUNIT_ASSERT(expected.globalStats == actual.globalStats);
+        CPPUNIT_ASSERT(expected.neededStats == actual.neededStats);
+        CPPUNIT_ASSERT(expected.lastScanTime == actual.lastScanTime);
+        CPPUNIT_ASSERT(expected.itemErrors == actual.itemErrors);
+        CPPUNIT_ASSERT_EQUAL(expected.recentChanges.size(), actual.recentChanges.size());
+        CPPUNIT_ASSERT_EQUAL(expected.completionByDevice.size(), actual.completionByDevice.size());
+        CPPUNIT_ASSERT_EQUAL(expected.autoNormalize, actual.autoNormalize);
+        CPPUNIT_ASSERT_EQUAL(expected.paused, actual.paused);
+    }
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("foo/baz"), restored.dirs.front().recentChanges.front().path);
+    CPPUNIT_ASSERT(restored.dirs.front().recentChanges.front().eventTime == DateTime::fromDate(2024, 3, 7));
+    CPPUNIT_ASSERT(restored.dirs.front().recentChanges.front().local);
+    CPPUNIT_ASSERT_EQUAL(7_st, static_cast<std::size_t>(restored.dirs.front().completionByDevice[connection.m_myId].needed.items));
+    for (auto i = std::size_t(); i != restored.devs.size(); ++i) {
+        const auto &expected = connection.m_devs[i], &actual = restored.devs[i];
+        CPPUNIT_ASSERT_EQUAL(expected.id, actual.id);
+        CPPUNIT_ASSERT_EQUAL(expected.name, actual.name);
+        CPPUNIT_ASSERT_EQUAL(expected.addresses, actual.addresses);
+        CPPUNIT_ASSERT(expected.status == actual.status);
+        CPPUNIT_ASSERT_EQUAL(expected.totalIncomingTraffic, actual.totalIncomingTraffic);
+        CPPUNIT_ASSERT_EQUAL(expected.overallCompletion.percentage, actual.overallCompletion.percentage);
+        CPPUNIT_ASSERT_EQUAL(expected.completionByDir.size(), actual.completionByDir.size());
+        CPPUNIT_ASSERT_EQUAL(expected.connectionLocal, actual.connectionLocal);
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<quint64>(5000), restored.devs.back().completionByDir[dir.id].globalBytes);
+
+    // IDs occurring multiple times share the same string data after deserialization
+    const auto &sharedDevId = restored.devs.back().id;
+    const auto &deviceIds = restored.dirs.front().deviceIds;
+    const auto sharedDevIdInDir = std::find(deviceIds.cbegin(), deviceIds.cend(), sharedDevId);
+    CPPUNIT_ASSERT(sharedDevIdInDir != deviceIds.cend());
+    CPPUNIT_ASSERT(sharedDevIdInDir->constData() == sharedDevId.constData());
+
+    // applying the snapshot populates folders and devices of a connection which has not read the config/status yet
+    SyncthingConnection restoredConnection;
+    auto newDirsEmitted = 0, newDevicesEmitted = 0;
+    QObject::connect(&restoredConnection, &SyncthingConnection::newDirs, [&newDirsEmitted] { ++newDirsEmitted; });
+    QObject::connect(&restoredConnection, &SyncthingConnection::newDevices, [&newDevicesEmitted] { ++newDevicesEmitted; });
+    CPPUNIT_ASSERT(restoredConnection.applySnapshot(SyncthingStateSnapshot(restored)));
+    CPPUNIT_ASSERT_EQUAL(1, newDirsEmitted);
+    CPPUNIT_ASSERT_EQUAL(1, newDevicesEmitted);
+    CPPUNIT_ASSERT_EQUAL(connection.m_myId, restoredConnection.myId());
+    CPPUNIT_ASSERT_EQUAL(connection.m_dirs.size(), restoredConnection.dirInfo().size());
+    CPPUNIT_ASSERT_EQUAL(connection.m_devs.size(), restoredConnection.devInfo().size());
+    CPPUNIT_ASSERT_EQUAL(dir.id, restoredConnection.dirInfo().front().id);
+    CPPUNIT_ASSERT_EQUAL(quint64(1234567), restoredConnection.dirInfo().front().globalStats.bytes);
+    CPPUNIT_ASSERT_EQUAL(quint64(1234567), restoredConnection.overallDirStatistics().global.bytes);
+    CPPUNIT_ASSERT(restoredConnection.dirInfo().front().status == SyncthingDirStatus::Unknown);
+    for (const auto &restoredDev : restoredConnection.devInfo()) {
+        CPPUNIT_ASSERT_EQUAL(restoredDev.id == connection.m_myId, restoredDev.status == SyncthingDevStatus::ThisDevice);
+        CPPUNIT_ASSERT_EQUAL(restoredDev.id == connection.m_myId, restoredDev.status != SyncthingDevStatus::Unknown);
+    }
+
+    // reconnecting keeps the restored folders/devices and global values until the config has been read
+    restoredConnection.reconnect();
+    CPPUNIT_ASSERT_EQUAL(connection.m_dirs.size(), restoredConnection.dirInfo().size());
+    CPPUNIT_ASSERT_EQUAL(connection.m_devs.size(), restoredConnection.devInfo().size());
+    CPPUNIT_ASSERT_EQUAL(connection.m_myId, restoredConnection.myId());
+
+    // reconnecting to a different Syncthing instance discards the restored state
+    restoredConnection.setSyncthingUrl(QStringLiteral("http://localhost:8385"));
+    restoredConnection.reconnect();
+    CPPUNIT_ASSERT(restoredConnection.dirInfo().empty());
+    CPPUNIT_ASSERT(restoredConnection.devInfo().empty());
+    CPPUNIT_ASSERT(restoredConnection.myId().isEmpty());
+
+    // the snapshot is not applied when the config has already been read
+    restoredConnection.m_rawConfig = config;
+    CPPUNIT_ASSERT(!restoredConnection.applySnapshot(SyncthingStateSnapshot(restored)));
+    CPPUNIT_ASSERT_EQUAL(1, newDirsEmitted);
+
+    // invalid data is rejected
+    CPPUNIT_ASSERT_MESSAGE("empty data rejected", !restored.deserialize(QByteArray()));
+    CPPUNIT_ASSERT_MESSAGE("truncated data rejected", !restored.deserialize(data.left(data.size() - 1)));
+    auto unsupportedVersion = data;
+    unsupportedVersion[5] = static_cast<char>(SyncthingStateSnapshot::version + 1);
+    CPPUNIT_ASSERT_MESSAGE("unsupported version rejected", !restored.deserialize(unsupportedVersion));
+
+    // compare size and speed with re-reading the raw JSON config for many folders shared with many devices
+    auto devs = QJsonArray(), dirDevs = QJsonArray(), dirs = QJsonArray();
+    for (auto i = 0; i != 20; ++i) {
+        const auto devId = QStringLiteral("DEV%1-MZJNU2Y-IQGDREY-DM2MGTI-MGL3BXN-PQ6W5BM-TBBZ4TJ-XZWICQ2").arg(i, 3, 10, QChar('0'));
+        devs.append(QJsonObject({ { QStringLiteral("deviceID"), devId }, { QStringLiteral("name"), QStringLiteral("Device %1").arg(i) },
+            { QStringLiteral("addresses"), QJsonArray({ QStringLiteral("dynamic") }) }, { QStringLiteral("compression"), QStringLiteral("metadata") } }));
+        dirDevs.append(QJsonObject({ { QStringLiteral("deviceID"), devId } }));
+    }
+    for (auto i = 0; i != 500; ++i) {
+        dirs.append(QJsonObject({ { QStringLiteral("id"), QStringLiteral("folder-%1").arg(i) },
+            { QStringLiteral("label"), QStringLiteral("Folder %1").arg(i) }, { QStringLiteral("path"), QStringLiteral("~/sync/folder-%1").arg(i) },
+            { QStringLiteral("type"), QStringLiteral("sendreceive") }, { QStringLiteral("devices"), dirDevs },
+            { QStringLiteral("rescanIntervalS"), 3600 }, { QStringLiteral("fsWatcherEnabled"), true } }));
+    }
+    const auto json = QJsonDocument(QJsonObject({ { QStringLiteral("devices"), devs }, { QStringLiteral("folders"), dirs } })).toJson(QJsonDocument::Compact);
+    const auto jsonStart = std::chrono::steady_clock::now();
+    const auto largeConfig = QJsonDocument::fromJson(json).object();
+    connection.readDevs(largeConfig.value(QLatin1String("devices")).toArray());
+    connection.readDirs(largeConfig.value(QLatin1String("folders")).toArray());
+    const auto jsonDuration = std::chrono::steady_clock::now() - jsonStart;
+    const auto largeData = SyncthingStateSnapshot(connection).serialize();
+    const auto binaryStart = std::chrono::steady_clock::now();
+    CPPUNIT_ASSERT(restored.deserialize(largeData));
+    const auto binaryDuration = std::chrono::steady_clock::now() - binaryStart;
+    CPPUNIT_ASSERT_EQUAL(500_st, restored.dirs.size());
+    CPPUNIT_ASSERT_EQUAL(connection.m_devs.size(), restored.devs.size());
+    std::cout << "\n - JSON config: " << json.size() << " bytes, parsed in "
+              << std::chrono::duration_cast<std::chrono::microseconds>(jsonDuration).count() << " µs"
+              << "\n - binary snapshot: " << largeData.size() << " bytes, deserialized in "
+              << std::chrono::duration_cast<std::chrono::microseconds>(binaryDuration).count() << " µs\n";
+    CPPUNIT_ASSERT_LESS(json.size(), largeData.size());
+}
+
+void MiscTests::testReplyLog()
+{
+    // record a few replies
+    auto buffer = QBuffer();
+    CPPUNIT_ASSERT(buffer.open(QIODevice::WriteOnly));
+    auto recorder = SyncthingReplyRecorder(&buffer);
+    CPPUNIT_ASSERT(recorder.isRecording());
+    auto recordedReply = SyncthingRecordedReply();
+    recordedReply.verb = QByteArrayLiteral("GET");
+    recordedReply.path = QStringLiteral("/rest/system/status");
+    recordedReply.httpStatus = 200;
+    recordedReply.response = QByteArrayLiteral("{\"myID\":\"first\"}");
+    recorder.record(recordedReply);
+    recordedReply.response = QByteArrayLiteral("{\"myID\":\"second\"}");
+    recorder.record(recordedReply);
+    recordedReply.path = QStringLiteral("/rest/events");
+    recordedReply.query = QStringLiteral("since=5&limit=10");
+    recordedReply.response = QByteArrayLiteral("[]");
+    recorder.record(recordedReply);
+    CPPUNIT_ASSERT_EQUAL(3_st, recorder.recordCount());
+    buffer.close();
+
+    // load recorded replies
+    auto replayer = SyncthingReplyReplayer(SyncthingReplayMode::AsFastAsPossible);
+    CPPUNIT_ASSERT(buffer.open(QIODevice::ReadOnly));
+    CPPUNIT_ASSERT(replayer.load(&buffer));
+    buffer.close();
+    CPPUNIT_ASSERT_EQUAL(3_st, replayer.records().size());
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("{\"myID\":\"second\"}"), QString::fromUtf8(replayer.records()[1].response));
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("since=5&limit=10"), replayer.records()[2].query);
+    CPPUNIT_ASSERT(!replayer.isExhausted());
+
+    // replay replies for the same request in the recorded order, repeating the last one
+    const auto replay = [&replayer](const char *verb, const QString &url, bool longPolling = false) {
+        auto *const reply = replayer.replyFor(verb, QUrl(url), longPolling);
+        waitForSignals(noop, 1000, signalInfo(reply, &QNetworkReply::finished));
+        return std::unique_ptr<QNetworkReply>(reply);
+    };
+    const auto base = QStringLiteral("http://127.0.0.1:8384");
+    const auto statusUrl = base + QStringLiteral("/rest/system/status");
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("{\"myID\":\"first\"}"), QString::fromUtf8(replay("GET", statusUrl)->readAll()));
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("{\"myID\":\"second\"}"), QString::fromUtf8(replay("GET", statusUrl)->readAll()));
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("{\"myID\":\"second\"}"), QString::fromUtf8(replay("GET", statusUrl)->readAll()));
+    CPPUNIT_ASSERT_EQUAL(2_st, replayer.replayedCount());
+
+    // fail requests without recorded replies
+    const auto notFound = replay("POST", statusUrl);
+    CPPUNIT_ASSERT_EQUAL(QNetworkReply::ContentNotFoundError, notFound->error());
+    CPPUNIT_ASSERT_EQUAL(404, notFound->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt());
+
+    // ignore "since" and "timeout" when matching requests
+    auto *const events = replayer.replyFor("GET", QUrl(base + QStringLiteral("/rest/events?since=42&limit=10&timeout=60")), true);
+    CPPUNIT_ASSERT(waitForSignals(noop, 1000, signalInfo(&replayer, &SyncthingReplyReplayer::exhausted),
+        signalInfo(events, &QNetworkReply::finished)));
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("[]"), QString::fromUtf8(events->readAll()));
+    CPPUNIT_ASSERT(replayer.isExhausted());
+    delete events;
+
+    // keep long-polling requests pending once all replies have been served
+    const auto pendingEvents
+        = std::unique_ptr<QNetworkReply>(replayer.replyFor("GET", QUrl(base + QStringLiteral("/rest/events?since=43&limit=10")), true));
+    QCoreApplication::processEvents();
+    CPPUNIT_ASSERT(!pendingEvents->isFinished());
+    pendingEvents->abort();
+    CPPUNIT_ASSERT(pendingEvents->isFinished());
+    CPPUNIT_ASSERT_EQUAL(QNetworkReply::OperationCanceledError, pendingEvents->error());
+
+    // restart from the beginning
+    replayer.restart();
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("{\"myID\":\"first\"}"), QString::fromUtf8(replay("GET", statusUrl)->readAll()));
+
+    // reject invalid data; a reply which is still pending is nevertheless served from the previously loaded replies
+    replayer.restart();
+    const auto pendingStatus = std::unique_ptr<QNetworkReply>(replayer.replyFor("GET", QUrl(statusUrl), false));
+    auto invalidBuffer = QBuffer();
+    CPPUNIT_ASSERT(invalidBuffer.open(QIODevice::ReadOnly));
+    CPPUNIT_ASSERT(!replayer.load(&invalidBuffer));
+    CPPUNIT_ASSERT(!replayer.errorString().isEmpty());
+    CPPUNIT_ASSERT(replayer.records().empty());
+    CPPUNIT_ASSERT(pendingStatus->isFinished() || waitForSignals(noop, 1000, signalInfo(pendingStatus.get(), &QNetworkReply::finished)));
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("{\"myID\":\"first\"}"), QString::fromUtf8(pendingStatus->readAll()));
+}
+
+/*!
+ * \brief Tests that recording replies does not consume the error message Syncthing returns within the response.
+ */
+void MiscTests::testRecordingErrorReplies()
+{
+    const auto errorMessage = QByteArrayLiteral("unable to restart: busy\n");
+    auto buffer = QBuffer();
+    CPPUNIT_ASSERT(buffer.open(QIODevice::WriteOnly));
+    auto recorder = SyncthingReplyRecorder(&buffer);
+    auto recordedReply = SyncthingRecordedReply();
+    recordedReply.verb = QByteArrayLiteral("POST");
+    recordedReply.path = QStringLiteral("/rest/system/restart");
+    recordedReply.httpStatus = 500;
+    recordedReply.error = QNetworkReply::InternalServerError;
+    recordedReply.response = errorMessage;
+    recorder.record(recordedReply);
+    buffer.close();
+    auto replayer = SyncthingReplyReplayer(SyncthingReplayMode::AsFastAsPossible);
+    CPPUNIT_ASSERT(buffer.open(QIODevice::ReadOnly));
+    CPPUNIT_ASSERT(replayer.load(&buffer));
+
+    // replay the failing request while recording replies of the connection
+    auto recordingBuffer = QBuffer();
+    CPPUNIT_ASSERT(recordingBuffer.open(QIODevice::WriteOnly));
+    auto connectionRecorder = SyncthingReplyRecorder(&recordingBuffer);
+    auto connection = SyncthingConnection(QStringLiteral("http://127.0.0.1:8384"), QByteArray());
+    connection.setReplyReplayer(&replayer);
+    connection.setReplyRecorder(&connectionRecorder);
+    auto errorResponse = QByteArray();
+    auto errorCategory = SyncthingErrorCategory::OverallConnection;
+    const auto connectionHandle = QObject::connect(&connection, &SyncthingConnection::error,
+        [&](const QString &, SyncthingErrorCategory category, int, const QNetworkRequest &, const QByteArray &response) {
+            errorCategory = category;
+            errorResponse = response;
+        });
+    CPPUNIT_ASSERT(waitForSignals([&connection] { connection.restart(); }, 1000, signalInfo(&connection, &SyncthingConnection::error)));
+    QObject::disconnect(connectionHandle);
+
+    // the error message is passed to the error signal and recorded as well
+    CPPUNIT_ASSERT(errorCategory == SyncthingErrorCategory::SpecificRequest);
+    CPPUNIT_ASSERT_EQUAL(QString::fromUtf8(errorMessage), QString::fromUtf8(errorResponse));
+    CPPUNIT_ASSERT_EQUAL(1_st, connectionRecorder.recordCount());
+    recordingBuffer.close();
+    auto recordedReplies = SyncthingReplyReplayer();
+    CPPUNIT_ASSERT(recordingBuffer.open(QIODevice::ReadOnly));
+    CPPUNIT_ASSERT(recordedReplies.load(&recordingBuffer));
+    CPPUNIT_ASSERT_EQUAL(1_st, recordedReplies.records().size());
+    CPPUNIT_ASSERT_EQUAL(QString::fromUtf8(errorMessage), QString::fromUtf8(recordedReplies.records().front().response));
+    CPPUNIT_ASSERT_EQUAL(static_cast<int>(QNetworkReply::InternalServerError), recordedReplies.records().front().error);
+}
+
+/*!
+ * \brief Tests that replies of browseIncrementally() are recorded completely although they are parsed while being received.
+ */
+void MiscTests::testRecordingIncrementalBrowsing()
+{
+    auto file = QFile(QString::fromLocal8Bit(testFilePath("mocks/browse.json").data()));
+    CPPUNIT_ASSERT(file.open(QFile::ReadOnly));
+    const auto response = file.readAll();
+    auto buffer = QBuffer();
+    CPPUNIT_ASSERT(buffer.open(QIODevice::WriteOnly));
+    auto recorder = SyncthingReplyRecorder(&buffer);
+    auto recordedReply = SyncthingRecordedReply();
+    recordedReply.verb = QByteArrayLiteral("GET");
+    recordedReply.path = QStringLiteral("/rest/db/browse");
+    recordedReply.query = QStringLiteral("folder=test");
+    recordedReply.httpStatus = 200;
+    recordedReply.response = response;
+    recorder.record(recordedReply);
+    buffer.close();
+
+    // browse incrementally via the specified replayer while recording the replies of the connection into the specified buffer
+    const auto browse = [](QBuffer &replayBuffer, QBuffer &recordingBuffer) {
+        auto replayer = SyncthingReplyReplayer(SyncthingReplayMode::AsFastAsPossible);
+        CPPUNIT_ASSERT(replayBuffer.open(QIODevice::ReadOnly));
+        CPPUNIT_ASSERT(replayer.load(&replayBuffer));
+        replayBuffer.close();
+        CPPUNIT_ASSERT(recordingBuffer.open(QIODevice::WriteOnly));
+        auto connectionRecorder = SyncthingReplyRecorder(&recordingBuffer);
+        auto connection = SyncthingConnection(QStringLiteral("http://127.0.0.1:8384"), QByteArray());
+        connection.setReplyReplayer(&replayer);
+        connection.setReplyRecorder(&connectionRecorder);
+        auto loop = QEventLoop();
+        auto timeout = QTimer();
+        auto items = std::vector<std::unique_ptr<SyncthingItem>>();
+        auto errorMessage = QString();
+        auto done = false;
+        timeout.setSingleShot(true);
+        timeout.setInterval(1000);
+        QObject::connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+        connection.browseIncrementally(
+            QStringLiteral("test"), QString(), 0,
+            [&](std::vector<std::unique_ptr<SyncthingItem>> &&batch, bool isLast, QString &&error) {
+                std::move(batch.begin(), batch.end(), std::back_inserter(items));
+                if (isLast) {
+                    done = true;
+                    errorMessage = std::move(error);
+                    loop.quit();
+                }
+            },
+            2);
+        timeout.start();
+        loop.exec();
+        recordingBuffer.close();
+        CPPUNIT_ASSERT(done);
+        CPPUNIT_ASSERT_EQUAL(QString(), errorMessage);
+        CPPUNIT_ASSERT_EQUAL(1_st, connectionRecorder.recordCount());
+        return items;
+    };
+
+    // the whole response is recorded
+    auto recordingBuffer = QBuffer();
+    const auto items = browse(buffer, recordingBuffer);
+    CPPUNIT_ASSERT(!items.empty());
+    auto recordedReplies = SyncthingReplyReplayer();
+    CPPUNIT_ASSERT(recordingBuffer.open(QIODevice::ReadOnly));
+    CPPUNIT_ASSERT(recordedReplies.load(&recordingBuffer));
+    recordingBuffer.close();
+    CPPUNIT_ASSERT_EQUAL(1_st, recordedReplies.records().size());
+    CPPUNIT_ASSERT_EQUAL(QString::fromUtf8(response), QString::fromUtf8(recordedReplies.records().front().response));
+
+    // replaying the recorded reply yields the same items
+    auto secondRecordingBuffer = QBuffer();
+    const auto replayedItems = browse(recordingBuffer, secondRecordingBuffer);
+    CPPUNIT_ASSERT_EQUAL(items.size(), replayedItems.size());
+    for (auto i = std::size_t(); i != items.size(); ++i) {
+        CPPUNIT_ASSERT_EQUAL(items[i]->name, replayedItems[i]->name);
+        CPPUNIT_ASSERT_EQUAL(items[i]->index, replayedItems[i]->index);
+        CPPUNIT_ASSERT_EQUAL(items[i]->children.size(), replayedItems[i]->children.size());
+    }
+}
+
+/*!
+ * \brief Drives a SyncthingConnection from recorded events and prints the event throughput.
+ */
+void MiscTests::testReplayingEvents()
+{
+    // record events like Syncthing would return them: a single one initially and then batches when passing "since"
+    constexpr auto batchCount = 50, eventsPerBatch = 200;
+    auto buffer = QBuffer();
+    CPPUNIT_ASSERT(buffer.open(QIODevice::WriteOnly));
+    auto recorder = SyncthingReplyRecorder(&buffer);
+    auto recordedReply = SyncthingRecordedReply();
+    recordedReply.verb = QByteArrayLiteral("GET");
+    recordedReply.path = QStringLiteral("/rest/events");
+    recordedReply.httpStatus = 200;
+    auto eventId = 0;
+    const auto makeEvents = [&eventId](int count) {
+        auto events = QJsonArray();
+        for (auto i = 0; i != count; ++i) {
+            events.append(QJsonObject{
+                { QStringLiteral("id"), ++eventId },
+                { QStringLiteral("type"), QStringLiteral("StateChanged") },
+                { QStringLiteral("time"), QStringLiteral("2024-05-01T12:34:56.123456789+02:00") },
+                { QStringLiteral("data"),
+                    QJsonObject{ { QStringLiteral("folder"), QStringLiteral("dir-%1").arg(eventId % 4) },
+                        { QStringLiteral("to"), eventId % 2 ? QStringLiteral("scanning") : QStringLiteral("idle") } } },
+            });
+        }
+        return QJsonDocument(events).toJson(QJsonDocument::Compact);
+    };
+    recordedReply.query = QStringLiteral("events=StateChanged&limit=1");
+    recordedReply.response = makeEvents(1);
+    recorder.record(recordedReply);
+    recordedReply.query = QStringLiteral("events=StateChanged");
+    for (auto i = 0; i != batchCount; ++i) {
+        recordedReply.response = makeEvents(eventsPerBatch);
+        recorder.record(recordedReply);
+    }
+    buffer.close();
+    auto replayer = SyncthingReplyReplayer(SyncthingReplayMode::AsFastAsPossible);
+    CPPUNIT_ASSERT(buffer.open(QIODevice::ReadOnly));
+    CPPUNIT_ASSERT(replayer.load(&buffer));
+
+    // setup connection to poll only the recorded events without requesting statistics
+    auto connection = SyncthingConnection(QStringLiteral("http://127.0.0.1:8384"), QByteArray());
+    auto dirs = QJsonArray();
+    for (auto i = 0; i != 4; ++i) {
+        dirs.append(QJsonObject{ { QStringLiteral("id"), QStringLiteral("dir-%1").arg(i) } });
+    }
+    connection.readDirs(dirs);
+    connection.setReplyReplayer(&replayer);
+    connection.m_eventMask = QStringLiteral("StateChanged");
+    connection.m_statsRequested = true;
+    connection.m_keepPolling = true;
+
+    // replay all events as fast as possible
+    const auto totalEvents = static_cast<std::uint64_t>(1 + batchCount * eventsPerBatch);
+    const auto &stateChanges = connection.eventCounts()[static_cast<std::size_t>(SyncthingEventType::StateChanged)];
+    const auto start = std::chrono::steady_clock::now();
+    CPPUNIT_ASSERT(waitForSignals([&connection] { connection.requestEvents(); }, 10000,
+        signalInfo(&replayer, &SyncthingReplyReplayer::exhausted)));
+    for (auto i = 0; i != 100 && stateChanges != totalEvents; ++i) {
+        waitForSignals(noop, 100, signalInfo(&connection, &SyncthingConnection::allEventsProcessed));
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    CPPUNIT_ASSERT_EQUAL(totalEvents, stateChanges);
+    CPPUNIT_ASSERT_EQUAL(static_cast<SyncthingEventId>(totalEvents), connection.m_lastEventId);
+    cerr << "\nReplayed " << totalEvents << " events in " << elapsed << " s (" << static_cast<std::uint64_t>(totalEvents / elapsed)
+         << " events/s)" << endl;
+
+    // the long-polling request for further events is pending
+    CPPUNIT_ASSERT(connection.m_eventsReply);
+    CPPUNIT_ASSERT(!connection.m_eventsReply->isFinished());
+    connection.disconnect();
+}
+
+void MiscTests::testConfigPatch()
+{
+    const auto parse = [](const char *json) { return QJsonDocument::fromJson(QByteArray(json)).object(); };
+    const auto oldConfig = parse(R"({
+        "version": 37,
+        "folders": [{"id": "f1", "label": "Folder 1", "devices": [{"deviceID": "D1"}]}, {"id": "f2", "label": "Folder 2"}],
+        "devices": [{"deviceID": "D1", "name": "Device 1"}],
+        "options": {"listenAddresses": ["default"], "globalAnnounceEnabled": true},
+        "gui": {"theme": "default", "address": "127.0.0.1:8384"},
+        "defaults": {"folder": {"path": "~"}, "device": {"name": ""}, "ignores": {"lines": []}}
+    })");
+
+    // no changes, order of folders and devices is not considered
+    auto reordered = oldConfig;
+    reordered.insert(QStringLiteral("folders"), QJsonArray({ oldConfig.value(QLatin1String("folders")).toArray().at(1),
+        oldConfig.value(QLatin1String("folders")).toArray().at(0) }));
+    CPPUNIT_ASSERT(SyncthingConfigPatch(oldConfig, reordered).isEmpty());
+
+    // changes which can be applied via per-object endpoints
+    const auto newConfig = parse(R"({
+        "version": 37,
+        "folders": [{"id": "f1", "label": "Folder one", "devices": [{"deviceID": "D1"}, {"deviceID": "D2"}]}, {"id": "f3", "label": "Folder 3"}],
+        "devices": [{"deviceID": "D1", "name": "Device 1"}, {"deviceID": "D2", "name": "Device 2"}],
+        "options": {"listenAddresses": ["default"], "globalAnnounceEnabled": false},
+        "gui": {"theme": "dark", "address": "127.0.0.1:8384"},
+        "defaults": {"folder": {"path": "~/sync"}, "device": {"name": ""}, "ignores": {"lines": ["*.tmp"]}}
+    })");
+    const auto patch = SyncthingConfigPatch(oldConfig, newConfig);
+    CPPUNIT_ASSERT(!patch.isEmpty());
+    CPPUNIT_ASSERT(!patch.requiresFullConfig);
+    const auto operations = QString::fromUtf8(QJsonDocument(patch.operations).toJson(QJsonDocument::Compact));
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("["
+                                        R"({"op":"replace","path":"/defaults/folder/path","value":"~/sync"},)"
+                                        R"({"op":"replace","path":"/defaults/ignores/lines","value":["*.tmp"]},)"
+                                        R"({"op":"add","path":"/devices/-","value":{"deviceID":"D2","name":"Device 2"}},)"
+                                        R"({"op":"replace","path":"/folders/0/devices","value":[{"deviceID":"D1"},{"deviceID":"D2"}]},)"
+                                        R"({"op":"replace","path":"/folders/0/label","value":"Folder one"},)"
+                                        R"({"op":"remove","path":"/folders/1"},)"
+                                        R"({"op":"add","path":"/folders/-","value":{"id":"f3","label":"Folder 3"}},)"
+                                        R"({"op":"replace","path":"/gui/theme","value":"dark"},)"
+                                        R"({"op":"replace","path":"/options/globalAnnounceEnabled","value":false}])"),
+        operations);
+    auto requests = QStringList();
+    for (const auto &request : patch.requests) {
+        requests << QString::fromLatin1(request.verb) % QChar(' ') % request.path % QChar(' ')
+                % (request.body.isUndefined() ? QString() : QString::fromUtf8(QJsonDocument(request.body.toObject()).toJson(QJsonDocument::Compact)));
+    }
+    CPPUNIT_ASSERT_EQUAL(QStringList({
+                             QStringLiteral(R"(POST config/devices {"deviceID":"D2","name":"Device 2"})"),
+                             QStringLiteral(R"(PATCH config/folders/f1 {"devices":[{"deviceID":"D1"},{"deviceID":"D2"}],"label":"Folder one"})"),
+                             QStringLiteral(R"(POST config/folders {"id":"f3","label":"Folder 3"})"),
+                             QStringLiteral("DELETE config/folders/f2 "),
+                             QStringLiteral(R"(PATCH config/defaults/folder {"path":"~/sync"})"),
+                             QStringLiteral(R"(PUT config/defaults/ignores {"lines":["*.tmp"]})"),
+                             QStringLiteral(R"(PATCH config/gui {"theme":"dark"})"),
+                             QStringLiteral(R"(PATCH config/options {"globalAnnounceEnabled":false})"),
+                         }),
+        requests);
+
+    // changes without per-object endpoint require posting the full config
+    auto versionChanged = oldConfig;
+    versionChanged.insert(QStringLiteral("version"), 38);
+    const auto fullConfigPatch = SyncthingConfigPatch(oldConfig, versionChanged);
+    CPPUNIT_ASSERT(fullConfigPatch.requiresFullConfig);
+    CPPUNIT_ASSERT_EQUAL(1_st, static_cast<std::size_t>(fullConfigPatch.operations.size()));
+
+    // merge patches set removed members to null
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral(R"({"a":null,"b":{"c":2}})"),
+        QString::fromUtf8(QJsonDocument(makeJsonMergePatch(parse(R"({"a":1,"b":{"c":1,"d":1}})"), parse(R"({"b":{"c":2,"d":1}})")).toObject())
+                              .toJson(QJsonDocument::Compact)));
+}
+
+void MiscTests::testConfigTransaction()
+{
+    // build config with 1,000 folders and devices where each folder is shared with one device
+    constexpr auto itemCount = 1000;
+    auto dirs = QJsonArray(), devs = QJsonArray();
+    auto dirIds = QStringList(), devIds = QStringList();
+    for (auto i = 0; i != itemCount; ++i) {
+        dirIds << QStringLiteral("folder-%1").arg(i);
+        devIds << QStringLiteral("DEV-%1").arg(i);
+        dirs.append(QJsonObject({ { QStringLiteral("id"), dirIds.back() }, { QStringLiteral("label"), QStringLiteral("Folder %1").arg(i) },
+            { QStringLiteral("devices"), QJsonArray({ QJsonObject({ { QStringLiteral("deviceID"), devIds.back() } }) }) },
+            { QStringLiteral("paused"), false }, { QStringLiteral("rescanIntervalS"), 3600 } }));
+        devs.append(QJsonObject({ { QStringLiteral("deviceID"), devIds.back() }, { QStringLiteral("paused"), false } }));
+    }
+    SyncthingConnection connection;
+    connection.m_rawConfig
+        = QJsonObject({ { QStringLiteral("version"), 37 }, { QStringLiteral("folders"), dirs }, { QStringLiteral("devices"), devs } });
+
+    // invalid edits are recorded as errors and not applied
+    auto transaction = SyncthingConfigTransaction(connection);
+    CPPUNIT_ASSERT(!transaction.setDirsPaused({ QStringLiteral("folder-0"), QStringLiteral("foo") }, true));
+    CPPUNIT_ASSERT(!transaction.setDirsRescanInterval({ QStringLiteral("folder-0") }, -1));
+    CPPUNIT_ASSERT(!transaction.shareDirs({ QStringLiteral("folder-0") }, { QStringLiteral("BAR") }));
+    CPPUNIT_ASSERT(!transaction.setDirsValue({ QStringLiteral("folder-0") }, QStringLiteral("id"), QStringLiteral("bar")));
+    CPPUNIT_ASSERT_EQUAL(4, static_cast<int>(transaction.errors().size()));
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("There is no folder with ID \"foo\"."), transaction.errors().front());
+    CPPUNIT_ASSERT(transaction.patch().isEmpty());
+    CPPUNIT_ASSERT(!transaction.commit());
+    transaction.reset();
+    CPPUNIT_ASSERT(transaction.isValid());
+
+    // few changes are submitted via per-object endpoints
+    CPPUNIT_ASSERT(transaction.setDirLabel(QStringLiteral("folder-1"), QStringLiteral("Renamed")));
+    CPPUNIT_ASSERT(transaction.shareDirs({ QStringLiteral("folder-1") }, { QStringLiteral("DEV-1"), QStringLiteral("DEV-2") }));
+    CPPUNIT_ASSERT(transaction.unshareDirs({ QStringLiteral("folder-2") }, { QStringLiteral("DEV-2") }));
+    CPPUNIT_ASSERT(transaction.setDevsPaused({ QStringLiteral("DEV-3") }, true));
+    const auto fewChanges = transaction.patch();
+    CPPUNIT_ASSERT(!fewChanges.requiresFullConfig);
+    auto requests = QStringList();
+    for (const auto &request : fewChanges.requests) {
+        requests << QString::fromLatin1(request.verb) % QChar(' ') % request.path % QChar(' ')
+                % QString::fromUtf8(QJsonDocument(request.body.toObject()).toJson(QJsonDocument::Compact));
+    }
+    CPPUNIT_ASSERT_EQUAL(
+        QStringList({
+            QStringLiteral(R"(PATCH config/devices/DEV-3 {"paused":true})"),
+            QStringLiteral(R"(PATCH config/folders/folder-1 {"devices":[{"deviceID":"DEV-1"},)"
+                           R"({"deviceID":"DEV-2","encryptionPassword":"","introducedBy":""}],"label":"Renamed"})"),
+            QStringLiteral(R"(PATCH config/folders/folder-2 {"devices":[]})"),
+        }),
+        requests);
+    CPPUNIT_ASSERT_LESSEQUAL(static_cast<std::size_t>(transaction.maxObjectRequests()), fewChanges.requests.size());
+
+    // benchmark altering the config per item (like pauseResumeDirectory() does for each call) against a 1,000-item batch
+    transaction.reset();
+    const auto perItemStart = std::chrono::steady_clock::now();
+    auto perItemBytes = std::size_t();
+    for (const auto &dirId : std::as_const(dirIds)) {
+        auto config = connection.rawConfig();
+        CPPUNIT_ASSERT(setDirectoriesPaused(config, QStringList(dirId), true));
+        perItemBytes += static_cast<std::size_t>(QJsonDocument(config).toJson(QJsonDocument::Compact).size());
+    }
+    const auto perItemDuration = std::chrono::steady_clock::now() - perItemStart;
+    const auto batchStart = std::chrono::steady_clock::now();
+    CPPUNIT_ASSERT(transaction.setDirsPaused(dirIds, true));
+    CPPUNIT_ASSERT(transaction.setDirsRescanInterval(dirIds, 7200));
+    CPPUNIT_ASSERT(transaction.shareDirs(dirIds, devIds.mid(0, 10)));
+    CPPUNIT_ASSERT(transaction.setDevsPaused(devIds, true));
+    const auto batchPatch = transaction.patch();
+    const auto batchBytes = static_cast<std::size_t>(QJsonDocument(transaction.config()).toJson(QJsonDocument::Compact).size());
+    const auto batchDuration = std::chrono::steady_clock::now() - batchStart;
+    CPPUNIT_ASSERT(transaction.isValid());
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::size_t>(2 * itemCount), batchPatch.requests.size());
+    const auto batchConfig = transaction.config();
+    const auto batchDirs = batchConfig.value(QLatin1String("folders")).toArray();
+    CPPUNIT_ASSERT_EQUAL(10, static_cast<int>(batchDirs.at(5).toObject().value(QLatin1String("devices")).toArray().size()));
+    CPPUNIT_ASSERT_EQUAL(11, static_cast<int>(batchDirs.at(500).toObject().value(QLatin1String("devices")).toArray().size()));
+    CPPUNIT_ASSERT_EQUAL(7200, batchDirs.at(999).toObject().value(QLatin1String("rescanIntervalS")).toInt());
+    std::cout << "\n - pausing " << itemCount << " folders one by one: " << perItemBytes << " bytes in " << itemCount << " requests, prepared in "
+              << std::chrono::duration_cast<std::chrono::microseconds>(perItemDuration).count() << " µs"
+              << "\n - " << batchPatch.operations.size() << " changes of " << itemCount << " folders/devices in one batch: " << batchBytes
+              << " bytes in 1 request, prepared in " << std::chrono::duration_cast<std::chrono::microseconds>(batchDuration).count() << " µs\n";
+    CPPUNIT_ASSERT_LESS(perItemBytes, batchBytes);
+}
+
+/*!
+ * \brief Tests committing a SyncthingConfigTransaction via per-object requests and via posting the full config using
+ *        recorded replies.
+ * \remarks Requests without recorded reply fail so a successful commit implies the expected requests have been sent.
+ */
+void MiscTests::testCommittingConfigTransaction()
+{
+    // record replies for the per-object requests and for posting the full config
+    auto buffer = QBuffer();
+    CPPUNIT_ASSERT(buffer.open(QIODevice::WriteOnly));
+    auto recorder = SyncthingReplyRecorder(&buffer);
+    auto recordedReply = SyncthingRecordedReply();
+    recordedReply.httpStatus = 200;
+    recordedReply.verb = QByteArrayLiteral("PATCH");
+    recordedReply.path = QStringLiteral("/rest/config/devices/DEV-0");
+    recorder.record(recordedReply);
+    recordedReply.path = QStringLiteral("/rest/config/folders/folder-1");
+    recorder.record(recordedReply);
+    recordedReply.verb = QByteArrayLiteral("PUT");
+    recordedReply.path = QStringLiteral("/rest/config");
+    recorder.record(recordedReply);
+    buffer.close();
+    auto replayer = SyncthingReplyReplayer(SyncthingReplayMode::AsFastAsPossible);
+    CPPUNIT_ASSERT(buffer.open(QIODevice::ReadOnly));
+    CPPUNIT_ASSERT(replayer.load(&buffer));
+
+    auto dirs = QJsonArray(), devs = QJsonArray();
+    for (auto i = 0; i != 3; ++i) {
+        dirs.append(QJsonObject({ { QStringLiteral("id"), QStringLiteral("folder-%1").arg(i) },
+            { QStringLiteral("label"), QStringLiteral("Folder %1").arg(i) }, { QStringLiteral("paused"), false } }));
+    }
+    for (auto i = 0; i != 2; ++i) {
+        devs.append(QJsonObject({ { QStringLiteral("deviceID"), QStringLiteral("DEV-%1").arg(i) }, { QStringLiteral("paused"), false } }));
+    }
+    auto connection = SyncthingConnection(QStringLiteral("http://127.0.0.1:8384"), QByteArray());
+    connection.setReplyReplayer(&replayer);
+    connection.m_rawConfig
+        = QJsonObject({ { QStringLiteral("version"), 37 }, { QStringLiteral("folders"), dirs }, { QStringLiteral("devices"), devs } });
+
+    auto transaction = SyncthingConfigTransaction(connection);
+    auto errorMessage = QStringLiteral("not committed");
+    const auto commit = [&] {
+        errorMessage = QStringLiteral("not committed");
+        CPPUNIT_ASSERT(waitForSignals([&] { CPPUNIT_ASSERT(transaction.commit()); }, 1000,
+            signalInfo(&transaction, &SyncthingConfigTransaction::committed,
+                [&errorMessage](const QString &message) { errorMessage = message; })));
+        CPPUNIT_ASSERT(!transaction.isCommitting());
+    };
+
+    // few changes are submitted via per-object requests; the submitted config is the new base afterwards
+    CPPUNIT_ASSERT(transaction.setDirLabel(QStringLiteral("folder-1"), QStringLiteral("Renamed")));
+    CPPUNIT_ASSERT(transaction.setDevsPaused({ QStringLiteral("DEV-0") }, true));
+    const auto patchedConfig = transaction.config();
+    commit();
+    CPPUNIT_ASSERT_EQUAL(QString(), errorMessage);
+    CPPUNIT_ASSERT_EQUAL(2_st, replayer.replayedCount());
+    CPPUNIT_ASSERT(transaction.baseConfig() == patchedConfig);
+    CPPUNIT_ASSERT(transaction.patch().isEmpty());
+
+    // simulate changes made by someone else in the meantime: another folder is added and a folder is renamed
+    auto currentConfig = transaction.baseConfig();
+    auto currentDirs = currentConfig.value(QLatin1String("folders")).toArray();
+    auto firstDir = currentDirs.at(0).toObject();
+    firstDir.insert(QStringLiteral("label"), QStringLiteral("Renamed elsewhere"));
+    currentDirs.replace(0, firstDir);
+    currentDirs.append(QJsonObject({ { QStringLiteral("id"), QStringLiteral("folder-3") }, { QStringLiteral("paused"), false } }));
+    currentConfig.insert(QStringLiteral("folders"), currentDirs);
+    connection.m_rawConfig = currentConfig;
+
+    // the full config is posted when exceeding the max. number of per-object requests; the edits are applied on top of the
+    // connection's current config which is the new base afterwards
+    transaction.setMaxObjectRequests(0);
+    CPPUNIT_ASSERT(transaction.setDirsPaused({ QStringLiteral("folder-2") }, true));
+    auto expectedDirs = currentDirs;
+    auto lastDir = expectedDirs.at(2).toObject();
+    lastDir.insert(QStringLiteral("paused"), true);
+    expectedDirs.replace(2, lastDir);
+    auto expectedConfig = currentConfig;
+    expectedConfig.insert(QStringLiteral("folders"), expectedDirs);
+    commit();
+    CPPUNIT_ASSERT_EQUAL(QString(), errorMessage);
+    CPPUNIT_ASSERT(replayer.isExhausted());
+    CPPUNIT_ASSERT_EQUAL(QString::fromUtf8(QJsonDocument(expectedConfig).toJson(QJsonDocument::Compact)),
+        QString::fromUtf8(QJsonDocument(transaction.baseConfig()).toJson(QJsonDocument::Compact)));
+    CPPUNIT_ASSERT(transaction.patch().isEmpty());
+
+    // further edits may refer to the folder added in the meantime
+    CPPUNIT_ASSERT(transaction.setDirLabel(QStringLiteral("folder-3"), QStringLiteral("Added elsewhere")));
+    CPPUNIT_ASSERT(transaction.isValid());
+}
@@ -23,6 +23,7 @@ class IgnorePatternTests : public TestFixture {
     CPPUNIT_TEST(testCaseInsensitiveMatching);
     CPPUNIT_TEST(testGreediness);
     CPPUNIT_TEST(testAlternativePathSeparators);
+    CPPUNIT_TEST(testLiteralPrefix);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -35,6 +36,7 @@ public:
     void testCaseInsensitiveMatching();
     void testGreediness();
     void testAlternativePathSeparators();
+    void testLiteralPrefix();
 
     void setUp() override;
     void tearDown() override;
@@ -251,3 +253,30 @@ void IgnorePatternTests::testAlternativePathSeparators()
     CPPUNIT_ASSERT(!p18b.matches(QStringLiteral("Saved\\Logs"), QChar('\\')));
     CPPUNIT_ASSERT(!p18b.matches(QStringLiteral("Saved/Logs"), QChar('\\')));
 }
+
+void IgnorePatternTests::testLiteralPrefix()
+{
+    auto p1 = SyncthingIgnorePattern(QStringLiteral("/foo/bar*/baz"));
+    CPPUNIT_ASSERT(p1.matchesFromRoot());
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("foo/bar"), p1.literalPrefix());
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("foo\\bar"), p1.literalPrefix(QChar('\\')));
+    const auto prefix1 = p1.literalPrefix();
+    CPPUNIT_ASSERT(p1.mightMatch(prefix1, QStringLiteral("foo/barbar/baz")));
+    CPPUNIT_ASSERT(!p1.mightMatch(prefix1, QStringLiteral("foo/baz")));
+    CPPUNIT_ASSERT_MESSAGE("anchored pattern only considered from root", !p1.mightMatch(prefix1, QStringLiteral("x/foo/bar/baz")));
+
+    auto p2 = SyncthingIgnorePattern(QStringLiteral("!(?i)Saved/Logs"));
+    CPPUNIT_ASSERT(!p2.matchesFromRoot());
+    const auto prefix2 = p2.literalPrefix(QChar('\\'));
+    CPPUNIT_ASSERT_EQUAL(QStringLiteral("Saved\\Logs"), prefix2);
+    CPPUNIT_ASSERT(p2.mightMatch(prefix2, QStringLiteral("documents\\saved\\logs"), QChar('\\')));
+    CPPUNIT_ASSERT(p2.mightMatch(prefix2, QStringLiteral("Documents/Saved/Logs"), QChar('\\')));
+    CPPUNIT_ASSERT(!p2.mightMatch(prefix2, QStringLiteral("Documents\\MySaved\\Logs"), QChar('\\')));
+
+    auto p3 = SyncthingIgnorePattern(QStringLiteral("**.tmp"));
+    CPPUNIT_ASSERT_EQUAL(QString(), p3.literalPrefix());
+    CPPUNIT_ASSERT(p3.mightMatch(p3.literalPrefix(), QStringLiteral("foo")));
+
+    auto p4 = SyncthingIgnorePattern(QStringLiteral("// comment"));
+    CPPUNIT_ASSERT(!p4.mightMatch(p4.literalPrefix(), QStringLiteral("// comment")));
+}
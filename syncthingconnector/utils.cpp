@@ -264,6 +264,112 @@ QString substituteTilde(const QString &path, const QString &tilde, const QString
     return path;
 }
 
+/// \cond
+/*!
+ * \brief Reads \a count digits from \a value starting at \a pos into \a result advancing \a pos.
+ */
+static bool readDigits(QStringView value, qsizetype &pos, qsizetype count, int &result)
+{
+    if (pos + count > value.size()) {
+        return false;
+    }
+    result = 0;
+    for (const auto end = pos + count; pos != end; ++pos) {
+        const auto c = value[pos].unicode();
+        if (c < u'0' || c > u'9') {
+            return false;
+        }
+        result = result * 10 + (c - u'0');
+    }
+    return true;
+}
+
+/*!
+ * \brief Returns whether \a value has the character \a c at \a pos advancing \a pos if that is the case.
+ */
+static bool readChar(QStringView value, qsizetype &pos, char16_t c)
+{
+    if (pos >= value.size() || value[pos].unicode() != c) {
+        return false;
+    }
+    ++pos;
+    return true;
+}
+
+static constexpr bool isLeapYear(int year)
+{
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+static constexpr int daysInMonth(int year, int month)
+{
+    return month == 2 ? (isLeapYear(year) ? 29 : 28) : (month == 4 || month == 6 || month == 9 || month == 11 ? 30 : 31);
+}
+/// \endcond
+
+/*!
+ * \brief Parses the specified RFC 3339 time stamp as used by Syncthing, e.g. "2024-05-01T12:34:56.123456789+02:00".
+ * \returns Returns whether \a value could be parsed. Only then \a localTime and \a utcOffset are assigned.
+ * \remarks
+ * - In contrast to DateTime::fromIsoString() this function operates directly on the UTF-16 data of \a value so there is no
+ *   need to convert the string to UTF-8 first. It also does not allocate and does not throw which makes it suitable for
+ *   parsing the many time stamps contained in events and statistics.
+ * - Fractional seconds are truncated to the precision of DateTime (100 ns).
+ * - Other ISO 8601 variants are not supported; callers may fall back to DateTime::fromIsoString() if this function fails.
+ */
+bool parseIsoTimeStamp(QStringView value, DateTime &localTime, TimeSpan &utcOffset)
+{
+    constexpr auto ticksPerSecond = static_cast<std::int64_t>(TimeSpan::ticksPerSecond);
+    constexpr auto ticksPerMinute = static_cast<std::int64_t>(TimeSpan::ticksPerMinute);
+    constexpr auto ticksPerHour = static_cast<std::int64_t>(TimeSpan::ticksPerHour);
+    auto pos = qsizetype();
+    auto year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+    if (!readDigits(value, pos, 4, year) || !readChar(value, pos, u'-') || !readDigits(value, pos, 2, month) || !readChar(value, pos, u'-')
+        || !readDigits(value, pos, 2, day) || !(readChar(value, pos, u'T') || readChar(value, pos, u't') || readChar(value, pos, u' '))
+        || !readDigits(value, pos, 2, hour) || !readChar(value, pos, u':') || !readDigits(value, pos, 2, minute) || !readChar(value, pos, u':')
+        || !readDigits(value, pos, 2, second)) {
+        return false;
+    }
+    if (year < 1 || month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month) || hour > 23 || minute > 59 || second > 59) {
+        return false;
+    }
+
+    // read fractional seconds considering only as many digits as DateTime can represent
+    auto fractionTicks = std::int64_t();
+    if (readChar(value, pos, u'.')) {
+        auto digits = 0;
+        auto factor = ticksPerSecond;
+        for (; pos < value.size() && value[pos].unicode() >= u'0' && value[pos].unicode() <= u'9'; ++pos, ++digits) {
+            if ((factor /= 10) > 0) {
+                fractionTicks += (value[pos].unicode() - u'0') * factor;
+            }
+        }
+        if (!digits) {
+            return false;
+        }
+    }
+
+    // read UTC offset
+    auto offsetTicks = std::int64_t();
+    if (!readChar(value, pos, u'Z') && !readChar(value, pos, u'z')) {
+        const auto sign = readChar(value, pos, u'+') ? 1 : (readChar(value, pos, u'-') ? -1 : 0);
+        auto offsetHours = 0, offsetMinutes = 0;
+        if (!sign || !readDigits(value, pos, 2, offsetHours) || !readChar(value, pos, u':') || !readDigits(value, pos, 2, offsetMinutes)
+            || offsetHours > 23 || offsetMinutes > 59) {
+            return false;
+        }
+        offsetTicks = sign * (offsetHours * ticksPerHour + offsetMinutes * ticksPerMinute);
+    }
+    if (pos != value.size()) {
+        return false;
+    }
+
+    localTime = DateTime::fromDate(year, month, day)
+        + TimeSpan(hour * ticksPerHour + minute * ticksPerMinute + second * ticksPerSecond + fractionTicks);
+    utcOffset = TimeSpan(offsetTicks);
+    return true;
+}
+
 #ifdef SYNCTHINGCONNECTION_SUPPORT_METERED
 /*!
  * \brief Loads the QNetworkInformation backend for determining whether the connection is metered.
@@ -22,7 +22,8 @@ QT_FORWARD_DECLARE_CLASS(QNetworkInformation)
 
 namespace CppUtilities {
 class DateTime;
-}
+class TimeSpan;
+} // namespace CppUtilities
 
 namespace Data {
 
@@ -44,6 +45,7 @@ LIB_SYNCTHING_CONNECTOR_EXPORT bool isLocal(const QString &hostName, const QHost
 LIB_SYNCTHING_CONNECTOR_EXPORT bool setDirectoriesPaused(QJsonObject &syncthingConfig, const QStringList &dirIds, bool paused);
 LIB_SYNCTHING_CONNECTOR_EXPORT bool setDevicesPaused(QJsonObject &syncthingConfig, const QStringList &dirs, bool paused);
 LIB_SYNCTHING_CONNECTOR_EXPORT QString substituteTilde(const QString &path, const QString &tilde, const QString &pathSeparator);
+LIB_SYNCTHING_CONNECTOR_EXPORT bool parseIsoTimeStamp(QStringView value, CppUtilities::DateTime &localTime, CppUtilities::TimeSpan &utcOffset);
 #ifdef SYNCTHINGCONNECTION_SUPPORT_METERED
 LIB_SYNCTHING_CONNECTOR_EXPORT const QNetworkInformation *loadNetworkInformationBackendForMetered();
 #endif
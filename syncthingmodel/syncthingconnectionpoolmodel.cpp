@@ -0,0 +1,137 @@
+#include "./syncthingconnectionpoolmodel.h"
+
+#include <syncthingconnector/syncthingconnectionpool.h>
+#include <syncthingconnector/utils.h>
+
+using namespace std;
+
+namespace Data {
+
+/*!
+ * \class SyncthingConnectionPoolModel
+ * \brief The SyncthingConnectionPoolModel class provides one row per connection of a SyncthingConnectionPool.
+ *
+ * Each row shows the status, completion and traffic of a Syncthing node. Rows are only updated when the pool emits
+ * SyncthingConnectionPool::nodesChanged() so the model emits at most one dataChanged() per update interval of the pool,
+ * regardless of the number of nodes. The aggregated statistics are available via SyncthingConnectionPool::statistics().
+ */
+
+SyncthingConnectionPoolModel::SyncthingConnectionPoolModel(SyncthingConnectionPool &pool, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_pool(pool)
+{
+    connect(&m_pool, &SyncthingConnectionPool::connectionAboutToBeAdded, this, &SyncthingConnectionPoolModel::handleConnectionAboutToBeAdded);
+    connect(&m_pool, &SyncthingConnectionPool::connectionAdded, this, &SyncthingConnectionPoolModel::handleConnectionAdded);
+    connect(&m_pool, &SyncthingConnectionPool::connectionAboutToBeRemoved, this, &SyncthingConnectionPoolModel::handleConnectionAboutToBeRemoved);
+    connect(&m_pool, &SyncthingConnectionPool::connectionRemoved, this, &SyncthingConnectionPoolModel::handleConnectionRemoved);
+    connect(&m_pool, &SyncthingConnectionPool::nodesChanged, this, &SyncthingConnectionPoolModel::handleNodesChanged);
+}
+
+QHash<int, QByteArray> SyncthingConnectionPoolModel::roleNames() const
+{
+    const static QHash<int, QByteArray> roles{
+        { Qt::DisplayRole, "label" },
+        { NodeStatus, "status" },
+        { NodeStatusString, "statusString" },
+        { NodeConnected, "connected" },
+        { NodeSyncthingUrl, "syncthingUrl" },
+        { NodeLocalCompletion, "localCompletion" },
+        { NodeRemoteCompletion, "remoteCompletion" },
+        { NodeNeededBytes, "neededBytes" },
+        { NodeGlobalBytes, "globalBytes" },
+        { NodeIncomingTraffic, "incomingTraffic" },
+        { NodeOutgoingTraffic, "outgoingTraffic" },
+        { NodeIncomingRate, "incomingRate" },
+        { NodeOutgoingRate, "outgoingRate" },
+        { NodeTrafficString, "trafficString" },
+        { NodeConnection, "connection" },
+    };
+    return roles;
+}
+
+QVariant SyncthingConnectionPoolModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole && section == 0) {
+        return tr("Syncthing node");
+    }
+    return QVariant();
+}
+
+QVariant SyncthingConnectionPoolModel::data(const QModelIndex &index, int role) const
+{
+    const auto *const node = index.isValid() && !index.parent().isValid() ? m_pool.node(index.row()) : nullptr;
+    if (!node) {
+        return QVariant();
+    }
+    const auto &connection = *node->connection;
+    switch (role) {
+    case Qt::DisplayRole:
+        return node->label;
+    case Qt::ToolTipRole:
+        return QStringLiteral("%1 (%2)").arg(connection.syncthingUrl(), connection.statusText());
+    case NodeStatus:
+        return static_cast<int>(connection.status());
+    case NodeStatusString:
+        return connection.statusText();
+    case NodeConnected:
+        return connection.isConnected();
+    case NodeSyncthingUrl:
+        return connection.syncthingUrl();
+    case NodeLocalCompletion:
+        return node->localCompletion;
+    case NodeRemoteCompletion:
+        return node->remoteCompletion.percentage;
+    case NodeNeededBytes:
+        return node->dirStatistics.needed.bytes;
+    case NodeGlobalBytes:
+        return node->dirStatistics.global.bytes;
+    case NodeIncomingTraffic:
+        return static_cast<quint64>(connection.totalIncomingTraffic());
+    case NodeOutgoingTraffic:
+        return static_cast<quint64>(connection.totalOutgoingTraffic());
+    case NodeIncomingRate:
+        return connection.totalIncomingRate();
+    case NodeOutgoingRate:
+        return connection.totalOutgoingRate();
+    case NodeTrafficString:
+        return tr("%1 in, %2 out")
+            .arg(trafficString(connection.totalIncomingTraffic(), connection.totalIncomingRate()),
+                trafficString(connection.totalOutgoingTraffic(), connection.totalOutgoingRate()));
+    case NodeConnection:
+        return QVariant::fromValue(node->connection.get());
+    default:;
+    }
+    return QVariant();
+}
+
+int SyncthingConnectionPoolModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_pool.connectionCount();
+}
+
+void SyncthingConnectionPoolModel::handleConnectionAboutToBeAdded(int index)
+{
+    beginInsertRows(QModelIndex(), index, index);
+}
+
+void SyncthingConnectionPoolModel::handleConnectionAdded()
+{
+    endInsertRows();
+}
+
+void SyncthingConnectionPoolModel::handleConnectionAboutToBeRemoved(int index)
+{
+    beginRemoveRows(QModelIndex(), index, index);
+}
+
+void SyncthingConnectionPoolModel::handleConnectionRemoved()
+{
+    endRemoveRows();
+}
+
+void SyncthingConnectionPoolModel::handleNodesChanged(int firstIndex, int lastIndex)
+{
+    emit dataChanged(index(firstIndex), index(lastIndex));
+}
+
+} // namespace Data
@@ -0,0 +1,64 @@
+#ifndef DATA_SYNCTHINGCONNECTIONPOOLMODEL_H
+#define DATA_SYNCTHINGCONNECTIONPOOLMODEL_H
+
+#include "./global.h"
+
+#include <QAbstractListModel>
+
+#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
+Q_MOC_INCLUDE("../syncthingconnector/syncthingconnectionpool.h")
+#endif
+
+namespace Data {
+
+class SyncthingConnectionPool;
+
+class LIB_SYNCTHING_MODEL_EXPORT SyncthingConnectionPoolModel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(Data::SyncthingConnectionPool *pool READ pool)
+
+public:
+    enum SyncthingConnectionPoolModelRole {
+        NodeStatus = Qt::UserRole + 1,
+        NodeStatusString,
+        NodeConnected,
+        NodeSyncthingUrl,
+        NodeLocalCompletion,
+        NodeRemoteCompletion,
+        NodeNeededBytes,
+        NodeGlobalBytes,
+        NodeIncomingTraffic,
+        NodeOutgoingTraffic,
+        NodeIncomingRate,
+        NodeOutgoingRate,
+        NodeTrafficString,
+        NodeConnection,
+    };
+
+    explicit SyncthingConnectionPoolModel(SyncthingConnectionPool &pool, QObject *parent = nullptr);
+
+    Data::SyncthingConnectionPool *pool() const;
+    QHash<int, QByteArray> roleNames() const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+private Q_SLOTS:
+    void handleConnectionAboutToBeAdded(int index);
+    void handleConnectionAdded();
+    void handleConnectionAboutToBeRemoved(int index);
+    void handleConnectionRemoved();
+    void handleNodesChanged(int firstIndex, int lastIndex);
+
+private:
+    SyncthingConnectionPool &m_pool;
+};
+
+inline SyncthingConnectionPool *SyncthingConnectionPoolModel::pool() const
+{
+    return &m_pool;
+}
+
+} // namespace Data
+
+#endif // DATA_SYNCTHINGCONNECTIONPOOLMODEL_H
@@ -9,6 +9,8 @@
 
 #include <QStringBuilder>
 
+#include <algorithm>
+
 using namespace std;
 using namespace CppUtilities;
 
@@ -26,6 +28,13 @@ SyncthingDeviceModel::SyncthingDeviceModel(SyncthingConnection &connection, QObj
 {
     updateRowCount();
     connect(&m_connection, &SyncthingConnection::devStatusChanged, this, &SyncthingDeviceModel::devStatusChanged);
+    connect(&m_connection, &SyncthingConnection::devConfigChanged, this, &SyncthingDeviceModel::devStatusChanged);
+    connect(&m_connection, &SyncthingConnection::devAboutToBeAdded, this, &SyncthingDeviceModel::handleDevAboutToBeAdded);
+    connect(&m_connection, &SyncthingConnection::devAdded, this, &SyncthingDeviceModel::handleDevAdded);
+    connect(&m_connection, &SyncthingConnection::devAboutToBeRemoved, this, &SyncthingDeviceModel::handleDevAboutToBeRemoved);
+    connect(&m_connection, &SyncthingConnection::devRemoved, this, &SyncthingDeviceModel::handleDevRemoved);
+    connect(&m_connection, &SyncthingConnection::devAboutToBeMoved, this, &SyncthingDeviceModel::handleDevAboutToBeMoved);
+    connect(&m_connection, &SyncthingConnection::devMoved, this, &SyncthingDeviceModel::handleDevMoved);
 }
 
 QHash<int, QByteArray> SyncthingDeviceModel::roleNames() const
@@ -368,53 +377,137 @@ int SyncthingDeviceModel::rowCount(const QModelIndex &parent) const
     }
 }
 
+/*!
+ * \brief Returns whether \a parent has children.
+ * \remarks Devices always have detail rows, even if those have not been populated yet via fetchMore().
+ */
+bool SyncthingDeviceModel::hasChildren(const QModelIndex &parent) const
+{
+    if (!parent.isValid()) {
+        return !m_devs.empty();
+    }
+    return !parent.parent().isValid() && static_cast<std::size_t>(parent.row()) < m_devs.size();
+}
+
+/*!
+ * \brief Returns whether the detail rows of the device at \a parent have not been populated yet.
+ */
+bool SyncthingDeviceModel::canFetchMore(const QModelIndex &parent) const
+{
+    return parent.isValid() && !parent.parent().isValid() && static_cast<std::size_t>(parent.row()) < m_rowCount.size()
+        && !m_rowCount[static_cast<std::size_t>(parent.row())];
+}
+
+/*!
+ * \brief Populates the detail rows of the device at \a parent.
+ * \remarks
+ * - Views call this when a device is expanded. Detail rows of collapsed devices are never populated so status changes of
+ *   those devices only need to update the top-level row. This makes a difference when many devices are configured.
+ * - The detail rows stay populated until the model is reset.
+ */
+void SyncthingDeviceModel::fetchMore(const QModelIndex &parent)
+{
+    if (!canFetchMore(parent)) {
+        return;
+    }
+    const auto row = static_cast<std::size_t>(parent.row());
+    const auto newRowCount = computeDeviceRowCount(m_devs[row]);
+    beginInsertRows(parent, 0, newRowCount - 1);
+    m_rowCount[row] = newRowCount;
+    endInsertRows();
+}
+
 void SyncthingDeviceModel::devStatusChanged(const SyncthingDev &dev, int index)
 {
     if (index < 0 || static_cast<std::size_t>(index) >= m_rowCount.size()) {
         return;
     }
 
-    // update top-level indices
-    const QModelIndex modelIndex1(this->index(index, 0, QModelIndex()));
+    // update top-level indices with a single emission covering both columns
+    const auto modelIndex1 = this->index(index, 0, QModelIndex());
     static const QVector<int> modelRoles1({ Qt::DisplayRole, Qt::EditRole, Qt::DecorationRole, Qt::ForegroundRole, DevicePaused, DeviceStatus,
         DeviceStatusString, DeviceStatusColor, DeviceId, IsThisDevice, IsPinned, DeviceNeededItemsCount });
-    emit dataChanged(modelIndex1, modelIndex1, modelRoles1);
-    const QModelIndex modelIndex2(this->index(index, 1, QModelIndex()));
-    static const QVector<int> modelRoles2({ Qt::DisplayRole, Qt::EditRole, Qt::ForegroundRole });
-    emit dataChanged(modelIndex2, modelIndex2, modelRoles2);
+    emit dataChanged(modelIndex1, this->index(index, 1, QModelIndex()), modelRoles1);
 
-    // remove/insert detail rows
+    // skip detail rows if not populated yet
     const auto oldRowCount = m_rowCount[static_cast<std::size_t>(index)];
+    if (!oldRowCount) {
+        return;
+    }
+
+    // remove/insert detail rows
     const auto newRowCount = computeDeviceRowCount(dev);
     const auto newLastRow = newRowCount - 1;
     if (oldRowCount > newRowCount) {
         // begin removing rows for statistics
-        beginRemoveRows(modelIndex1, 2, 3);
+        beginRemoveRows(modelIndex1, 2, 1 + oldRowCount - newRowCount);
         m_rowCount[static_cast<std::size_t>(index)] = newRowCount;
         endRemoveRows();
     } else if (newRowCount > oldRowCount) {
         // begin inserting rows for statistics
-        beginInsertRows(modelIndex1, 2, 3);
+        beginInsertRows(modelIndex1, 2, 1 + newRowCount - oldRowCount);
         m_rowCount[static_cast<std::size_t>(index)] = newRowCount;
         endInsertRows();
     }
 
-    // update detail rows
-    static const QVector<int> modelRoles3({ Qt::DisplayRole, Qt::EditRole, Qt::ToolTipRole, DeviceDetailTooltip });
-    emit dataChanged(this->index(0, 1, modelIndex1), this->index(newLastRow, 1, modelIndex1), modelRoles3);
-    static const QVector<int> modelRoles4({ Qt::DisplayRole, Qt::EditRole, DeviceDetail, DeviceDetailIcon });
-    emit dataChanged(this->index(0, 0, modelIndex1), this->index(newLastRow, 0, modelIndex1), modelRoles4);
+    // update detail rows with a single emission covering all rows and columns
+    static const QVector<int> modelRoles2(
+        { Qt::DisplayRole, Qt::EditRole, Qt::ForegroundRole, Qt::ToolTipRole, DeviceDetail, DeviceDetailIcon, DeviceDetailTooltip });
+    emit dataChanged(this->index(0, 0, modelIndex1), this->index(newLastRow, 1, modelIndex1), modelRoles2);
+}
+
+void SyncthingDeviceModel::handleDevAboutToBeAdded(int index)
+{
+    beginInsertRows(QModelIndex(), index, index);
+}
+
+void SyncthingDeviceModel::handleDevAdded(const SyncthingDev &, int index)
+{
+    m_rowCount.insert(m_rowCount.begin() + index, 0);
+    endInsertRows();
+}
+
+void SyncthingDeviceModel::handleDevAboutToBeRemoved(const SyncthingDev &, int index)
+{
+    beginRemoveRows(QModelIndex(), index, index);
+}
+
+void SyncthingDeviceModel::handleDevRemoved(const QString &, int index)
+{
+    m_rowCount.erase(m_rowCount.begin() + index);
+    endRemoveRows();
+}
+
+void SyncthingDeviceModel::handleDevAboutToBeMoved(const SyncthingDev &, int fromIndex, int toIndex)
+{
+    beginMoveRows(QModelIndex(), fromIndex, fromIndex, QModelIndex(), toIndex > fromIndex ? toIndex + 1 : toIndex);
+}
+
+void SyncthingDeviceModel::handleDevMoved(const SyncthingDev &, int fromIndex, int toIndex)
+{
+    const auto from = m_rowCount.begin() + fromIndex, to = m_rowCount.begin() + toIndex;
+    if (fromIndex > toIndex) {
+        std::rotate(to, from, from + 1);
+    } else {
+        std::rotate(from, from + 1, to + 1);
+    }
+    endMoveRows();
 }
 
 void SyncthingDeviceModel::handleConfigInvalidated()
 {
-    beginResetModel();
+    // keep rows (and thus the expansion state of views) when only changes are applied; see handleDevAdded() and others
+    if (!m_connection.isApplyingConfigIncrementally()) {
+        beginResetModel();
+    }
 }
 
 void SyncthingDeviceModel::handleNewConfigAvailable()
 {
-    updateRowCount();
-    endResetModel();
+    if (!m_connection.isApplyingConfigIncrementally()) {
+        updateRowCount();
+        endResetModel();
+    }
 }
 
 void SyncthingDeviceModel::handleStatusIconsChanged()
@@ -451,11 +544,8 @@ QVariant SyncthingDeviceModel::devStatusColor(const SyncthingDev &dev) const
 
 void SyncthingDeviceModel::updateRowCount()
 {
-    m_rowCount.clear();
-    m_rowCount.reserve(m_devs.size());
-    for (const auto &dev : m_devs) {
-        m_rowCount.emplace_back(computeDeviceRowCount(dev));
-    }
+    // detail rows are only populated on demand via fetchMore()
+    m_rowCount.assign(m_devs.size(), 0);
 }
 
 } // namespace Data
@@ -38,11 +38,20 @@ public:
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
     bool setData(const QModelIndex &index, const QVariant &value, int role) override;
     int rowCount(const QModelIndex &parent) const override;
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
     Q_INVOKABLE const SyncthingDev *devInfo(const QModelIndex &index) const;
     Q_INVOKABLE const SyncthingDev *info(const QModelIndex &index) const;
 
 private Q_SLOTS:
     void devStatusChanged(const Data::SyncthingDev &, int index);
+    void handleDevAboutToBeAdded(int index);
+    void handleDevAdded(const Data::SyncthingDev &dev, int index);
+    void handleDevAboutToBeRemoved(const Data::SyncthingDev &dev, int index);
+    void handleDevRemoved(const QString &devId, int index);
+    void handleDevAboutToBeMoved(const Data::SyncthingDev &dev, int fromIndex, int toIndex);
+    void handleDevMoved(const Data::SyncthingDev &dev, int fromIndex, int toIndex);
     void handleConfigInvalidated() override;
     void handleNewConfigAvailable() override;
     void handleStatusIconsChanged() override;
@@ -53,7 +62,7 @@ private:
     void updateRowCount();
 
     const std::vector<SyncthingDev> &m_devs;
-    std::vector<int> m_rowCount;
+    std::vector<int> m_rowCount; // number of populated detail rows per device; 0 if not populated yet
 };
 
 inline const SyncthingDev *SyncthingDeviceModel::info(const QModelIndex &index) const
@@ -9,6 +9,8 @@
 
 #include <QStringBuilder>
 
+#include <algorithm>
+
 using namespace std;
 using namespace CppUtilities;
 
@@ -25,6 +27,13 @@ SyncthingDirectoryModel::SyncthingDirectoryModel(SyncthingConnection &connection
 {
     updateRowCount();
     connect(&m_connection, &SyncthingConnection::dirStatusChanged, this, &SyncthingDirectoryModel::dirStatusChanged);
+    connect(&m_connection, &SyncthingConnection::dirConfigChanged, this, &SyncthingDirectoryModel::dirStatusChanged);
+    connect(&m_connection, &SyncthingConnection::dirAboutToBeAdded, this, &SyncthingDirectoryModel::handleDirAboutToBeAdded);
+    connect(&m_connection, &SyncthingConnection::dirAdded, this, &SyncthingDirectoryModel::handleDirAdded);
+    connect(&m_connection, &SyncthingConnection::dirAboutToBeRemoved, this, &SyncthingDirectoryModel::handleDirAboutToBeRemoved);
+    connect(&m_connection, &SyncthingConnection::dirRemoved, this, &SyncthingDirectoryModel::handleDirRemoved);
+    connect(&m_connection, &SyncthingConnection::dirAboutToBeMoved, this, &SyncthingDirectoryModel::handleDirAboutToBeMoved);
+    connect(&m_connection, &SyncthingConnection::dirMoved, this, &SyncthingDirectoryModel::handleDirMoved);
 }
 
 QHash<int, QByteArray> SyncthingDirectoryModel::roleNames() const
@@ -445,12 +454,12 @@ void SyncthingDirectoryModel::dirStatusChanged(const SyncthingDir &dir, int inde
     const auto newLastRow = newRowCount - 1;
     if (oldRowCount > newRowCount) {
         // begin removing rows for statistics
-        beginRemoveRows(modelIndex1, 2, 3);
+        beginRemoveRows(modelIndex1, 2, 1 + oldRowCount - newRowCount);
         m_rowCount[static_cast<std::size_t>(index)] = newRowCount;
         endRemoveRows();
     } else if (newRowCount > oldRowCount) {
         // begin inserting rows for statistics
-        beginInsertRows(modelIndex1, 2, 3);
+        beginInsertRows(modelIndex1, 2, 1 + newRowCount - oldRowCount);
         m_rowCount[static_cast<std::size_t>(index)] = newRowCount;
         endInsertRows();
     }
@@ -462,15 +471,58 @@ void SyncthingDirectoryModel::dirStatusChanged(const SyncthingDir &dir, int inde
     emit dataChanged(this->index(0, 0, modelIndex1), this->index(newLastRow, 0, modelIndex1), modelRoles4);
 }
 
+void SyncthingDirectoryModel::handleDirAboutToBeAdded(int index)
+{
+    beginInsertRows(QModelIndex(), index, index);
+}
+
+void SyncthingDirectoryModel::handleDirAdded(const SyncthingDir &dir, int index)
+{
+    m_rowCount.insert(m_rowCount.begin() + index, computeDirectoryRowCount(dir));
+    endInsertRows();
+}
+
+void SyncthingDirectoryModel::handleDirAboutToBeRemoved(const SyncthingDir &, int index)
+{
+    beginRemoveRows(QModelIndex(), index, index);
+}
+
+void SyncthingDirectoryModel::handleDirRemoved(const QString &, int index)
+{
+    m_rowCount.erase(m_rowCount.begin() + index);
+    endRemoveRows();
+}
+
+void SyncthingDirectoryModel::handleDirAboutToBeMoved(const SyncthingDir &, int fromIndex, int toIndex)
+{
+    beginMoveRows(QModelIndex(), fromIndex, fromIndex, QModelIndex(), toIndex > fromIndex ? toIndex + 1 : toIndex);
+}
+
+void SyncthingDirectoryModel::handleDirMoved(const SyncthingDir &, int fromIndex, int toIndex)
+{
+    const auto from = m_rowCount.begin() + fromIndex, to = m_rowCount.begin() + toIndex;
+    if (fromIndex > toIndex) {
+        std::rotate(to, from, from + 1);
+    } else {
+        std::rotate(from, from + 1, to + 1);
+    }
+    endMoveRows();
+}
+
 void SyncthingDirectoryModel::handleConfigInvalidated()
 {
-    beginResetModel();
+    // keep rows (and thus the expansion state of views) when only changes are applied; see handleDirAdded() and others
+    if (!m_connection.isApplyingConfigIncrementally()) {
+        beginResetModel();
+    }
 }
 
 void SyncthingDirectoryModel::handleNewConfigAvailable()
 {
-    updateRowCount();
-    endResetModel();
+    if (!m_connection.isApplyingConfigIncrementally()) {
+        updateRowCount();
+        endResetModel();
+    }
 }
 
 void SyncthingDirectoryModel::handleStatusIconsChanged()
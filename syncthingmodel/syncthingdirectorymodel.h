@@ -46,6 +46,12 @@ public:
 
 private Q_SLOTS:
     void dirStatusChanged(const Data::SyncthingDir &dir, int index);
+    void handleDirAboutToBeAdded(int index);
+    void handleDirAdded(const Data::SyncthingDir &dir, int index);
+    void handleDirAboutToBeRemoved(const Data::SyncthingDir &dir, int index);
+    void handleDirRemoved(const QString &dirId, int index);
+    void handleDirAboutToBeMoved(const Data::SyncthingDir &dir, int fromIndex, int toIndex);
+    void handleDirMoved(const Data::SyncthingDir &dir, int fromIndex, int toIndex);
     void handleConfigInvalidated() override;
     void handleNewConfigAvailable() override;
     void handleStatusIconsChanged() override;
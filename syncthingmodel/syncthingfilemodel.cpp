@@ -22,6 +22,7 @@
 #include <QThreadPool>
 #include <QtConcurrent>
 
+#include <algorithm>
 #include <cassert>
 #include <filesystem>
 #include <limits>
@@ -33,6 +34,9 @@ using namespace CppUtilities;
 namespace Data {
 
 static constexpr auto beforeFirstLine = std::numeric_limits<std::size_t>::max();
+static constexpr auto fullDiff = std::numeric_limits<std::size_t>::max();
+static constexpr auto diffContextLines = std::size_t(3);
+static constexpr auto maxIgnorePatternsForFullDiff = std::size_t(200);
 
 /// \cond
 static void populatePath(const QString &root, QChar pathSeparator, std::vector<std::unique_ptr<SyncthingItem>> &items)
@@ -191,36 +195,98 @@ QString SyncthingFileModel::path(const QModelIndex &index) const
 
 /*!
  * \brief Computes a diff between the present ignore patterns and staged changes.
+ * \remarks
+ * - By default all present patterns are part of the diff. If \a contextLines is specified, only hunks around the staged
+ *   changes are computed (with the specified number of unchanged lines around them and "@@ -l,s +l,s @@" headers) so
+ *   the effort only depends on the number of staged changes and not on the number of present patterns.
+ * - Staged removals of patterns which are immediately re-added are dropped from the staged changes.
  */
-QString SyncthingFileModel::computeIgnorePatternDiff()
+QString SyncthingFileModel::computeIgnorePatternDiff(std::size_t contextLines)
 {
     auto diff = QString();
-    auto index = std::size_t();
-    const auto appendNewLines = [&diff](const auto &lines) {
+    const auto appendLine = [&diff](QChar prefix, const QString &line) {
+        diff.append(prefix);
+        diff.append(line);
+        diff.append(QChar('\n'));
+    };
+    const auto appendNewLines = [&appendLine](const auto &lines) {
         for (const auto &line : lines) {
-            diff.append(QChar('+'));
-            diff.append(line);
-            diff.append(QChar('\n'));
+            appendLine(QChar('+'), line);
         }
     };
-    if (const auto change = m_stagedChanges.find(beforeFirstLine); change != m_stagedChanges.end()) {
-        appendNewLines(change->prepend);
-        appendNewLines(change->append);
+
+    // determine changed positions in order (position 0 is before the first line, position n + 1 refers to line n)
+    const auto patternCount = m_presentIgnorePatterns.size();
+    auto changedPositions = std::vector<std::size_t>();
+    changedPositions.reserve(static_cast<std::size_t>(m_stagedChanges.size()));
+    for (auto i = m_stagedChanges.begin(), end = m_stagedChanges.end(); i != end; ++i) {
+        if (i.key() == beforeFirstLine) {
+            changedPositions.emplace_back(0);
+            continue;
+        }
+        if (i.key() >= patternCount) {
+            continue;
+        }
+        auto &change = i.value();
+        if (change.replace && !change.prepend.isEmpty() && change.prepend.back() == m_presentIgnorePatterns[i.key()].pattern) {
+            change.prepend.removeLast();
+            change.replace = false;
+        }
+        changedPositions.emplace_back(i.key() + 1);
     }
-    for (const auto &pattern : m_presentIgnorePatterns) {
-        auto change = m_stagedChanges.find(index++);
-        if (change != m_stagedChanges.end()) {
-            if (change->replace && !change->prepend.isEmpty() && change->prepend.back() == pattern.pattern) {
-                change->prepend.removeLast();
-                change->replace = false;
-            }
-            appendNewLines(change->prepend);
+    std::sort(changedPositions.begin(), changedPositions.end());
+
+    // group changes into hunks covering the changed positions and their context
+    struct Hunk {
+        std::size_t begin, end; // positions, both inclusive
+        std::ptrdiff_t lineDelta; // number of added lines minus number of removed lines within the hunk
+    };
+    auto hunks = std::vector<Hunk>();
+    if (contextLines >= patternCount) {
+        hunks.emplace_back(Hunk{ 0, patternCount, 0 });
+    }
+    for (const auto position : changedPositions) {
+        const auto &change = *m_stagedChanges.find(position ? position - 1 : beforeFirstLine);
+        const auto lineDelta = static_cast<std::ptrdiff_t>(change.prepend.size() + change.append.size()) - (position && change.replace ? 1 : 0);
+        const auto begin = position > contextLines ? position - contextLines : 0;
+        const auto end = position + std::min(contextLines, patternCount - std::min(position, patternCount));
+        if (!hunks.empty() && begin <= hunks.back().end + 1) {
+            hunks.back().end = std::max(hunks.back().end, end);
+            hunks.back().lineDelta += lineDelta;
+        } else {
+            hunks.emplace_back(Hunk{ begin, end, lineDelta });
         }
-        diff.append(change == m_stagedChanges.end() || !change->replace ? QChar(' ') : QChar('-'));
-        diff.append(pattern.pattern);
-        diff.append(QChar('\n'));
-        if (change != m_stagedChanges.end()) {
-            appendNewLines(change->append);
+    }
+
+    // compute diff lines of hunks
+    auto lineDelta = std::ptrdiff_t();
+    for (const auto &hunk : hunks) {
+        if (hunk.begin > 1 || hunk.end < patternCount) {
+            const auto firstLine = std::max<std::size_t>(hunk.begin, 1);
+            const auto oldCount = hunk.end >= firstLine ? hunk.end - firstLine + 1 : 0;
+            const auto newCount = static_cast<std::ptrdiff_t>(oldCount) + hunk.lineDelta;
+            const auto oldStart = oldCount ? firstLine : firstLine - 1;
+            const auto newStart = static_cast<std::ptrdiff_t>(oldStart) + lineDelta + (newCount && !oldCount ? 1 : 0);
+            diff += QStringLiteral("@@ -%1,%2 +%3,%4 @@\n").arg(oldStart).arg(oldCount).arg(newStart).arg(newCount);
+        }
+        lineDelta += hunk.lineDelta;
+        for (auto position = hunk.begin; position <= hunk.end; ++position) {
+            if (!position) {
+                if (const auto change = m_stagedChanges.find(beforeFirstLine); change != m_stagedChanges.end()) {
+                    appendNewLines(change->prepend);
+                    appendNewLines(change->append);
+                }
+                continue;
+            }
+            const auto change = m_stagedChanges.find(position - 1);
+            const auto isChanged = change != m_stagedChanges.end();
+            if (isChanged) {
+                appendNewLines(change->prepend);
+            }
+            appendLine(isChanged && change->replace ? QChar('-') : QChar(' '), m_presentIgnorePatterns[position - 1].pattern);
+            if (isChanged) {
+                appendNewLines(change->append);
+            }
         }
     }
     return diff;
@@ -700,7 +766,31 @@ template <typename Callback> static void forEachItem(SyncthingItem *root, Callba
 
 void SyncthingFileModel::ignoreSelectedItems(bool ignore, bool deleteLocally)
 {
-    forEachItem(m_root.get(), [this, ignore, deleteLocally](const SyncthingItem *item) {
+    // index present and staged patterns so checked items can be handled without going through all patterns for each item
+    auto presentLines = QHash<QString, std::vector<std::size_t>>(), stagedLines = QHash<QString, std::vector<std::size_t>>();
+    presentLines.reserve(static_cast<qsizetype>(m_presentIgnorePatterns.size()));
+    auto line = std::size_t();
+    for (const auto &pattern : m_presentIgnorePatterns) {
+        presentLines[pattern.pattern].emplace_back(line++);
+    }
+    for (auto i = m_stagedChanges.cbegin(), end = m_stagedChanges.cend(); i != end; ++i) {
+        for (const auto *const patterns : { &i->prepend, &i->append }) {
+            for (const auto &pattern : *patterns) {
+                stagedLines[pattern].emplace_back(i.key());
+            }
+        }
+    }
+
+    // keep track of the greatest glob up to each line so the first line with a glob greater than a path can be found via
+    // binary search (the running maximum is sorted even if the patterns themselves are not)
+    auto greatestGlobLines = std::vector<std::size_t>();
+    greatestGlobLines.reserve(m_presentIgnorePatterns.size());
+    for (auto i = std::size_t(); i != m_presentIgnorePatterns.size(); ++i) {
+        greatestGlobLines.emplace_back(
+            i && !(m_presentIgnorePatterns[i].glob > m_presentIgnorePatterns[greatestGlobLines.back()].glob) ? greatestGlobLines.back() : i);
+    }
+
+    forEachItem(m_root.get(), [this, ignore, deleteLocally, &presentLines, &stagedLines, &greatestGlobLines](const SyncthingItem *item) {
         if (item->checked != Qt::Checked || !item->isFilesystemItem()) {
             return true;
         }
@@ -708,18 +798,21 @@ void SyncthingFileModel::ignoreSelectedItems(bool ignore, bool deleteLocally)
         const auto path = m_pathSeparator + item->path;
         const auto reversePattern = SyncthingIgnorePattern::forPath(path, !ignore);
         const auto wantedPattern = SyncthingIgnorePattern::forPath(path, ignore);
-        auto line = std::size_t();
-        for (auto &pattern : m_presentIgnorePatterns) {
-            if (pattern.pattern == reversePattern || pattern.pattern == wantedPattern) {
-                m_stagedChanges[line].replace = true;
+        for (const auto *const pattern : { &reversePattern, &wantedPattern }) {
+            if (const auto lines = presentLines.constFind(*pattern); lines != presentLines.cend()) {
+                for (const auto presentLine : *lines) {
+                    m_stagedChanges[presentLine].replace = true;
+                }
+            }
+            if (const auto lines = stagedLines.find(*pattern); lines != stagedLines.end()) {
+                for (const auto stagedLine : *lines) {
+                    if (const auto change = m_stagedChanges.find(stagedLine); change != m_stagedChanges.end()) {
+                        change->prepend.removeAll(*pattern);
+                        change->append.removeAll(*pattern);
+                    }
+                }
+                stagedLines.erase(lines);
             }
-            ++line;
-        }
-        for (auto &change : m_stagedChanges) {
-            change.prepend.removeAll(reversePattern);
-            change.prepend.removeAll(wantedPattern);
-            change.append.removeAll(reversePattern);
-            change.append.removeAll(wantedPattern);
         }
 
         // add line to explicitly ignore/include the item
@@ -737,24 +830,31 @@ void SyncthingFileModel::ignoreSelectedItems(bool ignore, bool deleteLocally)
             }
             list.append(pattern);
         };
-        line = std::size_t();
-        for (auto &pattern : m_presentIgnorePatterns) {
-            // reinstate a previously removed pattern
-            if (pattern.pattern == wantedPattern) {
-                if (auto change = m_stagedChanges.find(line); change != m_stagedChanges.end() && change->replace) {
-                    change->replace = false;
-                    break;
-                }
+        // keep alphabetical order and don't insert pattern after another one that would match
+        // note: The first matching pattern is usually already known from matching the item against the present patterns.
+        const auto greaterGlobLine = static_cast<std::size_t>(
+            std::partition_point(greatestGlobLines.cbegin(), greatestGlobLines.cend(),
+                [this, &path](std::size_t line) { return !(m_presentIgnorePatterns[line].glob > path); })
+            - greatestGlobLines.cbegin());
+        auto matchingLine = item->ignorePattern;
+        if (matchingLine == SyncthingItem::ignorePatternNotInitialized) {
+            matchingLine = 0;
+            while (matchingLine < greaterGlobLine && !m_presentIgnorePatterns[matchingLine].matches(item->path, m_pathSeparator)) {
+                ++matchingLine;
             }
-            // append pattern but keep alphabetical order and don't insert pattern after another one that would match
-            if (pattern.glob > path || pattern.matches(item->path, m_pathSeparator)) {
-                insertPattern(m_stagedChanges[line].prepend, wantedPattern, path);
-                break;
-            }
-            ++line;
         }
-        if (line == m_presentIgnorePatterns.size()) {
+        const auto line = std::min(greaterGlobLine, matchingLine);
+        // reinstate a previously removed pattern instead if it is present before (or at) the insertion point
+        if (const auto lines = presentLines.constFind(wantedPattern); lines != presentLines.cend() && lines->front() <= line) {
+            if (auto change = m_stagedChanges.find(lines->front()); change != m_stagedChanges.end() && change->replace) {
+                change->replace = false;
+            }
+        } else if (line < m_presentIgnorePatterns.size()) {
+            insertPattern(m_stagedChanges[line].prepend, wantedPattern, path);
+            stagedLines[wantedPattern].emplace_back(line);
+        } else {
             insertPattern(m_stagedChanges[m_presentIgnorePatterns.size() - 1].append, wantedPattern, path);
+            stagedLines[wantedPattern].emplace_back(m_presentIgnorePatterns.size() - 1);
         }
 
         // stage deletion of local file
@@ -896,8 +996,9 @@ QList<QAction *> SyncthingFileModel::selectionActions()
                 action->needsConfirmation = false;
                 m_manuallyEditedIgnorePatterns.clear();
                 m_manuallyEditedLocalDeletions.reset();
-                emit actionNeedsConfirmation(
-                    action, tr("Do you want to apply the following changes?"), computeIgnorePatternDiff(), m_stagedLocalFileDeletions);
+                emit actionNeedsConfirmation(action, tr("Do you want to apply the following changes?"),
+                    computeIgnorePatternDiff(m_presentIgnorePatterns.size() > maxIgnorePatternsForFullDiff ? diffContextLines : fullDiff),
+                    m_stagedLocalFileDeletions);
                 return;
             }
             action->needsConfirmation = true;
@@ -1077,46 +1178,64 @@ void SyncthingFileModel::processFetchQueue(const QString &lastItemPath)
 
     // query directory entries from Syncthing database
     if (rootItem->existsInDb.value_or(false)) {
-        m_pendingRequest = m_connection.browse(
-            m_dirId, path, 1, [this, populated](std::vector<std::unique_ptr<SyncthingItem>> &&items, QString &&errorMessage) mutable {
-                m_pendingRequest.reply = nullptr;
-                addErrorItem(items, std::move(errorMessage));
+        m_pendingRequest = m_connection.browseIncrementally(m_dirId, path, 1,
+            [this, populated, previousChildCount = rootItem->children.size(), receivedItems = false](
+                std::vector<std::unique_ptr<SyncthingItem>> &&items, bool finished, QString &&errorMessage) mutable {
+                if (finished) {
+                    m_pendingRequest.reply = nullptr;
+                }
                 const auto refreshedIndex = index(m_pendingRequest.forPath);
-
                 if (!refreshedIndex.isValid()) {
-                    processFetchQueue(m_pendingRequest.forPath);
+                    if (finished) {
+                        processFetchQueue(m_pendingRequest.forPath);
+                    }
                     return;
                 }
+
+                // replace previous children (e.g. the loading item) once the first batch has arrived or the request has finished
                 auto *const refreshedItem = reinterpret_cast<SyncthingItem *>(refreshedIndex.internalPointer());
-                const auto previousChildCount = refreshedItem->children.size();
-                if (previousChildCount) {
-                    beginRemoveRows(refreshedIndex, 0, static_cast<int>(refreshedItem->children.size() - 1));
-                    refreshedItem->children.clear();
-                    endRemoveRows();
+                if (!receivedItems && (finished || !items.empty())) {
+                    receivedItems = true;
+                    if (!refreshedItem->children.empty()) {
+                        beginRemoveRows(refreshedIndex, 0, static_cast<int>(refreshedItem->children.size() - 1));
+                        refreshedItem->children.clear();
+                        endRemoveRows();
+                    }
+                    if (refreshedItem->checked == Qt::PartiallyChecked) {
+                        setCheckState(refreshedIndex, Qt::Unchecked, false);
+                    }
+                }
+
+                // append the batch of items
+                if (finished) {
+                    addErrorItem(items, std::move(errorMessage));
                 }
                 if (!items.empty()) {
-                    const auto last = items.size() - 1;
+                    const auto first = refreshedItem->children.size();
+                    const auto last = first + items.size() - 1;
+                    auto row = first;
                     for (auto &item : items) {
                         item->parent = refreshedItem;
+                        item->index = row++;
                     }
                     populatePath(refreshedItem->path, m_pathSeparator, items);
-                    beginInsertRows(
-                        refreshedIndex, 0, last < std::numeric_limits<int>::max() ? static_cast<int>(last) : std::numeric_limits<int>::max());
-                    refreshedItem->children = std::move(items);
-                    forEachItem(refreshedItem, [](SyncthingItem *item) { return item->existsInDb.emplace(true); });
-                    switch (refreshedItem->checked) {
-                    case Qt::Checked:
-                        if (m_recursiveSelectionEnabled) {
-                            setChildrenChecked(refreshedItem, Qt::Checked);
+                    beginInsertRows(refreshedIndex, first < std::numeric_limits<int>::max() ? static_cast<int>(first) : std::numeric_limits<int>::max(),
+                        last < std::numeric_limits<int>::max() ? static_cast<int>(last) : std::numeric_limits<int>::max());
+                    refreshedItem->children.reserve(last + 1);
+                    for (auto &item : items) {
+                        forEachItem(item.get(), [](SyncthingItem *childItem) { return childItem->existsInDb.emplace(true); });
+                        if (refreshedItem->checked == Qt::Checked && m_recursiveSelectionEnabled) {
+                            setChildrenChecked(item.get(), item->checked = Qt::Checked);
                         }
-                        break;
-                    case Qt::PartiallyChecked:
-                        setCheckState(refreshedIndex, Qt::Unchecked, false);
-                        break;
-                    default:;
+                        refreshedItem->children.emplace_back(std::move(item));
                     }
                     endInsertRows();
                 }
+                if (!finished) {
+                    return;
+                }
+
+                // update size and continue with local lookup
                 if (!populated || refreshedItem->children.size() != previousChildCount) {
                     const auto sizeIndex = refreshedIndex.siblingAtColumn(1);
                     emit dataChanged(sizeIndex, sizeIndex, QVector<int>{ Qt::DisplayRole });
@@ -1157,15 +1276,19 @@ void SyncthingFileModel::queryIgnores()
     }
     m_ignorePatternsRequest = m_connection.ignores(m_dirId, [this](SyncthingIgnores &&ignores, QString &&errorMessage) {
         m_ignorePatternsRequest.reply = nullptr;
-        m_hasIgnorePatterns = errorMessage.isEmpty();
+        const auto hadIgnorePatterns = std::exchange(m_hasIgnorePatterns, errorMessage.isEmpty());
+        auto previousPatterns = std::exchange(m_presentIgnorePatterns, std::vector<SyncthingIgnorePattern>());
         m_isIgnoringAllByDefault = false;
-        m_presentIgnorePatterns.clear();
         m_presentIgnorePatterns.reserve(static_cast<std::size_t>(ignores.ignore.size()));
         for (auto &ignorePattern : ignores.ignore) {
             m_isIgnoringAllByDefault = m_isIgnoringAllByDefault || ignorePattern == m_ignoreAllByDefaultPattern;
             m_presentIgnorePatterns.emplace_back(std::move(ignorePattern));
         }
-        resetMatchingIgnorePatterns();
+        if (hadIgnorePatterns && m_hasIgnorePatterns) {
+            updateMatchingIgnorePatterns(previousPatterns);
+        } else {
+            resetMatchingIgnorePatterns();
+        }
     });
 }
 
@@ -1179,6 +1302,109 @@ void SyncthingFileModel::resetMatchingIgnorePatterns()
     invalidateAllIndicies(QVector<int>{ DetailsRole }, 0, QModelIndex());
 }
 
+/*!
+ * \brief Updates the matching ignore pattern of items after the ignore patterns have changed from \a previousPatterns to
+ *        m_presentIgnorePatterns.
+ * \remarks
+ * - Only the range of patterns that actually differs between \a previousPatterns and m_presentIgnorePatterns is considered.
+ *   Items whose first match lies before that range are not affected at all. Items whose first match lies after that range
+ *   (or which did not match at all) are only matched against the changed patterns, and only if the literal prefix of the
+ *   pattern allows a match. All other items are re-matched as of the start of the changed range.
+ * - dataChanged() is only emitted for items whose matching pattern actually changed (batched per parent).
+ */
+void SyncthingFileModel::updateMatchingIgnorePatterns(const std::vector<SyncthingIgnorePattern> &previousPatterns)
+{
+    // determine the range of changed patterns by skipping the common prefix and suffix
+    const auto &newPatterns = m_presentIgnorePatterns;
+    auto changedBegin = std::size_t();
+    for (const auto minSize = std::min(previousPatterns.size(), newPatterns.size());
+         changedBegin < minSize && previousPatterns[changedBegin].pattern == newPatterns[changedBegin].pattern;) {
+        ++changedBegin;
+    }
+    auto commonSuffix = std::size_t();
+    for (const auto maxSuffix = std::min(previousPatterns.size(), newPatterns.size()) - changedBegin;
+         commonSuffix < maxSuffix
+         && previousPatterns[previousPatterns.size() - 1 - commonSuffix].pattern == newPatterns[newPatterns.size() - 1 - commonSuffix].pattern;) {
+        ++commonSuffix;
+    }
+    const auto previousChangedEnd = previousPatterns.size() - commonSuffix;
+    const auto newChangedEnd = newPatterns.size() - commonSuffix;
+
+    // cache literal prefixes of changed patterns
+    auto literalPrefixes = std::vector<QString>();
+    literalPrefixes.reserve(newChangedEnd - changedBegin);
+    for (auto i = changedBegin; i != newChangedEnd; ++i) {
+        literalPrefixes.emplace_back(newPatterns[i].literalPrefix(m_pathSeparator));
+    }
+
+    // define function to compute the new matching pattern of an item from its previous one
+    const auto patternText = [](const std::vector<SyncthingIgnorePattern> &patterns, std::size_t index) {
+        return index < patterns.size() ? patterns[index].pattern : QString();
+    };
+    const auto matchChangedPatterns = [&](const SyncthingItem &item) {
+        for (auto i = changedBegin; i != newChangedEnd; ++i) {
+            const auto &pattern = newPatterns[i];
+            if (pattern.mightMatch(literalPrefixes[i - changedBegin], item.path, m_pathSeparator) && pattern.matches(item.path, m_pathSeparator)) {
+                return i;
+            }
+        }
+        return SyncthingItem::ignorePatternNoMatch;
+    };
+    const auto updateItem = [&](SyncthingItem &item) {
+        const auto previousMatch = item.ignorePattern;
+        if (previousMatch == SyncthingItem::ignorePatternNotInitialized || previousMatch < changedBegin || !item.isFilesystemItem()) {
+            return false; // not computed yet anyway or first match not affected by the change
+        }
+        if (previousMatch != SyncthingItem::ignorePatternNoMatch && previousMatch < previousChangedEnd) {
+            // the previously matching pattern has been changed/removed; re-match as of the changed range
+            item.ignorePattern = matchChangedPatterns(item);
+            for (auto i = newChangedEnd; item.ignorePattern == SyncthingItem::ignorePatternNoMatch && i < newPatterns.size(); ++i) {
+                if (newPatterns[i].matches(item.path, m_pathSeparator)) {
+                    item.ignorePattern = i;
+                }
+            }
+        } else {
+            // the previously matching pattern is still present (at a possibly shifted index) but a new pattern might take precedence
+            const auto changedMatch = matchChangedPatterns(item);
+            item.ignorePattern = changedMatch != SyncthingItem::ignorePatternNoMatch ? changedMatch
+                : previousMatch == SyncthingItem::ignorePatternNoMatch                ? previousMatch
+                                                                                      : previousMatch - previousChangedEnd + newChangedEnd;
+        }
+        return patternText(previousPatterns, previousMatch) != patternText(newPatterns, item.ignorePattern);
+    };
+
+    // traverse all items invalidating only rows of items whose matching pattern has changed
+    const auto invalidateRows = [this](SyncthingItem *firstItem, SyncthingItem *lastItem) {
+        const auto firstRow = static_cast<int>(firstItem->index), lastRow = static_cast<int>(lastItem->index);
+        emit dataChanged(createIndex(firstRow, 3, firstItem), createIndex(lastRow, 3, lastItem), QVector<int>{ Qt::DisplayRole });
+        emit dataChanged(createIndex(firstRow, 0, firstItem), createIndex(lastRow, 0, lastItem), QVector<int>{ DetailsRole });
+    };
+    const auto traverse = [&](SyncthingItem &parentItem, auto &traverseRef) -> void {
+        if (!parentItem.childrenPopulated) {
+            return;
+        }
+        auto *firstAffected = static_cast<SyncthingItem *>(nullptr), *lastAffected = static_cast<SyncthingItem *>(nullptr);
+        for (auto &child : parentItem.children) {
+            if (updateItem(*child)) {
+                if (!firstAffected) {
+                    firstAffected = child.get();
+                }
+                lastAffected = child.get();
+            }
+            if (child->isFilesystemItem()) {
+                traverseRef(*child, traverseRef);
+            }
+        }
+        if (firstAffected) {
+            invalidateRows(firstAffected, lastAffected);
+        }
+    };
+    if (updateItem(*m_root)) {
+        invalidateRows(m_root.get(), m_root.get());
+    }
+    traverse(*m_root, traverse);
+}
+
 void SyncthingFileModel::matchItemAgainstIgnorePatterns(SyncthingItem &item) const
 {
     if (!m_hasIgnorePatterns) {
@@ -13,6 +13,7 @@
 #include <QPixmap>
 #include <QSet>
 
+#include <limits>
 #include <map>
 #include <memory>
 #include <optional>
@@ -115,9 +116,10 @@ private:
     void processFetchQueue(const QString &lastItemPath = QString());
     void queryIgnores();
     void resetMatchingIgnorePatterns();
+    void updateMatchingIgnorePatterns(const std::vector<SyncthingIgnorePattern> &previousPatterns);
     void matchItemAgainstIgnorePatterns(SyncthingItem &item) const;
     void ignoreSelectedItems(bool ignore = true, bool deleteLocally = false);
-    QString computeIgnorePatternDiff();
+    QString computeIgnorePatternDiff(std::size_t contextLines = std::numeric_limits<std::size_t>::max());
     QString availabilityNote(const SyncthingItem *item) const;
 
 private:
@@ -86,12 +86,16 @@ void SyncthingModel::setBrightColors(bool brightColors)
 
 void SyncthingModel::handleConfigInvalidated()
 {
-    beginResetModel();
+    if (!m_connection.isApplyingConfigIncrementally()) {
+        beginResetModel();
+    }
 }
 
 void SyncthingModel::handleNewConfigAvailable()
 {
-    endResetModel();
+    if (!m_connection.isApplyingConfigIncrementally()) {
+        endResetModel();
+    }
 }
 
 void SyncthingModel::handleStatusIconsChanged()
@@ -0,0 +1,366 @@
+#include "./syncthingpullerrormodel.h"
+
+#include <QPointer>
+#include <QStringBuilder>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace Data {
+
+/*!
+ * \class SyncthingPullErrorModel
+ * \brief The SyncthingPullErrorModel class provides the pull errors of a directory as virtual list.
+ *
+ * The number of rows is determined by the number of pull errors Syncthing reports for the directory. The errors themselves
+ * are only requested when rows are accessed, one page of pageSize() errors at a time via SyncthingConnection::pullErrors().
+ * The most recently used maxCachedPages() pages are kept in memory and the neighbouring page is prefetched so scrolling through
+ * a huge list of errors neither blocks the UI nor needs to hold all errors in memory. Rows of pages which have not been loaded
+ * yet show a placeholder (and have LoadedRole set to false) until the page arrives. Rows of pages which could not be loaded show
+ * the error message until the page is requested again after retryDelay().
+ *
+ * The model is reloaded when the number of pull errors of the directory changes.
+ */
+
+/*!
+ * \brief Constructs a new model for the pull errors of the directory with the specified \a dirId.
+ */
+SyncthingPullErrorModel::SyncthingPullErrorModel(SyncthingConnection &connection, const QString &dirId, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_connection(connection)
+    , m_dirId(dirId)
+    , m_generation(0)
+    , m_rowCount(0)
+    , m_reportedCount(0)
+    , m_pageSize(defaultPageSize)
+    , m_maxCachedPages(defaultMaxCachedPages)
+    , m_loading(false)
+{
+    m_requestTimer.setSingleShot(true);
+    m_requestTimer.setInterval(0);
+    connect(&m_requestTimer, &QTimer::timeout, this, &SyncthingPullErrorModel::requestWantedPages);
+    m_retryTimer.setSingleShot(true);
+    m_retryTimer.setInterval(defaultRetryDelay);
+    connect(&m_retryTimer, &QTimer::timeout, this, &SyncthingPullErrorModel::dropFailedPages);
+    connect(&m_connection, &SyncthingConnection::dirStatusChanged, this, &SyncthingPullErrorModel::handleDirStatusChanged);
+    connect(&m_connection, &SyncthingConnection::newDirs, this, &SyncthingPullErrorModel::handleNewDirs);
+    auto row = int();
+    if (const auto *const dir = m_connection.findDirInfo(m_dirId, row)) {
+        m_rowCount = m_reportedCount = errorCountOf(*dir);
+    }
+}
+
+SyncthingPullErrorModel::~SyncthingPullErrorModel()
+{
+    abortRequests();
+}
+
+QHash<int, QByteArray> SyncthingPullErrorModel::roleNames() const
+{
+    const static auto roles = QHash<int, QByteArray>{
+        { PathRole, "path" },
+        { MessageRole, "message" },
+        { LoadedRole, "loaded" },
+    };
+    return roles;
+}
+
+int SyncthingPullErrorModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rowCount;
+}
+
+QVariant SyncthingPullErrorModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.parent().isValid() || index.row() >= m_rowCount) {
+        return QVariant();
+    }
+
+    // prefetch the neighbouring page the view is approaching
+    const auto number = index.row() / m_pageSize + 1;
+    const auto offset = index.row() % m_pageSize;
+    const auto *const currentPage = page(number);
+    if (currentPage) {
+        if (offset >= m_pageSize / 2) {
+            if (number * m_pageSize < m_rowCount) {
+                want(number + 1);
+            }
+        } else if (number > 1) {
+            want(number - 1);
+        }
+    } else {
+        want(number);
+    }
+
+    // return a placeholder until the page has been loaded
+    if (!currentPage || !currentPage->errorMessage.isEmpty()) {
+        switch (role) {
+        case Qt::DisplayRole:
+        case MessageRole:
+            return currentPage ? currentPage->errorMessage : tr("Loading …");
+        case PathRole:
+            return QString();
+        case LoadedRole:
+            return false;
+        default:
+            return QVariant();
+        }
+    }
+    if (static_cast<std::size_t>(offset) >= currentPage->errors.size()) {
+        return QVariant();
+    }
+    const auto &error = currentPage->errors[static_cast<std::size_t>(offset)];
+    switch (role) {
+    case Qt::DisplayRole:
+        return QString(error.path % QChar('\n') % error.message);
+    case Qt::ToolTipRole:
+    case MessageRole:
+        return error.message;
+    case PathRole:
+        return error.path;
+    case LoadedRole:
+        return true;
+    default:
+        return QVariant();
+    }
+}
+
+/*!
+ * \brief Sets the number of pull errors requested at once.
+ * \remarks Reloads the model as cached pages are invalidated.
+ */
+void SyncthingPullErrorModel::setPageSize(int pageSize)
+{
+    if (pageSize < 1 || pageSize == m_pageSize) {
+        return;
+    }
+    m_pageSize = pageSize;
+    reload();
+}
+
+/*!
+ * \brief Sets the max. number of pages kept in memory.
+ */
+void SyncthingPullErrorModel::setMaxCachedPages(int maxCachedPages)
+{
+    m_maxCachedPages = std::max(maxCachedPages, 1);
+    evictPages();
+}
+
+/*!
+ * \brief Sets the delay in milliseconds after which pages that could not be loaded are requested again.
+ * \remarks Takes effect when the next page could not be loaded.
+ */
+void SyncthingPullErrorModel::setRetryDelay(int retryDelay)
+{
+    m_retryTimer.setInterval(std::max(retryDelay, 0));
+}
+
+/*!
+ * \brief Returns the error at the specified \a row or nullptr if the page containing it is not loaded.
+ * \remarks Does not request the page and does not count as access of the page.
+ */
+const SyncthingItemError *SyncthingPullErrorModel::itemError(int row) const
+{
+    if (row < 0 || row >= m_rowCount) {
+        return nullptr;
+    }
+    const auto number = row / m_pageSize + 1;
+    const auto offset = static_cast<std::size_t>(row % m_pageSize);
+    const auto i = std::find_if(m_pages.cbegin(), m_pages.cend(), [number](const Page &page) { return page.number == number; });
+    return i != m_pages.cend() && offset < i->errors.size() ? &i->errors[offset] : nullptr;
+}
+
+/*!
+ * \brief Sets the function used to request a page of pull errors instead of SyncthingConnection::pullErrors().
+ * \remarks
+ * - This is meant for testing. The function must invoke the callback asynchronously. The reply of the returned QueryResult
+ *   (if any) is deleted and its connection disconnected when the request is aborted.
+ * - Passing an empty function restores the default behavior.
+ */
+void SyncthingPullErrorModel::setPageRequest(PageRequest &&pageRequest)
+{
+    m_pageRequest = std::move(pageRequest);
+}
+
+/*!
+ * \brief Discards all loaded pages and pending requests and takes over the current number of pull errors.
+ */
+void SyncthingPullErrorModel::reload()
+{
+    beginResetModel();
+    abortRequests();
+    ++m_generation;
+    m_pages.clear();
+    m_wantedPages.clear();
+    m_requestTimer.stop();
+    m_retryTimer.stop();
+    m_rowCount = m_reportedCount;
+    endResetModel();
+    setLoading(false);
+}
+
+void SyncthingPullErrorModel::handleDirStatusChanged(const SyncthingDir &dir)
+{
+    if (dir.id != m_dirId) {
+        return;
+    }
+    if (const auto count = errorCountOf(dir); count != m_reportedCount) {
+        m_reportedCount = count;
+        reload();
+    }
+}
+
+void SyncthingPullErrorModel::handleNewDirs()
+{
+    auto row = int();
+    const auto *const dir = m_connection.findDirInfo(m_dirId, row);
+    if (const auto count = dir ? errorCountOf(*dir) : 0; count != m_reportedCount) {
+        m_reportedCount = count;
+        reload();
+    }
+}
+
+/*!
+ * \brief Requests the pages which have been accessed since the last invocation.
+ * \remarks
+ * This is invoked via m_requestTimer so accesses of a view (re-)painting its rows are coalesced. When scrolling fast through the
+ * list only the pages accessed last are requested and pages which have been skipped are not.
+ */
+void SyncthingPullErrorModel::requestWantedPages()
+{
+    if (m_wantedPages.size() > static_cast<std::size_t>(m_maxCachedPages)) {
+        m_wantedPages.erase(m_wantedPages.begin(), m_wantedPages.end() - m_maxCachedPages);
+    }
+    for (const auto number : m_wantedPages) {
+        if (m_pendingRequests.contains(number) || page(number)) {
+            continue;
+        }
+        auto callback = PageCallback([model = QPointer<SyncthingPullErrorModel>(this), generation = m_generation, number](
+                                         std::vector<SyncthingItemError> &&errors, QString &&errorMessage) {
+            if (model && model->m_generation == generation) {
+                model->handlePage(number, std::move(errors), std::move(errorMessage));
+            }
+        });
+        m_pendingRequests.insert(number,
+            m_pageRequest ? m_pageRequest(m_dirId, number, m_pageSize, std::move(callback))
+                          : m_connection.pullErrors(m_dirId, number, m_pageSize, std::move(callback)));
+    }
+    m_wantedPages.clear();
+    setLoading(!m_pendingRequests.isEmpty());
+}
+
+/*!
+ * \brief Drops pages which could not be loaded so they are requested again when their rows are accessed the next time.
+ * \remarks Emits dataChanged() for the rows of these pages so views access them again if they are still visible.
+ */
+void SyncthingPullErrorModel::dropFailedPages()
+{
+    auto failedPages = std::vector<int>();
+    m_pages.erase(std::remove_if(m_pages.begin(), m_pages.end(),
+                      [&failedPages](const Page &page) {
+                          if (page.errorMessage.isEmpty()) {
+                              return false;
+                          }
+                          failedPages.emplace_back(page.number);
+                          return true;
+                      }),
+        m_pages.end());
+    for (const auto number : failedPages) {
+        const auto firstRow = (number - 1) * m_pageSize;
+        if (const auto lastRow = std::min(firstRow + m_pageSize, m_rowCount) - 1; firstRow <= lastRow) {
+            emit dataChanged(index(firstRow), index(lastRow));
+        }
+    }
+}
+
+/*!
+ * \brief Schedules requesting the page with the specified \a number unless it is already loaded or requested.
+ */
+void SyncthingPullErrorModel::want(int number) const
+{
+    if (m_pendingRequests.contains(number) || std::find(m_wantedPages.cbegin(), m_wantedPages.cend(), number) != m_wantedPages.cend()
+        || std::any_of(m_pages.cbegin(), m_pages.cend(), [number](const Page &page) { return page.number == number; })) {
+        return;
+    }
+    m_wantedPages.emplace_back(number);
+    if (!m_requestTimer.isActive()) {
+        m_requestTimer.start();
+    }
+}
+
+/*!
+ * \brief Returns the loaded page with the specified \a number or nullptr if it is not loaded.
+ * \remarks Moves the page to the front so it is considered most recently used.
+ */
+auto SyncthingPullErrorModel::page(int number) const -> const Page *
+{
+    const auto i = std::find_if(m_pages.begin(), m_pages.end(), [number](const Page &page) { return page.number == number; });
+    if (i == m_pages.end()) {
+        return nullptr;
+    }
+    std::rotate(m_pages.begin(), i, i + 1);
+    return &m_pages.front();
+}
+
+void SyncthingPullErrorModel::handlePage(int number, std::vector<SyncthingItemError> &&errors, QString &&errorMessage)
+{
+    if (const auto request = m_pendingRequests.find(number); request != m_pendingRequests.end()) {
+        m_pendingRequests.erase(request);
+    }
+
+    // drop rows which do not exist (anymore) if the page is incomplete; the count reported by Syncthing might be outdated
+    const auto firstRow = (number - 1) * m_pageSize;
+    const auto loadedCount = static_cast<int>(errors.size());
+    if (errorMessage.isEmpty() && loadedCount < m_pageSize && firstRow + loadedCount < m_rowCount) {
+        const auto newRowCount = firstRow + loadedCount;
+        beginRemoveRows(QModelIndex(), newRowCount, m_rowCount - 1);
+        m_rowCount = newRowCount;
+        m_pages.erase(
+            std::remove_if(m_pages.begin(), m_pages.end(), [number](const Page &page) { return page.number > number; }), m_pages.end());
+        endRemoveRows();
+    }
+
+    // insert page as most recently used one; keep a page which could not be loaded only until it is requested again
+    if (!errorMessage.isEmpty() && !m_retryTimer.isActive()) {
+        m_retryTimer.start();
+    }
+    m_pages.insert(m_pages.begin(), Page{ number, std::move(errors), std::move(errorMessage) });
+    evictPages();
+    if (const auto lastRow = std::min(firstRow + m_pageSize, m_rowCount) - 1; firstRow <= lastRow) {
+        emit dataChanged(index(firstRow), index(lastRow));
+    }
+    setLoading(!m_pendingRequests.isEmpty());
+}
+
+void SyncthingPullErrorModel::evictPages()
+{
+    if (m_pages.size() > static_cast<std::size_t>(m_maxCachedPages)) {
+        m_pages.resize(static_cast<std::size_t>(m_maxCachedPages));
+    }
+}
+
+void SyncthingPullErrorModel::abortRequests()
+{
+    for (const auto &request : std::as_const(m_pendingRequests)) {
+        QObject::disconnect(request.connection);
+        delete request.reply;
+    }
+    m_pendingRequests.clear();
+}
+
+void SyncthingPullErrorModel::setLoading(bool loading)
+{
+    if (m_loading != loading) {
+        emit loadingChanged(m_loading = loading);
+    }
+}
+
+int SyncthingPullErrorModel::errorCountOf(const SyncthingDir &dir)
+{
+    const auto count = std::max<quint64>(dir.pullErrorCount, dir.itemErrors.size());
+    return static_cast<int>(std::min<quint64>(count, static_cast<quint64>(std::numeric_limits<int>::max())));
+}
+
+} // namespace Data
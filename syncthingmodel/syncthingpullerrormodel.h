@@ -0,0 +1,141 @@
+#ifndef DATA_SYNCTHINGPULLERRORMODEL_H
+#define DATA_SYNCTHINGPULLERRORMODEL_H
+
+#include "./global.h"
+
+#include <syncthingconnector/syncthingconnection.h>
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QTimer>
+
+#include <functional>
+#include <vector>
+
+namespace Data {
+
+class LIB_SYNCTHING_MODEL_EXPORT SyncthingPullErrorModel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(QString dirId READ dirId CONSTANT)
+    Q_PROPERTY(int pageSize READ pageSize WRITE setPageSize)
+    Q_PROPERTY(int maxCachedPages READ maxCachedPages WRITE setMaxCachedPages)
+    Q_PROPERTY(int retryDelay READ retryDelay WRITE setRetryDelay)
+    Q_PROPERTY(bool loading READ isLoading NOTIFY loadingChanged)
+
+public:
+    enum SyncthingPullErrorModelRole {
+        PathRole = Qt::UserRole + 1,
+        MessageRole,
+        LoadedRole,
+    };
+
+    using PageCallback = std::function<void(std::vector<SyncthingItemError> &&, QString &&)>;
+    using PageRequest = std::function<SyncthingConnection::QueryResult(const QString &dirId, int page, int perPage, PageCallback &&callback)>;
+
+    static constexpr int defaultPageSize = 100;
+    static constexpr int defaultMaxCachedPages = 8;
+    static constexpr int defaultRetryDelay = 3000;
+
+    explicit SyncthingPullErrorModel(SyncthingConnection &connection, const QString &dirId, QObject *parent = nullptr);
+    ~SyncthingPullErrorModel() override;
+
+    QHash<int, QByteArray> roleNames() const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    const QString &dirId() const;
+    int pageSize() const;
+    void setPageSize(int pageSize);
+    int maxCachedPages() const;
+    void setMaxCachedPages(int maxCachedPages);
+    int retryDelay() const;
+    void setRetryDelay(int retryDelay);
+    bool isLoading() const;
+    const SyncthingItemError *itemError(int row) const;
+    void setPageRequest(PageRequest &&pageRequest);
+
+public Q_SLOTS:
+    void reload();
+
+Q_SIGNALS:
+    void loadingChanged(bool loading);
+
+private Q_SLOTS:
+    void handleDirStatusChanged(const Data::SyncthingDir &dir);
+    void handleNewDirs();
+    void requestWantedPages();
+    void dropFailedPages();
+
+private:
+    struct Page {
+        int number = 0;
+        std::vector<SyncthingItemError> errors;
+        QString errorMessage;
+    };
+
+    void want(int page) const;
+    const Page *page(int number) const;
+    void handlePage(int number, std::vector<SyncthingItemError> &&errors, QString &&errorMessage);
+    void evictPages();
+    void abortRequests();
+    void setLoading(bool loading);
+    static int errorCountOf(const SyncthingDir &dir);
+
+    SyncthingConnection &m_connection;
+    PageRequest m_pageRequest;
+    QString m_dirId;
+    mutable std::vector<Page> m_pages;
+    mutable std::vector<int> m_wantedPages;
+    mutable QTimer m_requestTimer;
+    QTimer m_retryTimer;
+    QHash<int, SyncthingConnection::QueryResult> m_pendingRequests;
+    quint64 m_generation;
+    int m_rowCount;
+    int m_reportedCount;
+    int m_pageSize;
+    int m_maxCachedPages;
+    bool m_loading;
+};
+
+/*!
+ * \brief Returns the ID of the directory pull errors are shown for.
+ */
+inline const QString &SyncthingPullErrorModel::dirId() const
+{
+    return m_dirId;
+}
+
+/*!
+ * \brief Returns the number of pull errors requested at once.
+ */
+inline int SyncthingPullErrorModel::pageSize() const
+{
+    return m_pageSize;
+}
+
+/*!
+ * \brief Returns the max. number of pages kept in memory.
+ */
+inline int SyncthingPullErrorModel::maxCachedPages() const
+{
+    return m_maxCachedPages;
+}
+
+/*!
+ * \brief Returns the delay in milliseconds after which pages that could not be loaded are requested again.
+ */
+inline int SyncthingPullErrorModel::retryDelay() const
+{
+    return m_retryTimer.interval();
+}
+
+/*!
+ * \brief Returns whether pages are currently being requested.
+ */
+inline bool SyncthingPullErrorModel::isLoading() const
+{
+    return m_loading;
+}
+
+} // namespace Data
+
+#endif // DATA_SYNCTHINGPULLERRORMODEL_H
@@ -1,8 +1,12 @@
+#include "../syncthingconnectionpoolmodel.h"
 #include "../syncthingdevicemodel.h"
 #include "../syncthingdirectorymodel.h"
 #include "../syncthingfilemodel.h"
+#include "../syncthingpullerrormodel.h"
 
 #include <syncthingconnector/syncthingconnection.h>
+#include <syncthingconnector/syncthingconnectionpool.h>
+#include <syncthingconnector/syncthingconnectionsettings.h>
 
 #include <QtTest/QtTest>
 
@@ -15,7 +19,10 @@
 
 #include <qtutilities/misc/compat.h>
 
+#include <algorithm>
 #include <limits>
+#include <utility>
+#include <vector>
 
 class ModelTests : public QObject {
     Q_OBJECT
@@ -26,7 +33,11 @@ private Q_SLOTS:
 
     void testDirectoryModel();
     void testDevicesModel();
+    void testDeviceCompletionUpdates();
     void testFileModel();
+    void testIncrementalIgnorePatternMatching();
+    void testPullErrorModel();
+    void testConnectionPoolModel();
 
 private:
     QTimer m_timeout;
@@ -102,13 +113,18 @@ void ModelTests::testDirectoryModel()
 
 void ModelTests::testDevicesModel()
 {
-    const auto model = Data::SyncthingDeviceModel(m_connection);
+    auto model = Data::SyncthingDeviceModel(m_connection);
     QCOMPARE(model.rowCount(QModelIndex()), 2);
     QCOMPARE(model.index(0, 0).data(), QStringLiteral("Myself"));
     QCOMPARE(model.index(0, 1).data(), QStringLiteral("This Device"));
     QCOMPARE(model.index(1, 0).data(), QStringLiteral("Other instance"));
     QCOMPARE(model.index(1, 1).data(), QStringLiteral("Unknown"));
     const auto dev1Idx = model.index(0, 0);
+    QVERIFY2(model.hasChildren(dev1Idx), "devices have children before detail rows are populated");
+    QCOMPARE(model.rowCount(dev1Idx), 0);
+    QVERIFY2(model.canFetchMore(dev1Idx), "detail rows are populated lazily");
+    model.fetchMore(dev1Idx);
+    QVERIFY2(!model.canFetchMore(dev1Idx), "cannot fetch more when detail rows already populated");
     QCOMPARE(model.rowCount(dev1Idx), 6);
     QCOMPARE(model.index(0, 0, dev1Idx).data(), QStringLiteral("ID"));
     QCOMPARE(model.index(0, 1, dev1Idx).data(), QStringLiteral("P56IOI7-MZJNU2Y-IQGDREY-DM2MGTI-MGL3BXN-PQ6W5BM-TBBZ4TJ-XZWICQ2"));
@@ -119,11 +135,61 @@ void ModelTests::testDevicesModel()
     QCOMPARE(model.index(5, 0, dev1Idx).data(), QStringLiteral("Introducer"));
     QCOMPARE(model.index(5, 1, dev1Idx).data(), QStringLiteral("no"));
     const auto dev2Idx = model.index(1, 0);
+    QCOMPARE(model.rowCount(dev2Idx), 0);
+    model.fetchMore(dev2Idx);
     QCOMPARE(model.rowCount(dev2Idx), 6);
     QCOMPARE(model.index(0, 1, dev2Idx).data(), QStringLiteral("53STGR7-YBM6FCX-PAZ2RHM-YPY6OEJ-WYHVZO7-PCKQRCK-PZLTP7T"));
     QCOMPARE(model.index(2, 1, dev2Idx).data(), QStringLiteral("dynamic, tcp://192.168.1.3:22000"));
 }
 
+void ModelTests::testDeviceCompletionUpdates()
+{
+    auto model = Data::SyncthingDeviceModel(m_connection);
+    auto devIndex = int(), dirIndex = int();
+    const auto devId = QStringLiteral("53STGR7-YBM6FCX-PAZ2RHM-YPY6OEJ-WYHVZO7-PCKQRCK-PZLTP7T");
+    const auto dirId = QStringLiteral("GXWxf-3zgnU");
+    auto *const devInfo = m_connection.findDevInfo(devId, devIndex);
+    auto *const dirInfo = m_connection.findDirInfo(dirId, dirIndex);
+    QVERIFY(devInfo);
+    QVERIFY(dirInfo);
+    const auto devIdx = model.index(devIndex, 0);
+    QCOMPARE(model.rowCount(devIdx), 0);
+
+    QSignalSpy devStatusChangedSpy(&m_connection, &Data::SyncthingConnection::devStatusChanged);
+    QSignalSpy dataChangedSpy(&model, &QAbstractItemModel::dataChanged);
+    QSignalSpy rowsInsertedSpy(&model, &QAbstractItemModel::rowsInserted);
+    auto completion = Data::SyncthingCompletion();
+    completion.lastUpdate = CppUtilities::DateTime::now();
+    completion.globalBytes = 1000;
+    completion.needed.bytes = 500;
+    completion.needed.items = 2;
+
+    // changing the completion of a device whose detail rows have not been fetched only updates the top-level row
+    m_connection.readRemoteFolderCompletion(completion, devId, devInfo, devIndex, dirId, dirInfo, dirIndex);
+    QCOMPARE(devStatusChangedSpy.count(), 1);
+    QCOMPARE(dataChangedSpy.count(), 1);
+    QVERIFY2(!dataChangedSpy.at(0).at(0).toModelIndex().parent().isValid(), "only top-level row updated");
+    QCOMPARE(rowsInsertedSpy.count(), 0);
+    QCOMPARE(model.rowCount(devIdx), 0);
+
+    // reporting the same completion again is not signalled at all
+    m_connection.readRemoteFolderCompletion(completion, devId, devInfo, devIndex, dirId, dirInfo, dirIndex);
+    QCOMPARE(devStatusChangedSpy.count(), 1);
+    QCOMPARE(dataChangedSpy.count(), 1);
+
+    // changes are signalled for detail rows as well once they have been fetched
+    model.fetchMore(devIdx);
+    QCOMPARE(model.rowCount(devIdx), 6);
+    completion.needed = Data::SyncthingCompletion::Needed();
+    m_connection.readRemoteFolderCompletion(completion, devId, devInfo, devIndex, dirId, dirInfo, dirIndex);
+    QCOMPARE(devStatusChangedSpy.count(), 2);
+    QCOMPARE(dataChangedSpy.count(), 3);
+    QCOMPARE(dataChangedSpy.at(2).at(0).toModelIndex().parent(), devIdx);
+
+    // reset completion for other tests
+    m_connection.readRemoteFolderCompletion(Data::SyncthingCompletion(), devId, devInfo, devIndex, dirId, dirInfo, dirIndex);
+}
+
 void ModelTests::testFileModel()
 {
     auto row = 0;
@@ -298,6 +364,9 @@ void ModelTests::testFileModel()
     append.append << changedTestPatterns.at(3) << changedTestPatterns.at(4);
     QCOMPARE(model.computeIgnorePatternDiff(), QStringLiteral("+// new comment at beginning\n foo\n-bar\n baz\n+biz\n+buz\n"));
     QCOMPARE(model.computeNewIgnorePatterns().ignore, changedTestPatterns);
+    QCOMPARE(model.computeIgnorePatternDiff(0),
+        QStringLiteral("@@ -0,0 +1,1 @@\n+// new comment at beginning\n@@ -2,2 +3,3 @@\n-bar\n baz\n+biz\n+buz\n"));
+    QCOMPARE(model.computeIgnorePatternDiff(1), model.computeIgnorePatternDiff());
 
     // clear all ignore pattern related state; diff and new ignore patterns should be computed to be empty
     model.m_isIgnoringAllByDefault = false;
@@ -440,5 +509,305 @@ void ModelTests::testFileModel()
     QCOMPARE(model.computeNewIgnorePatterns().ignore, expectedPatterns);
 }
 
+/*!
+ * \brief Tests that re-matching items incrementally after the ignore patterns have changed yields the same result as
+ *        re-matching all items against all patterns.
+ */
+void ModelTests::testIncrementalIgnorePatternMatching()
+{
+    auto row = 0;
+    const auto *dirInfo = m_connection.findDirInfo(QStringLiteral("GXWxf-3zgnU"), row);
+    QVERIFY(dirInfo);
+    auto model = Data::SyncthingFileModel(m_connection, *dirInfo);
+    connect(&model, &Data::SyncthingFileModel::fetchQueueEmpty, this, [this]() {
+        m_timeout.stop();
+        m_loop.quit();
+    });
+    m_timeout.start();
+    m_loop.exec();
+    QCOMPARE(model.rowCount(model.index(0, 0)), 2);
+
+    // collect all items
+    auto items = std::vector<Data::SyncthingItem *>();
+    const auto collectItems = [&items](Data::SyncthingItem &item, auto &collectItemsRef) -> void {
+        items.emplace_back(&item);
+        if (item.childrenPopulated) {
+            for (auto &child : item.children) {
+                collectItemsRef(*child, collectItemsRef);
+            }
+        }
+    };
+    collectItems(*model.m_root, collectItems);
+    QVERIFY(items.size() >= 8);
+
+    // define patterns to go through one after another, starting with a full match against the first patterns
+    const auto patternSets = std::vector<QStringList>{
+        { QStringLiteral("/Camera/IMG_20201213_122451.jpg"), QStringLiteral("!/Camera"), QStringLiteral("*.jpg") },
+        // insert patterns at the beginning, in the middle and at the end
+        { QStringLiteral("/Camera/IMG_20201213_125329.jpg"), QStringLiteral("/Camera/IMG_20201213_122451.jpg"), QStringLiteral("/100ANDRO"),
+            QStringLiteral("!/Camera"), QStringLiteral("*.jpg"), QStringLiteral("**") },
+        // remove patterns in the middle and at the beginning
+        { QStringLiteral("/Camera/IMG_20201213_125329.jpg"), QStringLiteral("/Camera/IMG_20201213_122451.jpg"), QStringLiteral("*.jpg"),
+            QStringLiteral("**") },
+        { QStringLiteral("/Camera/IMG_20201213_122451.jpg"), QStringLiteral("*.jpg") },
+        // reorder patterns
+        { QStringLiteral("*.jpg"), QStringLiteral("/Camera/IMG_20201213_122451.jpg") },
+        { QStringLiteral("!/Camera/IMG_2020121*"), QStringLiteral("/100ANDRO"), QStringLiteral("*.jpg"), QStringLiteral("/Camera") },
+        { QStringLiteral("/Camera"), QStringLiteral("*.jpg"), QStringLiteral("/100ANDRO"), QStringLiteral("!/Camera/IMG_2020121*") },
+        // remove all patterns
+        {},
+    };
+    const auto setPatterns = [&model](const QStringList &patterns) {
+        auto previousPatterns = std::exchange(model.m_presentIgnorePatterns, std::vector<Data::SyncthingIgnorePattern>());
+        for (const auto &pattern : patterns) {
+            model.m_presentIgnorePatterns.emplace_back(QString(pattern));
+        }
+        return previousPatterns;
+    };
+    model.m_hasIgnorePatterns = true;
+    setPatterns(patternSets.front());
+    for (auto *const item : items) {
+        model.matchItemAgainstIgnorePatterns(*item);
+    }
+    QVERIFY(std::any_of(items.begin(), items.end(), [](const Data::SyncthingItem *item) {
+        return item->ignorePattern != Data::SyncthingItem::ignorePatternNoMatch;
+    }));
+
+    // re-setting the same patterns does not affect any items
+    QSignalSpy dataChangedSpy(&model, &QAbstractItemModel::dataChanged);
+    model.updateMatchingIgnorePatterns(setPatterns(patternSets.front()));
+    QCOMPARE(dataChangedSpy.count(), 0);
+
+    // change patterns and compare the incremental result with a full re-match
+    auto incrementalMatches = std::vector<std::size_t>(items.size());
+    for (auto i = std::size_t(1); i != patternSets.size(); ++i) {
+        model.updateMatchingIgnorePatterns(setPatterns(patternSets[i]));
+        std::transform(items.begin(), items.end(), incrementalMatches.begin(), [](const Data::SyncthingItem *item) { return item->ignorePattern; });
+        for (auto j = std::size_t(); j != items.size(); ++j) {
+            model.matchItemAgainstIgnorePatterns(*items[j]);
+            QVERIFY2(incrementalMatches[j] == items[j]->ignorePattern,
+                qPrintable(QStringLiteral("pattern set %1, item \"%2\": %3 != %4")
+                        .arg(i)
+                        .arg(items[j]->path)
+                        .arg(incrementalMatches[j])
+                        .arg(items[j]->ignorePattern)));
+        }
+    }
+}
+
+/*!
+ * \brief Tests page arithmetic, caching, coalescing of requests and reloading of the pull error model.
+ * \remarks Pages are served by a stub so the test can control which pages arrive when.
+ */
+void ModelTests::testPullErrorModel()
+{
+    auto model = Data::SyncthingPullErrorModel(m_connection, QStringLiteral("pull-error-test"));
+    auto requests = std::vector<std::pair<int, Data::SyncthingPullErrorModel::PageCallback>>();
+    auto unexpectedRequests = 0;
+    model.setPageRequest(
+        [&requests, &unexpectedRequests](const QString &dirId, int page, int perPage, Data::SyncthingPullErrorModel::PageCallback &&callback) {
+            if (dirId != QStringLiteral("pull-error-test") || perPage != 100) {
+                ++unexpectedRequests;
+            }
+            requests.emplace_back(page, std::move(callback));
+            return Data::SyncthingConnection::QueryResult();
+        });
+    const auto requestedPages = [&requests] {
+        auto pages = std::vector<int>();
+        for (const auto &request : requests) {
+            pages.emplace_back(request.first);
+        }
+        return pages;
+    };
+    const auto servePage = [&requests](int page, int count) {
+        const auto request
+            = std::find_if(requests.begin(), requests.end(), [page](const auto &pendingRequest) { return pendingRequest.first == page; });
+        QVERIFY(request != requests.end());
+        auto errors = std::vector<Data::SyncthingItemError>();
+        for (auto i = 0; i != count; ++i) {
+            errors.emplace_back(QStringLiteral("directory not empty"), QStringLiteral("/page-%1/item-%2").arg(page).arg(i));
+        }
+        auto callback = std::move(request->second);
+        requests.erase(request);
+        callback(std::move(errors), QString());
+    };
+    model.setMaxCachedPages(2);
+    QCOMPARE(model.rowCount(), 0);
+
+    // take over the number of pull errors when the folder status changes
+    auto dir = Data::SyncthingDir(QStringLiteral("pull-error-test"));
+    dir.pullErrorCount = 250;
+    QSignalSpy modelResetSpy(&model, &QAbstractItemModel::modelReset);
+    QSignalSpy dataChangedSpy(&model, &QAbstractItemModel::dataChanged);
+    QSignalSpy rowsRemovedSpy(&model, &QAbstractItemModel::rowsRemoved);
+    emit m_connection.dirStatusChanged(dir, -1);
+    QCOMPARE(modelResetSpy.size(), 1);
+    QCOMPARE(model.rowCount(), 250);
+
+    // accessing rows of the same page leads to only one request which is not sent before the event loop is processed
+    QCOMPARE(model.data(model.index(0), Data::SyncthingPullErrorModel::LoadedRole).toBool(), false);
+    QCOMPARE(model.data(model.index(0)).toString(), QStringLiteral("Loading …"));
+    model.data(model.index(10));
+    model.data(model.index(99));
+    QVERIFY(requests.empty());
+    QCoreApplication::processEvents();
+    QCOMPARE(requestedPages(), std::vector<int>{ 1 });
+    QVERIFY(model.isLoading());
+
+    // rows of a loaded page are available and the neighbouring page is prefetched when approaching it
+    servePage(1, 100);
+    QCOMPARE(dataChangedSpy.size(), 1);
+    QCOMPARE(dataChangedSpy.at(0).at(0).toModelIndex().row(), 0);
+    QCOMPARE(dataChangedSpy.at(0).at(1).toModelIndex().row(), 99);
+    QVERIFY(!model.isLoading());
+    QCOMPARE(model.data(model.index(42), Data::SyncthingPullErrorModel::PathRole).toString(), QStringLiteral("/page-1/item-42"));
+    QVERIFY(requests.empty());
+    model.data(model.index(60));
+    QCoreApplication::processEvents();
+    QCOMPARE(requestedPages(), std::vector<int>{ 2 });
+    servePage(2, 100);
+    QCOMPARE(model.itemError(150)->path, QStringLiteral("/page-2/item-50"));
+
+    // a short page truncates the rows and the least recently used page is evicted
+    model.data(model.index(0));
+    model.data(model.index(200));
+    QCoreApplication::processEvents();
+    QCOMPARE(requestedPages(), std::vector<int>{ 3 });
+    servePage(3, 30);
+    QCOMPARE(rowsRemovedSpy.size(), 1);
+    QCOMPARE(rowsRemovedSpy.at(0).at(1).toInt(), 230);
+    QCOMPARE(rowsRemovedSpy.at(0).at(2).toInt(), 249);
+    QCOMPARE(model.rowCount(), 230);
+    QVERIFY(model.itemError(0));
+    QVERIFY(model.itemError(229));
+    QVERIFY(!model.itemError(150));
+
+    // pages are requested only once even if they are wanted repeatedly (e.g. as neighbouring page)
+    model.data(model.index(100));
+    model.data(model.index(0));
+    model.data(model.index(120));
+    model.data(model.index(229));
+    QCoreApplication::processEvents();
+    QCOMPARE(requestedPages(), std::vector<int>{ 2 });
+
+    // the model is reloaded when the number of errors changes; results of pending requests are discarded
+    dir.pullErrorCount = 260;
+    emit m_connection.dirStatusChanged(dir, -1);
+    QCOMPARE(modelResetSpy.size(), 2);
+    QCOMPARE(model.rowCount(), 260);
+    QVERIFY(!model.itemError(0));
+    QVERIFY(!model.isLoading());
+    dataChangedSpy.clear();
+    servePage(2, 100);
+    QCOMPARE(dataChangedSpy.size(), 0);
+    QVERIFY(!model.itemError(100));
+
+    // only the pages accessed last are requested when scrolling fast
+    model.data(model.index(0));
+    model.data(model.index(110));
+    model.data(model.index(210));
+    QCoreApplication::processEvents();
+    QCOMPARE(requestedPages(), (std::vector<int>{ 2, 3 }));
+    QCOMPARE(unexpectedRequests, 0);
+
+    // the same number of errors does not cause a reload
+    emit m_connection.dirStatusChanged(dir, -1);
+    QCOMPARE(modelResetSpy.size(), 2);
+
+    // rows of a page which could not be loaded show the error until the page is requested again after the retry delay
+    model.setRetryDelay(10);
+    const auto failedRequest
+        = std::find_if(requests.begin(), requests.end(), [](const auto &pendingRequest) { return pendingRequest.first == 2; });
+    QVERIFY(failedRequest != requests.end());
+    auto failedCallback = std::move(failedRequest->second);
+    requests.erase(failedRequest);
+    failedCallback(std::vector<Data::SyncthingItemError>(), QStringLiteral("connection refused"));
+    QCOMPARE(model.data(model.index(150)).toString(), QStringLiteral("connection refused"));
+    QCOMPARE(model.data(model.index(150), Data::SyncthingPullErrorModel::LoadedRole).toBool(), false);
+    QCoreApplication::processEvents();
+    QCOMPARE(requestedPages(), std::vector<int>{ 3 });
+    dataChangedSpy.clear();
+    QVERIFY(dataChangedSpy.wait());
+    QCOMPARE(dataChangedSpy.at(0).at(0).toModelIndex().row(), 100);
+    QCOMPARE(dataChangedSpy.at(0).at(1).toModelIndex().row(), 199);
+    QCOMPARE(model.data(model.index(150)).toString(), QStringLiteral("Loading …"));
+    QCoreApplication::processEvents();
+    QCOMPARE(requestedPages(), (std::vector<int>{ 3, 2 }));
+    servePage(2, 100);
+    QCOMPARE(model.data(model.index(150), Data::SyncthingPullErrorModel::PathRole).toString(), QStringLiteral("/page-2/item-50"));
+    QCOMPARE(unexpectedRequests, 0);
+}
+
+void ModelTests::testConnectionPoolModel()
+{
+    qRegisterMetaType<Data::SyncthingConnectionPoolStatistics>();
+    auto pool = Data::SyncthingConnectionPool();
+    pool.setUpdateInterval(0);
+    auto model = Data::SyncthingConnectionPoolModel(pool);
+    auto rowsInsertedSpy = QSignalSpy(&model, &QAbstractItemModel::rowsInserted);
+    auto rowsRemovedSpy = QSignalSpy(&model, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy dataChangedSpy(&model, &QAbstractItemModel::dataChanged);
+    auto statisticsSpy = QSignalSpy(&pool, &Data::SyncthingConnectionPool::statisticsChanged);
+
+    // one row is inserted per connection; the URL is used as label if no label has been configured
+    auto settings = std::vector<Data::SyncthingConnectionSettings>(3);
+    settings[0].label = QStringLiteral("first");
+    settings[0].syncthingUrl = QStringLiteral("http://127.0.0.1:8001");
+    settings[1].syncthingUrl = QStringLiteral("http://127.0.0.1:8002");
+    settings[2].label = QStringLiteral("third");
+    settings[2].syncthingUrl = QStringLiteral("http://127.0.0.1:8003");
+    pool.setConnections(settings);
+    QCOMPARE(rowsInsertedSpy.size(), 3);
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(model.index(0).data().toString(), QStringLiteral("first"));
+    QCOMPARE(model.index(1).data().toString(), QStringLiteral("http://127.0.0.1:8002"));
+    QCOMPARE(model.index(2).data(Data::SyncthingConnectionPoolModel::NodeSyncthingUrl).toString(), QStringLiteral("http://127.0.0.1:8003"));
+    QCOMPARE(model.index(2).data(Data::SyncthingConnectionPoolModel::NodeConnection).value<Data::SyncthingConnection *>(), pool.connection(2));
+    QVERIFY(!model.index(0).data(Data::SyncthingConnectionPoolModel::NodeConnected).toBool());
+    QVERIFY(!model.index(3).data().isValid());
+
+    // changes of the connections are flushed in one batch
+    QVERIFY(statisticsSpy.wait());
+    dataChangedSpy.clear();
+    auto &first = *pool.connection(0), &third = *pool.connection(2);
+    first.m_status = Data::SyncthingStatus::Idle;
+    first.m_overallDirStats.global.bytes = 1000;
+    first.m_overallDirStats.needed.bytes = 250;
+    third.m_status = Data::SyncthingStatus::Synchronizing;
+    third.m_overallDirStats.global.bytes = 3000;
+    emit first.dirStatisticsChanged();
+    emit third.statusChanged(Data::SyncthingStatus::Synchronizing);
+    QVERIFY(statisticsSpy.wait());
+    QCOMPARE(dataChangedSpy.size(), 1);
+    QCOMPARE(dataChangedSpy.front().at(0).toModelIndex().row(), 0);
+    QCOMPARE(dataChangedSpy.front().at(1).toModelIndex().row(), 2);
+    QVERIFY(model.index(0).data(Data::SyncthingConnectionPoolModel::NodeConnected).toBool());
+    QCOMPARE(model.index(0).data(Data::SyncthingConnectionPoolModel::NodeLocalCompletion).toDouble(), 75.0);
+    QCOMPARE(model.index(0).data(Data::SyncthingConnectionPoolModel::NodeNeededBytes).toULongLong(), quint64(250));
+    QCOMPARE(model.index(2).data(Data::SyncthingConnectionPoolModel::NodeGlobalBytes).toULongLong(), quint64(3000));
+    QCOMPARE(model.index(2).data(Data::SyncthingConnectionPoolModel::NodeLocalCompletion).toDouble(), 100.0);
+
+    // statistics are aggregated over connected nodes
+    const auto &statistics = pool.statistics();
+    QCOMPARE(statistics.nodeCount, 3);
+    QCOMPARE(statistics.connectedNodes, 2);
+    QCOMPARE(statistics.synchronizingNodes, 1);
+    QCOMPARE(statistics.global.bytes, quint64(4000));
+    QCOMPARE(statistics.needed.bytes, quint64(250));
+    QCOMPARE(statistics.localCompletion, 93.75);
+    QCOMPARE(statistics.remoteCompletion, 100.0);
+
+    // removing a connection removes its row and updates the statistics immediately
+    pool.removeConnection(0);
+    QCOMPARE(rowsRemovedSpy.size(), 1);
+    QCOMPARE(model.rowCount(), 2);
+    QCOMPARE(model.index(0).data().toString(), QStringLiteral("http://127.0.0.1:8002"));
+    QCOMPARE(statistics.nodeCount, 2);
+    QCOMPARE(statistics.connectedNodes, 1);
+    QCOMPARE(statistics.needed.bytes, quint64(0));
+    QCOMPARE(statistics.localCompletion, 100.0);
+    third.m_status = Data::SyncthingStatus::Disconnected; // as it is not actually connected
+}
+
 QTEST_MAIN(ModelTests)
 #include "models.moc"
@@ -27,7 +27,12 @@ DiffHighlighter::DiffHighlighter(QTextDocument *parent)
 
 void DiffHighlighter::highlightBlock(const QString &text)
 {
-    if (text.startsWith(QChar('-'))) {
+    if (!m_enabled) {
+        return;
+    }
+    if (text.startsWith(QLatin1String("@@"))) {
+        setFormat(0, static_cast<int>(text.size()), QColor(Qt::gray));
+    } else if (text.startsWith(QChar('-'))) {
         setFormat(0, static_cast<int>(text.size()), QColor(Qt::red));
     } else if (text.startsWith(QChar('+'))) {
         setFormat(0, static_cast<int>(text.size()), QColor(Qt::green));
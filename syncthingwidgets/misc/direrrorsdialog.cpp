@@ -4,10 +4,13 @@
 #include <syncthingconnector/syncthingdir.h>
 #include <syncthingconnector/utils.h>
 
+#include <syncthingmodel/syncthingpullerrormodel.h>
+
 #include <QDir>
 #include <QHBoxLayout>
 #include <QIcon>
 #include <QLabel>
+#include <QListView>
 #include <QMessageBox>
 #include <QPushButton>
 #include <QStringBuilder>
@@ -25,11 +28,22 @@ using namespace Data;
 
 namespace QtGui {
 
-DirectoryErrorsDialog::DirectoryErrorsDialog(const Data::SyncthingConnection &connection, const Data::SyncthingDir &dir, QWidget *parent)
+DirectoryErrorsDialog::DirectoryErrorsDialog(Data::SyncthingConnection &connection, const Data::SyncthingDir &dir, QWidget *parent)
     : TextViewDialog(tr("Errors for folder %1").arg(dir.displayName()), parent)
     , m_connection(connection)
     , m_dirId(dir.id)
+    , m_model(new SyncthingPullErrorModel(connection, dir.id, this))
 {
+    // show errors via a list view backed by a model which loads errors page by page instead of putting all errors into the
+    // text browser (which would take very long for many errors)
+    m_view = new QListView(this);
+    m_view->setModel(m_model);
+    m_view->setUniformItemSizes(true);
+    m_view->setAlternatingRowColors(true);
+    m_view->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    browser()->hide();
+    layout()->insertWidget(0, m_view);
+
     // add layout to show status and additional buttons
     auto *const buttonLayout = new QHBoxLayout;
     buttonLayout->setContentsMargins(0, 0, 0, 0);
@@ -54,9 +68,15 @@ DirectoryErrorsDialog::DirectoryErrorsDialog(const Data::SyncthingConnection &co
     connect(&connection, &SyncthingConnection::dirStatusChanged, this, &DirectoryErrorsDialog::handleDirStatusChanged);
     connect(&connection, &SyncthingConnection::newDirs, this, &DirectoryErrorsDialog::handleNewDirs);
     connect(m_rmNonEmptyDirsButton, &QPushButton::clicked, this, &DirectoryErrorsDialog::removeNonEmptyDirs);
-
-    // populate initially available errors
-    updateErrors(dir);
+    connect(m_model, &QAbstractItemModel::dataChanged, this,
+        [this](const QModelIndex &topLeft, const QModelIndex &bottomRight) { collectNonEmptyDirs(topLeft.row(), bottomRight.row()); });
+    connect(m_model, &QAbstractItemModel::modelReset, this, &DirectoryErrorsDialog::clearNonEmptyDirs);
+    connect(m_model, &QAbstractItemModel::rowsRemoved, this,
+        [this](const QModelIndex &, int firstRow, int lastRow) { dropNonEmptyDirs(firstRow, lastRow); });
+
+    // show initial status
+    updateStatus(dir);
+    clearNonEmptyDirs();
 }
 
 DirectoryErrorsDialog::~DirectoryErrorsDialog()
@@ -66,7 +86,7 @@ DirectoryErrorsDialog::~DirectoryErrorsDialog()
 void DirectoryErrorsDialog::handleDirStatusChanged(const SyncthingDir &dir)
 {
     if (dir.id == m_dirId) {
-        updateErrors(dir);
+        updateStatus(dir);
     }
 }
 
@@ -74,28 +94,62 @@ void DirectoryErrorsDialog::handleNewDirs()
 {
     auto index = int();
     if (const auto *const dir = m_connection.findDirInfo(m_dirId, index)) {
-        updateErrors(*dir);
+        updateStatus(*dir);
     }
 }
 
-void DirectoryErrorsDialog::updateErrors(const Data::SyncthingDir &dir)
+void DirectoryErrorsDialog::updateStatus(const Data::SyncthingDir &dir)
 {
-    // update status
     m_statusLabel->setText(tr("%1 item(s) out-of-sync", nullptr, trQuandity(dir.pullErrorCount)).arg(dir.pullErrorCount));
-    m_rmNonEmptyDirsButton->setHidden(m_nonEmptyDirs.empty());
-
-    // clear previous errors
-    auto *const textBrowser = browser();
-    textBrowser->clear();
-    m_nonEmptyDirs.clear();
+}
 
-    // add item errors to textBrowser
-    for (const SyncthingItemError &error : dir.itemErrors) {
-        textBrowser->append(error.path % QChar(':') % QChar('\n') % error.message % QChar('\n'));
-        if (error.message.endsWith(QStringLiteral("directory not empty"))) {
-            m_nonEmptyDirs << dir.path + error.path;
+/*!
+ * \brief Records non-empty directories mentioned by the errors within the specified rows once they have been loaded.
+ * \remarks
+ * - Only errors of pages which have been loaded (by scrolling through the list) are considered.
+ * - Directories are kept when their page is evicted from the model's cache; they are only dropped when the rows are removed.
+ */
+void DirectoryErrorsDialog::collectNonEmptyDirs(int firstRow, int lastRow)
+{
+    auto index = int();
+    const auto *const dir = m_connection.findDirInfo(m_dirId, index);
+    if (!dir) {
+        return;
+    }
+    for (auto row = firstRow; row <= lastRow; ++row) {
+        const auto *const error = m_model->itemError(row);
+        if (!error) {
+            continue;
+        }
+        if (error->message.endsWith(QStringLiteral("directory not empty"))) {
+            m_nonEmptyDirs[row] = dir->path + error->path;
+        } else {
+            m_nonEmptyDirs.erase(row);
         }
     }
+    m_rmNonEmptyDirsButton->setHidden(m_nonEmptyDirs.empty());
+}
+
+/*!
+ * \brief Drops non-empty directories recorded for the specified rows which have been removed from the model.
+ * \remarks Directories recorded for subsequent rows are moved up accordingly.
+ */
+void DirectoryErrorsDialog::dropNonEmptyDirs(int firstRow, int lastRow)
+{
+    const auto removedCount = lastRow - firstRow + 1;
+    m_nonEmptyDirs.erase(m_nonEmptyDirs.lower_bound(firstRow), m_nonEmptyDirs.upper_bound(lastRow));
+    for (auto i = m_nonEmptyDirs.upper_bound(lastRow); i != m_nonEmptyDirs.end();) {
+        auto node = m_nonEmptyDirs.extract(i++);
+        node.key() -= removedCount;
+        m_nonEmptyDirs.insert(std::move(node));
+    }
+    m_rmNonEmptyDirsButton->setHidden(m_nonEmptyDirs.empty());
+}
+
+void DirectoryErrorsDialog::clearNonEmptyDirs()
+{
+    m_nonEmptyDirs.clear();
+    m_rmNonEmptyDirsButton->setHidden(true);
 }
 
 QString printDirectories(const QString &message, const QStringList &dirs)
@@ -111,14 +165,21 @@ void DirectoryErrorsDialog::removeNonEmptyDirs()
         return;
     }
 
+    auto nonEmptyDirs = QStringList();
+    nonEmptyDirs.reserve(static_cast<QStringList::size_type>(m_nonEmptyDirs.size()));
+    for (const auto &[row, dirPath] : m_nonEmptyDirs) {
+        nonEmptyDirs << dirPath;
+    }
+    nonEmptyDirs.sort();
+    nonEmptyDirs.removeDuplicates();
     const QString title(tr("Remove non-empty directories for folder \"%1\"").arg(dir->displayName()));
-    if (QMessageBox::warning(this, title, printDirectories(tr("Do you really want to remove the following directories:"), m_nonEmptyDirs),
+    if (QMessageBox::warning(this, title, printDirectories(tr("Do you really want to remove the following directories:"), nonEmptyDirs),
             QMessageBox::YesToAll | QMessageBox::NoToAll, QMessageBox::NoToAll)
         != QMessageBox::YesToAll) {
         return;
     }
     QStringList removedDirs, failedDirs;
-    for (const auto &dirPath : std::as_const(m_nonEmptyDirs)) {
+    for (const auto &dirPath : std::as_const(nonEmptyDirs)) {
         auto ok = false;
         auto dirObj = QDir(dirPath);
         if (!dirObj.exists() || !dirObj.removeRecursively()) {
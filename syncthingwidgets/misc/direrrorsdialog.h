@@ -3,11 +3,15 @@
 
 #include "./textviewdialog.h"
 
+#include <map>
+
 QT_FORWARD_DECLARE_CLASS(QLabel)
+QT_FORWARD_DECLARE_CLASS(QListView)
 QT_FORWARD_DECLARE_CLASS(QPushButton)
 
 namespace Data {
 class SyncthingConnection;
+class SyncthingPullErrorModel;
 struct SyncthingDir;
 } // namespace Data
 
@@ -16,19 +20,24 @@ namespace QtGui {
 class SYNCTHINGWIDGETS_EXPORT DirectoryErrorsDialog : public TextViewDialog {
     Q_OBJECT
 public:
-    explicit DirectoryErrorsDialog(const Data::SyncthingConnection &connection, const Data::SyncthingDir &dir, QWidget *parent = nullptr);
+    explicit DirectoryErrorsDialog(Data::SyncthingConnection &connection, const Data::SyncthingDir &dir, QWidget *parent = nullptr);
     ~DirectoryErrorsDialog() override;
 
 private Q_SLOTS:
     void handleDirStatusChanged(const Data::SyncthingDir &dir);
     void handleNewDirs();
-    void updateErrors(const Data::SyncthingDir &dir);
+    void updateStatus(const Data::SyncthingDir &dir);
+    void collectNonEmptyDirs(int firstRow, int lastRow);
+    void dropNonEmptyDirs(int firstRow, int lastRow);
+    void clearNonEmptyDirs();
     void removeNonEmptyDirs();
 
 private:
     const Data::SyncthingConnection &m_connection;
     QString m_dirId;
-    QStringList m_nonEmptyDirs;
+    std::map<int, QString> m_nonEmptyDirs;
+    Data::SyncthingPullErrorModel *m_model;
+    QListView *m_view;
     QLabel *m_statusLabel;
     QPushButton *m_rmNonEmptyDirsButton;
 };
@@ -0,0 +1,317 @@
+#include "./filecopier.h"
+
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+#ifdef __linux__
+#include <cerrno>
+
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace QtGui {
+
+/// \cond
+namespace {
+
+constexpr auto markerFileName = ".syncthingtray-copy-incomplete";
+
+std::filesystem::path normalizedPath(const std::filesystem::path &path)
+{
+    return std::filesystem::absolute(path).lexically_normal();
+}
+
+#ifdef __linux__
+class FileDescriptor {
+public:
+    explicit FileDescriptor(int fd)
+        : m_fd(fd)
+    {
+    }
+    ~FileDescriptor()
+    {
+        if (m_fd >= 0) {
+            ::close(m_fd);
+        }
+    }
+    FileDescriptor(const FileDescriptor &) = delete;
+    FileDescriptor &operator=(const FileDescriptor &) = delete;
+    operator int() const
+    {
+        return m_fd;
+    }
+
+private:
+    int m_fd;
+};
+
+[[noreturn]] void throwLastError(const char *what, const std::filesystem::path &source, const std::filesystem::path &destination)
+{
+    throw std::filesystem::filesystem_error(what, source, destination, std::error_code(errno, std::generic_category()));
+}
+#endif
+
+} // namespace
+/// \endcond
+
+/*!
+ * \class FileCopier
+ * \brief The FileCopier class copies directory trees using multiple threads and reports progress.
+ *
+ * The trees added via addTree() are walked once to create directories, recreate symlinks and determine the files to
+ * copy as well as the total size. The files are then copied by a bounded pool of worker threads. Under Linux the copy is
+ * done kernel-side, preferably via a reflink (FICLONE) and otherwise via copy_file_range(), falling back to read()/write()
+ * when neither is supported by the involved file systems. On other platforms std::filesystem::copy_file() is used which
+ * uses the platform's native copy function.
+ *
+ * The progress getters and cancel() may be used from other threads while run() is ongoing.
+ *
+ * Copied files get the modification time of their source. If a copy is canceled or fails, a marker file is left in the
+ * destination directory so isResumable() can tell that the destination may be reused instead of being cleaned up. When
+ * resuming, files of the same size and modification time as their source are skipped.
+ */
+
+/*!
+ * \brief Constructs a new copier using at most \a maxWorkers threads (or a default depending on the hardware if 0).
+ */
+FileCopier::FileCopier(unsigned int maxWorkers)
+    : m_maxWorkers(maxWorkers ? maxWorkers : std::clamp(std::thread::hardware_concurrency(), 1u, 4u))
+    , m_canceled(false)
+    , m_bytesTotal(0)
+    , m_bytesCopied(0)
+    , m_filesTotal(0)
+    , m_filesCopied(0)
+    , m_filesSkipped(0)
+{
+}
+
+/*!
+ * \brief Adds the tree under \a source to be copied to \a destination when run() is called.
+ */
+void FileCopier::addTree(const std::filesystem::path &source, const std::filesystem::path &destination)
+{
+    m_trees.emplace_back(Tree{ source, destination });
+}
+
+/*!
+ * \brief Copies all added trees, blocking until done.
+ * \returns Returns true if all files have been copied and false if the copy has been canceled.
+ * \throws Throws std::filesystem::filesystem_error if a file or directory could not be read or written.
+ */
+bool FileCopier::run()
+{
+    // walk all trees first so the total is known before copying starts
+    auto jobs = std::vector<Job>();
+    for (const auto &tree : m_trees) {
+        collectJobs(tree, jobs);
+        if (m_canceled) {
+            return false;
+        }
+    }
+
+    // copy files reachable via multiple trees (e.g. a nested tree also added separately) only once
+    std::sort(jobs.begin(), jobs.end(), [](const Job &lhs, const Job &rhs) { return lhs.destination < rhs.destination; });
+    jobs.erase(std::unique(jobs.begin(), jobs.end(), [](const Job &lhs, const Job &rhs) { return lhs.destination == rhs.destination; }), jobs.end());
+
+    // compute totals from the remaining files and skip files which are already up-to-date
+    for (const auto &job : jobs) {
+        ++m_filesTotal;
+        m_bytesTotal += job.size;
+        if (job.upToDate) {
+            ++m_filesCopied;
+            ++m_filesSkipped;
+            m_bytesCopied += job.size;
+        }
+    }
+    jobs.erase(std::remove_if(jobs.begin(), jobs.end(), [](const Job &job) { return job.upToDate; }), jobs.end());
+
+    // copy big files first so workers are not kept busy by a single big file at the end
+    std::sort(jobs.begin(), jobs.end(), [](const Job &lhs, const Job &rhs) { return lhs.size > rhs.size; });
+
+    // copy files concurrently
+    auto nextJob = std::atomic_size_t(0);
+    auto failure = std::exception_ptr();
+    auto failureMutex = std::mutex();
+    auto failed = std::atomic_bool(false);
+    const auto work = [&] {
+        for (auto i = nextJob++; i < jobs.size() && !m_canceled && !failed; i = nextJob++) {
+            try {
+                copyFile(jobs[i]);
+            } catch (...) {
+                auto lock = std::lock_guard<std::mutex>(failureMutex);
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+                failed = true;
+            }
+        }
+    };
+    const auto workerCount = std::min<std::size_t>(m_maxWorkers, jobs.size());
+    auto workers = std::vector<std::thread>();
+    workers.reserve(workerCount > 1 ? workerCount - 1 : 0);
+    for (auto i = std::size_t(1); i < workerCount; ++i) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    if (m_canceled) {
+        return false;
+    }
+
+    // remove markers as the copy is complete
+    for (const auto &tree : m_trees) {
+        std::filesystem::remove(tree.destination / markerFileName);
+    }
+    return true;
+}
+
+/*!
+ * \brief Returns whether \a destination contains an incomplete copy of \a source left by a canceled or failed run().
+ */
+bool FileCopier::isResumable(const std::filesystem::path &source, const std::filesystem::path &destination)
+{
+    auto marker = std::ifstream(destination / markerFileName);
+    auto markedSource = std::filesystem::path();
+    return marker && (marker >> markedSource) && markedSource == normalizedPath(source);
+}
+
+/// \cond
+void FileCopier::collectJobs(const Tree &tree, std::vector<Job> &jobs) const
+{
+    std::filesystem::create_directories(tree.destination);
+    const auto markerPath = tree.destination / markerFileName;
+    if (auto marker = std::ofstream(markerPath, std::ios_base::out | std::ios_base::trunc); !(marker << normalizedPath(tree.source))) {
+        throw std::filesystem::filesystem_error("unable to write marker file", markerPath, std::make_error_code(std::errc::io_error));
+    }
+    const auto end = std::filesystem::recursive_directory_iterator();
+    for (auto i = std::filesystem::recursive_directory_iterator(tree.source); i != end; ++i) {
+        if (m_canceled) {
+            return;
+        }
+        const auto &entry = *i;
+        const auto status = entry.symlink_status();
+        const auto destination = tree.destination / entry.path().lexically_relative(tree.source);
+        if (std::filesystem::is_symlink(status)) {
+            auto ec = std::error_code();
+            std::filesystem::remove(destination, ec);
+            std::filesystem::copy_symlink(entry.path(), destination);
+        } else if (std::filesystem::is_directory(status)) {
+            std::filesystem::create_directories(destination);
+        } else if (std::filesystem::is_regular_file(status)) {
+            const auto size = static_cast<std::uint64_t>(entry.file_size());
+            const auto lastWriteTime = entry.last_write_time();
+            auto ec = std::error_code();
+            const auto upToDate = std::filesystem::file_size(destination, ec) == size && !ec
+                && std::filesystem::last_write_time(destination, ec) == lastWriteTime && !ec;
+            jobs.emplace_back(Job{ entry.path(), destination, size, lastWriteTime, upToDate });
+        }
+    }
+}
+
+void FileCopier::copyFile(const Job &job)
+{
+#ifdef __linux__
+    const auto source = FileDescriptor(::open(job.source.c_str(), O_RDONLY | O_CLOEXEC));
+    if (source < 0) {
+        throwLastError("unable to open source file", job.source, job.destination);
+    }
+    struct stat sourceStat;
+    if (::fstat(source, &sourceStat) != 0) {
+        throwLastError("unable to stat source file", job.source, job.destination);
+    }
+    const auto destination
+        = FileDescriptor(::open(job.destination.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, sourceStat.st_mode & 07777));
+    if (destination < 0) {
+        throwLastError("unable to open destination file", job.source, job.destination);
+    }
+
+    auto copied = std::uint64_t();
+    auto done = false;
+#ifdef FICLONE
+    // try to create a reflink which shares the data with the source (e.g. on Btrfs and XFS)
+    if (::ioctl(destination, FICLONE, static_cast<int>(source)) == 0) {
+        copied = job.size;
+        m_bytesCopied += job.size;
+        done = true;
+    }
+#endif
+#ifdef SYS_copy_file_range
+    // copy within the kernel in chunks so progress can be reported and cancellation is possible
+    constexpr auto chunkSize = std::size_t(8 * 1024 * 1024);
+    while (!done && !m_canceled) {
+        const auto res = ::syscall(SYS_copy_file_range, static_cast<int>(source), nullptr, static_cast<int>(destination), nullptr, chunkSize, 0u);
+        if (res > 0) {
+            copied += static_cast<std::uint64_t>(res);
+            m_bytesCopied += static_cast<std::uint64_t>(res);
+        } else if (res == 0) {
+            done = true;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (!copied && (errno == EXDEV || errno == ENOSYS || errno == EINVAL || errno == EOPNOTSUPP || errno == EPERM)) {
+            break; // not supported for the involved file systems, fall back to read()/write()
+        } else {
+            throwLastError("unable to copy file", job.source, job.destination);
+        }
+    }
+#endif
+    // fall back to copying via a buffer in user space
+    if (!done) {
+        auto buffer = std::vector<char>(256 * 1024);
+        while (!m_canceled) {
+            const auto bytesRead = ::read(source, buffer.data(), buffer.size());
+            if (bytesRead < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throwLastError("unable to read source file", job.source, job.destination);
+            }
+            if (bytesRead == 0) {
+                done = true;
+                break;
+            }
+            for (auto offset = ssize_t(); offset < bytesRead;) {
+                const auto bytesWritten = ::write(destination, buffer.data() + offset, static_cast<std::size_t>(bytesRead - offset));
+                if (bytesWritten < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throwLastError("unable to write destination file", job.source, job.destination);
+                }
+                offset += bytesWritten;
+            }
+            copied += static_cast<std::uint64_t>(bytesRead);
+            m_bytesCopied += static_cast<std::uint64_t>(bytesRead);
+        }
+    }
+    if (!done) {
+        return; // canceled; the file is left incomplete and will be copied again when resuming
+    }
+    // account for the file having changed its size since the tree has been walked
+    if (copied != job.size) {
+        m_bytesTotal += copied;
+        m_bytesTotal -= job.size;
+    }
+#else
+    std::filesystem::copy_file(job.source, job.destination, std::filesystem::copy_options::overwrite_existing);
+    m_bytesCopied += job.size;
+#endif
+    std::filesystem::last_write_time(job.destination, job.lastWriteTime);
+    ++m_filesCopied;
+}
+/// \endcond
+
+} // namespace QtGui
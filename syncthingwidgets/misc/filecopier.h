@@ -0,0 +1,114 @@
+#ifndef SYNCTHINGWIDGETS_FILECOPIER_H
+#define SYNCTHINGWIDGETS_FILECOPIER_H
+
+#include "../global.h"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace QtGui {
+
+class SYNCTHINGWIDGETS_EXPORT FileCopier {
+public:
+    explicit FileCopier(unsigned int maxWorkers = 0);
+
+    void addTree(const std::filesystem::path &source, const std::filesystem::path &destination);
+    bool run();
+    void cancel();
+    bool isCanceled() const;
+    std::uint64_t bytesTotal() const;
+    std::uint64_t bytesCopied() const;
+    std::uint64_t filesTotal() const;
+    std::uint64_t filesCopied() const;
+    std::uint64_t filesSkipped() const;
+
+    static bool isResumable(const std::filesystem::path &source, const std::filesystem::path &destination);
+
+private:
+    struct Tree {
+        std::filesystem::path source;
+        std::filesystem::path destination;
+    };
+    struct Job {
+        std::filesystem::path source;
+        std::filesystem::path destination;
+        std::uint64_t size;
+        std::filesystem::file_time_type lastWriteTime;
+        bool upToDate;
+    };
+
+    void collectJobs(const Tree &tree, std::vector<Job> &jobs) const;
+    void copyFile(const Job &job);
+
+    std::vector<Tree> m_trees;
+    unsigned int m_maxWorkers;
+    std::atomic_bool m_canceled;
+    std::atomic_uint64_t m_bytesTotal;
+    std::atomic_uint64_t m_bytesCopied;
+    std::atomic_uint64_t m_filesTotal;
+    std::atomic_uint64_t m_filesCopied;
+    std::atomic_uint64_t m_filesSkipped;
+};
+
+/*!
+ * \brief Requests cancellation; run() returns as soon as the workers have noticed it.
+ * \remarks May be called from any thread.
+ */
+inline void FileCopier::cancel()
+{
+    m_canceled = true;
+}
+
+/*!
+ * \brief Returns whether cancel() has been called.
+ */
+inline bool FileCopier::isCanceled() const
+{
+    return m_canceled;
+}
+
+/*!
+ * \brief Returns the number of bytes of all files to be copied (known once all trees have been walked).
+ */
+inline std::uint64_t FileCopier::bytesTotal() const
+{
+    return m_bytesTotal;
+}
+
+/*!
+ * \brief Returns the number of bytes copied so far (including bytes of files skipped as already up-to-date).
+ */
+inline std::uint64_t FileCopier::bytesCopied() const
+{
+    return m_bytesCopied;
+}
+
+/*!
+ * \brief Returns the number of files to be copied (known once all trees have been walked).
+ */
+inline std::uint64_t FileCopier::filesTotal() const
+{
+    return m_filesTotal;
+}
+
+/*!
+ * \brief Returns the number of files copied so far (including files skipped as already up-to-date).
+ */
+inline std::uint64_t FileCopier::filesCopied() const
+{
+    return m_filesCopied;
+}
+
+/*!
+ * \brief Returns the number of files skipped so far because they were already up-to-date.
+ */
+inline std::uint64_t FileCopier::filesSkipped() const
+{
+    return m_filesSkipped;
+}
+
+} // namespace QtGui
+
+#endif // SYNCTHINGWIDGETS_FILECOPIER_H
@@ -6,9 +6,13 @@
 #include <qtutilities/models/checklistmodel.h>
 
 #include <syncthingconnector/syncthingconnection.h>
+#include <syncthingconnector/syncthingconnectionpool.h>
+#include <syncthingconnector/syncthingconnectionsettings.h>
 #include <syncthingconnector/syncthingdir.h>
+#include <syncthingconnector/utils.h>
 
 #include <syncthingmodel/colors.h>
+#include <syncthingmodel/syncthingconnectionpoolmodel.h>
 #include <syncthingmodel/syncthingerrormodel.h>
 #include <syncthingmodel/syncthingfilemodel.h>
 
@@ -500,4 +504,81 @@ QDialog *errorNotificationsDialog(Data::SyncthingConnection &connection, QWidget
     return dlg;
 }
 
+QDialog *connectionPoolDialog(std::vector<Data::SyncthingConnectionSettings> settings, QWidget *parent)
+{
+    auto dlg = new QDialog(parent);
+    dlg->setWindowTitle(QCoreApplication::translate("QtGui::OtherDialogs", "Overview of all connections") + QStringLiteral(" - " APP_NAME));
+    dlg->setWindowIcon(QIcon(QStringLiteral(":/icons/hicolor/scalable/app/syncthingtray.svg")));
+    dlg->setAttribute(Qt::WA_DeleteOnClose);
+
+    // setup view first so it is destroyed before the pool and model
+    auto *const splitter = new QSplitter(dlg);
+    auto *const view = new QTreeView(dlg);
+    splitter->setOrientation(Qt::Horizontal);
+    splitter->setSizePolicy(QSizePolicy::MinimumExpanding, QSizePolicy::MinimumExpanding);
+    splitter->addWidget(view);
+    view->setFrameShape(QFrame::StyledPanel);
+    view->setItemsExpandable(false);
+    view->setRootIsDecorated(false);
+
+    // setup pool with a connection for each configured Syncthing instance which is monitored as long as the dialog is open
+    auto *const pool = new SyncthingConnectionPool(dlg);
+    auto *const model = new SyncthingConnectionPoolModel(*pool, pool);
+    pool->setConnections(settings);
+    pool->setUiVisible(true);
+    pool->connectAll();
+    view->setModel(model);
+
+    // add label showing details of the current node
+    auto *const details = new QLabel(dlg);
+    details->setAlignment(Qt::AlignTop | Qt::AlignLeft);
+    details->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    details->setContentsMargins(7, 0, 0, 0);
+    splitter->addWidget(details);
+    const auto updateDetails = [view, details] {
+        const auto index = view->currentIndex();
+        if (!index.isValid()) {
+            details->setText(QCoreApplication::translate("QtGui::OtherDialogs", "Select a connection to show details."));
+            return;
+        }
+        details->setText(
+            QCoreApplication::translate("QtGui::OtherDialogs", "URL: %1\nStatus: %2\nLocal completion: %3 %\nRemote completion: %4 %\nTraffic: %5")
+                .arg(index.data(SyncthingConnectionPoolModel::NodeSyncthingUrl).toString(),
+                    index.data(SyncthingConnectionPoolModel::NodeStatusString).toString(),
+                    QString::number(index.data(SyncthingConnectionPoolModel::NodeLocalCompletion).toDouble(), 'f', 1),
+                    QString::number(index.data(SyncthingConnectionPoolModel::NodeRemoteCompletion).toDouble(), 'f', 1),
+                    index.data(SyncthingConnectionPoolModel::NodeTrafficString).toString()));
+    };
+    updateDetails();
+    QObject::connect(view->selectionModel(), &QItemSelectionModel::currentRowChanged, details, updateDetails);
+    QObject::connect(model, &QAbstractItemModel::dataChanged, details, updateDetails);
+
+    // add label showing statistics aggregated over all nodes
+    auto *const summary = new QLabel(dlg);
+    summary->setWordWrap(true);
+    summary->setContentsMargins(0, 7, 0, 0);
+    const auto updateSummary = [summary](const SyncthingConnectionPoolStatistics &statistics) {
+        summary->setText(QCoreApplication::translate("QtGui::OtherDialogs",
+            "%1 of %2 connected, %3 synchronizing, %4 out of sync - local completion: %5 %, remote completion: %6 % - traffic: %7 in, %8 out")
+                .arg(QString::number(statistics.connectedNodes), QString::number(statistics.nodeCount),
+                    QString::number(statistics.synchronizingNodes), QString::number(statistics.outOfSyncNodes),
+                    QString::number(statistics.localCompletion, 'f', 1), QString::number(statistics.remoteCompletion, 'f', 1),
+                    trafficString(statistics.totalIncomingTraffic, statistics.totalIncomingRate),
+                    trafficString(statistics.totalOutgoingTraffic, statistics.totalOutgoingRate)));
+    };
+    updateSummary(pool->statistics());
+    QObject::connect(pool, &SyncthingConnectionPool::statisticsChanged, summary, updateSummary);
+
+    // setup layout
+    auto layout = new QVBoxLayout;
+    layout->setAlignment(Qt::AlignCenter);
+    layout->setSpacing(0);
+    layout->setContentsMargins(7, 7, 7, 7);
+    layout->addWidget(splitter);
+    layout->addWidget(summary);
+    dlg->setLayout(layout);
+
+    return dlg;
+}
+
 } // namespace QtGui
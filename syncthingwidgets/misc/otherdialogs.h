@@ -5,11 +5,14 @@
 
 #include <QtGlobal>
 
+#include <vector>
+
 QT_FORWARD_DECLARE_CLASS(QDialog)
 QT_FORWARD_DECLARE_CLASS(QWidget)
 
 namespace Data {
 class SyncthingConnection;
+struct SyncthingConnectionSettings;
 struct SyncthingDir;
 } // namespace Data
 
@@ -23,6 +26,7 @@ SYNCTHINGWIDGETS_EXPORT QDialog *browseRemoteFilesDialog(
 SYNCTHINGWIDGETS_EXPORT QDialog *errorNotificationsDialog(Data::SyncthingConnection &connection, QWidget *parent = nullptr);
 SYNCTHINGWIDGETS_EXPORT TextViewDialog *ignorePatternsDialog(
     Data::SyncthingConnection &connection, const Data::SyncthingDir &dir, QWidget *parent = nullptr);
+SYNCTHINGWIDGETS_EXPORT QDialog *connectionPoolDialog(std::vector<Data::SyncthingConnectionSettings> settings, QWidget *parent = nullptr);
 
 } // namespace QtGui
 
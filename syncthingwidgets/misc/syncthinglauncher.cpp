@@ -9,7 +9,6 @@
 
 #include <c++utilities/io/ansiescapecodes.h>
 
-#include <QMetaObject>
 #include <QtConcurrentRun>
 
 #ifdef SYNCTHINGCONNECTION_SUPPORT_METERED
@@ -53,6 +52,11 @@ SyncthingLauncher::SyncthingLauncher(QObject *parent)
     , m_lastLauncherSettings(nullptr)
 #endif
     , m_relevantConnection(nullptr)
+#ifdef SYNCTHINGWIDGETS_USE_LIBSYNCTHING
+    , m_logPipeline(this, std::bind(&SyncthingLauncher::handleLogBatch, this, _1))
+#else
+    , m_logPipeline(this, SyncthingLogPipeline::BatchHandler())
+#endif
     , m_guiListeningUrlSearch("Access the GUI via the following URL: ", "\n\r", std::string_view(), BufferSearch::CallbackType())
     , m_exitSearch("Syncthing exited: ", "\n\r", std::string_view(), BufferSearch::CallbackType())
 #ifdef SYNCTHINGWIDGETS_USE_LIBSYNCTHING
@@ -72,6 +76,7 @@ SyncthingLauncher::SyncthingLauncher(QObject *parent)
     connect(&m_process, &SyncthingProcess::confirmKill, this, &SyncthingLauncher::confirmKill);
 #ifdef SYNCTHINGWIDGETS_USE_LIBSYNCTHING
     connect(&m_startWatcher, &QFutureWatcher<std::int64_t>::finished, this, &SyncthingLauncher::handleLibSyncthingFinished);
+    m_logPipeline.setMinLevel(static_cast<int>(m_libsyncthingLogLevel));
 #endif
 
     // initialize handling of metered connections
@@ -331,17 +336,17 @@ QString SyncthingLauncher::libSyncthingLogLevelString(LibSyncthing::LogLevel log
 void SyncthingLauncher::setLibSyncthingLogLevel(const QString &logLevel, LibSyncthing::LogLevel fallbackLogLevel)
 {
     if (logLevel.compare(QLatin1String("debug"), Qt::CaseInsensitive) == 0) {
-        m_libsyncthingLogLevel = LibSyncthing::LogLevel::Debug;
+        setLibSyncthingLogLevel(LibSyncthing::LogLevel::Debug);
     } else if (logLevel.compare(QLatin1String("verbose"), Qt::CaseInsensitive) == 0) {
-        m_libsyncthingLogLevel = LibSyncthing::LogLevel::Verbose;
+        setLibSyncthingLogLevel(LibSyncthing::LogLevel::Verbose);
     } else if (logLevel.compare(QLatin1String("info"), Qt::CaseInsensitive) == 0) {
-        m_libsyncthingLogLevel = LibSyncthing::LogLevel::Info;
+        setLibSyncthingLogLevel(LibSyncthing::LogLevel::Info);
     } else if (logLevel.compare(QLatin1String("warning"), Qt::CaseInsensitive) == 0) {
-        m_libsyncthingLogLevel = LibSyncthing::LogLevel::Warning;
+        setLibSyncthingLogLevel(LibSyncthing::LogLevel::Warning);
     } else if (logLevel.compare(QLatin1String("fatal"), Qt::CaseInsensitive) == 0) {
-        m_libsyncthingLogLevel = LibSyncthing::LogLevel::Fatal;
+        setLibSyncthingLogLevel(LibSyncthing::LogLevel::Fatal);
     } else {
-        m_libsyncthingLogLevel = fallbackLogLevel;
+        setLibSyncthingLogLevel(fallbackLogLevel);
     }
 }
 
@@ -418,9 +423,7 @@ void SyncthingLauncher::stopLibSyncthing()
 void SyncthingLauncher::handleProcessReadyRead()
 {
     const auto data = m_process.readAll();
-    if (m_logFile.isOpen()) {
-        m_logFile.write(data);
-    }
+    m_logPipeline.writeToLogFile(data);
     handleOutputAvailable(-1, data);
 }
 
@@ -469,6 +472,11 @@ static const char *const logLevelStrings[] = {
     "[FATAL]   ",
 };
 
+/*!
+ * \brief Passes a log message of the built-in Syncthing instance to the log pipeline.
+ * \remarks Invoked from the threads of the Go runtime. Writing to the log file and handling the output within the GUI thread
+ *          happens batched via m_logPipeline.
+ */
 void SyncthingLauncher::handleLoggingCallback(LibSyncthing::LogLevel level, const char *message, size_t messageSize)
 {
     auto messageData = QByteArray();
@@ -477,19 +485,38 @@ void SyncthingLauncher::handleLoggingCallback(LibSyncthing::LogLevel level, cons
     messageData.append(logLevelStrings[static_cast<int>(level)]);
     messageData.append(message, static_cast<int>(messageSize));
     messageData.append('\n');
-    if (level >= m_libsyncthingLogLevel && m_logFile.isOpen()) {
-        m_logFile.write(messageData);
+    m_logPipeline.append(static_cast<int>(level), std::move(messageData));
+}
+
+/*!
+ * \brief Handles a batch of log messages of the built-in Syncthing instance delivered by m_logPipeline.
+ */
+void SyncthingLauncher::handleLogBatch(SyncthingLogBatch &&batch)
+{
+    searchOutput(batch.data);
+    if (!batch.visibleData.isEmpty()) {
+        emitOutput(batch.visibleData);
     }
-#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
-    QMetaObject::invokeMethod(this, &SyncthingLauncher::handleOutputAvailable, Qt::QueuedConnection, static_cast<int>(level), std::move(messageData));
-#else
-    QMetaObject::invokeMethod(
-        this, "handleOutputAvailable", Qt::QueuedConnection, Q_ARG(int, static_cast<int>(level)), Q_ARG(QByteArray, messageData));
-#endif
 }
 #endif
 
 void SyncthingLauncher::handleOutputAvailable(int logLevel, const QByteArray &data)
+{
+    searchOutput(data);
+#ifdef SYNCTHINGWIDGETS_USE_LIBSYNCTHING
+    if (logLevel < static_cast<int>(m_libsyncthingLogLevel)) {
+        return;
+    }
+#else
+    Q_UNUSED(logLevel)
+#endif
+    emitOutput(data);
+}
+
+/*!
+ * \brief Searches the specified \a data for the exit message and the GUI address.
+ */
+void SyncthingLauncher::searchOutput(const QByteArray &data)
 {
     const auto *const exitOffset = m_exitSearch.process(data.data(), static_cast<std::size_t>(data.size()));
     const auto *const guiAddressOffset = m_guiListeningUrlSearch.process(data.data(), static_cast<std::size_t>(data.size()));
@@ -508,13 +535,13 @@ void SyncthingLauncher::handleOutputAvailable(int logLevel, const QByteArray &da
         m_guiListeningUrl.clear();
         emit guiUrlChanged(m_guiListeningUrl);
     }
-#ifdef SYNCTHINGWIDGETS_USE_LIBSYNCTHING
-    if (logLevel < static_cast<int>(m_libsyncthingLogLevel)) {
-        return;
-    }
-#else
-    Q_UNUSED(logLevel)
-#endif
+}
+
+/*!
+ * \brief Emits outputAvailable() for the specified \a data or buffers it if not emitting output at this point.
+ */
+void SyncthingLauncher::emitOutput(const QByteArray &data)
+{
     if (isEmittingOutput()) {
         emit outputAvailable(data);
     } else {
@@ -550,6 +577,7 @@ void SyncthingLauncher::runLibSyncthing(const LibSyncthing::RuntimeOptions &runt
         showLibSyncthingNotSupported(QByteArrayLiteral("libsyncthing has already been started"));
         return;
     }
+    m_logPipeline.start();
     LibSyncthing::setLoggingCallback(std::bind(&SyncthingLauncher::handleLoggingCallback, this, _1, _2, _3));
     emit runningChanged(true);
     emit startingChanged();
@@ -561,6 +589,7 @@ void SyncthingLauncher::handleLibSyncthingFinished()
     const auto exitCode = m_startFuture.result();
     const auto &exitStatus = m_lastExitStatus.emplace(static_cast<int>(exitCode), exitCode == 0 ? QProcess::NormalExit : QProcess::CrashExit);
     LibSyncthing::setLoggingCallback(LibSyncthing::LoggingCallback());
+    m_logPipeline.stop();
     m_guiListeningUrl.clear();
     emit guiUrlChanged(m_guiListeningUrl);
     emit exited(exitStatus.code, exitStatus.status);
@@ -7,6 +7,8 @@
 #include <syncthing/interface.h>
 #endif
 
+#include "./syncthinglogpipeline.h"
+
 #include <syncthingconnector/syncthingprocess.h>
 
 #include <c++utilities/io/buffersearch.h>
@@ -55,7 +57,11 @@ public:
     explicit SyncthingLauncher(QObject *parent = nullptr);
     ~SyncthingLauncher() override;
 
-    QFile &logFile();
+    bool isLogFileOpen() const;
+    QString logFileName() const;
+    bool openLogFile(const QString &fileName);
+    void closeLogFile();
+    bool removeLogFile(const QString &fileName);
     bool isRunning() const;
     bool isStarting() const;
 #ifdef SYNCTHINGWIDGETS_USE_LIBSYNCTHING
@@ -119,12 +125,15 @@ private Q_SLOTS:
     void handleProcessReadyRead();
     void handleProcessStateChanged(QProcess::ProcessState newState);
     void handleProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
-    void handleOutputAvailable(int logLevel, const QByteArray &data);
 
 private:
+    void handleOutputAvailable(int logLevel, const QByteArray &data);
+    void searchOutput(const QByteArray &data);
+    void emitOutput(const QByteArray &data);
     void resetState();
 #ifdef SYNCTHINGWIDGETS_USE_LIBSYNCTHING
     void handleLoggingCallback(LibSyncthing::LogLevel, const char *message, std::size_t messageSize);
+    void handleLogBatch(SyncthingLogBatch &&batch);
     void runLibSyncthing(const LibSyncthing::RuntimeOptions &runtimeOptions);
     void handleLibSyncthingFinished();
 #endif
@@ -132,7 +141,6 @@ private:
     void showLibSyncthingNotSupported(QByteArray &&reason = QByteArrayLiteral("libsyncthing support not enabled"));
 
     SyncthingProcess m_process;
-    QFile m_logFile;
     QUrl m_guiListeningUrl;
 #if defined(SYNCTHINGWIDGETS_GUI_QTWIDGETS)
     const Settings::Launcher *m_lastLauncherSettings;
@@ -146,6 +154,7 @@ private:
 #ifdef SYNCTHINGWIDGETS_USE_LIBSYNCTHING
     QFutureWatcher<std::int64_t> m_startWatcher;
 #endif
+    SyncthingLogPipeline m_logPipeline;
     QByteArray m_outputBuffer;
     CppUtilities::BufferSearch m_guiListeningUrlSearch;
     CppUtilities::BufferSearch m_exitSearch;
@@ -163,13 +172,37 @@ private:
     static SyncthingLauncher *s_mainInstance;
 };
 
-/// \brief Returns the log file.
+/// \brief Returns whether the log file is currently open.
+inline bool SyncthingLauncher::isLogFileOpen() const
+{
+    return m_logPipeline.isLogFileOpen();
+}
+
+/// \brief Returns the name of the log file last passed to openLogFile().
+inline QString SyncthingLauncher::logFileName() const
+{
+    return m_logPipeline.logFileName();
+}
+
+/// \brief Opens the log file with the specified \a fileName for appending the output of Syncthing.
 /// \remarks
-/// - No log file is written by default. Open the QFile returned by this function to enable logging to this file.
-/// - You must not use the QFile object returned by this function while Syncthing is running.
-inline QFile &SyncthingLauncher::logFile()
+/// - No log file is written by default.
+/// - May be called at any time, also while Syncthing is running.
+inline bool SyncthingLauncher::openLogFile(const QString &fileName)
+{
+    return m_logPipeline.openLogFile(fileName);
+}
+
+/// \brief Closes the log file; the output of Syncthing is no longer written to a file from now on.
+inline void SyncthingLauncher::closeLogFile()
+{
+    m_logPipeline.closeLogFile();
+}
+
+/// \brief Removes the log file with the specified \a fileName, closing it first if it is currently open.
+inline bool SyncthingLauncher::removeLogFile(const QString &fileName)
 {
-    return m_logFile;
+    return m_logPipeline.removeLogFile(fileName);
 }
 
 /// \brief Returns whether Syncthing is running.
@@ -290,9 +323,10 @@ inline QString SyncthingLauncher::libSyncthingLogLevelString() const
 }
 
 /// \brief Sets the log level for the built-in Syncthing instance.
+/// \remarks Takes also effect for the log of a currently running instance.
 inline void SyncthingLauncher::setLibSyncthingLogLevel(LibSyncthing::LogLevel logLevel)
 {
-    m_libsyncthingLogLevel = logLevel;
+    m_logPipeline.setMinLevel(static_cast<int>(m_libsyncthingLogLevel = logLevel));
 }
 #endif
 
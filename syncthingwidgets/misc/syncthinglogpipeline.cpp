@@ -0,0 +1,293 @@
+#include "./syncthinglogpipeline.h"
+
+#include <QFile>
+#include <QMetaObject>
+#include <QObject>
+
+#include <utility>
+
+namespace Data {
+
+/*!
+ * \class SyncthingLogBatch
+ * \brief The SyncthingLogBatch struct holds log lines delivered by SyncthingLogPipeline at once.
+ *
+ * The \a data member contains all lines (e.g. to search for specific messages) while \a visibleData contains only the lines
+ * matching SyncthingLogPipeline::minLevel() at the time the lines have been processed.
+ */
+
+/*!
+ * \class SyncthingLogPipeline
+ * \brief The SyncthingLogPipeline class passes log lines from arbitrary threads to a log file and the GUI thread.
+ *
+ * The built-in Syncthing instance invokes its logging callback from the threads of the Go runtime, possibly concurrently and
+ * at a high rate when the debug log level is enabled. Writing each line synchronously to the log file and posting one event
+ * per line to the GUI thread does not scale for that. Hence this class:
+ *
+ * - accumulates lines appended via append() in a lock-free queue,
+ * - writes them to the log file from a dedicated writer thread, one buffered write and flush per batch, and
+ * - delivers them as SyncthingLogBatch to the batch handler within the thread of the context object. This happens at most
+ *   once per deliveryInterval() and never while the previous batch has not been handled yet. Lines arriving in the meantime
+ *   are combined into the next batch.
+ *
+ * \remarks
+ * - The pipeline is supposed to be a member of the context object. Batches still queued when the context object is destroyed
+ *   are discarded.
+ * - The log file is owned by the pipeline and written from the writer thread. Hence it must only be opened, closed and
+ *   removed via the functions of this class which may be called at any time (also while the pipeline is running).
+ */
+
+/// \cond
+SyncthingLogPipeline::Entry::Entry(int level, QByteArray &&line)
+    : next(nullptr)
+    , level(level)
+    , line(std::move(line))
+{
+}
+/// \endcond
+
+/*!
+ * \brief Constructs a new pipeline delivering batches to the specified \a batchHandler within the thread of \a context.
+ */
+SyncthingLogPipeline::SyncthingLogPipeline(QObject *context, BatchHandler &&batchHandler)
+    : m_context(context)
+    , m_batchHandler(std::move(batchHandler))
+    , m_entries(nullptr)
+    , m_minLevel(0)
+    , m_deliveryInterval(defaultDeliveryInterval)
+    , m_stopRequested(false)
+    , m_deliveryPending(false)
+{
+}
+
+/*!
+ * \brief Stops the writer thread discarding lines which have not been processed yet.
+ */
+SyncthingLogPipeline::~SyncthingLogPipeline()
+{
+    if (m_writer.joinable()) {
+        {
+            const auto lock = std::lock_guard<std::mutex>(m_writerMutex);
+            m_stopRequested = true;
+        }
+        m_writerCondVar.notify_one();
+        m_writer.join();
+    }
+    deleteEntries(takeEntries());
+}
+
+/*!
+ * \brief Returns whether the log file is currently open.
+ */
+bool SyncthingLogPipeline::isLogFileOpen() const
+{
+    const auto lock = std::lock_guard<std::mutex>(m_logFileMutex);
+    return m_logFile.isOpen();
+}
+
+/*!
+ * \brief Returns the name of the log file last passed to openLogFile().
+ */
+QString SyncthingLogPipeline::logFileName() const
+{
+    const auto lock = std::lock_guard<std::mutex>(m_logFileMutex);
+    return m_logFile.fileName();
+}
+
+/*!
+ * \brief Opens the log file with the specified \a fileName for appending, closing the previously opened log file.
+ * \remarks Lines processed from now on are written to the file.
+ * \returns Returns whether the file could be opened.
+ */
+bool SyncthingLogPipeline::openLogFile(const QString &fileName)
+{
+    const auto lock = std::lock_guard<std::mutex>(m_logFileMutex);
+    m_logFile.close();
+    m_logFile.setFileName(fileName);
+    return m_logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text);
+}
+
+/*!
+ * \brief Closes the log file; lines processed from now on are no longer written to a file.
+ */
+void SyncthingLogPipeline::closeLogFile()
+{
+    const auto lock = std::lock_guard<std::mutex>(m_logFileMutex);
+    m_logFile.close();
+}
+
+/*!
+ * \brief Removes the log file with the specified \a fileName, closing it first if it is currently open.
+ * \returns Returns whether the file has been removed or did not exist in the first place.
+ */
+bool SyncthingLogPipeline::removeLogFile(const QString &fileName)
+{
+    const auto lock = std::lock_guard<std::mutex>(m_logFileMutex);
+    if (m_logFile.fileName() == fileName) {
+        m_logFile.close();
+    }
+    return !QFile::exists(fileName) || QFile::remove(fileName);
+}
+
+/*!
+ * \brief Writes the specified \a data directly to the log file if it is open; may be called from any thread.
+ * \remarks This is meant for output which does not need to pass the pipeline, e.g. the output of an external process.
+ */
+void SyncthingLogPipeline::writeToLogFile(const QByteArray &data)
+{
+    const auto lock = std::lock_guard<std::mutex>(m_logFileMutex);
+    if (m_logFile.isOpen()) {
+        m_logFile.write(data);
+        m_logFile.flush();
+    }
+}
+
+/*!
+ * \brief Starts the writer thread.
+ * \remarks
+ * - Lines are written to the log file if one has been opened via openLogFile() and their level is at least minLevel().
+ * - Does nothing if the pipeline is already running.
+ */
+void SyncthingLogPipeline::start()
+{
+    if (m_writer.joinable()) {
+        return;
+    }
+    m_stopRequested = false;
+    m_writer = std::thread(&SyncthingLogPipeline::run, this);
+}
+
+/*!
+ * \brief Stops the writer thread after processing all lines appended so far.
+ * \remarks
+ * - Must be called from the thread of the context object. Remaining lines are delivered synchronously so they are handled
+ *   before this function returns.
+ * - Lines must no longer be appended when calling this function.
+ */
+void SyncthingLogPipeline::stop()
+{
+    if (m_writer.joinable()) {
+        {
+            const auto lock = std::lock_guard<std::mutex>(m_writerMutex);
+            m_stopRequested = true;
+        }
+        m_writerCondVar.notify_one();
+        m_writer.join();
+    }
+    processEntries(takeEntries());
+    deliver();
+}
+
+/*!
+ * \brief Appends the specified \a line with the specified \a level; may be called from any thread.
+ * \remarks This function does not block. It only needs to lock a mutex (to wake up the writer thread) if the queue was empty.
+ */
+void SyncthingLogPipeline::append(int level, QByteArray &&line)
+{
+    auto *const entry = new Entry(level, std::move(line));
+    auto *head = m_entries.load(std::memory_order_relaxed);
+    do {
+        entry->next = head;
+    } while (!m_entries.compare_exchange_weak(head, entry, std::memory_order_release, std::memory_order_relaxed));
+    if (!head) {
+        { const auto lock = std::lock_guard<std::mutex>(m_writerMutex); }
+        m_writerCondVar.notify_one();
+    }
+}
+
+/// \cond
+
+void SyncthingLogPipeline::run()
+{
+    auto lastProcessing = std::chrono::steady_clock::now() - m_deliveryInterval;
+    auto lock = std::unique_lock<std::mutex>(m_writerMutex);
+    for (;;) {
+        m_writerCondVar.wait(lock, [this] { return m_stopRequested || m_entries.load(std::memory_order_relaxed); });
+        // wait until the delivery interval has passed so further lines are accumulated in the meantime
+        m_writerCondVar.wait_until(lock, lastProcessing + m_deliveryInterval, [this] { return m_stopRequested; });
+        if (m_stopRequested) {
+            return; // remaining lines are processed by stop()
+        }
+        lock.unlock();
+        processEntries(takeEntries());
+        lastProcessing = std::chrono::steady_clock::now();
+        lock.lock();
+    }
+}
+
+/*!
+ * \brief Takes all queued entries returning them in the order they have been appended.
+ */
+SyncthingLogPipeline::Entry *SyncthingLogPipeline::takeEntries()
+{
+    auto *entries = m_entries.exchange(nullptr, std::memory_order_acquire);
+    auto *reversed = static_cast<Entry *>(nullptr);
+    while (entries) {
+        reversed = std::exchange(entries, std::exchange(entries->next, reversed));
+    }
+    return reversed;
+}
+
+/*!
+ * \brief Writes the specified \a entries to the log file, adds them to the pending batch and deletes them.
+ */
+void SyncthingLogPipeline::processEntries(Entry *entries)
+{
+    if (!entries) {
+        return;
+    }
+    auto batch = SyncthingLogBatch();
+    const auto minLevel = m_minLevel.load(std::memory_order_relaxed);
+    for (auto *entry = entries; entry; entry = entry->next) {
+        batch.data.append(entry->line);
+        if (entry->level >= minLevel) {
+            batch.visibleData.append(entry->line);
+        }
+        ++batch.lineCount;
+    }
+    deleteEntries(entries);
+    if (!batch.visibleData.isEmpty()) {
+        writeToLogFile(batch.visibleData);
+    }
+
+    {
+        const auto lock = std::lock_guard<std::mutex>(m_batchMutex);
+        if (m_batch.isEmpty()) {
+            m_batch = std::move(batch);
+        } else {
+            m_batch.data.append(batch.data);
+            m_batch.visibleData.append(batch.visibleData);
+            m_batch.lineCount += batch.lineCount;
+        }
+    }
+    if (!m_deliveryPending.exchange(true)) {
+        QMetaObject::invokeMethod(m_context, [this] { deliver(); }, Qt::QueuedConnection);
+    }
+}
+
+/*!
+ * \brief Passes the pending batch to the batch handler; invoked within the thread of the context object.
+ */
+void SyncthingLogPipeline::deliver()
+{
+    m_deliveryPending = false;
+    auto batch = SyncthingLogBatch();
+    {
+        const auto lock = std::lock_guard<std::mutex>(m_batchMutex);
+        std::swap(batch, m_batch);
+    }
+    if (!batch.isEmpty() && m_batchHandler) {
+        m_batchHandler(std::move(batch));
+    }
+}
+
+void SyncthingLogPipeline::deleteEntries(Entry *entries)
+{
+    while (entries) {
+        delete std::exchange(entries, entries->next);
+    }
+}
+
+/// \endcond
+
+} // namespace Data
@@ -0,0 +1,123 @@
+#ifndef SYNCTHINGWIDGETS_SYNCTHINGLOGPIPELINE_H
+#define SYNCTHINGWIDGETS_SYNCTHINGLOGPIPELINE_H
+
+#include "../global.h"
+
+#include <QByteArray>
+#include <QFile>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+QT_FORWARD_DECLARE_CLASS(QObject)
+
+namespace Data {
+
+struct SYNCTHINGWIDGETS_EXPORT SyncthingLogBatch {
+    QByteArray data;
+    QByteArray visibleData;
+    std::size_t lineCount = 0;
+    bool isEmpty() const;
+};
+
+/// \brief Returns whether the batch contains no lines.
+inline bool SyncthingLogBatch::isEmpty() const
+{
+    return !lineCount;
+}
+
+class SYNCTHINGWIDGETS_EXPORT SyncthingLogPipeline {
+public:
+    using BatchHandler = std::function<void(SyncthingLogBatch &&batch)>;
+    static constexpr auto defaultDeliveryInterval = std::chrono::milliseconds(100);
+
+    explicit SyncthingLogPipeline(QObject *context, BatchHandler &&batchHandler);
+    SyncthingLogPipeline(const SyncthingLogPipeline &) = delete;
+    SyncthingLogPipeline &operator=(const SyncthingLogPipeline &) = delete;
+    ~SyncthingLogPipeline();
+
+    bool isRunning() const;
+    std::chrono::milliseconds deliveryInterval() const;
+    void setDeliveryInterval(std::chrono::milliseconds deliveryInterval);
+    int minLevel() const;
+    void setMinLevel(int minLevel);
+    bool isLogFileOpen() const;
+    QString logFileName() const;
+    bool openLogFile(const QString &fileName);
+    void closeLogFile();
+    bool removeLogFile(const QString &fileName);
+    void writeToLogFile(const QByteArray &data);
+    void start();
+    void stop();
+    void append(int level, QByteArray &&line);
+
+private:
+    struct Entry {
+        explicit Entry(int level, QByteArray &&line);
+        Entry *next;
+        int level;
+        QByteArray line;
+    };
+
+    void run();
+    Entry *takeEntries();
+    void processEntries(Entry *entries);
+    void deliver();
+    static void deleteEntries(Entry *entries);
+
+    QObject *const m_context;
+    BatchHandler m_batchHandler;
+    std::atomic<Entry *> m_entries;
+    std::thread m_writer;
+    std::mutex m_writerMutex;
+    std::condition_variable m_writerCondVar;
+    mutable std::mutex m_logFileMutex;
+    QFile m_logFile;
+    std::atomic_int m_minLevel;
+    std::chrono::milliseconds m_deliveryInterval;
+    bool m_stopRequested;
+    std::mutex m_batchMutex;
+    SyncthingLogBatch m_batch;
+    std::atomic_bool m_deliveryPending;
+};
+
+/// \brief Returns whether the writer thread is running.
+inline bool SyncthingLogPipeline::isRunning() const
+{
+    return m_writer.joinable();
+}
+
+/// \brief Returns the minimum interval between two batches delivered to the batch handler.
+inline std::chrono::milliseconds SyncthingLogPipeline::deliveryInterval() const
+{
+    return m_deliveryInterval;
+}
+
+/// \brief Sets the minimum interval between two batches delivered to the batch handler.
+/// \remarks Takes only effect when the pipeline is started the next time.
+inline void SyncthingLogPipeline::setDeliveryInterval(std::chrono::milliseconds deliveryInterval)
+{
+    m_deliveryInterval = deliveryInterval;
+}
+
+/// \brief Returns the minimum level of lines to be written to the log file and to be included in SyncthingLogBatch::visibleData.
+inline int SyncthingLogPipeline::minLevel() const
+{
+    return m_minLevel.load(std::memory_order_relaxed);
+}
+
+/// \brief Sets the minimum level of lines to be written to the log file and to be included in SyncthingLogBatch::visibleData.
+/// \remarks May be called at any time; takes effect for the next batch.
+inline void SyncthingLogPipeline::setMinLevel(int minLevel)
+{
+    m_minLevel.store(minLevel, std::memory_order_relaxed);
+}
+
+} // namespace Data
+
+#endif // SYNCTHINGWIDGETS_SYNCTHINGLOGPIPELINE_H
@@ -22,6 +22,8 @@
 #include <QTextBrowser>
 #include <QVBoxLayout>
 
+#include <algorithm>
+
 using namespace std;
 using namespace std::placeholders;
 using namespace QtUtilities;
@@ -75,9 +77,13 @@ TextViewDialog *TextViewDialog::forLogEntries(SyncthingConnection &connection, Q
     }
     helpLabel->setWordWrap(true);
     helpLabel->setText(helpText);
-    QObject::connect(&connection, &SyncthingConnection::logAvailable, dlg, &TextViewDialog::showLogEntries);
-    connect(dlg, &TextViewDialog::reload, &connection, &SyncthingConnection::requestLog);
-    connection.requestLog();
+    // show entries retrieved so far and request only newer entries from Syncthing
+    const auto &logStore = connection.logStore();
+    dlg->appendLogEntries(logStore, logStore.beginIndex(), logStore.endIndex());
+    QObject::connect(&connection, &SyncthingConnection::logEntriesAppended, dlg,
+        [dlg, &logStore](std::size_t beginIndex, std::size_t endIndex) { dlg->appendLogEntries(logStore, beginIndex, endIndex); });
+    connect(dlg, &TextViewDialog::reload, &connection, &SyncthingConnection::requestNewLogEntries);
+    connection.requestNewLogEntries();
     dlg->layout()->addWidget(helpLabel);
     return dlg;
 }
@@ -121,4 +127,12 @@ void TextViewDialog::showLogEntries(const std::vector<SyncthingLogEntry> &logEnt
         browser()->append(entry.when % QChar(':') % QChar(' ') % QChar('\n') % entry.message % QChar('\n'));
     }
 }
+
+void TextViewDialog::appendLogEntries(const SyncthingLogStore &logStore, std::size_t beginIndex, std::size_t endIndex)
+{
+    for (auto index = std::max(beginIndex, logStore.beginIndex()), end = std::min(endIndex, logStore.endIndex()); index < end; ++index) {
+        const auto &entry = logStore.at(index);
+        browser()->append(entry.when % QChar(':') % QChar(' ') % QChar('\n') % entry.message % QChar('\n'));
+    }
+}
 } // namespace QtGui
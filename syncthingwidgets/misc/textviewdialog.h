@@ -5,6 +5,7 @@
 
 #include <QDialog>
 
+#include <cstddef>
 #include <functional>
 
 QT_FORWARD_DECLARE_CLASS(QTextBrowser)
@@ -14,6 +15,7 @@ namespace Data {
 class SyncthingConnection;
 struct SyncthingDir;
 struct SyncthingLogEntry;
+class SyncthingLogStore;
 } // namespace Data
 
 namespace QtGui {
@@ -39,6 +41,7 @@ protected:
 
 private:
     void showLogEntries(const std::vector<Data::SyncthingLogEntry> &logEntries);
+    void appendLogEntries(const Data::SyncthingLogStore &logStore, std::size_t beginIndex, std::size_t endIndex);
 
     QTextBrowser *m_browser;
     QVBoxLayout *m_layout;
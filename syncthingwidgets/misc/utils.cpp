@@ -17,6 +17,7 @@ void handleRelevantControlsChanged(bool visible, int tabIndex, Data::SyncthingCo
     CppUtilities::modFlagEnum(flags, Data::SyncthingConnection::PollingFlags::TrafficStatistics, visible);
     CppUtilities::modFlagEnum(flags, Data::SyncthingConnection::PollingFlags::DeviceStatistics, visible && tabIndex == 1);
     connection.setPollingFlags(flags);
+    connection.pollingScheduler()->setUiVisible(visible);
 }
 
 QString readmeUrl()
@@ -6,6 +6,10 @@
 
 #include <qtutilities/misc/compat.h>
 
+#include <QtConcurrentRun>
+
+#include <algorithm>
+
 #if defined(LIB_SYNCTHING_CONNECTOR_SUPPORT_SYSTEMD) && (defined(PLATFORM_UNIX) || defined(PLATFORM_MINGW) || defined(PLATFORM_CYGWIN))
 #define PLATFORM_HAS_GETLOGIN
 #include <unistd.h>
@@ -38,17 +42,34 @@ SetupDetection::SetupDetection(QObject *parent)
     timeout.setInterval(hasConfiguredTimeout ? configuredTimeout : 2500);
     timeout.setSingleShot(true);
 
+    // configure per-probe timeouts so a single slow probe (e.g. systemd not being available) does not hold up the detection
+    // note: Checking the systemd units may take as long as the overall timeout allows if systemd is available (see
+    //       handleSystemdAvailabilityChanged()) unless a timeout is configured explicitly. The other probes may take as long
+    //       as the overall timeout allows anyway.
+    auto hasConfiguredServiceTimeout = false;
+    const auto configuredServiceTimeout
+        = qEnvironmentVariableIntValue(PROJECT_VARNAME_UPPER "_WIZARD_SETUP_DETECTION_SERVICE_TIMEOUT", &hasConfiguredServiceTimeout);
+    setProbeTimeout(Probe::ServiceStatus, hasConfiguredServiceTimeout ? configuredServiceTimeout : std::min(timeout.interval(), 1000));
+    m_awaitingServiceStatusIfSystemdAvailable = !hasConfiguredServiceTimeout;
+    for (auto i = std::size_t(); i != probeCount; ++i) {
+        m_probeTimers[i].setSingleShot(true);
+        connect(&m_probeTimers[i], &QTimer::timeout, this, [this, i] { handleProbeTimeout(static_cast<Probe>(i)); });
+    }
+
     // connect signals & slots
     connect(&connection, &Data::SyncthingConnection::error, this, &SetupDetection::handleConnectionError);
     connect(&connection, &Data::SyncthingConnection::statusChanged, this, &SetupDetection::checkDone);
 #ifdef LIB_SYNCTHING_CONNECTOR_SUPPORT_SYSTEMD
     connect(&userService, &Data::SyncthingService::unitFileStateChanged, this, &SetupDetection::checkDone);
     connect(&systemService, &Data::SyncthingService::unitFileStateChanged, this, &SetupDetection::checkDone);
+    connect(&userService, &Data::SyncthingService::systemdAvailableChanged, this, &SetupDetection::handleSystemdAvailabilityChanged);
+    connect(&systemService, &Data::SyncthingService::systemdAvailableChanged, this, &SetupDetection::handleSystemdAvailabilityChanged);
 #endif
     connect(&launcher, &Data::SyncthingLauncher::outputAvailable, this, &SetupDetection::handleLauncherOutput);
     connect(&launcher, &Data::SyncthingLauncher::exited, this, &SetupDetection::handleLauncherExit);
     connect(&launcher, &Data::SyncthingLauncher::errorOccurred, this, &SetupDetection::handleLauncherError);
     connect(&timeout, &QTimer::timeout, this, &SetupDetection::handleTimeout);
+    connect(&m_configWatcher, &QFutureWatcher<ParsedConfig>::finished, this, &SetupDetection::handleConfigParsed);
 }
 
 void SetupDetection::determinePaths()
@@ -81,19 +102,108 @@ bool SetupDetection::hasConfig() const
     return configOk && !config.guiAddress.isEmpty() && !config.guiApiKey.isEmpty();
 }
 
+/*!
+ * \brief Returns whether the setup detection has been completed.
+ * \remarks
+ * This is the case when all probes have been finished/skipped/timed out, when the overall timeout has been exceeded or when
+ * there is enough information (see hasEnoughInformation()). In the latter case some probes might still be running and update
+ * the information later.
+ */
 bool SetupDetection::isDone() const
 {
-    return timedOut
-        || (!connection.isConnecting() && (launcherExitCode.has_value() || launcherError.has_value())
-#ifdef LIB_SYNCTHING_CONNECTOR_SUPPORT_SYSTEMD
-            && !userService.unitFileState().isEmpty() && !systemService.unitFileState().isEmpty()
-#endif
-        );
+    return m_done || timedOut || (m_testStarted && (areAllProbesSettled() || hasEnoughInformation()));
+}
+
+/*!
+ * \brief Returns whether enough information is available to complete the setup detection before all probes have been settled.
+ * \remarks
+ * If Syncthing is already running and reachable, the wizard only needs to know the state of the systemd units in addition.
+ * Whether Syncthing could be launched is then irrelevant so the binary version check need not be awaited.
+ */
+bool SetupDetection::hasEnoughInformation() const
+{
+    const auto serviceState = probeInfo(Probe::ServiceStatus).state;
+    return probeInfo(Probe::ApiConnection).state == ProbeState::Finished && connection.isConnected() && serviceState != ProbeState::Pending
+        && serviceState != ProbeState::Running;
+}
+
+/*!
+ * \brief Sets the \a timeout in milliseconds for the specified \a probe.
+ * \remarks
+ * - Set to 0 to only apply the overall timeout. Takes effect when the probe is started the next time.
+ * - By default, checking the systemd units times out after one second (or the environment variable
+ *   `SYNCTHINGTRAY_WIZARD_SETUP_DETECTION_SERVICE_TIMEOUT`) unless systemd is available in which case only the overall
+ *   timeout applies. Setting a timeout for Probe::ServiceStatus explicitly disables the latter.
+ */
+void SetupDetection::setProbeTimeout(Probe probe, int timeout)
+{
+    this->probe(probe).timeout = timeout;
+    if (probe == Probe::ServiceStatus) {
+        m_awaitingServiceStatusIfSystemdAvailable = false;
+    }
+}
+
+/*!
+ * \brief Returns a human-readable name for the specified \a probe.
+ */
+QString SetupDetection::probeName(Probe probe)
+{
+    switch (probe) {
+    case Probe::ConfigLocation:
+        return tr("Locating config file");
+    case Probe::ConfigParsing:
+        return tr("Parsing config file");
+    case Probe::ApiConnection:
+        return tr("Connecting to Syncthing API");
+    case Probe::ServiceStatus:
+        return tr("Checking systemd units");
+    case Probe::BinaryVersion:
+        return tr("Test-launching Syncthing");
+    }
+    return QString();
+}
+
+/*!
+ * \brief Returns a human-readable description of the state and timing of each probe, e.g. to diagnose slow environments.
+ */
+QStringList SetupDetection::probeTimings() const
+{
+    auto timings = QStringList();
+    timings.reserve(static_cast<QStringList::size_type>(probeCount));
+    for (auto i = std::size_t(); i != probeCount; ++i) {
+        const auto &info = m_probes[i];
+        const auto name = probeName(static_cast<Probe>(i));
+        switch (info.state) {
+        case ProbeState::Pending:
+            timings << tr("%1: not started").arg(name);
+            break;
+        case ProbeState::Running:
+            timings << tr("%1: still running (started after %2 ms)").arg(name).arg(info.startTime);
+            break;
+        case ProbeState::Finished:
+            timings << tr("%1: finished after %2 ms (started after %3 ms)").arg(name).arg(info.duration).arg(info.startTime);
+            break;
+        case ProbeState::Skipped:
+            timings << tr("%1: skipped").arg(name);
+            break;
+        case ProbeState::TimedOut:
+            timings << tr("%1: timed out after %2 ms (started after %3 ms)").arg(name).arg(info.duration).arg(info.startTime);
+            break;
+        }
+    }
+    return timings;
 }
 
 void SetupDetection::reset()
 {
     timeout.stop();
+    for (auto &probeTimer : m_probeTimers) {
+        probeTimer.stop();
+    }
+    for (auto &info : m_probes) {
+        info.state = ProbeState::Pending;
+        info.startTime = info.duration = -1;
+    }
     timedOut = false;
     configOk = false;
     autostartEnabled = false;
@@ -108,22 +218,60 @@ void SetupDetection::reset()
     launcherError.reset();
     launcherOutput.clear();
     m_testStarted = false;
+    m_done = false;
 }
 
+/*!
+ * \brief Starts the setup detection; done() is emitted when isDone() returns true.
+ * \remarks
+ * The probes are started as soon as their dependencies are available: The systemd unit check and the test-launch of
+ * Syncthing start immediately. The config file is parsed in the background and the API connection is established as soon
+ * as the config has been parsed.
+ */
 void SetupDetection::startTest()
 {
     if (m_testStarted) {
         return;
     }
     m_testStarted = true;
-    restoreConfig();
-    initConnection();
-    connection.reconnect();
+    m_done = false;
+    m_elapsedTime.start();
+    timeout.start();
+
+    // start independent probes
+    startProbe(Probe::ServiceStatus);
+#ifdef LIB_SYNCTHING_CONNECTOR_SUPPORT_SYSTEMD
+    handleSystemdAvailabilityChanged();
+#else
+    settleProbe(Probe::ServiceStatus, ProbeState::Skipped);
+#endif
+    startProbe(Probe::BinaryVersion);
     launcher.launch(launcherSettings);
     autostartConfiguredPath = configuredAutostartPath();
     autostartEnabled = autostartConfiguredPath.has_value() ? !autostartConfiguredPath.value().isEmpty() : isAutostartEnabled();
     autostartSupposedPath = supposedAutostartPath();
-    timeout.start();
+
+    // locate config file unless already done (the path might also have been selected manually)
+    startProbe(Probe::ConfigLocation);
+    if (configFilePath.isEmpty()) {
+        determinePaths();
+    }
+    settleProbe(Probe::ConfigLocation, ProbeState::Finished);
+
+    // parse config file in the background; the API connection is initialized in handleConfigParsed()
+    if (configFilePath.isEmpty()) {
+        settleProbe(Probe::ConfigParsing, ProbeState::Skipped);
+        initConnection();
+        settleProbe(Probe::ApiConnection, ProbeState::Skipped);
+    } else {
+        startProbe(Probe::ConfigParsing);
+        m_configWatcher.setFuture(QtConcurrent::run([path = configFilePath] {
+            auto parsedConfig = ParsedConfig();
+            parsedConfig.first = parsedConfig.second.restore(path);
+            return parsedConfig;
+        }));
+    }
+    checkDone();
 }
 
 void SetupDetection::handleConnectionError(const QString &error)
@@ -155,16 +303,109 @@ void SetupDetection::handleTimeout()
     checkDone();
 }
 
+/*!
+ * \brief Keeps waiting for the systemd units to be checked until the overall timeout is exceeded if systemd is available.
+ * \remarks Querying the units might take a while, e.g. when the system is under load. So the shorter per-probe timeout is
+ *          only supposed to prevent waiting for systemd when it is not available at all.
+ */
+void SetupDetection::handleSystemdAvailabilityChanged()
+{
+#ifdef LIB_SYNCTHING_CONNECTOR_SUPPORT_SYSTEMD
+    if (m_awaitingServiceStatusIfSystemdAvailable && isProbeRunning(Probe::ServiceStatus)
+        && (userService.isSystemdAvailable() || systemService.isSystemdAvailable())) {
+        m_probeTimers[static_cast<std::size_t>(Probe::ServiceStatus)].stop();
+    }
+#endif
+}
+
+void SetupDetection::handleConfigParsed()
+{
+    if (!isProbeRunning(Probe::ConfigParsing)) {
+        return; // the result is not relevant anymore, e.g. due to a timeout or reset
+    }
+    auto parsedConfig = m_configWatcher.result();
+    configOk = parsedConfig.first;
+    config = std::move(parsedConfig.second);
+    settleProbe(Probe::ConfigParsing, ProbeState::Finished);
+
+    // connect to the API if the config contains the required information
+    initConnection();
+    if (hasConfig()) {
+        startProbe(Probe::ApiConnection);
+        connection.reconnect();
+    } else {
+        settleProbe(Probe::ApiConnection, ProbeState::Skipped);
+    }
+    checkDone();
+}
+
 void SetupDetection::checkDone()
 {
     if (!m_testStarted) {
         return;
     }
+
+    // settle probes which have been concluded
+    if (isProbeRunning(Probe::ApiConnection) && !connection.isConnecting()) {
+        settleProbe(Probe::ApiConnection, ProbeState::Finished);
+    }
+#ifdef LIB_SYNCTHING_CONNECTOR_SUPPORT_SYSTEMD
+    if (isProbeRunning(Probe::ServiceStatus) && !userService.unitFileState().isEmpty() && !systemService.unitFileState().isEmpty()) {
+        settleProbe(Probe::ServiceStatus, ProbeState::Finished);
+    }
+#endif
+    if (isProbeRunning(Probe::BinaryVersion) && (launcherExitCode.has_value() || launcherError.has_value())) {
+        settleProbe(Probe::BinaryVersion, ProbeState::Finished);
+    }
+
     if (isDone()) {
         timeout.stop();
         m_testStarted = false;
+        m_done = true;
         emit done();
     }
 }
 
+/// \cond
+bool SetupDetection::areAllProbesSettled() const
+{
+    return std::none_of(m_probes.cbegin(), m_probes.cend(),
+        [](const ProbeInfo &info) { return info.state == ProbeState::Pending || info.state == ProbeState::Running; });
+}
+
+void SetupDetection::startProbe(Probe probe)
+{
+    auto &info = this->probe(probe);
+    info.state = ProbeState::Running;
+    info.startTime = m_elapsedTime.elapsed();
+    info.duration = -1;
+    if (info.timeout > 0) {
+        m_probeTimers[static_cast<std::size_t>(probe)].start(info.timeout);
+    }
+}
+
+void SetupDetection::settleProbe(Probe probe, ProbeState state)
+{
+    auto &info = this->probe(probe);
+    if (state != ProbeState::Skipped) {
+        info.duration = m_elapsedTime.elapsed() - info.startTime;
+    }
+    info.state = state;
+    m_probeTimers[static_cast<std::size_t>(probe)].stop();
+}
+
+void SetupDetection::handleProbeTimeout(Probe probe)
+{
+    if (!m_testStarted || !isProbeRunning(probe)) {
+        return;
+    }
+    settleProbe(probe, ProbeState::TimedOut);
+    if (probe == Probe::ConfigParsing) {
+        initConnection();
+        settleProbe(Probe::ApiConnection, ProbeState::Skipped);
+    }
+    checkDone();
+}
+/// \endcond
+
 } // namespace QtGui
@@ -12,10 +12,14 @@
 #include <syncthingconnector/syncthingservice.h>
 
 #include <QByteArray>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
 #include <QStringBuilder>
 #include <QTimer>
 
+#include <array>
 #include <optional>
+#include <utility>
 
 namespace QtGui {
 
@@ -23,9 +27,29 @@ class SYNCTHINGWIDGETS_EXPORT SetupDetection : public QObject {
     Q_OBJECT
 
 public:
+    /// \brief The Probe enum specifies the individual checks setup detection consists of.
+    /// \remarks ConfigParsing depends on ConfigLocation and ApiConnection depends on ConfigParsing. The other probes run
+    ///          concurrently from the start.
+    enum class Probe { ConfigLocation, ConfigParsing, ApiConnection, ServiceStatus, BinaryVersion };
+    static constexpr std::size_t probeCount = 5;
+    /// \brief The ProbeState enum specifies the state of a probe.
+    enum class ProbeState { Pending, Running, Finished, Skipped, TimedOut };
+    /// \brief The ProbeInfo struct holds the state and timing of a probe.
+    struct ProbeInfo {
+        ProbeState state = ProbeState::Pending;
+        qint64 startTime = -1; /**< start time in milliseconds relative to the start of the test */
+        qint64 duration = -1; /**< duration in milliseconds (only set when the probe has been finished or timed out) */
+        int timeout = 0; /**< timeout in milliseconds; 0 means there is only the overall timeout */
+    };
+
     explicit SetupDetection(QObject *parent = nullptr);
     bool hasConfig() const;
     bool isDone() const;
+    bool hasEnoughInformation() const;
+    const ProbeInfo &probeInfo(Probe probe) const;
+    void setProbeTimeout(Probe probe, int timeout);
+    static QString probeName(Probe probe);
+    QStringList probeTimings() const;
 
 public Q_SLOTS:
     void determinePaths();
@@ -43,6 +67,8 @@ private Q_SLOTS:
     void handleLauncherError(QProcess::ProcessError error);
     void handleLauncherOutput(const QByteArray &output);
     void handleTimeout();
+    void handleSystemdAvailabilityChanged();
+    void handleConfigParsed();
     void checkDone();
 
 public:
@@ -70,9 +96,43 @@ public:
     QString autostartSupposedPath;
 
 private:
+    using ParsedConfig = std::pair<bool, Data::SyncthingConfig>;
+    ProbeInfo &probe(Probe probe);
+    bool isProbeRunning(Probe probe) const;
+    bool areAllProbesSettled() const;
+    void startProbe(Probe probe);
+    void settleProbe(Probe probe, ProbeState state);
+    void handleProbeTimeout(Probe probe);
+
+    std::array<ProbeInfo, probeCount> m_probes;
+    std::array<QTimer, probeCount> m_probeTimers;
+    QElapsedTimer m_elapsedTime;
+    QFutureWatcher<ParsedConfig> m_configWatcher;
     bool m_testStarted = false;
+    bool m_done = false;
+    bool m_awaitingServiceStatusIfSystemdAvailable = true;
 };
 
+/*!
+ * \brief Returns the state and timing of the specified \a probe.
+ */
+inline const SetupDetection::ProbeInfo &SetupDetection::probeInfo(Probe probe) const
+{
+    return m_probes[static_cast<std::size_t>(probe)];
+}
+
+/// \cond
+inline SetupDetection::ProbeInfo &SetupDetection::probe(Probe probe)
+{
+    return m_probes[static_cast<std::size_t>(probe)];
+}
+
+inline bool SetupDetection::isProbeRunning(Probe probe) const
+{
+    return probeInfo(probe).state == ProbeState::Running;
+}
+/// \endcond
+
 } // namespace QtGui
 
 #endif // SETTINGS_SETUP_DETECTION_H
@@ -326,6 +326,10 @@ void Wizard::showDetailsFromSetupDetection()
     addList(infoItems);
 #endif
 
+    // add timing of the individual probes
+    addParagraph(tr("Setup detection:"));
+    addListRo(detection.probeTimings());
+
     // show info in dialog
     auto dlg = QDialog(this);
     dlg.setWindowFlags(Qt::Tool);
@@ -0,0 +1,140 @@
+#include "../misc/filecopier.h"
+
+#include <QtTest/QtTest>
+
+#include <QTemporaryDir>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+
+using namespace QtGui;
+
+class FileCopierTests : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init();
+    void testCopying();
+    void testCancelingAndResuming();
+
+private:
+    static void writeFile(const std::filesystem::path &path, const std::string &contents);
+    static std::string readFile(const std::filesystem::path &path);
+
+    std::optional<QTemporaryDir> m_tempDir;
+    std::filesystem::path m_source;
+    std::filesystem::path m_destination;
+};
+
+void FileCopierTests::writeFile(const std::filesystem::path &path, const std::string &contents)
+{
+    std::filesystem::create_directories(path.parent_path());
+    auto file = std::ofstream(path, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+    file << contents;
+}
+
+std::string FileCopierTests::readFile(const std::filesystem::path &path)
+{
+    auto file = std::ifstream(path, std::ios_base::in | std::ios_base::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+/*!
+ * \brief Creates a source tree with files of different sizes in a new temporary directory.
+ */
+void FileCopierTests::init()
+{
+    m_tempDir.emplace();
+    QVERIFY(m_tempDir->isValid());
+    const auto root = std::filesystem::path(m_tempDir->path().toStdU16String());
+    m_source = root / "source";
+    m_destination = root / "destination";
+    writeFile(m_source / "a.txt", "foo");
+    writeFile(m_source / "sub" / "b.txt", "barbaz");
+    writeFile(m_source / "sub" / "deeper" / "c.bin", std::string(1024 * 1024 + 3, 'x'));
+    std::filesystem::create_directories(m_source / "empty");
+}
+
+/*!
+ * \brief Tests copying trees including files reachable via multiple trees.
+ */
+void FileCopierTests::testCopying()
+{
+#ifndef Q_OS_WINDOWS
+    std::filesystem::create_symlink("a.txt", m_source / "link");
+#endif
+
+    // add a nested tree separately as well; its files must only be copied and counted once
+    auto copier = FileCopier(2);
+    copier.addTree(m_source, m_destination);
+    copier.addTree(m_source / "sub", m_destination / "sub");
+    QVERIFY(copier.run());
+    QVERIFY(!copier.isCanceled());
+    QCOMPARE(copier.filesTotal(), std::uint64_t(3));
+    QCOMPARE(copier.filesCopied(), std::uint64_t(3));
+    QCOMPARE(copier.filesSkipped(), std::uint64_t(0));
+    QCOMPARE(copier.bytesTotal(), std::uint64_t(3 + 6 + 1024 * 1024 + 3));
+    QCOMPARE(copier.bytesCopied(), copier.bytesTotal());
+
+    // contents, modification times and the directory structure are preserved
+    for (const auto *const file : { "a.txt", "sub/b.txt", "sub/deeper/c.bin" }) {
+        QCOMPARE(readFile(m_destination / file), readFile(m_source / file));
+        QVERIFY(std::filesystem::last_write_time(m_destination / file) == std::filesystem::last_write_time(m_source / file));
+    }
+    QVERIFY(std::filesystem::is_directory(m_destination / "empty"));
+#ifndef Q_OS_WINDOWS
+    QVERIFY(std::filesystem::is_symlink(m_destination / "link"));
+    QCOMPARE(std::filesystem::read_symlink(m_destination / "link"), std::filesystem::path("a.txt"));
+#endif
+
+    // the copy is complete so it is not resumable
+    QVERIFY(!FileCopier::isResumable(m_source, m_destination));
+    QVERIFY(!FileCopier::isResumable(m_source / "sub", m_destination / "sub"));
+}
+
+/*!
+ * \brief Tests that a canceled copy can be resumed, skipping only files with the same size and modification time.
+ */
+void FileCopierTests::testCancelingAndResuming()
+{
+    // cancel the copy; a marker for the source is left so the destination can be resumed
+    auto canceledCopier = FileCopier();
+    canceledCopier.addTree(m_source, m_destination);
+    canceledCopier.cancel();
+    QVERIFY(!canceledCopier.run());
+    QVERIFY(canceledCopier.isCanceled());
+    QVERIFY(FileCopier::isResumable(m_source, m_destination));
+    QVERIFY(!FileCopier::isResumable(m_source / "sub", m_destination));
+
+    // prepare the destination as if some files had been copied before
+    // note: a.txt has the same size and modification time (but different contents to detect whether it is skipped), b.txt
+    //       has the same size but a different modification time and c.bin has the same modification time but a different size
+    writeFile(m_destination / "a.txt", "FOO");
+    std::filesystem::last_write_time(m_destination / "a.txt", std::filesystem::last_write_time(m_source / "a.txt"));
+    writeFile(m_destination / "sub" / "b.txt", "BARBAZ");
+    std::filesystem::last_write_time(
+        m_destination / "sub" / "b.txt", std::filesystem::last_write_time(m_source / "sub" / "b.txt") - std::chrono::hours(1));
+    writeFile(m_destination / "sub" / "deeper" / "c.bin", "incomplete");
+    std::filesystem::last_write_time(
+        m_destination / "sub" / "deeper" / "c.bin", std::filesystem::last_write_time(m_source / "sub" / "deeper" / "c.bin"));
+
+    // resume the copy
+    auto copier = FileCopier();
+    copier.addTree(m_source, m_destination);
+    QVERIFY(copier.run());
+    QCOMPARE(copier.filesTotal(), std::uint64_t(3));
+    QCOMPARE(copier.filesCopied(), std::uint64_t(3));
+    QCOMPARE(copier.filesSkipped(), std::uint64_t(1));
+    QCOMPARE(copier.bytesCopied(), copier.bytesTotal());
+    QCOMPARE(readFile(m_destination / "a.txt"), std::string("FOO"));
+    QCOMPARE(readFile(m_destination / "sub" / "b.txt"), std::string("barbaz"));
+    QCOMPARE(readFile(m_destination / "sub" / "deeper" / "c.bin"), readFile(m_source / "sub" / "deeper" / "c.bin"));
+    QVERIFY(!FileCopier::isResumable(m_source, m_destination));
+}
+
+QTEST_GUILESS_MAIN(FileCopierTests)
+#include "filecopier.moc"
@@ -0,0 +1,194 @@
+#include "../misc/syncthinglogpipeline.h"
+
+#include <QtTest/QtTest>
+
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <thread>
+#include <vector>
+
+using namespace Data;
+
+class LogPipelineTests : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init();
+    void testBatching();
+    void testLevelFiltering();
+    void testLogFile();
+
+private:
+    std::size_t lineCount() const;
+    QByteArray joinedData() const;
+    QByteArray joinedVisibleData() const;
+
+    std::vector<SyncthingLogBatch> m_batches;
+};
+
+void LogPipelineTests::init()
+{
+    m_batches.clear();
+}
+
+std::size_t LogPipelineTests::lineCount() const
+{
+    auto lineCount = std::size_t();
+    for (const auto &batch : m_batches) {
+        lineCount += batch.lineCount;
+    }
+    return lineCount;
+}
+
+QByteArray LogPipelineTests::joinedData() const
+{
+    auto data = QByteArray();
+    for (const auto &batch : m_batches) {
+        data.append(batch.data);
+    }
+    return data;
+}
+
+QByteArray LogPipelineTests::joinedVisibleData() const
+{
+    auto data = QByteArray();
+    for (const auto &batch : m_batches) {
+        data.append(batch.visibleData);
+    }
+    return data;
+}
+
+/*!
+ * \brief Tests that lines are combined into batches and delivered in order.
+ */
+void LogPipelineTests::testBatching()
+{
+    auto context = QObject(); // discards batches still queued when the pipeline goes out of scope
+    auto pipeline = SyncthingLogPipeline(&context, [this](SyncthingLogBatch &&batch) { m_batches.emplace_back(std::move(batch)); });
+    pipeline.setDeliveryInterval(std::chrono::milliseconds(10));
+
+    // lines appended before starting the pipeline are processed at once
+    pipeline.append(2, QByteArrayLiteral("foo\n"));
+    pipeline.append(2, QByteArrayLiteral("bar\n"));
+    pipeline.append(2, QByteArrayLiteral("baz\n"));
+    pipeline.start();
+    QVERIFY(pipeline.isRunning());
+    QTRY_COMPARE(m_batches.size(), std::size_t(1));
+    QCOMPARE(m_batches.front().lineCount, std::size_t(3));
+    QCOMPARE(m_batches.front().data, QByteArrayLiteral("foo\nbar\nbaz\n"));
+    QCOMPARE(m_batches.front().visibleData, m_batches.front().data);
+
+    // lines appended from other threads are delivered within the thread of the context object; stopping delivers remaining lines
+    auto threads = std::vector<std::thread>();
+    for (auto i = 0; i != 4; ++i) {
+        threads.emplace_back([&pipeline, i] {
+            for (auto j = 0; j != 25; ++j) {
+                pipeline.append(2, QByteArray::number(i) + QByteArrayLiteral("\n"));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    pipeline.stop();
+    QVERIFY(!pipeline.isRunning());
+    for (const auto &batch : m_batches) {
+        QVERIFY(!batch.isEmpty());
+    }
+    QCOMPARE(lineCount(), std::size_t(103));
+    const auto data = joinedVisibleData();
+    QVERIFY(data.startsWith(QByteArrayLiteral("foo\nbar\nbaz\n")));
+    for (auto i = 0; i != 4; ++i) {
+        QVERIFY(data.count(QByteArray::number(i) + QByteArrayLiteral("\n")) == 25);
+    }
+}
+
+/*!
+ * \brief Tests that only lines with at least the minimum level end up in the visible data and that the level can be changed
+ *        while the pipeline is running.
+ */
+void LogPipelineTests::testLevelFiltering()
+{
+    auto context = QObject();
+    auto pipeline = SyncthingLogPipeline(&context, [this](SyncthingLogBatch &&batch) { m_batches.emplace_back(std::move(batch)); });
+    pipeline.setDeliveryInterval(std::chrono::milliseconds(10));
+    pipeline.setMinLevel(2);
+    pipeline.start();
+
+    pipeline.append(1, QByteArrayLiteral("verbose\n"));
+    pipeline.append(2, QByteArrayLiteral("info\n"));
+    pipeline.append(3, QByteArrayLiteral("warning\n"));
+    QTRY_COMPARE(lineCount(), std::size_t(3));
+    QCOMPARE(joinedData(), QByteArrayLiteral("verbose\ninfo\nwarning\n"));
+    QCOMPARE(joinedVisibleData(), QByteArrayLiteral("info\nwarning\n"));
+
+    pipeline.setMinLevel(3);
+    QCOMPARE(pipeline.minLevel(), 3);
+    pipeline.append(2, QByteArrayLiteral("info\n"));
+    pipeline.append(3, QByteArrayLiteral("warning\n"));
+    QTRY_COMPARE(lineCount(), std::size_t(5));
+    QCOMPARE(joinedData(), QByteArrayLiteral("verbose\ninfo\nwarning\ninfo\nwarning\n"));
+    QCOMPARE(joinedVisibleData(), QByteArrayLiteral("info\nwarning\nwarning\n"));
+
+    // a batch without visible lines is still delivered as the whole data is needed to search the output
+    const auto batchCount = m_batches.size();
+    pipeline.append(1, QByteArrayLiteral("verbose\n"));
+    pipeline.stop();
+    QCOMPARE(m_batches.size(), batchCount + 1);
+    QCOMPARE(m_batches.back().lineCount, std::size_t(1));
+    QVERIFY(m_batches.back().visibleData.isEmpty());
+}
+
+/*!
+ * \brief Tests that visible lines are written to the log file which can be opened, closed and removed while the pipeline
+ *        is running.
+ */
+void LogPipelineTests::testLogFile()
+{
+    auto tempDir = QTemporaryDir();
+    QVERIFY(tempDir.isValid());
+    const auto logFilePath = tempDir.filePath(QStringLiteral("syncthing.log"));
+    auto context = QObject();
+    auto pipeline = SyncthingLogPipeline(&context, [this](SyncthingLogBatch &&batch) { m_batches.emplace_back(std::move(batch)); });
+    pipeline.setDeliveryInterval(std::chrono::milliseconds(10));
+    pipeline.setMinLevel(2);
+    pipeline.start();
+
+    // lines are not written as long as no log file is open
+    QVERIFY(!pipeline.isLogFileOpen());
+    pipeline.append(2, QByteArrayLiteral("not logged\n"));
+    QTRY_COMPARE(lineCount(), std::size_t(1));
+    QVERIFY(!QFile::exists(logFilePath));
+
+    // lines are written once the log file has been opened, also when it is opened while the pipeline is running
+    QVERIFY(pipeline.openLogFile(logFilePath));
+    QVERIFY(pipeline.isLogFileOpen());
+    QCOMPARE(pipeline.logFileName(), logFilePath);
+    pipeline.append(2, QByteArrayLiteral("logged\n"));
+    pipeline.append(1, QByteArrayLiteral("filtered\n"));
+    QTRY_COMPARE(lineCount(), std::size_t(3));
+    pipeline.writeToLogFile(QByteArrayLiteral("written directly\n"));
+
+    // lines are no longer written after closing the log file
+    pipeline.closeLogFile();
+    QVERIFY(!pipeline.isLogFileOpen());
+    pipeline.append(3, QByteArrayLiteral("after close\n"));
+    pipeline.stop();
+    QCOMPARE(lineCount(), std::size_t(4));
+
+    auto logFile = QFile(logFilePath);
+    QVERIFY(logFile.open(QIODevice::ReadOnly | QIODevice::Text));
+    QCOMPARE(logFile.readAll(), QByteArrayLiteral("logged\nwritten directly\n"));
+    logFile.close();
+
+    // removing the log file closes it if it is currently open
+    QVERIFY(pipeline.openLogFile(logFilePath));
+    QVERIFY(pipeline.removeLogFile(logFilePath));
+    QVERIFY(!pipeline.isLogFileOpen());
+    QVERIFY(!QFile::exists(logFilePath));
+    QVERIFY(pipeline.removeLogFile(logFilePath));
+}
+
+QTEST_GUILESS_MAIN(LogPipelineTests)
+#include "logpipeline.moc"
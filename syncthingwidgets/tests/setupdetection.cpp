@@ -0,0 +1,151 @@
+#include "../settings/setupdetection.h"
+
+// use meta-data of syncthingtray application here
+#include "resources/../../tray/resources/config.h"
+
+#include <QtTest/QtTest>
+
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+
+#include <optional>
+
+using namespace QtGui;
+
+class SetupDetectionTests : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init();
+    void testProbeTimeouts();
+    void testEarlyCompletion();
+    void testProbeTimeoutSettling();
+
+private:
+    void prepare(SetupDetection &detection);
+
+    std::optional<QTemporaryDir> m_tempDir;
+};
+
+void SetupDetectionTests::init()
+{
+    m_tempDir.emplace();
+    QVERIFY(m_tempDir->isValid());
+}
+
+/*!
+ * \brief Configures \a detection to use a non-existent config file and a long overall timeout.
+ */
+void SetupDetectionTests::prepare(SetupDetection &detection)
+{
+    detection.configFilePath = m_tempDir->filePath(QStringLiteral("config.xml"));
+    detection.launcherSettings.useLibSyncthing = false;
+    detection.launcherSettings.syncthingPath.clear();
+    detection.timeout.setInterval(10000);
+}
+
+/*!
+ * \brief Tests the default timeout for checking the systemd units and overriding it via the environment.
+ */
+void SetupDetectionTests::testProbeTimeouts()
+{
+    qunsetenv(PROJECT_VARNAME_UPPER "_WIZARD_SETUP_DETECTION_SERVICE_TIMEOUT");
+    qputenv(PROJECT_VARNAME_UPPER "_WIZARD_SETUP_DETECTION_TIMEOUT", "500");
+    {
+        auto detection = SetupDetection();
+        QCOMPARE(detection.timeout.interval(), 500);
+        QCOMPARE(detection.probeInfo(SetupDetection::Probe::ServiceStatus).timeout, 500);
+        QCOMPARE(detection.probeInfo(SetupDetection::Probe::BinaryVersion).timeout, 0);
+    }
+    qunsetenv(PROJECT_VARNAME_UPPER "_WIZARD_SETUP_DETECTION_TIMEOUT");
+    {
+        auto detection = SetupDetection();
+        QCOMPARE(detection.timeout.interval(), 2500);
+        QCOMPARE(detection.probeInfo(SetupDetection::Probe::ServiceStatus).timeout, 1000);
+    }
+    qputenv(PROJECT_VARNAME_UPPER "_WIZARD_SETUP_DETECTION_SERVICE_TIMEOUT", "123");
+    {
+        auto detection = SetupDetection();
+        QCOMPARE(detection.probeInfo(SetupDetection::Probe::ServiceStatus).timeout, 123);
+    }
+    qunsetenv(PROJECT_VARNAME_UPPER "_WIZARD_SETUP_DETECTION_SERVICE_TIMEOUT");
+}
+
+/*!
+ * \brief Tests that the detection is done before the overall timeout once all probes have been settled.
+ */
+void SetupDetectionTests::testEarlyCompletion()
+{
+    auto detection = SetupDetection();
+    prepare(detection);
+#ifdef LIB_SYNCTHING_CONNECTOR_SUPPORT_SYSTEMD
+    // don't wait for the systemd units which might not be present in the test environment
+    detection.setProbeTimeout(SetupDetection::Probe::ServiceStatus, 100);
+#endif
+
+    QSignalSpy doneSpy(&detection, &SetupDetection::done);
+    detection.startTest();
+    QVERIFY(doneSpy.wait(5000) || doneSpy.count() == 1);
+    QVERIFY(detection.isDone());
+    QVERIFY(!detection.timedOut);
+    QVERIFY(!detection.timeout.isActive());
+
+    // launching Syncthing failed as no executable is configured
+    QCOMPARE(detection.probeInfo(SetupDetection::Probe::BinaryVersion).state, SetupDetection::ProbeState::Finished);
+    QVERIFY(detection.launcherError.has_value());
+    QVERIFY(!detection.launcherExitCode.has_value());
+
+    // the config file has been parsed (unsuccessfully) so there is no API connection to test
+    QCOMPARE(detection.probeInfo(SetupDetection::Probe::ConfigLocation).state, SetupDetection::ProbeState::Finished);
+    QCOMPARE(detection.probeInfo(SetupDetection::Probe::ConfigParsing).state, SetupDetection::ProbeState::Finished);
+    QCOMPARE(detection.probeInfo(SetupDetection::Probe::ApiConnection).state, SetupDetection::ProbeState::Skipped);
+    QVERIFY(!detection.configOk);
+    QVERIFY(!detection.hasConfig());
+
+#ifndef LIB_SYNCTHING_CONNECTOR_SUPPORT_SYSTEMD
+    QCOMPARE(detection.probeInfo(SetupDetection::Probe::ServiceStatus).state, SetupDetection::ProbeState::Skipped);
+#else
+    const auto serviceState = detection.probeInfo(SetupDetection::Probe::ServiceStatus).state;
+    QVERIFY(serviceState == SetupDetection::ProbeState::Finished || serviceState == SetupDetection::ProbeState::TimedOut);
+#endif
+    QCOMPARE(doneSpy.count(), 1);
+}
+
+/*!
+ * \brief Tests that a probe exceeding its own timeout is settled as timed out without waiting for the overall timeout.
+ */
+void SetupDetectionTests::testProbeTimeoutSettling()
+{
+    const auto sleepPath = QStandardPaths::findExecutable(QStringLiteral("sleep"));
+    if (sleepPath.isEmpty()) {
+        QSKIP("The sleep executable is required to simulate a hanging Syncthing binary.");
+    }
+
+    auto detection = SetupDetection();
+    prepare(detection);
+    detection.launcherSettings.syncthingPath = sleepPath;
+    detection.launcherSettings.syncthingArgs = QStringLiteral("10");
+    detection.setProbeTimeout(SetupDetection::Probe::BinaryVersion, 50);
+#ifdef LIB_SYNCTHING_CONNECTOR_SUPPORT_SYSTEMD
+    detection.setProbeTimeout(SetupDetection::Probe::ServiceStatus, 50);
+#endif
+
+    QSignalSpy doneSpy(&detection, &SetupDetection::done);
+    detection.startTest();
+    QVERIFY(doneSpy.wait(5000) || doneSpy.count() == 1);
+    QVERIFY(!detection.timedOut);
+
+    const auto &binaryVersion = detection.probeInfo(SetupDetection::Probe::BinaryVersion);
+    QCOMPARE(binaryVersion.state, SetupDetection::ProbeState::TimedOut);
+    QVERIFY(binaryVersion.duration >= 50);
+    QVERIFY(!detection.launcherExitCode.has_value());
+    QVERIFY(!detection.launcherError.has_value());
+    QVERIFY(!detection.probeTimings().isEmpty());
+
+    detection.reset();
+    QCOMPARE(detection.probeInfo(SetupDetection::Probe::BinaryVersion).state, SetupDetection::ProbeState::Pending);
+}
+
+QTEST_MAIN(SetupDetectionTests)
+#include "setupdetection.moc"
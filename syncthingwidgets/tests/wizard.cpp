@@ -215,6 +215,7 @@ void WizardTests::testConfiguringLauncher()
     if (setupDetection.timedOut) {
         qDebug() << "timeout of " << setupDetection.timeout.interval() << " ms has been exceeded (normal if systemd units not available)";
     }
+    qDebug() << "setup detection timings: " << setupDetection.probeTimings();
     // -> verify whether the launcher setup detection is in the expected state before checking UI itself
     QVERIFY(setupDetection.launcherExitCode.has_value());
     QCOMPARE(setupDetection.launcherExitCode.value(), 0);
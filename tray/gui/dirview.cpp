@@ -56,8 +56,6 @@ void DirView::mouseReleaseEvent(QMouseEvent *event)
         }
     } else if (clickedRow.index.row() == 10 && clickedRow.data->pullErrorCount) {
         auto &connection(*clickedRow.model->connection());
-        connection.requestDirPullErrors(clickedRow.data->id);
-
         auto *const textViewDlg = new DirectoryErrorsDialog(connection, *clickedRow.data);
         textViewDlg->setAttribute(Qt::WA_DeleteOnClose);
         textViewDlg->show();
@@ -6,37 +6,39 @@ import Main
 
 Page {
     title: qsTr("Errors of folder \"%1\"").arg(dirName)
-    Component.onCompleted: App.loadDirErrors(dirId, listView)
     ScrollView {
         anchors.fill: parent
         CustomListView {
             id: listView
             width: parent.width
-            enabled: false
+            model: App.createPullErrorModel(dirId, listView)
             delegate: ItemDelegate {
                 width: listView.width
                 contentItem: ColumnLayout {
                     spacing: 0
                     Label {
                         Layout.fillWidth: true
-                        text: modelData.path
+                        text: path
+                        visible: loaded
                         wrapMode: Text.WrapAnywhere
                         font.weight: Font.Medium
                     }
                     Label {
                         Layout.fillWidth: true
-                        text: modelData.message
+                        text: message
                         wrapMode: Text.WrapAnywhere
                         font.weight: Font.Light
                     }
                 }
-                required property var modelData
+                required property string path
+                required property string message
+                required property bool loaded
             }
         }
     }
     BusyIndicator {
         anchors.centerIn: parent
-        running: !listView.enabled
+        running: listView.model?.loading ?? false
     }
 
     required property string dirName
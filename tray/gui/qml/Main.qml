@@ -82,6 +82,17 @@ ApplicationWindow {
                     wrapMode: Text.WordWrap
                     Layout.fillWidth: true
                 }
+                ProgressBar {
+                    visible: App.importExportProgress.bytesTotal > 0
+                    value: App.importExportProgress.ratio ?? 0
+                    Layout.preferredWidth: statusButton.width * 2
+                }
+                CustomToolButton {
+                    visible: App.importExportProgress.canceled === false
+                    icon.source: App.faUrlBase + "times"
+                    text: qsTr("Cancel copying files")
+                    onClicked: App.cancelImportExport()
+                }
                 CustomToolButton {
                     visible: !App.connection.connected
                     icon.source: App.faUrlBase + "refresh"
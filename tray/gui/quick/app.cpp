@@ -14,6 +14,7 @@
 #include <syncthingmodel/syncthingicons.h>
 
 #include <syncthingconnector/syncthingconnectionsettings.h>
+#include <syncthingconnector/syncthingstatesnapshot.h>
 
 #include <qtutilities/misc/desktoputils.h>
 
@@ -32,6 +33,7 @@
 #include <QNetworkReply>
 #include <QQmlContext>
 #include <QQuickWindow>
+#include <QSaveFile>
 #include <QStandardPaths>
 #include <QStringBuilder>
 #include <QUrlQuery>
@@ -168,9 +170,12 @@ App::App(bool insecure, QObject *parent)
     m_app->installEventFilter(this);
     m_app->setWindowIcon(QIcon(QStringLiteral(":/icons/hicolor/scalable/app/syncthingtray.svg")));
     connect(m_app, &QGuiApplication::applicationStateChanged, this, &App::handleStateChanged);
+    m_importExportProgressTimer.setInterval(250);
+    connect(&m_importExportProgressTimer, &QTimer::timeout, this, &App::importExportProgressChanged);
 
     deletePipelineCache();
     loadSettings();
+    restoreStateSnapshot();
     applySettings();
 #ifdef SYNCTHING_APP_DARK_MODE_FROM_COLOR_SCHEME
     QtUtilities::onDarkModeChanged([this](bool darkColorScheme) { applyDarkmodeChange(darkColorScheme, m_darkPalette); }, this);
@@ -535,28 +540,6 @@ bool App::showQrCode(Icon *icon)
     return true;
 }
 
-bool App::loadDirErrors(const QString &dirId, QObject *view)
-{
-    auto connection = connect(&m_connection, &Data::SyncthingConnection::dirStatusChanged, view, [this, dirId, view](const Data::SyncthingDir &dir) {
-        if (dir.id != dirId) {
-            return;
-        }
-        auto array = m_engine.newArray(static_cast<quint32>(dir.itemErrors.size()));
-        auto index = quint32();
-        for (const auto &itemError : dir.itemErrors) {
-            auto error = m_engine.newObject();
-            error.setProperty(QStringLiteral("path"), itemError.path);
-            error.setProperty(QStringLiteral("message"), itemError.message);
-            array.setProperty(index++, error);
-        }
-        view->setProperty("model", array.toVariant());
-        view->setProperty("enabled", true);
-    });
-    connect(this, &QObject::destroyed, [connection] { disconnect(connection); });
-    m_connection.requestDirPullErrors(dirId);
-    return true;
-}
-
 bool App::loadStatistics(const QJSValue &callback)
 {
     if (!callback.isCallable()) {
@@ -594,11 +577,27 @@ Data::SyncthingFileModel *App::createFileModel(const QString &dirId, QObject *pa
     return model;
 }
 
+Data::SyncthingPullErrorModel *App::createPullErrorModel(const QString &dirId, QObject *parent)
+{
+    return new Data::SyncthingPullErrorModel(m_connection, dirId, parent);
+}
+
 DiffHighlighter *App::createDiffHighlighter(QTextDocument *parent)
 {
     return new DiffHighlighter(parent);
 }
 
+Data::SyncthingConfigTransaction *App::createConfigTransaction(QObject *parent)
+{
+    auto transaction = new Data::SyncthingConfigTransaction(m_connection, parent);
+    connect(transaction, &Data::SyncthingConfigTransaction::committed, this, [this](const QString &errorMessage) {
+        if (!errorMessage.isEmpty()) {
+            emit error(tr("Unable to apply changes: ") + errorMessage);
+        }
+    });
+    return transaction;
+}
+
 #ifdef Q_OS_ANDROID
 #define REQUIRES_ANDROID_API(x) __attribute__((__availability__(android, introduced = x)))
 #define ANDROID_API_AT_LEAST(x) __builtin_available(android x, *)
@@ -830,6 +829,7 @@ void App::setCurrentControls(bool visible, int tabIndex)
     CppUtilities::modFlagEnum(flags, Data::SyncthingConnection::PollingFlags::DeviceStatistics, visible && tabIndex == 2);
     CppUtilities::modFlagEnum(flags, Data::SyncthingConnection::PollingFlags::DiskEvents, visible && tabIndex == 3);
     m_connection.setPollingFlags(flags);
+    m_connection.pollingScheduler()->setUiVisible(visible);
 }
 
 bool App::performHapticFeedback()
@@ -966,6 +966,7 @@ void App::handleStateChanged(Qt::ApplicationState state)
     if (m_isGuiLoaded && ((state == Qt::ApplicationSuspended) || (state & Qt::ApplicationHidden))) {
         qDebug() << "App considered suspended/hidden, reducing polling, stopping UI processing";
         setCurrentControls(false);
+        storeStateSnapshot();
         for (auto *const uiObject : m_uiObjects) {
             uiObject->moveToThread(nullptr);
         }
@@ -1334,6 +1335,43 @@ bool App::openSettings()
     return true;
 }
 
+/*!
+ * \brief Populates folders and devices from the state snapshot stored when the app was used last time.
+ * \remarks This makes folders and devices show up immediately on startup (with their last known statistics) instead of
+ *          only after connecting to Syncthing which might take a while, e.g. when Syncthing is started by the app itself.
+ */
+void App::restoreStateSnapshot()
+{
+    if (!m_settingsDir.has_value()) {
+        return;
+    }
+    auto file = QFile(m_settingsDir->path() + QStringLiteral("/statesnapshot.bin"));
+    if (!file.open(QFile::ReadOnly)) {
+        return; // no snapshot has been stored so far
+    }
+    auto snapshot = SyncthingStateSnapshot();
+    if (!snapshot.deserialize(file.readAll())) {
+        qWarning() << "Ignoring invalid state snapshot under" << file.fileName();
+        return;
+    }
+    m_connection.applySnapshot(std::move(snapshot));
+}
+
+/*!
+ * \brief Stores a snapshot of the current state to be restored via restoreStateSnapshot() on the next startup.
+ * \remarks Only done when connected so a previously stored snapshot is not overridden with incomplete information.
+ */
+void App::storeStateSnapshot()
+{
+    if (!m_settingsDir.has_value() || !m_connection.isConnected()) {
+        return;
+    }
+    auto file = QSaveFile(m_settingsDir->path() + QStringLiteral("/statesnapshot.bin"));
+    if (!file.open(QFile::WriteOnly) || file.write(SyncthingStateSnapshot(m_connection).serialize()) < 0 || !file.commit()) {
+        qWarning() << "Unable to store state snapshot:" << file.errorString();
+    }
+}
+
 QString App::readSettingFile(QFile &settingsFile, QJsonObject &settings)
 {
     auto parsError = QJsonParseError();
@@ -1461,12 +1499,11 @@ void App::applyLauncherSettings()
     options.dataDir = options.configDir;
     m_launcher.setLibSyncthingLogLevel(launcherSettingsObj.value(QLatin1String("logLevel")).toString());
     if (launcherSettingsObj.value(QLatin1String("writeLogFile")).toBool()) {
-        if (!m_launcher.logFile().isOpen()) {
-            m_launcher.logFile().setFileName(m_settingsDir->path() + QStringLiteral("/syncthing.log"));
-            m_launcher.logFile().open(QIODeviceBase::WriteOnly | QIODeviceBase::Append | QIODeviceBase::Text);
+        if (!m_launcher.isLogFileOpen()) {
+            m_launcher.openLogFile(m_settingsDir->path() + QStringLiteral("/syncthing.log"));
         }
     } else {
-        m_launcher.logFile().close();
+        m_launcher.closeLogFile();
     }
     m_launcher.setRunning(shouldRun, std::move(options));
 #else
@@ -1490,11 +1527,11 @@ bool App::clearLogfile()
         return false;
     }
 
-    auto &logFile = m_launcher.logFile();
-    if (logFile.fileName().isEmpty()) {
-        logFile.setFileName(m_settingsDir->path() + QStringLiteral("/syncthing.log"));
+    auto logFileName = m_launcher.logFileName();
+    if (logFileName.isEmpty()) {
+        logFileName = m_settingsDir->path() + QStringLiteral("/syncthing.log");
     }
-    auto ok = !logFile.exists() || logFile.remove();
+    auto ok = m_launcher.removeLogFile(logFileName);
     if (ok) {
         emit info(tr("Persistent logging disabled and logfile removed"));
     } else {
@@ -1522,6 +1559,53 @@ void App::setImportExportStatus(ImportExportStatus importExportStatus)
     }
 }
 
+/*!
+ * \brief Returns the progress of files being copied by the ongoing import/export/move or an empty map if none.
+ */
+QVariantMap App::importExportProgress() const
+{
+    auto progress = QVariantMap();
+    if (const auto &copier = m_fileCopier) {
+        const auto bytesTotal = copier->bytesTotal(), bytesCopied = copier->bytesCopied();
+        progress.insert(QStringLiteral("bytesTotal"), static_cast<qulonglong>(bytesTotal));
+        progress.insert(QStringLiteral("bytesCopied"), static_cast<qulonglong>(bytesCopied));
+        progress.insert(QStringLiteral("filesTotal"), static_cast<qulonglong>(copier->filesTotal()));
+        progress.insert(QStringLiteral("filesCopied"), static_cast<qulonglong>(copier->filesCopied()));
+        progress.insert(QStringLiteral("ratio"), bytesTotal ? static_cast<double>(bytesCopied) / static_cast<double>(bytesTotal) : 0.0);
+        progress.insert(QStringLiteral("canceled"), copier->isCanceled());
+    }
+    return progress;
+}
+
+/*!
+ * \brief Cancels copying files for the ongoing import/export/move.
+ * \remarks Already copied files are kept so invoking the same import/export/move again resumes it.
+ */
+bool App::cancelImportExport()
+{
+    if (!m_fileCopier || m_fileCopier->isCanceled()) {
+        return false;
+    }
+    m_fileCopier->cancel();
+    emit importExportProgressChanged();
+    return true;
+}
+
+std::shared_ptr<FileCopier> App::startFileCopier()
+{
+    m_fileCopier = std::make_shared<FileCopier>();
+    m_importExportProgressTimer.start();
+    emit importExportProgressChanged();
+    return m_fileCopier;
+}
+
+void App::stopFileCopier()
+{
+    m_fileCopier.reset();
+    m_importExportProgressTimer.stop();
+    emit importExportProgressChanged();
+}
+
 /*!
  * \brief Opens the Syncthing config file in the standard editor.
  */
@@ -1645,7 +1729,8 @@ bool App::importSettings(const QVariantMap &availableSettings, const QVariantMap
     }
 
     setImportExportStatus(ImportExportStatus::Importing);
-    QtConcurrent::run([this, importSyncthingHome, availableSettings, selectedSettings, rawConfig = m_connection.rawConfig()]() mutable {
+    QtConcurrent::run([this, importSyncthingHome, availableSettings, selectedSettings, rawConfig = m_connection.rawConfig(),
+                          copier = importSyncthingHome ? startFileCopier() : nullptr]() mutable {
         // copy selected files from import directory to settings directory
         auto summary = QStringList();
         auto syncthingHomePath = availableSettings.value(QStringLiteral("currentSyncthingHomePath")).toString();
@@ -1680,10 +1765,14 @@ bool App::importSettings(const QVariantMap &availableSettings, const QVariantMap
                 const auto homeSrcPath = SYNCTHING_APP_STRING_CONVERSION(homeSrcPathStr);
                 const auto homeDstPath = syncthingHomePath.isEmpty() ? (settingsPath / "syncthing")
                                                                      : std::filesystem::path(SYNCTHING_APP_STRING_CONVERSION(syncthingHomePath));
-                std::filesystem::remove_all(homeDstPath);
-                std::filesystem::create_directory(homeDstPath);
-                std::filesystem::copy(
-                    homeSrcPath, homeDstPath, std::filesystem::copy_options::update_existing | std::filesystem::copy_options::recursive);
+                if (!FileCopier::isResumable(homeSrcPath, homeDstPath)) {
+                    std::filesystem::remove_all(homeDstPath);
+                    std::filesystem::create_directory(homeDstPath);
+                }
+                copier->addTree(homeSrcPath, homeDstPath);
+                if (!copier->run()) {
+                    return std::make_pair(tr("Import has been canceled; import again to resume it."), true);
+                }
                 summary.append(tr("Imported Syncthing config and database from \"%1\".").arg(homeSrcPathStr));
             }
         } catch (const std::runtime_error &e) {
@@ -1729,6 +1818,7 @@ bool App::importSettings(const QVariantMap &availableSettings, const QVariantMap
         }
         return std::make_pair(summary.join(QChar('\n')), false);
     }).then(this, [this, callback](const std::pair<QString, bool> &res) {
+        stopFileCopier();
         setImportExportStatus(ImportExportStatus::None);
         m_settingsImport.first.clear();
         m_settingsImport.second.clear();
@@ -1760,7 +1850,7 @@ bool App::exportSettings(const QUrl &url, const QJSValue &callback)
     }
     setImportExportStatus(ImportExportStatus::Exporting);
 
-    QtConcurrent::run([this, url, currentHomePath = currentSyncthingHomeDir()] {
+    QtConcurrent::run([this, url, currentHomePath = currentSyncthingHomeDir(), copier = startFileCopier()] {
         const auto path = resolveUrl(url);
         const auto dir = QDir(path);
         if (!dir.exists() && !dir.mkpath(QStringLiteral("."))) {
@@ -1770,18 +1860,20 @@ bool App::exportSettings(const QUrl &url, const QJSValue &callback)
             return std::make_pair(tr("settings directory was not located."), true);
         }
         try {
-            std::filesystem::copy(SYNCTHING_APP_STRING_CONVERSION(m_settingsDir->path()), SYNCTHING_APP_STRING_CONVERSION(path),
-                std::filesystem::copy_options::update_existing | std::filesystem::copy_options::recursive);
+            copier->addTree(SYNCTHING_APP_STRING_CONVERSION(m_settingsDir->path()), SYNCTHING_APP_STRING_CONVERSION(path));
             if (!currentHomePath.isEmpty()) {
-                std::filesystem::copy(SYNCTHING_APP_STRING_CONVERSION(currentHomePath),
-                    SYNCTHING_APP_STRING_CONVERSION(path + QStringLiteral("/syncthing")),
-                    std::filesystem::copy_options::update_existing | std::filesystem::copy_options::recursive);
+                copier->addTree(
+                    SYNCTHING_APP_STRING_CONVERSION(currentHomePath), SYNCTHING_APP_STRING_CONVERSION(path + QStringLiteral("/syncthing")));
+            }
+            if (!copier->run()) {
+                return std::make_pair(tr("export has been canceled; export to \"%1\" again to resume it.").arg(path), true);
             }
         } catch (const std::filesystem::filesystem_error &e) {
             return std::make_pair(QString::fromUtf8(e.what()), true);
         }
         return std::make_pair(tr("Settings have been exported to \"%1\".").arg(path), false);
     }).then(this, [this, callback](const std::pair<QString, bool> &res) {
+        stopFileCopier();
         setImportExportStatus(ImportExportStatus::None);
         if (callback.isCallable()) {
             callback.call(QJSValueList{ QJSValue(res.first), QJSValue(res.second) });
@@ -1889,7 +1981,7 @@ bool App::moveSyncthingHome(const QString &newHomeDir, const QJSValue &callback)
 
     setImportExportStatus(ImportExportStatus::Moving);
     QtConcurrent::run([newHomeDir = newHomeDir, customHomeDir = currentSyncthingHomeDir(), defaultPath = m_settingsDir.value_or(QDir()).path(),
-                          rawConfig = m_connection.rawConfig()]() mutable {
+                          rawConfig = m_connection.rawConfig(), copier = startFileCopier()]() mutable {
         // determine paths
         const auto sourceDir = customHomeDir.isEmpty() ? defaultPath + QStringLiteral("/syncthing") : customHomeDir;
         const auto sourceDirStd = std::filesystem::path(SYNCTHING_APP_STRING_CONVERSION(sourceDir));
@@ -1911,12 +2003,19 @@ bool App::moveSyncthingHome(const QString &newHomeDir, const QJSValue &callback)
             const auto sourceStatus = std::filesystem::symlink_status(sourceDirStd);
             const auto destinationStatus = std::filesystem::symlink_status(destinationDirStd);
             if (std::filesystem::is_directory(sourceStatus) && !std::filesystem::is_empty(sourceDirStd)) {
-                std::filesystem::remove_all(destinationDirStd);
-                summary.append(tr("Cleaned up new home directory \"%1\".").arg(destinationDir));
+                if (FileCopier::isResumable(sourceDirStd, destinationDirStd)) {
+                    summary.append(tr("Resuming to copy data to new home directory \"%1\".").arg(destinationDir));
+                } else {
+                    std::filesystem::remove_all(destinationDirStd);
+                    summary.append(tr("Cleaned up new home directory \"%1\".").arg(destinationDir));
+                    std::filesystem::create_directory(destinationDirStd);
+                }
 
-                std::filesystem::create_directory(destinationDirStd);
-                std::filesystem::copy(
-                    sourceDirStd, destinationDirStd, std::filesystem::copy_options::update_existing | std::filesystem::copy_options::recursive);
+                copier->addTree(sourceDirStd, destinationDirStd);
+                if (!copier->run()) {
+                    summary.append(tr("Copying data has been canceled; move the home directory to \"%1\" again to resume it.").arg(destinationDir));
+                    return std::make_tuple(QString(), summary.join(QChar('\n')), true);
+                }
                 copied = true;
                 summary.append(tr("Copied data from previous home directory \"%1\" to new one.").arg(sourceDir));
 
@@ -1936,6 +2035,7 @@ bool App::moveSyncthingHome(const QString &newHomeDir, const QJSValue &callback)
         return std::make_tuple(newHomeDir, summary.join(QChar('\n')), false);
     }).then(this, [this, callback](const std::tuple<QString, QString, bool> &res) {
         m_homeDirMove.reset();
+        stopFileCopier();
 
         auto [setHomeDir, message, errorOccurred] = res;
         if (!setHomeDir.isNull()) {
@@ -4,6 +4,7 @@
 #include "./quickicon.h"
 
 #include <syncthingwidgets/misc/diffhighlighter.h>
+#include <syncthingwidgets/misc/filecopier.h>
 #include <syncthingwidgets/misc/internalerror.h>
 #include <syncthingwidgets/misc/otherdialogs.h>
 #include <syncthingwidgets/misc/statusinfo.h>
@@ -13,10 +14,12 @@
 #include <syncthingmodel/syncthingdevicemodel.h>
 #include <syncthingmodel/syncthingdirectorymodel.h>
 #include <syncthingmodel/syncthingfilemodel.h>
+#include <syncthingmodel/syncthingpullerrormodel.h>
 #include <syncthingmodel/syncthingrecentchangesmodel.h>
 #include <syncthingmodel/syncthingsortfiltermodel.h>
 
 #include <syncthingconnector/syncthingconfig.h>
+#include <syncthingconnector/syncthingconfigtransaction.h>
 #include <syncthingconnector/syncthingconnection.h>
 #include <syncthingconnector/syncthingconnectionsettings.h>
 #include <syncthingconnector/syncthingconnectionstatus.h>
@@ -29,6 +32,7 @@
 #include <QFuture>
 #include <QJsonObject>
 #include <QQmlApplicationEngine>
+#include <QTimer>
 #include <QUrl>
 #include <QtVersion>
 
@@ -38,6 +42,7 @@
 #endif
 
 #include <array>
+#include <memory>
 #include <optional>
 
 QT_FORWARD_DECLARE_CLASS(QTextDocument)
@@ -72,6 +77,7 @@ class App : public QObject {
     Q_PROPERTY(QVariantMap statistics READ statistics)
     Q_PROPERTY(bool savingConfig READ isSavingConfig NOTIFY savingConfigChanged)
     Q_PROPERTY(bool importExportOngoing READ isImportExportOngoing NOTIFY importExportOngoingChanged)
+    Q_PROPERTY(QVariantMap importExportProgress READ importExportProgress NOTIFY importExportProgressChanged)
     Q_PROPERTY(QString statusText READ statusText NOTIFY statusInfoChanged)
     Q_PROPERTY(QIcon statusIcon READ statusIcon NOTIFY statusInfoChanged)
     Q_PROPERTY(QString additionalStatusText READ additionalStatusText NOTIFY statusInfoChanged)
@@ -194,6 +200,7 @@ public:
     {
         return m_importExportStatus != ImportExportStatus::None;
     }
+    QVariantMap importExportProgress() const;
     const QString &statusText() const
     {
         return m_statusInfo.statusText();
@@ -233,6 +240,7 @@ public:
     Q_INVOKABLE void applyLauncherSettings();
     Q_INVOKABLE bool clearLogfile();
     Q_INVOKABLE bool checkOngoingImportExport();
+    Q_INVOKABLE bool cancelImportExport();
     Q_INVOKABLE bool openSyncthingConfigFile();
     Q_INVOKABLE bool checkSettings(const QUrl &url, const QJSValue &callback = QJSValue());
     Q_INVOKABLE bool importSettings(const QVariantMap &availableSettings, const QVariantMap &selectedSettings, const QJSValue &callback = QJSValue());
@@ -252,7 +260,6 @@ public:
     Q_INVOKABLE bool showLog(QObject *textArea);
     Q_INVOKABLE void clearLog();
     Q_INVOKABLE bool showQrCode(Icon *icon);
-    Q_INVOKABLE bool loadDirErrors(const QString &dirId, QObject *view);
     Q_INVOKABLE bool loadStatistics(const QJSValue &callback);
     Q_INVOKABLE bool showError(const QString &errorMessage);
     Q_INVOKABLE void setCurrentControls(bool visible, int tabIndex = -1);
@@ -261,7 +268,9 @@ public:
     Q_INVOKABLE QString resolveUrl(const QUrl &url);
     Q_INVOKABLE bool shouldIgnorePermissions(const QString &path);
     Q_INVOKABLE Data::SyncthingFileModel *createFileModel(const QString &dirId, QObject *parent);
+    Q_INVOKABLE Data::SyncthingPullErrorModel *createPullErrorModel(const QString &dirId, QObject *parent);
     Q_INVOKABLE QtGui::DiffHighlighter *createDiffHighlighter(QTextDocument *parent);
+    Q_INVOKABLE Data::SyncthingConfigTransaction *createConfigTransaction(QObject *parent);
     Q_INVOKABLE QVariantList internalErrors() const;
     Q_INVOKABLE void clearInternalErrors();
     Q_INVOKABLE bool postSyncthingConfig(const QJsonObject &rawConfig, const QJSValue &callback = QJSValue());
@@ -294,6 +303,7 @@ Q_SIGNALS:
     void connectionErrorsRequested();
     void savingConfigChanged(bool isSavingConfig);
     void importExportOngoingChanged(bool importExportOngoing);
+    void importExportProgressChanged();
     void statusInfoChanged();
     void textShared(const QString &text);
     void newDeviceTriggered(const QString &devId);
@@ -337,11 +347,15 @@ private:
     QString externalFilesDir() const;
     QStringList externalStoragePaths() const;
     void setImportExportStatus(ImportExportStatus importExportStatus);
+    std::shared_ptr<FileCopier> startFileCopier();
+    void stopFileCopier();
     void applyDarkmodeChange(bool isDarkColorSchemeEnabled, bool isDarkPaletteEnabled);
     static QString openSettingFile(QFile &settingsFile, const QString &path);
     static QString readSettingFile(QFile &settingsFile, QJsonObject &settings);
     bool openSettings();
     QString locateSettingsExportDir();
+    void restoreStateSnapshot();
+    void storeStateSnapshot();
 
     QQmlApplicationEngine m_engine;
     QGuiApplication *m_app;
@@ -369,6 +383,8 @@ private:
     QString m_syncthingDataDir;
     std::pair<QVariantMap, QVariantMap> m_settingsImport;
     std::optional<QString> m_homeDirMove;
+    std::shared_ptr<FileCopier> m_fileCopier;
+    QTimer m_importExportProgressTimer;
     Data::SyncthingLauncher m_launcher;
     QtUtilities::QtSettings m_qtSettings;
     QFile m_settingsFile;
@@ -10,6 +10,7 @@
 #include "./scenegraph/managedtexturenode.h"
 
 #include <QBitmap>
+#include <QCache>
 #include <QGuiApplication>
 #include <QIcon>
 #include <QPainter>
@@ -19,12 +20,77 @@
 #include <QSGTexture>
 #include <QScreen>
 
+#include <algorithm>
 #include <cstdlib>
 
 namespace QtGui {
 
 Q_GLOBAL_STATIC(ImageTexturesCache, s_iconImageCache)
 
+/// \cond
+namespace {
+
+/*!
+ * \brief The IconImageKey struct identifies an image rendered from an icon source.
+ * \remarks The source key is the cacheKey() of QIcon/QPixmap/QBitmap sources or the RGBA value of QColor sources.
+ */
+struct IconImageKey {
+    qint64 sourceKey;
+    int sourceType;
+    QSize size;
+    qreal devicePixelRatio;
+    QIcon::Mode mode;
+
+    bool operator==(const IconImageKey &other) const
+    {
+        return sourceKey == other.sourceKey && sourceType == other.sourceType && size == other.size
+            && qFuzzyCompare(devicePixelRatio, other.devicePixelRatio) && mode == other.mode;
+    }
+};
+
+size_t qHash(const IconImageKey &key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.sourceKey, key.sourceType, key.size.width(), key.size.height(), key.devicePixelRatio, static_cast<int>(key.mode));
+}
+
+/*!
+ * \brief The IconImageCache class caches images rendered from icon sources process-wide.
+ *
+ * Lists in the UI instantiate many icons from the same source. Rendering the source only once means those icons end
+ * up with the very same QImage which in turn means ImageTexturesCache uploads only one texture for them (which is
+ * packed into the scene graph's texture atlas as the texture is created with QQuickWindow::TextureCanUseAtlas).
+ */
+class IconImageCache {
+public:
+    explicit IconImageCache();
+    template <typename RenderFunction> QImage image(const IconImageKey &key, RenderFunction &&render);
+
+private:
+    QCache<IconImageKey, QImage> m_images;
+};
+
+IconImageCache::IconImageCache()
+    : m_images(8 * 1024) // max. cost in KiB
+{
+}
+
+template <typename RenderFunction> QImage IconImageCache::image(const IconImageKey &key, RenderFunction &&render)
+{
+    if (const auto *const cachedImage = m_images.object(key)) {
+        return *cachedImage;
+    }
+    auto image = render();
+    if (!image.isNull()) {
+        m_images.insert(key, new QImage(image), std::max<qsizetype>(image.sizeInBytes() / 1024, 1));
+    }
+    return image;
+}
+
+} // namespace
+/// \endcond
+
+Q_GLOBAL_STATIC(IconImageCache, s_iconRenderCache)
+
 Icon::Icon(QQuickItem *parent)
     : QQuickItem(parent)
     , m_active(false)
@@ -209,23 +275,39 @@ void Icon::updatePolish()
 
     if (const auto itemSize = QSizeF(width(), height()); !itemSize.isNull()) {
         const auto size = itemSize.toSize();
-        switch (m_source.userType()) {
-        case QMetaType::QPixmap:
-            m_icon = m_source.value<QPixmap>().toImage();
+        const auto sourceType = m_source.userType();
+        switch (sourceType) {
+        case QMetaType::QPixmap: {
+            const auto pixmap = m_source.value<QPixmap>();
+            m_icon = s_iconRenderCache->image(
+                IconImageKey{ pixmap.cacheKey(), sourceType, QSize(), 1.0, QIcon::Normal }, [&pixmap] { return pixmap.toImage(); });
             break;
+        }
         case QMetaType::QImage:
             m_icon = m_source.value<QImage>();
             break;
-        case QMetaType::QBitmap:
-            m_icon = m_source.value<QBitmap>().toImage();
+        case QMetaType::QBitmap: {
+            const auto bitmap = m_source.value<QBitmap>();
+            m_icon = s_iconRenderCache->image(
+                IconImageKey{ bitmap.cacheKey(), sourceType, QSize(), 1.0, QIcon::Normal }, [&bitmap] { return bitmap.toImage(); });
             break;
-        case QMetaType::QIcon:
-            m_icon = iconPixmap(m_source.value<QIcon>());
+        }
+        case QMetaType::QIcon: {
+            const auto icon = m_source.value<QIcon>();
+            m_icon = s_iconRenderCache->image(IconImageKey{ icon.cacheKey(), sourceType, iconSizeHint(), m_devicePixelRatio, iconMode() },
+                [this, &icon] { return iconPixmap(icon); });
             break;
-        case QMetaType::QColor:
-            m_icon = QImage(size, QImage::Format_Alpha8);
-            m_icon.fill(m_source.value<QColor>());
+        }
+        case QMetaType::QColor: {
+            const auto color = m_source.value<QColor>();
+            m_icon = s_iconRenderCache->image(
+                IconImageKey{ static_cast<qint64>(static_cast<quint64>(color.rgba64())), sourceType, size, 1.0, QIcon::Normal }, [&size, &color] {
+                    auto image = QImage(size, QImage::Format_Alpha8);
+                    image.fill(color);
+                    return image;
+                });
             break;
+        }
         default:
             break;
         }
@@ -77,6 +77,7 @@ TrayWidget::TrayWidget(TrayMenu *parent)
     , m_webViewDlg(nullptr)
     , m_notificationsDlg(nullptr)
     , m_internalErrorsButton(nullptr)
+    , m_connectionsOverviewButton(nullptr)
     , m_notifier(m_connection)
     , m_dirModel(m_connection)
     , m_sortFilterDirModel(&m_dirModel)
@@ -149,6 +150,13 @@ TrayWidget::TrayWidget(TrayMenu *parent)
     scanAllButton->setIcon(QIcon(QStringLiteral("refresh.fa")));
     scanAllButton->setFlat(true);
     cornerFrameLayout->addWidget(scanAllButton);
+    m_connectionsOverviewButton = new QPushButton(m_cornerFrame);
+    m_connectionsOverviewButton->setToolTip(tr("Show overview of all connections"));
+    m_connectionsOverviewButton->setIcon(
+        QIcon::fromTheme(QStringLiteral("network-connect"), QIcon(QStringLiteral(":/icons/hicolor/scalable/actions/network-connect.svg"))));
+    m_connectionsOverviewButton->setFlat(true);
+    m_connectionsOverviewButton->setVisible(false);
+    cornerFrameLayout->addWidget(m_connectionsOverviewButton);
     m_ui->tabWidget->setCornerWidget(m_cornerFrame, Qt::BottomRightCorner);
 
     // setup connection menu
@@ -218,6 +226,7 @@ TrayWidget::TrayWidget(TrayMenu *parent)
     connect(scanAllButton, &QPushButton::clicked, &m_connection, &SyncthingConnection::rescanAllDirs);
     connect(viewIdButton, &QPushButton::clicked, this, &TrayWidget::showOwnDeviceId);
     connect(showLogButton, &QPushButton::clicked, this, &TrayWidget::showLog);
+    connect(m_connectionsOverviewButton, &QPushButton::clicked, this, &TrayWidget::showConnectionsOverview);
     connect(m_ui->notificationsPushButton, &QPushButton::clicked, this, &TrayWidget::showNotifications);
     connect(restartButton, &QPushButton::clicked, this, &TrayWidget::restartSyncthing);
     connect(m_connectionsActionGroup, &QActionGroup::triggered, this, &TrayWidget::handleConnectionSelected);
@@ -379,6 +388,16 @@ void TrayWidget::showOwnDeviceId()
     showDialog(dlg, centerWidgetAvoidingOverflow(dlg));
 }
 
+void TrayWidget::showConnectionsOverview()
+{
+    const auto &connectionSettings = Settings::values().connection;
+    auto settings = std::vector<SyncthingConnectionSettings>();
+    settings.reserve(1 + connectionSettings.secondary.size());
+    settings.emplace_back(connectionSettings.primary);
+    settings.insert(settings.end(), connectionSettings.secondary.cbegin(), connectionSettings.secondary.cend());
+    showCenteredDialog(connectionPoolDialog(std::move(settings), this), QSize(600, 400));
+}
+
 void TrayWidget::showLog()
 {
     auto *const dlg = TextViewDialog::forLogEntries(m_connection, this);
@@ -541,6 +560,7 @@ void TrayWidget::applySettings(const QString &connectionConfig)
     }
     m_ui->connectionsPushButton->setText(m_selectedConnection->label);
     m_ui->connectionsPushButton->setHidden(secondaryConnectionSettings.empty());
+    m_connectionsOverviewButton->setHidden(secondaryConnectionSettings.empty());
     const bool reconnectRequired = m_connection.applySettings(*m_selectedConnection);
 
     // apply notification settings
@@ -823,7 +843,7 @@ bool TrayWidget::updateTrafficText()
 
 void TrayWidget::updateOverallStatistics()
 {
-    const auto overallStats = m_connection.computeOverallDirStatistics();
+    const auto &overallStats = m_connection.overallDirStatistics();
     m_ui->globalStatisticsLabel->setText(directoryStatusString(overallStats.global));
     m_ui->localStatisticsLabel->setText(directoryStatusString(overallStats.local));
 }
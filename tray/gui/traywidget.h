@@ -70,6 +70,7 @@ public Q_SLOTS:
     void showAboutDialog();
     void showWebUI();
     void showOwnDeviceId();
+    void showConnectionsOverview();
     void showLog();
     void showNotifications();
     void showUsingPositioningSettings();
@@ -135,6 +136,7 @@ private:
     QDialog *m_notificationsDlg;
     QFrame *m_cornerFrame;
     QPushButton *m_internalErrorsButton;
+    QPushButton *m_connectionsOverviewButton;
     Data::SyncthingConnection m_connection;
     Data::SyncthingNotifier m_notifier;
     Data::SyncthingDirectoryModel m_dirModel;